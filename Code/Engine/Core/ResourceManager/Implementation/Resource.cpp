@@ -151,6 +151,9 @@ void ezResource::CallUnloadData(Unload WhatToUnload)
   m_LoadingState = ld.m_State;
   m_uiQualityLevelsDiscardable = ld.m_uiQualityLevelsDiscardable;
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
+
+  // resources usually adjust their memory usage through ModifyMemoryUsage() when unloading
+  ezResourceManager::UpdateMemoryUsageTotals(this);
 }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -287,6 +290,7 @@ void ezResource::VerifyAfterCreateResource(const ezResourceLoadDesc& ld)
     EZ_ASSERT_DEV(MemUsage.m_uiMemoryGPU != 0xFFFFFFFF, "Resource '{0}' did not properly update its GPU memory usage", GetResourceID());
 
     m_MemoryUsage = MemUsage;
+    ezResourceManager::UpdateMemoryUsageTotals(this);
   }
 
   ezResourceEvent e;
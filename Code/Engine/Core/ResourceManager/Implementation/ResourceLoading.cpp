@@ -2,7 +2,13 @@
 
 #include <Core/ResourceManager/Implementation/ResourceManagerState.h>
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
+
+ezCVarInt cvar_ResourceMaxConcurrentLoads("Resource.MaxConcurrentLoads", 2, ezCVarFlags::Default, "How many resources may be loaded from disk at the same time");
+
+static constexpr ezUInt32 s_uiMaxLoadingTimeSamples = 128;
 
 ezTypelessResourceHandle ezResourceManager::LoadResourceByType(const ezRTTI* pResourceType, ezStringView sResourceID)
 {
@@ -53,7 +59,8 @@ void ezResourceManager::InternalPreloadResource(ezResource* pResource, bool bHig
 
     if (bHighestPriority && ezTaskSystem::GetCurrentThreadWorkerType() == ezWorkerThreadType::FileAccess)
     {
-      ezResourceManager::s_pState->m_bAllowLaunchDataLoadTask = true;
+      // the calling data load task may block until this resource is loaded, so it must not count against the budget
+      ezResourceManager::s_pState->m_bAllowDataLoadTaskOverBudget = true;
     }
 
     RunWorkerTask();
@@ -102,52 +109,44 @@ void ezResourceManager::RunWorkerTask()
 
   SetupWorkerTasks();
 
-  if (s_pState->m_bAllowLaunchDataLoadTask && !s_pState->m_LoadingQueue.IsEmpty())
+  const ezUInt32 uiMaxConcurrentLoads = static_cast<ezUInt32>(ezMath::Max<int>(1, cvar_ResourceMaxConcurrentLoads));
+
+  // don't start more tasks than there are queued resources, each task takes exactly one resource from the queue
+  while (s_pState->m_uiNumPendingDataLoadTasks < s_pState->m_LoadingQueue.GetCount())
   {
-    s_pState->m_bAllowLaunchDataLoadTask = false;
+    if (s_pState->m_uiNumActiveDataLoadTasks >= uiMaxConcurrentLoads)
+    {
+      if (!s_pState->m_bAllowDataLoadTaskOverBudget)
+        break;
+
+      s_pState->m_bAllowDataLoadTaskOverBudget = false;
+    }
+
+    ++s_pState->m_uiNumActiveDataLoadTasks;
+    ++s_pState->m_uiNumPendingDataLoadTasks;
+
+    ezResourceManagerState::TaskDataDataLoad* pTaskData = nullptr;
 
     for (ezUInt32 i = 0; i < s_pState->m_WorkerTasksDataLoad.GetCount(); ++i)
     {
       if (s_pState->m_WorkerTasksDataLoad[i].m_pTask->IsTaskFinished())
       {
-        s_pState->m_WorkerTasksDataLoad[i].m_GroupId =
-          ezTaskSystem::StartSingleTask(s_pState->m_WorkerTasksDataLoad[i].m_pTask, ezTaskPriority::FileAccess);
-        return;
+        pTaskData = &s_pState->m_WorkerTasksDataLoad[i];
+        break;
       }
     }
 
     // could not find any unused task -> need to create a new one
+    if (pTaskData == nullptr)
     {
       ezStringBuilder s;
       s.SetFormat("Resource Data Loader {0}", s_pState->m_WorkerTasksDataLoad.GetCount());
-      auto& data = s_pState->m_WorkerTasksDataLoad.ExpandAndGetRef();
-      data.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerDataLoad);
-      data.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
-      data.m_GroupId = ezTaskSystem::StartSingleTask(data.m_pTask, ezTaskPriority::FileAccess);
+      pTaskData = &s_pState->m_WorkerTasksDataLoad.ExpandAndGetRef();
+      pTaskData->m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerDataLoad);
+      pTaskData->m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
     }
-  }
-}
-
-void ezResourceManager::ReverseBubbleSortStep(ezDeque<LoadingInfo>& data)
-{
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
-
-  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
-
-  const ezUInt32 uiCount = data.GetCount();
 
-  for (ezUInt32 i = uiCount; i > 1; --i)
-  {
-    const ezUInt32 idx2 = i - 1;
-    const ezUInt32 idx1 = i - 2;
-
-    if (data[idx1].m_fPriority > data[idx2].m_fPriority)
-    {
-      ezMath::Swap(data[idx1], data[idx2]);
-    }
+    pTaskData->m_GroupId = ezTaskSystem::StartSingleTask(pTaskData->m_pTask, ezTaskPriority::FileAccess);
   }
 }
 
@@ -160,6 +159,9 @@ void ezResourceManager::UpdateLoadingDeadlines()
 
   EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
 
+  // Re-evaluate a limited number of entries per call, which gives us iterative updates with deterministic performance characteristics.
+  // The heap order changes while updating, so first gather the resources and then re-prioritize them one by one.
+
   const ezUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
   s_pState->m_uiLastResourcePriorityUpdateIdx = ezMath::Min(s_pState->m_uiLastResourcePriorityUpdateIdx, uiCount);
 
@@ -168,29 +170,69 @@ void ezResourceManager::UpdateLoadingDeadlines()
   if (uiUpdateCount == 0)
   {
     s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
-    uiUpdateCount = ezMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+    uiUpdateCount = ezMath::Min(50u, uiCount);
   }
 
-  if (uiUpdateCount > 0)
+  ezHybridArray<ezResource*, 50> resourcesToUpdate;
+
+  for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
   {
-    {
-      EZ_PROFILE_SCOPE("EvalLoadingDeadlines");
+    resourcesToUpdate.PushBack(s_pState->m_LoadingQueue[s_pState->m_uiLastResourcePriorityUpdateIdx].m_pResource);
+    ++s_pState->m_uiLastResourcePriorityUpdateIdx;
+  }
 
-      const ezTime tNow = ezTime::Now();
+  const ezTime tNow = ezTime::Now();
 
-      for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_pState->m_LoadingQueue[s_pState->m_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_pState->m_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+  for (ezResource* pResource : resourcesToUpdate)
+  {
+    s_pState->m_LoadingQueue.UpdatePriority(pResource, pResource->GetLoadingPriority(tNow));
+  }
+}
 
-    {
-      EZ_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_pState->m_LoadingQueue);
-    }
+void ezResourceManager::UpdateLoadingStats()
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  ezStats::SetStat("Resource Manager/Loading/Queue Depth", s_pState->m_LoadingQueue.GetCount());
+  ezStats::SetStat("Resource Manager/Loading/Active Data Loads", s_pState->m_uiNumActiveDataLoadTasks);
+
+  if (!s_pState->m_bLoadingTimeSamplesChanged)
+    return;
+
+  s_pState->m_bLoadingTimeSamplesChanged = false;
+
+  ezHybridArray<ezTime, s_uiMaxLoadingTimeSamples> samples;
+  samples = s_pState->m_LoadingTimeSamples.GetArrayPtr();
+  samples.Sort();
+
+  auto GetPercentile = [&](ezUInt32 uiPercent) -> double
+  {
+    const ezUInt32 uiIndex = ezMath::Min((samples.GetCount() * uiPercent) / 100, samples.GetCount() - 1);
+    return samples[uiIndex].GetMilliseconds();
+  };
+
+  ezStats::SetStat("Resource Manager/Loading/Loaded Resources", s_pState->m_uiNumResourcesLoaded);
+  ezStats::SetStat("Resource Manager/Loading/Time To Load P50 (ms)", GetPercentile(50));
+  ezStats::SetStat("Resource Manager/Loading/Time To Load P90 (ms)", GetPercentile(90));
+  ezStats::SetStat("Resource Manager/Loading/Time To Load P99 (ms)", GetPercentile(99));
+}
+
+void ezResourceManager::AddLoadingTimeSample(ezTime timeToLoad)
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  if (s_pState->m_LoadingTimeSamples.GetCount() < s_uiMaxLoadingTimeSamples)
+  {
+    s_pState->m_LoadingTimeSamples.PushBack(timeToLoad);
+  }
+  else
+  {
+    s_pState->m_LoadingTimeSamples[s_pState->m_uiNextLoadingTimeSample] = timeToLoad;
   }
+
+  s_pState->m_uiNextLoadingTimeSample = (s_pState->m_uiNextLoadingTimeSample + 1) % s_uiMaxLoadingTimeSamples;
+  ++s_pState->m_uiNumResourcesLoaded;
+  s_pState->m_bLoadingTimeSamplesChanged = true;
 }
 
 void ezResourceManager::PreloadResource(ezResource* pResource)
@@ -221,10 +263,7 @@ ezResult ezResourceManager::RemoveFromLoadingQueue(ezResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return EZ_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
-  if (s_pState->m_LoadingQueue.RemoveAndSwap(li))
+  if (s_pState->m_LoadingQueue.Remove(pResource))
   {
     pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     return EZ_SUCCESS;
@@ -240,19 +279,14 @@ void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPr
 
   pResource->m_Flags.Add(ezResourceFlags::IsQueuedForLoading);
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
   if (bHighestPriority)
   {
     pResource->SetPriority(ezResourcePriority::Critical);
-    li.m_fPriority = 0.0f;
-    s_pState->m_LoadingQueue.PushFront(li);
+    s_pState->m_LoadingQueue.Insert(pResource, 0.0f, ezTime::Now(), true);
   }
   else
   {
-    li.m_fPriority = pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate);
-    s_pState->m_LoadingQueue.PushBack(li);
+    s_pState->m_LoadingQueue.Insert(pResource, pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate), ezTime::Now(), false);
   }
 }
 
@@ -285,10 +319,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_pState->m_LoadingQueue.IndexOf(li) == ezInvalidIndex)
+    if (!s_pState->m_LoadingQueue.Contains(pResource))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
@@ -445,3 +476,128 @@ void ezResourceManager::EnsureResourceLoadingState(ezResource* pResourceToLoad,
     }
   }
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezResourceLoadingQueue::Insert(ezResource* pResource, float fPriority, ezTime enqueueTime, bool bInFront)
+{
+  EZ_ASSERT_DEBUG(!Contains(pResource), "Resource is already in the loading queue");
+
+  LoadingInfo li;
+  li.m_pResource = pResource;
+  li.m_fPriority = fPriority;
+  li.m_iSequence = bInFront ? m_iNextFrontSequence-- : m_iNextBackSequence++;
+  li.m_EnqueueTime = enqueueTime;
+
+  const ezUInt32 uiIndex = m_Heap.GetCount();
+  m_Heap.PushBack(li);
+  m_HeapIndex.Insert(pResource, uiIndex);
+
+  SiftUp(uiIndex);
+}
+
+bool ezResourceLoadingQueue::Remove(const ezResource* pResource)
+{
+  ezUInt32 uiIndex = 0;
+  if (!m_HeapIndex.TryGetValue(pResource, uiIndex))
+    return false;
+
+  RemoveAt(uiIndex);
+  return true;
+}
+
+void ezResourceLoadingQueue::UpdatePriority(const ezResource* pResource, float fPriority)
+{
+  ezUInt32 uiIndex = 0;
+  if (!m_HeapIndex.TryGetValue(pResource, uiIndex))
+    return;
+
+  const float fOldPriority = m_Heap[uiIndex].m_fPriority;
+  m_Heap[uiIndex].m_fPriority = fPriority;
+
+  if (fPriority < fOldPriority)
+    SiftUp(uiIndex);
+  else if (fPriority > fOldPriority)
+    SiftDown(uiIndex);
+}
+
+void ezResourceLoadingQueue::PopFront()
+{
+  EZ_ASSERT_DEBUG(!IsEmpty(), "The loading queue is empty");
+  RemoveAt(0);
+}
+
+void ezResourceLoadingQueue::Clear()
+{
+  m_Heap.Clear();
+  m_HeapIndex.Clear();
+}
+
+void ezResourceLoadingQueue::SetAt(ezUInt32 uiIndex, const LoadingInfo& info)
+{
+  m_Heap[uiIndex] = info;
+  m_HeapIndex[info.m_pResource] = uiIndex;
+}
+
+void ezResourceLoadingQueue::RemoveAt(ezUInt32 uiIndex)
+{
+  m_HeapIndex.Remove(m_Heap[uiIndex].m_pResource);
+
+  const ezUInt32 uiLast = m_Heap.GetCount() - 1;
+
+  if (uiIndex != uiLast)
+  {
+    // move the last entry into the gap, it may need to go either direction from there
+    SetAt(uiIndex, m_Heap[uiLast]);
+    m_Heap.PopBack();
+
+    SiftUp(uiIndex);
+    SiftDown(uiIndex);
+  }
+  else
+  {
+    m_Heap.PopBack();
+  }
+}
+
+void ezResourceLoadingQueue::SiftUp(ezUInt32 uiIndex)
+{
+  const LoadingInfo li = m_Heap[uiIndex];
+
+  while (uiIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!(li < m_Heap[uiParent]))
+      break;
+
+    SetAt(uiIndex, m_Heap[uiParent]);
+    uiIndex = uiParent;
+  }
+
+  SetAt(uiIndex, li);
+}
+
+void ezResourceLoadingQueue::SiftDown(ezUInt32 uiIndex)
+{
+  const LoadingInfo li = m_Heap[uiIndex];
+  const ezUInt32 uiCount = m_Heap.GetCount();
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiIndex * 2 + 1;
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && m_Heap[uiChild + 1] < m_Heap[uiChild])
+      ++uiChild;
+
+    if (!(m_Heap[uiChild] < li))
+      break;
+
+    SetAt(uiIndex, m_Heap[uiChild]);
+    uiIndex = uiChild;
+  }
+
+  SetAt(uiIndex, li);
+}
@@ -317,6 +317,231 @@ void ezResourceManager::SetAutoFreeUnused(ezTime timeout, ezTime lastAcquireThre
   s_pState->m_AutoFreeUnusedThreshold = lastAcquireThreshold;
 }
 
+void ezResourceManager::SetMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  s_pState->m_uiMemoryBudgetCPU = uiBudgetCPU;
+  s_pState->m_uiMemoryBudgetGPU = uiBudgetGPU;
+
+  UpdateAnyMemoryBudget();
+}
+
+void ezResourceManager::SetMemoryBudgetForResourceType(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  auto& info = GetResourceTypeInfo(pResourceType);
+  info.m_uiMemoryBudgetCPU = uiBudgetCPU;
+  info.m_uiMemoryBudgetGPU = uiBudgetGPU;
+
+  UpdateAnyMemoryBudget();
+}
+
+void ezResourceManager::UpdateAnyMemoryBudget()
+{
+  bool bAnyBudget = s_pState->m_uiMemoryBudgetCPU > 0 || s_pState->m_uiMemoryBudgetGPU > 0;
+
+  for (auto it = s_pState->m_TypeInfo.GetIterator(); it.IsValid() && !bAnyBudget; ++it)
+  {
+    bAnyBudget = it.Value().m_uiMemoryBudgetCPU > 0 || it.Value().m_uiMemoryBudgetGPU > 0;
+  }
+
+  s_pState->m_bAnyMemoryBudget = bAnyBudget;
+}
+
+void ezResourceManager::UpdateMemoryUsageTotals(ezResource* pResource)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  ezResource::MemoryUsage& counted = pResource->m_MemoryUsageInTotals;
+  const ezResource::MemoryUsage& current = pResource->m_MemoryUsage;
+
+  if (counted.m_uiMemoryCPU == current.m_uiMemoryCPU && counted.m_uiMemoryGPU == current.m_uiMemoryGPU)
+    return;
+
+  ezResource::MemoryUsage& total = s_pState->m_LoadedResources[pResource->GetDynamicRTTI()].m_MemoryUsage;
+  total.m_uiMemoryCPU = total.m_uiMemoryCPU - counted.m_uiMemoryCPU + current.m_uiMemoryCPU;
+  total.m_uiMemoryGPU = total.m_uiMemoryGPU - counted.m_uiMemoryGPU + current.m_uiMemoryGPU;
+
+  counted = current;
+}
+
+void ezResourceManager::SetMemoryBudgetEnforcement(ezTime timeSlice, ezTime lastAcquireThreshold)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  s_pState->m_MemoryBudgetTimeSlice = timeSlice;
+  s_pState->m_MemoryBudgetLastAcquireThreshold = lastAcquireThreshold;
+}
+
+ezUInt32 ezResourceManager::EnforceMemoryBudgets(ezTime timeSlice, ezTime lastAcquireThreshold)
+{
+  if (timeSlice.IsZeroOrNegative())
+    return 0;
+
+  EZ_LOCK(s_ResourceMutex);
+
+  if (!s_pState->m_bAnyMemoryBudget)
+    return 0;
+
+  EZ_PROFILE_SCOPE("EnforceMemoryBudgets");
+
+  struct Usage
+  {
+    ezUInt64 m_uiMemoryCPU = 0;
+    ezUInt64 m_uiMemoryGPU = 0;
+    ezUInt64 m_uiBudgetCPU = 0;
+    ezUInt64 m_uiBudgetGPU = 0;
+    LoadedResources* m_pResources = nullptr;
+    bool m_bIncrementalUnload = true;
+
+    bool IsOverBudget() const
+    {
+      return (m_uiBudgetCPU > 0 && m_uiMemoryCPU > m_uiBudgetCPU) || (m_uiBudgetGPU > 0 && m_uiMemoryGPU > m_uiBudgetGPU);
+    }
+
+    void Change(const ezResource::MemoryUsage& before, const ezResource::MemoryUsage& after)
+    {
+      m_uiMemoryCPU = m_uiMemoryCPU - ezMath::Min(m_uiMemoryCPU, before.m_uiMemoryCPU) + after.m_uiMemoryCPU;
+      m_uiMemoryGPU = m_uiMemoryGPU - ezMath::Min(m_uiMemoryGPU, before.m_uiMemoryGPU) + after.m_uiMemoryGPU;
+    }
+  };
+
+  struct Candidate
+  {
+    ezResource* m_pResource = nullptr;
+    ezUInt32 m_uiType = 0;
+    ezTime m_LastAcquire;
+    bool m_bReferenced = false;
+
+    // unreferenced resources are deallocated before referenced ones get demoted, each in least recently used order
+    bool operator<(const Candidate& rhs) const
+    {
+      if (m_bReferenced != rhs.m_bReferenced)
+        return !m_bReferenced;
+
+      return m_LastAcquire < rhs.m_LastAcquire;
+    }
+  };
+
+  const ezTime tStart = ezTime::Now();
+
+  Usage total;
+  total.m_uiBudgetCPU = s_pState->m_uiMemoryBudgetCPU;
+  total.m_uiBudgetGPU = s_pState->m_uiMemoryBudgetGPU;
+
+  ezHybridArray<Usage, 32> types;
+  bool bAnyTypeOverBudget = false;
+
+  // the totals are kept up to date whenever the memory usage of a resource changes, so only the types need to be visited here
+  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    Usage& usage = types.ExpandAndGetRef();
+    usage.m_pResources = &itType.Value();
+
+    auto itInfo = s_pState->m_TypeInfo.Find(itType.Key());
+    if (itInfo.IsValid())
+    {
+      usage.m_uiBudgetCPU = itInfo.Value().m_uiMemoryBudgetCPU;
+      usage.m_uiBudgetGPU = itInfo.Value().m_uiMemoryBudgetGPU;
+      usage.m_bIncrementalUnload = itInfo.Value().m_bIncrementalUnload;
+    }
+
+    usage.m_uiMemoryCPU = usage.m_pResources->m_MemoryUsage.m_uiMemoryCPU;
+    usage.m_uiMemoryGPU = usage.m_pResources->m_MemoryUsage.m_uiMemoryGPU;
+    bAnyTypeOverBudget |= usage.IsOverBudget();
+
+    total.m_uiMemoryCPU += usage.m_uiMemoryCPU;
+    total.m_uiMemoryGPU += usage.m_uiMemoryGPU;
+  }
+
+  const bool bTotalOverBudget = total.IsOverBudget();
+
+  if (!bTotalOverBudget && !bAnyTypeOverBudget)
+    return 0;
+
+  ezDynamicArray<Candidate> candidates;
+
+  for (ezUInt32 uiType = 0; uiType < types.GetCount(); ++uiType)
+  {
+    const Usage& usage = types[uiType];
+
+    if (!bTotalOverBudget && !usage.IsOverBudget())
+      continue;
+
+    for (auto it = usage.m_pResources->m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      ezResource* pResource = it.Value();
+
+      Candidate candidate;
+      candidate.m_pResource = pResource;
+      candidate.m_uiType = uiType;
+      candidate.m_LastAcquire = pResource->GetLastAcquireTime();
+      candidate.m_bReferenced = pResource->GetReferenceCount() > 0;
+
+      if (candidate.m_bReferenced)
+      {
+        // demoting resources that are still in use would just make them load again right away
+        if (pResource->GetNumQualityLevelsDiscardable() == 0 || IsQueuedForLoading(pResource) || tStart - candidate.m_LastAcquire <= lastAcquireThreshold)
+          continue;
+      }
+      else if (!usage.m_bIncrementalUnload)
+      {
+        continue;
+      }
+
+      candidates.PushBack(candidate);
+    }
+  }
+
+  candidates.Sort();
+
+  ezUInt32 uiAffectedCount = 0;
+  ezStringBuilder sResourceName;
+
+  for (const Candidate& candidate : candidates)
+  {
+    // stop once we wasted enough time
+    if (ezTime::Now() - tStart >= timeSlice)
+      break;
+
+    Usage& usage = types[candidate.m_uiType];
+
+    if (!total.IsOverBudget() && !usage.IsOverBudget())
+      continue;
+
+    ezResource* pResource = candidate.m_pResource;
+    const ezResource::MemoryUsage before = pResource->m_MemoryUsageInTotals;
+    ezResource::MemoryUsage after;
+
+    if (!candidate.m_bReferenced)
+    {
+      sResourceName = pResource->GetResourceID();
+
+      if (DeallocateResource(pResource).Failed())
+        continue;
+
+      usage.m_pResources->m_Resources.Remove(ezTempHashedString(sResourceName));
+
+      ezLog::Debug("Freed '{}' to stay within the memory budget", ezArgSensitive(sResourceName, "ResourceID"));
+    }
+    else
+    {
+      pResource->CallUnloadData(ezResource::Unload::OneQualityLevel);
+      pResource->UpdateMemoryUsage(after);
+      pResource->m_MemoryUsage = after;
+      UpdateMemoryUsageTotals(pResource);
+    }
+
+    usage.Change(before, after);
+    total.Change(before, after);
+    ++uiAffectedCount;
+  }
+
+  return uiAffectedCount;
+}
+
 void ezResourceManager::AllowResourceTypeAcquireDuringUpdateContent(const ezRTTI* pTypeBeingUpdated, const ezRTTI* pTypeItWantsToAcquire)
 {
   auto& info = s_pState->m_TypeInfo[pTypeBeingUpdated];
@@ -407,6 +632,10 @@ ezResult ezResourceManager::DeallocateResource(ezResource* pResource)
 
   EZ_ASSERT_DEV(pResource->GetReferenceCount() == 0, "The resource '{}' ({}) is being deallocated, you just stored a handle to it, which won't work! If you are listening to ezResourceEvent::Type::ResourceContentUnloading then additionally listen to ezResourceEvent::Type::ResourceDeleted to clean up handles to dead resources.", pResource->GetResourceID(), pResource->GetResourceDescription());
 
+  // whatever the resource still reports doesn't count anymore
+  pResource->m_MemoryUsage = ezResource::MemoryUsage();
+  UpdateMemoryUsageTotals(pResource);
+
   // delete the resource via the RTTI provided allocator
   pResource->GetDynamicRTTI()->GetAllocator()->Deallocate(pResource);
 
@@ -495,10 +724,20 @@ void ezResourceManager::PerFrameUpdate()
     s_pState->m_ResourcesToUnloadOnMainThread.Clear();
   }
 
+  {
+    EZ_LOCK(s_ResourceMutex);
+    UpdateLoadingStats();
+  }
+
   if (s_pState->m_AutoFreeUnusedTimeout.IsPositive())
   {
     FreeUnusedResources(s_pState->m_AutoFreeUnusedTimeout, s_pState->m_AutoFreeUnusedThreshold);
   }
+
+  if (s_pState->m_bAnyMemoryBudget)
+  {
+    EnforceMemoryBudgets(s_pState->m_MemoryBudgetTimeSlice, s_pState->m_MemoryBudgetLastAcquireThreshold);
+  }
 }
 
 const ezEvent<const ezResourceEvent&, ezMutex>& ezResourceManager::GetResourceEvents()
@@ -538,7 +777,6 @@ void ezResourceManager::OnCoreStartup()
   s_pState = EZ_DEFAULT_NEW(ezResourceManagerState);
 
   EZ_LOCK(s_ResourceMutex);
-  s_pState->m_bAllowLaunchDataLoadTask = true;
   s_pState->m_bShutdown = false;
 
   ezPlugin::Events().AddEventHandler(PluginEventHandler);
@@ -555,7 +793,7 @@ void ezResourceManager::EngineAboutToShutdown()
       return;
     }
 
-    s_pState->m_bAllowLaunchDataLoadTask = false; // prevent a new one from starting
+    s_pState->m_bAllowDataLoadTaskOverBudget = false; // prevent a new one from starting
     s_pState->m_bShutdown = true;
   }
 
@@ -572,9 +810,9 @@ void ezResourceManager::EngineAboutToShutdown()
   {
     EZ_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_pState->m_LoadingQueue)
+    for (ezUInt32 i = 0; i < s_pState->m_LoadingQueue.GetCount(); ++i)
     {
-      entry.m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      s_pState->m_LoadingQueue[i].m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     }
 
     s_pState->m_LoadingQueue.Clear();
@@ -899,6 +1137,7 @@ void ezResourceManager::SetResourceLowResData(const ezTypelessResourceHandle& hR
     EZ_ASSERT_DEV(MemUsage.m_uiMemoryGPU != 0xFFFFFFFF, "Resource '{0}' did not properly update its GPU memory usage", pResource->GetResourceID());
 
     pResource->m_MemoryUsage = MemUsage;
+    UpdateMemoryUsageTotals(pResource);
   }
 }
 
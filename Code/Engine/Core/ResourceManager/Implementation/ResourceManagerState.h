@@ -5,6 +5,49 @@ EZ_CORE_INTERNAL_HEADER
 
 #include <Core/ResourceManager/ResourceManager.h>
 
+/// \brief [internal] Binary min-heap of the resources that are waiting for a data load task.
+///
+/// Entries are ordered by their loading priority (lower values are loaded first) and then by the order in which they were requested.
+/// The heap position of every resource is tracked, so that removing or re-prioritizing a specific resource only costs O(log n).
+class ezResourceLoadingQueue
+{
+public:
+  using LoadingInfo = ezResourceManager::LoadingInfo;
+
+  bool IsEmpty() const { return m_Heap.IsEmpty(); }
+  ezUInt32 GetCount() const { return m_Heap.GetCount(); }
+  bool Contains(const ezResource* pResource) const { return m_HeapIndex.Contains(pResource); }
+
+  /// \brief Adds the resource to the queue. If bInFront is set, it is sorted before all other entries with the same priority.
+  void Insert(ezResource* pResource, float fPriority, ezTime enqueueTime, bool bInFront);
+
+  /// \brief Removes the resource from the queue. Returns false, if it was not queued.
+  bool Remove(const ezResource* pResource);
+
+  /// \brief Changes the priority of a queued resource and restores the heap order.
+  void UpdatePriority(const ezResource* pResource, float fPriority);
+
+  /// \brief Returns the entry that should be loaded next.
+  const LoadingInfo& PeekFront() const { return m_Heap[0]; }
+  void PopFront();
+
+  /// \brief Gives access to the entries in heap order, which is not the loading order.
+  const LoadingInfo& operator[](ezUInt32 uiIndex) const { return m_Heap[uiIndex]; }
+
+  void Clear();
+
+private:
+  void SetAt(ezUInt32 uiIndex, const LoadingInfo& info);
+  void RemoveAt(ezUInt32 uiIndex);
+  void SiftUp(ezUInt32 uiIndex);
+  void SiftDown(ezUInt32 uiIndex);
+
+  ezDynamicArray<LoadingInfo> m_Heap;
+  ezHashTable<const ezResource*, ezUInt32> m_HeapIndex;
+  ezInt64 m_iNextBackSequence = 0;
+  ezInt64 m_iNextFrontSequence = -1;
+};
+
 class ezResourceManagerState
 {
 private:
@@ -51,19 +94,34 @@ private:
   ezUInt32 m_uiForceNoFallbackAcquisition = 0;
 
   // resources in this queue are waiting for a task to load them
-  ezDeque<ezResourceManager::LoadingInfo> m_LoadingQueue;
+  ezResourceLoadingQueue m_LoadingQueue;
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> m_LoadedResources;
 
-  bool m_bAllowLaunchDataLoadTask = true;
+  // allows one data load task to be started even if the budget of concurrent loads is used up,
+  // e.g. because a data load task needs another resource loaded with highest priority
+  bool m_bAllowDataLoadTaskOverBudget = false;
   bool m_bShutdown = false;
 
   ezHybridArray<TaskDataUpdateContent, 24> m_WorkerTasksUpdateContent;
   ezHybridArray<TaskDataDataLoad, 8> m_WorkerTasksDataLoad;
 
+  // data load tasks that were started and have not finished their work yet
+  ezUInt32 m_uiNumActiveDataLoadTasks = 0;
+  // the subset of the active data load tasks that has not taken a resource from the queue yet
+  ezUInt32 m_uiNumPendingDataLoadTasks = 0;
+
   ezTime m_LastFrameUpdate;
   ezUInt32 m_uiLastResourcePriorityUpdateIdx = 0;
 
+  // Loading statistics
+
+  // ring buffer of the most recent times between a resource being queued and its content being updated
+  ezDynamicArray<ezTime> m_LoadingTimeSamples;
+  ezUInt32 m_uiNextLoadingTimeSample = 0;
+  ezUInt32 m_uiNumResourcesLoaded = 0;
+  bool m_bLoadingTimeSamplesChanged = false;
+
   ezDynamicArray<ezResource*> m_LoadedResourceOfTypeTempContainer;
   ezHashTable<ezTempHashedString, const ezRTTI*> m_ResourcesToUnloadOnMainThread;
 
@@ -101,5 +159,12 @@ private:
   ezTime m_AutoFreeUnusedTimeout = ezTime::MakeZero();
   ezTime m_AutoFreeUnusedThreshold = ezTime::MakeZero();
 
+  // Memory budgets
+  ezUInt64 m_uiMemoryBudgetCPU = 0;
+  ezUInt64 m_uiMemoryBudgetGPU = 0;
+  bool m_bAnyMemoryBudget = false;
+  ezTime m_MemoryBudgetTimeSlice = ezTime::MakeFromMilliseconds(1);
+  ezTime m_MemoryBudgetLastAcquireThreshold = ezTime::MakeFromSeconds(5);
+
   ezMap<const ezRTTI*, ezResourceManager::ResourceTypeInfo> m_TypeInfo;
 };
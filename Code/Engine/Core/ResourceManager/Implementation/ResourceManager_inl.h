@@ -329,3 +329,9 @@ void ezResourceManager::SetIncrementalUnloadForResourceType(bool bActive)
 {
   GetResourceTypeInfo(ezGetStaticRTTI<ResourceType>()).m_bIncrementalUnload = bActive;
 }
+
+template <typename ResourceType>
+void ezResourceManager::SetMemoryBudgetForResourceType(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  SetMemoryBudgetForResourceType(ezGetStaticRTTI<ResourceType>(), uiBudgetCPU, uiBudgetGPU);
+}
@@ -8,10 +8,40 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
-struct FileResourceLoadData
+/// \brief Reads the serialized file path from m_Reader, followed by the file content from m_MappedReader, if the file is memory mapped.
+struct FileResourceLoadData : public ezStreamReader
 {
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+  {
+    ezUInt64 uiBytesRead = m_Reader.ReadBytes(pReadBuffer, uiBytesToRead);
+
+    if (uiBytesRead < uiBytesToRead)
+    {
+      uiBytesRead += m_MappedReader.ReadBytes(pReadBuffer != nullptr ? ezMemoryUtils::AddByteOffset(pReadBuffer, static_cast<std::ptrdiff_t>(uiBytesRead)) : nullptr, uiBytesToRead - uiBytesRead);
+    }
+
+    return uiBytesRead;
+  }
+
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override
+  {
+    ezUInt64 uiBytesSkipped = m_Reader.SkipBytes(uiBytesToSkip);
+
+    if (uiBytesSkipped < uiBytesToSkip)
+    {
+      uiBytesSkipped += m_MappedReader.SkipBytes(uiBytesToSkip - uiBytesSkipped);
+    }
+
+    return uiBytesSkipped;
+  }
+
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+
+  // only used when the file content is available as a memory mapping (e.g. uncompressed files in archives),
+  // in that case the file stays open until the data stream is closed, to keep the mapping alive
+  ezFileReader m_MappedFile;
+  ezRawMemoryStreamReader m_MappedReader;
 };
 
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
@@ -20,9 +50,14 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   ezResourceLoadData res;
 
-  ezFileReader File;
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+  ezFileReader& File = pData->m_MappedFile;
+
   if (File.Open(pResource->GetResourceID()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
 
@@ -35,11 +70,11 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
-
   const ezUInt64 uiFileSize = File.GetFileSize();
+  const ezArrayPtr<const ezUInt8> mappedData = File.GetMappedData();
+  const bool bIsMapped = !mappedData.IsEmpty() && mappedData.GetCount() == uiFileSize;
 
-  const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
+  const ezUInt64 uiBlobCapacity = (bIsMapped ? 0 : uiFileSize) + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
   pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
 
   ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
@@ -51,10 +86,21 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  if (bIsMapped)
+  {
+    // the file content is read straight from the mapped memory, no need to copy it
+    pData->m_Reader.Reset(pBlobPtr, uiOffset);
+    pData->m_MappedReader.Reset(mappedData.GetPtr(), mappedData.GetCount());
+  }
+  else
+  {
+    File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+    File.Close();
+
+    pData->m_Reader.Reset(pBlobPtr, uiOffset + uiFileSize);
+  }
 
-  pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
-  res.m_pDataStream = &pData->m_Reader;
+  res.m_pDataStream = pData;
   res.m_pCustomLoaderData = pData;
 
   return res;
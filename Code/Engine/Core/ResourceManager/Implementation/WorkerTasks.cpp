@@ -15,20 +15,24 @@ void ezResourceManagerWorkerDataLoad::Execute()
   ezResource* pResourceToLoad = nullptr;
   ezResourceTypeLoader* pLoader = nullptr;
   ezUniquePtr<ezResourceTypeLoader> pCustomLoader;
+  ezTime enqueueTime;
 
   {
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
 
+    --ezResourceManager::s_pState->m_uiNumPendingDataLoadTasks;
+
     if (ezResourceManager::s_pState->m_LoadingQueue.IsEmpty())
     {
-      ezResourceManager::s_pState->m_bAllowLaunchDataLoadTask = true;
+      --ezResourceManager::s_pState->m_uiNumActiveDataLoadTasks;
       return;
     }
 
     ezResourceManager::UpdateLoadingDeadlines();
 
-    auto it = ezResourceManager::s_pState->m_LoadingQueue.PeekFront();
+    const auto& it = ezResourceManager::s_pState->m_LoadingQueue.PeekFront();
     pResourceToLoad = it.m_pResource;
+    enqueueTime = it.m_EnqueueTime;
     ezResourceManager::s_pState->m_LoadingQueue.PopFront();
 
     if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
@@ -94,13 +98,14 @@ void ezResourceManagerWorkerDataLoad::Execute()
     pUpdateContentTask->m_pLoader = pLoader;
     pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
     pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
+    pUpdateContentTask->m_EnqueueTime = enqueueTime;
 
     // schedule the task to run, either on the main thread or on some other thread
     *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
       pUpdateContentTask, bResourceIsLoadedOnMainThread ? ezTaskPriority::SomeFrameMainThread : ezTaskPriority::LateNextFrame);
 
-    // restart the next loading task (this one is about to finish)
-    ezResourceManager::s_pState->m_bAllowLaunchDataLoadTask = true;
+    // start the next loading task (this one is about to finish)
+    --ezResourceManager::s_pState->m_uiNumActiveDataLoadTasks;
     ezResourceManager::RunWorkerTask();
 
     pCustomLoader.Clear();
@@ -153,7 +158,9 @@ void ezResourceManagerWorkerUpdateContent::Execute()
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
     EZ_ASSERT_DEV(ezResourceManager::IsQueuedForLoading(m_pResourceToLoad), "Multi-threaded access detected");
     m_pResourceToLoad->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+    ezResourceManager::UpdateMemoryUsageTotals(m_pResourceToLoad);
     m_pResourceToLoad->m_LastAcquire = ezResourceManager::GetLastFrameUpdate();
+    ezResourceManager::AddLoadingTimeSample(ezTime::Now() - m_EnqueueTime);
   }
 
   m_pLoader = nullptr;
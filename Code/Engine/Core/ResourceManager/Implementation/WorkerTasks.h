@@ -33,6 +33,8 @@ public:
   // this is only used to clean up a custom loader at the right time, if one is used
   // m_pLoader is always set, no need to go through m_pCustomLoader
   ezUniquePtr<ezResourceTypeLoader> m_pCustomLoader;
+  // when the resource was put into the loading queue, used for the loading time statistics
+  ezTime m_EnqueueTime;
 
 private:
   friend class ezResourceManager;
@@ -232,6 +232,7 @@ private:
   ezString m_sUniqueID;
   ezString m_sResourceDescription;
   MemoryUsage m_MemoryUsage;
+  MemoryUsage m_MemoryUsageInTotals; ///< The part of m_MemoryUsage that is already counted in the memory usage totals of the resource manager.
   ezBitflags<ezResourceFlags> m_Flags;
 
   ezTime m_LastAcquire;
@@ -226,6 +226,34 @@ public:
   template <typename ResourceType>
   static void SetIncrementalUnloadForResourceType(bool bActive);
 
+  /// \brief Sets how much CPU and GPU memory all resources together may use, as reported through ezResource::GetMemoryUsage(). Zero means unlimited, which is the default.
+  ///
+  /// Once a budget is exceeded, PerFrameUpdate() calls EnforceMemoryBudgets() with the values passed to SetMemoryBudgetEnforcement().
+  /// The memory usage per type is tracked whenever resources are loaded, unloaded or deallocated, so checking the budgets is cheap.
+  static void SetMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Same as SetMemoryBudget(), but only for the resources of exactly the given type.
+  template <typename ResourceType>
+  static void SetMemoryBudgetForResourceType(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Same as SetMemoryBudget(), but only for the resources of exactly the given type.
+  static void SetMemoryBudgetForResourceType(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Configures how much time PerFrameUpdate() may spend on enforcing the memory budgets and which resources count as recently used.
+  ///
+  /// The defaults are 1 millisecond and 5 seconds. See EnforceMemoryBudgets().
+  static void SetMemoryBudgetEnforcement(ezTime timeSlice, ezTime lastAcquireThreshold);
+
+  /// \brief Frees memory in least recently used order until all memory budgets are met again or the time slice is used up. Returns the number of affected resources.
+  ///
+  /// Resources that are not referenced anymore are deallocated first, unless incremental unloading is disabled for their type.
+  /// After that, resources that are still referenced, but have not been acquired within lastAcquireThreshold, get one quality level unloaded at a time,
+  /// which demotes them to lower resolution data. They are loaded in full quality again once they get acquired.
+  /// Only resources of types that are over their own budget are affected, unless the global budget is exceeded.
+  ///
+  /// Must be called from the main thread, because some resource types can only be unloaded there.
+  static ezUInt32 EnforceMemoryBudgets(ezTime timeSlice, ezTime lastAcquireThreshold);
+
   template <typename TypeBeingUpdated, typename TypeItWantsToAcquire>
   static void AllowResourceTypeAcquireDuringUpdateContent()
   {
@@ -430,6 +458,7 @@ private:
   friend class ezResourceManagerWorkerDataLoad;
   friend class ezResourceManagerWorkerUpdateContent;
   friend class ezResourceHandleReadContext;
+  friend class ezResourceLoadingQueue;
 
   // Events
 private:
@@ -452,15 +481,23 @@ private:
   struct LoadedResources
   {
     ezHashTable<ezTempHashedString, ezResource*> m_Resources;
+    ezResource::MemoryUsage m_MemoryUsage; ///< Sum of the memory usage of all resources of this type, see UpdateMemoryUsageTotals().
   };
 
   struct LoadingInfo
   {
     float m_fPriority = 0;
+    ezInt64 m_iSequence = 0; ///< Breaks ties between equal priorities, lower values were requested earlier.
     ezResource* m_pResource = nullptr;
+    ezTime m_EnqueueTime;
+
+    EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const
+    {
+      if (m_fPriority != rhs.m_fPriority)
+        return m_fPriority < rhs.m_fPriority;
 
-    EZ_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
-    EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
+      return m_iSequence < rhs.m_iSequence;
+    }
   };
   static void EnsureResourceLoadingState(ezResource* pResource, const ezResourceState RequestedState);
   static void PreloadResource(ezResource* pResource);
@@ -471,7 +508,8 @@ private:
   static ezResource* GetResource(const ezRTTI* pRtti, ezStringView sResourceID, bool bIsReloadable);
   static void RunWorkerTask();
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
+  static void UpdateLoadingStats();
+  static void AddLoadingTimeSample(ezTime timeToLoad);
   static bool ReloadResource(ezResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
@@ -488,10 +526,17 @@ private:
     bool m_bIncrementalUnload = true;
     bool m_bAllowNestedAcquireCached = false;
 
+    ezUInt64 m_uiMemoryBudgetCPU = 0;
+    ezUInt64 m_uiMemoryBudgetGPU = 0;
+
     ezHybridArray<const ezRTTI*, 8> m_NestedTypes;
   };
 
   static ResourceTypeInfo& GetResourceTypeInfo(const ezRTTI* pRtti);
+  static void UpdateAnyMemoryBudget();
+
+  /// \brief Adds the change of the resource's memory usage since the last call to the total of its type. Has to be called whenever ezResource::m_MemoryUsage was updated.
+  static void UpdateMemoryUsageTotals(ezResource* pResource);
 
   // Type loaders
 private:
@@ -581,12 +581,22 @@ private:
 
     ezUInt32 m_uiStableRandomSeed = 0;
 
+    /// The world update counter at which the global transform was last recomputed by the world update.
+    /// ezInvalidIndex indicates that the local transform or the parent has changed since then. Only used if ezWorldDesc::m_bTrackTransformChanges is set.
+    ezUInt32 m_uiGlobalTransformUpdateCounter = ezInvalidIndex;
+
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
     ezUInt32 m_uiLastGlobalTransformUpdateCounter = 0;
-#else
-    ezUInt32 m_uiPadding2[1];
+    ezUInt32 m_uiPadding2[3];
 #endif
 
+    /// \brief Flags the global transform as outdated, so that the next world update recomputes it even if only changed objects are updated.
+    void MarkTransformChanged() { m_uiGlobalTransformUpdateCounter = ezInvalidIndex; }
+
+    /// \brief Returns whether the global transform has to be recomputed in the world update with the given counter.
+    /// That is the case if the local transform has changed or if the parent's global transform has been recomputed in the same update.
+    bool NeedsGlobalTransformUpdate(ezUInt32 uiUpdateCounter) const;
+
     /// \brief Recomputes the local transform from this object's global transform and, if available, the parent's global transform.
     void UpdateLocalTransform();
 
@@ -610,6 +620,9 @@ private:
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& ref_spatialSystem);
 
+    /// \brief Updates the global bounds and returns whether the spatial data has to be updated with the new bounds.
+    bool UpdateGlobalBoundsAndCheckSpatialData();
+
     void UpdateLastGlobalTransform(ezUInt32 uiUpdateCounter);
 
     void RecreateSpatialData(ezSpatialSystem& ref_spatialSystem);
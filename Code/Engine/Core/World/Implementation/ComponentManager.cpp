@@ -45,6 +45,12 @@ void ezComponentManagerBase::DeleteComponent(ezComponent* pComponent)
   GetWorld()->m_Data.m_DeadComponents.Insert(pComponent);
 }
 
+void ezComponentManagerBase::ReserveComponents(ezUInt32 uiCount)
+{
+  m_Components.Reserve(uiCount);
+  ReserveComponentStorage(uiCount);
+}
+
 void ezComponentManagerBase::Deinitialize()
 {
   for (auto it = m_Components.GetIterator(); it.IsValid(); ++it)
@@ -256,6 +256,13 @@ void ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
 
   m_pTransformationData->UpdateGlobalTransformNonRecursive(GetWorld()->GetUpdateCounter());
 
+  if (IsStatic())
+  {
+    // Static objects are not processed by the world's transform update, so they are stamped here. That way their dynamic children are
+    // updated once in the next transform update, instead of in every update because the static parent stays marked as changed.
+    m_pTransformationData->m_uiGlobalTransformUpdateCounter = GetWorld()->m_Data.GetNextGlobalTransformUpdateCounter();
+  }
+
   if (ezSpatialSystem* pSpatialSystem = GetWorld()->GetSpatialSystem())
   {
     m_pTransformationData->UpdateGlobalBoundsAndSpatialData(*pSpatialSystem);
@@ -735,6 +742,11 @@ void ezGameObject::UpdateLocalBounds()
   {
     m_pTransformationData->UpdateGlobalBounds(pSpatialSystem);
   }
+  else
+  {
+    // the global bounds of dynamic objects are updated in the next world update
+    m_pTransformationData->MarkTransformChanged();
+  }
 }
 
 void ezGameObject::UpdateGlobalTransformAndBounds()
@@ -1142,6 +1154,7 @@ void ezGameObject::TransformationData::UpdateLocalTransform()
   m_localRotation = tLocal.m_Rotation;
   m_localScaling = tLocal.m_Scale;
   m_localScaling.SetW(1.0f);
+  MarkTransformChanged();
 }
 
 void ezGameObject::TransformationData::UpdateGlobalTransformNonRecursive(ezUInt32 uiUpdateCounter)
@@ -1183,12 +1196,7 @@ void ezGameObject::TransformationData::UpdateGlobalBounds(ezSpatialSystem* pSpat
 
 void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& ref_spatialSystem)
 {
-  ezSimdBBoxSphere oldGlobalBounds = m_globalBounds;
-
-  UpdateGlobalBounds();
-
-  const bool bIsAlwaysVisible = m_localBounds.m_BoxHalfExtents.w() != ezSimdFloat::MakeZero();
-  if (m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds)
+  if (UpdateGlobalBoundsAndCheckSpatialData())
   {
     ref_spatialSystem.UpdateSpatialDataBounds(m_hSpatialData, m_globalBounds);
   }
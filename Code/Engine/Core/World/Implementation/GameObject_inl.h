@@ -276,6 +276,7 @@ EZ_ALWAYS_INLINE ezTransform ezGameObject::GetLastGlobalTransform() const
 EZ_ALWAYS_INLINE void ezGameObject::SetLocalPosition(const ezSimdVec4f& vPosition, UpdateBehaviorIfStatic updateBehavior)
 {
   m_pTransformationData->m_localPosition = vPosition;
+  m_pTransformationData->MarkTransformChanged();
 
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
@@ -292,6 +293,7 @@ EZ_ALWAYS_INLINE const ezSimdVec4f& ezGameObject::GetLocalPositionSimd() const
 EZ_ALWAYS_INLINE void ezGameObject::SetLocalRotation(const ezSimdQuat& qRotation, UpdateBehaviorIfStatic updateBehavior)
 {
   m_pTransformationData->m_localRotation = qRotation;
+  m_pTransformationData->MarkTransformChanged();
 
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
@@ -310,6 +312,7 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalScaling(const ezSimdVec4f& vScaling,
   ezSimdFloat uniformScale = m_pTransformationData->m_localScaling.w();
   m_pTransformationData->m_localScaling = vScaling;
   m_pTransformationData->m_localScaling.SetW(uniformScale);
+  m_pTransformationData->MarkTransformChanged();
 
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
@@ -326,6 +329,7 @@ EZ_ALWAYS_INLINE const ezSimdVec4f& ezGameObject::GetLocalScalingSimd() const
 EZ_ALWAYS_INLINE void ezGameObject::SetLocalUniformScaling(const ezSimdFloat& fScaling, UpdateBehaviorIfStatic updateBehavior)
 {
   m_pTransformationData->m_localScaling.SetW(fScaling);
+  m_pTransformationData->MarkTransformChanged();
 
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
@@ -594,12 +598,31 @@ EZ_ALWAYS_INLINE void ezGameObject::TransformationData::UpdateGlobalTransformWit
   m_globalTransform = ezSimdTransform::MakeGlobalTransform(m_pParentData->m_globalTransform, localTransform);
 }
 
+EZ_FORCE_INLINE bool ezGameObject::TransformationData::NeedsGlobalTransformUpdate(ezUInt32 uiUpdateCounter) const
+{
+  if (m_uiGlobalTransformUpdateCounter == ezInvalidIndex)
+    return true;
+
+  // static parents are stamped when their global transform is recomputed, see ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
+  return m_pParentData != nullptr && (m_pParentData->m_uiGlobalTransformUpdateCounter == uiUpdateCounter || m_pParentData->m_uiGlobalTransformUpdateCounter == ezInvalidIndex);
+}
+
 EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBounds()
 {
   m_globalBounds = m_localBounds;
   m_globalBounds.Transform(m_globalTransform);
 }
 
+EZ_FORCE_INLINE bool ezGameObject::TransformationData::UpdateGlobalBoundsAndCheckSpatialData()
+{
+  const ezSimdBBoxSphere oldGlobalBounds = m_globalBounds;
+
+  UpdateGlobalBounds();
+
+  const bool bIsAlwaysVisible = m_localBounds.m_BoxHalfExtents.w() != ezSimdFloat::MakeZero();
+  return m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds;
+}
+
 EZ_ALWAYS_INLINE void ezGameObject::TransformationData::UpdateLastGlobalTransform(ezUInt32 uiUpdateCounter)
 {
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
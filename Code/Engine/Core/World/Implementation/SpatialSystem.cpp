@@ -19,6 +19,16 @@ void ezSpatialSystem::StartNewFrame()
   ++m_uiFrameCounter;
 }
 
+void ezSpatialSystem::UpdateSpatialDataBoundsBatch(ezArrayPtr<const ezSpatialDataHandle> handles, ezArrayPtr<const ezSimdBBoxSphere> bounds)
+{
+  EZ_ASSERT_DEBUG(handles.GetCount() == bounds.GetCount(), "Number of handles and bounds must match");
+
+  for (ezUInt32 i = 0; i < handles.GetCount(); ++i)
+  {
+    UpdateSpatialDataBounds(handles[i], bounds[i]);
+  }
+}
+
 void ezSpatialSystem::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, ezDynamicArray<ezGameObject*>& out_objects) const
 {
   out_objects.Clear();
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+
+/// Shared building blocks for spatial system implementations.
+///
+/// All functions that work on a 'cell' expect a type with the SoA members m_BoundingSpheres (BoundingSphereStreams), m_BoundingBoxHalfExtents, m_TagSets,
+/// m_ObjectPointers and m_LastVisibleFrameIdxAndVisType, and a stats type with the members m_uiNumObjectsTested, m_uiNumObjectsPassed and m_uiNumObjectsFiltered.
+namespace ezInternal
+{
+  /// \brief Stores bounding spheres in blocks of four, where the x, y, z and radius values of the four spheres each fill one SIMD register.
+  ///
+  /// This allows the query kernels below to test four objects against a shape with each instruction, without any shuffling.
+  /// The unused entries of the last block contain zero sized spheres at the origin and must be masked out with GetValidMask().
+  class BoundingSphereStreams
+  {
+  public:
+    struct Block
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezSimdVec4f m_x;
+      ezSimdVec4f m_y;
+      ezSimdVec4f m_z;
+      ezSimdVec4f m_r;
+    };
+
+    BoundingSphereStreams(ezAllocator* pAlignedAllocator)
+      : m_Blocks(pAlignedAllocator)
+    {
+    }
+
+    EZ_ALWAYS_INLINE ezUInt32 GetCount() const { return m_uiCount; }
+    EZ_ALWAYS_INLINE bool IsEmpty() const { return m_uiCount == 0; }
+
+    EZ_ALWAYS_INLINE const Block* GetBlocks() const { return m_Blocks.GetData(); }
+    EZ_ALWAYS_INLINE ezUInt32 GetBlockCount() const { return m_Blocks.GetCount(); }
+
+    /// \brief Returns a mask with one bit for every used entry of the given block.
+    EZ_ALWAYS_INLINE ezUInt32 GetValidMask(ezUInt32 uiBlockIndex) const
+    {
+      const ezUInt32 uiNumValid = ezMath::Min(m_uiCount - uiBlockIndex * 4, 4u);
+      return static_cast<ezUInt32>(EZ_BIT(uiNumValid) - 1);
+    }
+
+    void PushBack(const ezSimdBSphere& sphere)
+    {
+      if ((m_uiCount & 3) == 0)
+      {
+        Block& block = m_Blocks.ExpandAndGetRef();
+        block.m_x.SetZero();
+        block.m_y.SetZero();
+        block.m_z.SetZero();
+        block.m_r.SetZero();
+      }
+
+      Set(m_uiCount, sphere);
+      ++m_uiCount;
+    }
+
+    /// \brief Moves the last sphere to the given index, same as ezDynamicArray::RemoveAtAndSwap.
+    void RemoveAtAndSwap(ezUInt32 uiIndex)
+    {
+      EZ_ASSERT_DEBUG(uiIndex < m_uiCount, "Out of bounds access. Array has {0} elements, trying to access element at index {1}.", m_uiCount, uiIndex);
+
+      --m_uiCount;
+      if (uiIndex != m_uiCount)
+      {
+        Set(uiIndex, Get(m_uiCount));
+      }
+
+      if ((m_uiCount & 3) == 0)
+      {
+        m_Blocks.PopBack();
+      }
+      else
+      {
+        Set(m_uiCount, ezSimdBSphere(ezSimdVec4f::MakeZero(), 0.0f));
+      }
+    }
+
+    EZ_FORCE_INLINE void Set(ezUInt32 uiIndex, const ezSimdBSphere& sphere)
+    {
+      float* pData = GetBlockData(uiIndex);
+
+      alignas(16) float values[4];
+      sphere.m_CenterAndRadius.Store<4>(values);
+
+      pData[0] = values[0];
+      pData[4] = values[1];
+      pData[8] = values[2];
+      pData[12] = values[3];
+    }
+
+    EZ_FORCE_INLINE ezSimdBSphere Get(ezUInt32 uiIndex) const
+    {
+      const float* pData = GetBlockData(uiIndex);
+
+      ezSimdBSphere sphere;
+      sphere.m_CenterAndRadius.Set(pData[0], pData[4], pData[8], pData[12]);
+      return sphere;
+    }
+
+  private:
+    EZ_ALWAYS_INLINE float* GetBlockData(ezUInt32 uiIndex) { return reinterpret_cast<float*>(&m_Blocks[uiIndex >> 2]) + (uiIndex & 3); }
+    EZ_ALWAYS_INLINE const float* GetBlockData(ezUInt32 uiIndex) const { return reinterpret_cast<const float*>(&m_Blocks[uiIndex >> 2]) + (uiIndex & 3); }
+
+    ezDynamicArray<Block> m_Blocks;
+    ezUInt32 m_uiCount = 0;
+  };
+
+  /// \brief The six frustum planes transposed so that four (or two times two) planes can be tested with one instruction.
+  struct FrustumPlaneData
+  {
+    ezSimdVec4f m_x0x1x2x3;
+    ezSimdVec4f m_y0y1y2y3;
+    ezSimdVec4f m_z0z1z2z3;
+    ezSimdVec4f m_w0w1w2w3;
+
+    ezSimdVec4f m_x4x5x4x5;
+    ezSimdVec4f m_y4y5y4y5;
+    ezSimdVec4f m_z4z5z4z5;
+    ezSimdVec4f m_w4w5w4w5;
+
+    // every plane component broadcast to all four lanes, to test the four spheres of a BoundingSphereStreams::Block at once
+    ezSimdVec4f m_PlaneX[6];
+    ezSimdVec4f m_PlaneY[6];
+    ezSimdVec4f m_PlaneZ[6];
+    ezSimdVec4f m_PlaneW[6];
+  };
+
+  inline FrustumPlaneData MakeFrustumPlaneData(const ezFrustum& frustum)
+  {
+    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
+    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
+    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
+    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
+    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
+    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
+    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
+
+    FrustumPlaneData planeData;
+
+    ezSimdMat4f helperMat;
+    helperMat.SetRows(plane0, plane1, plane2, plane3);
+
+    planeData.m_x0x1x2x3 = helperMat.m_col0;
+    planeData.m_y0y1y2y3 = helperMat.m_col1;
+    planeData.m_z0z1z2z3 = helperMat.m_col2;
+    planeData.m_w0w1w2w3 = helperMat.m_col3;
+
+    helperMat.SetRows(plane4, plane5, plane4, plane5);
+
+    planeData.m_x4x5x4x5 = helperMat.m_col0;
+    planeData.m_y4y5y4y5 = helperMat.m_col1;
+    planeData.m_z4z5z4z5 = helperMat.m_col2;
+    planeData.m_w4w5w4w5 = helperMat.m_col3;
+
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      const ezPlane& plane = frustum.GetPlane(i);
+      planeData.m_PlaneX[i].Set(plane.m_vNormal.x);
+      planeData.m_PlaneY[i].Set(plane.m_vNormal.y);
+      planeData.m_PlaneZ[i].Set(plane.m_vNormal.z);
+      planeData.m_PlaneW[i].Set(plane.m_fNegDistance);
+    }
+
+    return planeData;
+  }
+
+  EZ_ALWAYS_INLINE bool FilterByTags(const ezTagSet& tags, const ezTagSet* pIncludeTags, const ezTagSet* pExcludeTags)
+  {
+    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
+      return true;
+
+    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
+      return true;
+
+    return false;
+  }
+
+  EZ_ALWAYS_INLINE bool UseTagsFilter(const ezSpatialSystem::QueryParams& queryParams)
+  {
+    return (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
+  }
+
+  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const FrustumPlaneData& planeData)
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
+    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
+    return (cmp_0123 || cmp_4545).NoneSet<4>();
+  }
+
+  /// \brief Returns a mask with one bit for every sphere of the block that intersects the frustum.
+  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const BoundingSphereStreams::Block& block, const FrustumPlaneData& planeData)
+  {
+    ezSimdVec4b outside(false);
+
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      ezSimdVec4f dist = ezSimdVec4f::MulAdd(block.m_x, planeData.m_PlaneX[i], planeData.m_PlaneW[i]);
+      dist = ezSimdVec4f::MulAdd(block.m_y, planeData.m_PlaneY[i], dist);
+      dist = ezSimdVec4f::MulAdd(block.m_z, planeData.m_PlaneZ[i], dist);
+
+      outside = outside || (dist > block.m_r);
+    }
+
+    return (!outside).GetMask();
+  }
+
+  /// \brief Tests the four spheres of a BoundingSphereStreams::Block against a query shape at once.
+  template <typename ShapeType>
+  struct BlockOverlapTest;
+
+  template <>
+  struct BlockOverlapTest<ezSimdBSphere>
+  {
+    explicit BlockOverlapTest(const ezSimdBSphere& sphere)
+      : m_x(sphere.m_CenterAndRadius.x())
+      , m_y(sphere.m_CenterAndRadius.y())
+      , m_z(sphere.m_CenterAndRadius.z())
+      , m_r(sphere.m_CenterAndRadius.w())
+    {
+    }
+
+    /// Same as ezSimdBSphere::Overlaps(const ezSimdBSphere&) for all four spheres.
+    EZ_FORCE_INLINE ezUInt32 GetMask(const BoundingSphereStreams::Block& block) const
+    {
+      const ezSimdVec4f dx = block.m_x - m_x;
+      const ezSimdVec4f dy = block.m_y - m_y;
+      const ezSimdVec4f dz = block.m_z - m_z;
+      const ezSimdVec4f r = block.m_r + m_r;
+
+      const ezSimdVec4f distSquared = ezSimdVec4f::MulAdd(dz, dz, ezSimdVec4f::MulAdd(dy, dy, dx.CompMul(dx)));
+      return (distSquared < r.CompMul(r)).GetMask();
+    }
+
+    ezSimdVec4f m_x, m_y, m_z, m_r;
+  };
+
+  template <>
+  struct BlockOverlapTest<ezSimdBBox>
+  {
+    explicit BlockOverlapTest(const ezSimdBBox& box)
+      : m_MinX(box.m_Min.x())
+      , m_MinY(box.m_Min.y())
+      , m_MinZ(box.m_Min.z())
+      , m_MaxX(box.m_Max.x())
+      , m_MaxY(box.m_Max.y())
+      , m_MaxZ(box.m_Max.z())
+    {
+    }
+
+    /// Same as ezSimdBBox::Overlaps(const ezSimdBSphere&) for all four spheres, i.e. checks whether the closest point in the box is inside the sphere.
+    EZ_FORCE_INLINE ezUInt32 GetMask(const BoundingSphereStreams::Block& block) const
+    {
+      const ezSimdVec4f dx = block.m_x.CompMin(m_MaxX).CompMax(m_MinX) - block.m_x;
+      const ezSimdVec4f dy = block.m_y.CompMin(m_MaxY).CompMax(m_MinY) - block.m_y;
+      const ezSimdVec4f dz = block.m_z.CompMin(m_MaxZ).CompMax(m_MinZ) - block.m_z;
+
+      const ezSimdVec4f distSquared = ezSimdVec4f::MulAdd(dz, dz, ezSimdVec4f::MulAdd(dy, dy, dx.CompMul(dx)));
+      return (distSquared <= block.m_r.CompMul(block.m_r)).GetMask();
+    }
+
+    ezSimdVec4f m_MinX, m_MinY, m_MinZ;
+    ezSimdVec4f m_MaxX, m_MaxY, m_MaxZ;
+  };
+
+  /// \brief Calls the callback for all objects in the cell that overlap the given shape (ezSimdBSphere or ezSimdBBox).
+  template <typename ShapeType, bool UseTagsFilter, typename CellType, typename StatsType>
+  ezVisitorExecution::Enum FindObjectsInCell(const CellType& cell, const ShapeType& shape, const ezSpatialSystem::QueryParams& queryParams, StatsType& ref_stats, const ezSpatialSystem::QueryCallback& callback)
+  {
+    const BoundingSphereStreams& boundingSpheres = cell.m_BoundingSpheres;
+    auto tagSets = cell.m_TagSets.GetData();
+    auto objectPointers = cell.m_ObjectPointers.GetData();
+
+    ref_stats.m_uiNumObjectsTested += boundingSpheres.GetCount();
+
+    const BlockOverlapTest<ShapeType> overlapTest(shape);
+    const BoundingSphereStreams::Block* pBlocks = boundingSpheres.GetBlocks();
+    const ezUInt32 uiNumBlocks = boundingSpheres.GetBlockCount();
+
+    for (ezUInt32 uiBlock = 0; uiBlock < uiNumBlocks; ++uiBlock)
+    {
+      ezUInt32 mask = overlapTest.GetMask(pBlocks[uiBlock]) & boundingSpheres.GetValidMask(uiBlock);
+
+      while (mask > 0)
+      {
+        const ezUInt32 i = uiBlock * 4 + ezMath::FirstBitLow(mask);
+        mask &= mask - 1;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+          {
+            ref_stats.m_uiNumObjectsFiltered++;
+            continue;
+          }
+        }
+
+        ref_stats.m_uiNumObjectsPassed++;
+
+        if (callback(objectPointers[i]) == ezVisitorExecution::Stop)
+          return ezVisitorExecution::Stop;
+      }
+    }
+
+    return ezVisitorExecution::Continue;
+  }
+
+  /// \brief Adds all objects of the cell that intersect the frustum to out_objects and marks them as visible in the given frame.
+  template <bool UseTagsFilter, bool UseOcclusionCallback, typename CellType, typename StatsType>
+  void FindVisibleObjectsInCell(const CellType& cell, const FrustumPlaneData& planeData, const ezSpatialSystem::QueryParams& queryParams, StatsType& ref_stats,
+    const ezSpatialSystem::IsOccludedFunc& isOccluded, ezUInt64 uiFrameIdxAndType, ezDynamicArray<const ezGameObject*>& out_objects)
+  {
+    const BoundingSphereStreams& boundingSpheres = cell.m_BoundingSpheres;
+    auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
+    auto tagSets = cell.m_TagSets.GetData();
+    auto objectPointers = cell.m_ObjectPointers.GetData();
+    auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
+
+    ref_stats.m_uiNumObjectsTested += boundingSpheres.GetCount();
+
+    auto processVisibleObject = [&](ezUInt32 i)
+    {
+      if constexpr (UseTagsFilter)
+      {
+        if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+        {
+          ref_stats.m_uiNumObjectsFiltered++;
+          return;
+        }
+      }
+
+      if constexpr (UseOcclusionCallback)
+      {
+        const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres.Get(i).GetCenter(), boundingBoxHalfExtents[i]);
+        if (isOccluded(bbox))
+        {
+          return;
+        }
+      }
+
+      lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
+      out_objects.PushBack(objectPointers[i]);
+
+      ref_stats.m_uiNumObjectsPassed++;
+    };
+
+    const BoundingSphereStreams::Block* pBlocks = boundingSpheres.GetBlocks();
+    const ezUInt32 uiNumBlocks = boundingSpheres.GetBlockCount();
+
+    // test up to eight blocks before going through the results, that keeps the loop free of branches that depend on the test results
+    for (ezUInt32 uiFirstBlock = 0; uiFirstBlock < uiNumBlocks; uiFirstBlock += 8)
+    {
+      const ezUInt32 uiNumBlocksInBatch = ezMath::Min(uiNumBlocks - uiFirstBlock, 8u);
+
+      ezUInt32 mask = 0;
+      for (ezUInt32 i = 0; i < uiNumBlocksInBatch; ++i)
+      {
+        mask |= SphereFrustumIntersect(pBlocks[uiFirstBlock + i], planeData) << (i * 4);
+      }
+
+      // the unused entries of the last block might pass the test
+      const ezUInt32 uiLastBlockInBatch = uiNumBlocksInBatch - 1;
+      mask &= ~((boundingSpheres.GetValidMask(uiFirstBlock + uiLastBlockInBatch) ^ 0xF) << (uiLastBlockInBatch * 4));
+
+      while (mask > 0)
+      {
+        const ezUInt32 i = uiFirstBlock * 4 + ezMath::FirstBitLow(mask);
+        mask &= mask - 1;
+
+        processVisibleObject(i);
+      }
+    }
+  }
+} // namespace ezInternal
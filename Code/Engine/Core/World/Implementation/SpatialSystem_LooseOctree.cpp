@@ -0,0 +1,708 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/Implementation/SpatialSystemHelpers.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiRootNodeIndex = 0;
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Node
+{
+  Node(ezAllocator* pAlignedAllocator, ezAllocator* pAllocator)
+    : m_BoundingSpheres(pAlignedAllocator)
+    , m_BoundingBoxHalfExtents(pAlignedAllocator)
+    , m_TagSets(pAllocator)
+    , m_ObjectPointers(pAllocator)
+    , m_LastVisibleFrameIdxAndVisType(pAllocator)
+    , m_DataIndices(pAllocator)
+  {
+  }
+
+  void Init(ezUInt32 uiParentIndex, const ezSimdVec4f& vCenter, float fHalfExtents)
+  {
+    // the loose bounds are twice as large as the cell
+    m_Bounds = ezSimdBBox::MakeFromCenterAndHalfExtents(vCenter, ezSimdVec4f(fHalfExtents * 2.0f));
+    m_vCenter = vCenter;
+    m_fHalfExtents = fHalfExtents;
+    m_uiParentIndex = uiParentIndex;
+    m_uiNumObjectsInSubTree = 0;
+
+    for (ezUInt32& uiChildIndex : m_ChildIndices)
+    {
+      uiChildIndex = ezInvalidIndex;
+    }
+  }
+
+  EZ_FORCE_INLINE ezUInt32 AddData(const ezSimdBBoxSphere& bounds, const ezTagSet& tags, ezGameObject* pObject, ezUInt64 uiLastVisibleFrameIdxAndVisType, ezUInt32 uiDataIndex)
+  {
+    m_BoundingSpheres.PushBack(bounds.GetSphere());
+    m_BoundingBoxHalfExtents.PushBack(bounds.m_BoxHalfExtents);
+    m_TagSets.PushBack(tags);
+    m_ObjectPointers.PushBack(pObject);
+    m_DataIndices.PushBack(uiDataIndex);
+    m_LastVisibleFrameIdxAndVisType.PushBack(uiLastVisibleFrameIdxAndVisType);
+
+    return m_BoundingSpheres.GetCount() - 1;
+  }
+
+  // Returns the data index of the moved data
+  EZ_FORCE_INLINE ezUInt32 RemoveData(ezUInt32 uiNodeDataIndex)
+  {
+    ezUInt32 uiMovedDataIndex = m_DataIndices.PeekBack();
+
+    m_BoundingSpheres.RemoveAtAndSwap(uiNodeDataIndex);
+    m_BoundingBoxHalfExtents.RemoveAtAndSwap(uiNodeDataIndex);
+    m_TagSets.RemoveAtAndSwap(uiNodeDataIndex);
+    m_ObjectPointers.RemoveAtAndSwap(uiNodeDataIndex);
+    m_DataIndices.RemoveAtAndSwap(uiNodeDataIndex);
+    m_LastVisibleFrameIdxAndVisType.RemoveAtAndSwap(uiNodeDataIndex);
+
+    return uiMovedDataIndex;
+  }
+
+  EZ_ALWAYS_INLINE bool IsTooLargeForChildren(float fObjectHalfExtents, float fMinNodeHalfExtents) const
+  {
+    const float fChildHalfExtents = m_fHalfExtents * 0.5f;
+    return fChildHalfExtents < fMinNodeHalfExtents || fObjectHalfExtents > fChildHalfExtents;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetChildSlot(const ezSimdVec4f& vPosition) const
+  {
+    const ezSimdVec4b cmp = vPosition >= m_vCenter;
+    return (cmp.x() ? 1 : 0) | (cmp.y() ? 2 : 0) | (cmp.z() ? 4 : 0);
+  }
+
+  EZ_ALWAYS_INLINE ezBoundingBox GetBoundingBox() const { return ezSimdConversion::ToBBoxSphere(m_Bounds).GetBox(); }
+
+  ezSimdBBoxSphere m_Bounds;
+  ezSimdVec4f m_vCenter;
+  float m_fHalfExtents = 0.0f;
+
+  ezUInt32 m_uiParentIndex = ezInvalidIndex;
+  ezUInt32 m_ChildIndices[8];
+  ezUInt32 m_uiNumObjectsInSubTree = 0;
+
+  ezInternal::BoundingSphereStreams m_BoundingSpheres;
+  ezDynamicArray<ezSimdVec4f> m_BoundingBoxHalfExtents;
+  ezDynamicArray<ezTagSet> m_TagSets;
+  ezDynamicArray<ezGameObject*> m_ObjectPointers;
+  mutable ezDynamicArray<ezAtomicInteger64> m_LastVisibleFrameIdxAndVisType;
+  ezDynamicArray<ezUInt32> m_DataIndices;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Tree
+{
+  struct NodeDataMapping
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNodeIndex = ezInvalidIndex;
+    ezUInt32 m_uiNodeDataIndex = ezInvalidIndex;
+  };
+
+  Tree(ezSpatialSystem_LooseOctree& ref_system, ezSpatialData::Category category)
+    : m_System(ref_system)
+    , m_Nodes(&ref_system.m_Allocator)
+    , m_FreeNodes(&ref_system.m_Allocator)
+    , m_DataMappings(&ref_system.m_Allocator)
+    , m_Category(category)
+  {
+    EZ_VERIFY(AllocateNode(ezInvalidIndex, ezSimdVec4f::MakeZero(), m_System.m_fRootHalfExtents) == s_uiRootNodeIndex, "Implementation error");
+  }
+
+  ezUInt32 AllocateNode(ezUInt32 uiParentIndex, const ezSimdVec4f& vCenter, float fHalfExtents)
+  {
+    ezUInt32 uiNodeIndex;
+    if (!m_FreeNodes.IsEmpty())
+    {
+      uiNodeIndex = m_FreeNodes.PeekBack();
+      m_FreeNodes.PopBack();
+    }
+    else
+    {
+      uiNodeIndex = m_Nodes.GetCount();
+      m_Nodes.PushBack(EZ_NEW(&m_System.m_AlignedAllocator, Node, &m_System.m_AlignedAllocator, &m_System.m_Allocator));
+    }
+
+    m_Nodes[uiNodeIndex]->Init(uiParentIndex, vCenter, fHalfExtents);
+    ++m_uiNumActiveNodes;
+
+    return uiNodeIndex;
+  }
+
+  EZ_ALWAYS_INLINE bool IsInsideRootCell(const ezSimdVec4f& vPosition) const
+  {
+    return (vPosition.Abs() <= ezSimdVec4f(m_System.m_fRootHalfExtents)).AllSet<3>();
+  }
+
+  /// Queries test the bounding spheres of the objects, so the sphere has to fit into the loose node bounds as well as the box.
+  EZ_ALWAYS_INLINE float GetObjectHalfExtents(const ezSimdBBoxSphere& bounds) const
+  {
+    return ezMath::Max<float>(bounds.m_BoxHalfExtents.HorizontalMax<3>(), bounds.m_CenterAndRadius.w());
+  }
+
+  ezUInt32 GetOrCreateNode(const ezSimdBBoxSphere& bounds)
+  {
+    const ezSimdVec4f vCenter = bounds.m_CenterAndRadius;
+    if (!IsInsideRootCell(vCenter))
+      return s_uiRootNodeIndex;
+
+    const float fObjectHalfExtents = GetObjectHalfExtents(bounds);
+    const float fMinNodeHalfExtents = m_System.m_fMinNodeHalfExtents;
+
+    ezUInt32 uiNodeIndex = s_uiRootNodeIndex;
+    while (true)
+    {
+      Node* pNode = m_Nodes[uiNodeIndex].Borrow();
+      if (pNode->IsTooLargeForChildren(fObjectHalfExtents, fMinNodeHalfExtents))
+        return uiNodeIndex;
+
+      const ezUInt32 uiSlot = pNode->GetChildSlot(vCenter);
+      ezUInt32 uiChildIndex = pNode->m_ChildIndices[uiSlot];
+
+      if (uiChildIndex == ezInvalidIndex)
+      {
+        const float fChildHalfExtents = pNode->m_fHalfExtents * 0.5f;
+        const ezSimdVec4f vSign = ezSimdVec4f::Select((vCenter >= pNode->m_vCenter), ezSimdVec4f(1.0f), ezSimdVec4f(-1.0f));
+        const ezSimdVec4f vChildCenter = ezSimdVec4f::MulAdd(vSign, ezSimdVec4f(fChildHalfExtents), pNode->m_vCenter);
+
+        uiChildIndex = AllocateNode(uiNodeIndex, vChildCenter, fChildHalfExtents);
+
+        // pNode is still valid, nodes are allocated individually
+        pNode->m_ChildIndices[uiSlot] = uiChildIndex;
+      }
+
+      uiNodeIndex = uiChildIndex;
+    }
+  }
+
+  /// Returns true if the object with the new bounds can stay in the given node.
+  /// Since the loose bounds are larger than the cell, objects can move a bit without being re-inserted.
+  bool CanStayInNode(ezUInt32 uiNodeIndex, const ezSimdBBoxSphere& bounds) const
+  {
+    const Node& node = *m_Nodes[uiNodeIndex];
+    const float fObjectHalfExtents = GetObjectHalfExtents(bounds);
+
+    if (uiNodeIndex == s_uiRootNodeIndex)
+    {
+      if (!IsInsideRootCell(bounds.m_CenterAndRadius))
+        return true;
+    }
+    else
+    {
+      const ezSimdVec4f vDistance = (bounds.m_CenterAndRadius - node.m_vCenter).Abs() + ezSimdVec4f(fObjectHalfExtents);
+      if (!(vDistance <= ezSimdVec4f(node.m_fHalfExtents * 2.0f)).AllSet<3>())
+        return false;
+    }
+
+    // objects that became small enough for a child node should move down
+    return node.IsTooLargeForChildren(fObjectHalfExtents, m_System.m_fMinNodeHalfExtents);
+  }
+
+  void AddSpatialData(const ezSimdBBoxSphere& bounds, const ezTagSet& tags, ezGameObject* pObject, ezUInt64 uiLastVisibleFrameIdxAndVisType, const ezSpatialDataHandle& hData)
+  {
+    const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+    const ezUInt32 uiNodeIndex = GetOrCreateNode(bounds);
+    const ezUInt32 uiNodeDataIndex = m_Nodes[uiNodeIndex]->AddData(bounds, tags, pObject, uiLastVisibleFrameIdxAndVisType, uiDataIndex);
+
+    for (ezUInt32 i = uiNodeIndex; i != ezInvalidIndex; i = m_Nodes[i]->m_uiParentIndex)
+    {
+      ++m_Nodes[i]->m_uiNumObjectsInSubTree;
+    }
+
+    m_DataMappings.EnsureCount(uiDataIndex + 1);
+    EZ_ASSERT_DEBUG(m_DataMappings[uiDataIndex].m_uiNodeIndex == ezInvalidIndex, "data has already been added to a node");
+    m_DataMappings[uiDataIndex] = {uiNodeIndex, uiNodeDataIndex};
+  }
+
+  void RemoveSpatialData(const ezSpatialDataHandle& hData)
+  {
+    const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+    auto& mapping = m_DataMappings[uiDataIndex];
+    const ezUInt32 uiNodeIndex = mapping.m_uiNodeIndex;
+
+    const ezUInt32 uiMovedDataIndex = m_Nodes[uiNodeIndex]->RemoveData(mapping.m_uiNodeDataIndex);
+    if (uiMovedDataIndex != uiDataIndex)
+    {
+      m_DataMappings[uiMovedDataIndex].m_uiNodeDataIndex = mapping.m_uiNodeDataIndex;
+    }
+
+    mapping = {};
+
+    for (ezUInt32 i = uiNodeIndex; i != ezInvalidIndex; i = m_Nodes[i]->m_uiParentIndex)
+    {
+      --m_Nodes[i]->m_uiNumObjectsInSubTree;
+    }
+
+    // remove empty nodes, so that objects moving through a large world don't leave a trail of nodes behind
+    ezUInt32 uiEmptyNodeIndex = uiNodeIndex;
+    while (uiEmptyNodeIndex != s_uiRootNodeIndex && m_Nodes[uiEmptyNodeIndex]->m_uiNumObjectsInSubTree == 0)
+    {
+      Node& parent = *m_Nodes[m_Nodes[uiEmptyNodeIndex]->m_uiParentIndex];
+      for (ezUInt32& uiChildIndex : parent.m_ChildIndices)
+      {
+        if (uiChildIndex == uiEmptyNodeIndex)
+        {
+          uiChildIndex = ezInvalidIndex;
+          break;
+        }
+      }
+
+      m_FreeNodes.PushBack(uiEmptyNodeIndex);
+      --m_uiNumActiveNodes;
+
+      uiEmptyNodeIndex = m_Nodes[uiEmptyNodeIndex]->m_uiParentIndex;
+    }
+  }
+
+  /// Visits all non-empty nodes for which nodeFilter returns true. The children of nodes that don't pass the filter are skipped.
+  /// The root node always passes, since it also contains the objects outside of the root cell.
+  template <typename NodeFilter, typename Functor>
+  EZ_FORCE_INLINE void ForEachNode(NodeFilter nodeFilter, Functor func) const
+  {
+    ezHybridArray<ezUInt32, 64> nodeStack;
+    nodeStack.PushBack(s_uiRootNodeIndex);
+
+    while (!nodeStack.IsEmpty())
+    {
+      const ezUInt32 uiNodeIndex = nodeStack.PeekBack();
+      nodeStack.PopBack();
+
+      const Node& node = *m_Nodes[uiNodeIndex];
+      if (uiNodeIndex != s_uiRootNodeIndex && !nodeFilter(node))
+        continue;
+
+      if (!node.m_BoundingSpheres.IsEmpty())
+      {
+        if (func(node) == ezVisitorExecution::Stop)
+          return;
+      }
+
+      if (node.m_uiNumObjectsInSubTree > node.m_BoundingSpheres.GetCount())
+      {
+        for (ezUInt32 uiChildIndex : node.m_ChildIndices)
+        {
+          if (uiChildIndex != ezInvalidIndex)
+          {
+            nodeStack.PushBack(uiChildIndex);
+          }
+        }
+      }
+    }
+  }
+
+  ezSpatialSystem_LooseOctree& m_System;
+  ezDynamicArray<ezUniquePtr<Node>> m_Nodes;
+  ezDynamicArray<ezUInt32> m_FreeNodes;
+  ezUInt32 m_uiNumActiveNodes = 0;
+
+  ezDynamicArray<NodeDataMapping> m_DataMappings;
+
+  const ezSpatialData::Category m_Category;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Stats
+{
+  ezUInt32 m_uiNumObjectsTested = 0;
+  ezUInt32 m_uiNumObjectsPassed = 0;
+  ezUInt32 m_uiNumObjectsFiltered = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_LooseOctree, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezSpatialSystem_LooseOctree::ezSpatialSystem_LooseOctree(float fRootHalfExtents /*= 65536.0f*/, float fMinNodeHalfExtents /*= 64.0f*/)
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_fRootHalfExtents(fRootHalfExtents)
+  , m_fMinNodeHalfExtents(fMinNodeHalfExtents)
+  , m_Trees(&m_Allocator)
+  , m_DataTable(&m_Allocator)
+{
+  EZ_ASSERT_DEV(fMinNodeHalfExtents > 0.0f && fMinNodeHalfExtents <= fRootHalfExtents, "Invalid node extents");
+
+  m_Trees.SetCount(MAX_NUM_TREES);
+}
+
+ezSpatialSystem_LooseOctree::~ezSpatialSystem_LooseOctree() = default;
+
+ezResult ezSpatialSystem_LooseOctree::GetNodeBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_boundingBox) const
+{
+  Data* pData = nullptr;
+  if (!m_DataTable.TryGetValue(hData.GetInternalID(), pData))
+    return EZ_FAILURE;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(*pData,
+    [&](const Tree& tree)
+    {
+      out_boundingBox = tree.m_Nodes[tree.m_DataMappings[uiDataIndex].m_uiNodeIndex]->GetBoundingBox();
+      return ezVisitorExecution::Stop;
+    });
+
+  return EZ_SUCCESS;
+}
+
+void ezSpatialSystem_LooseOctree::GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezSpatialData::Category filterCategory /*= ezInvalidSpatialDataCategory*/) const
+{
+  for (ezUInt32 uiTreeIndex = 0; uiTreeIndex < m_Trees.GetCount(); ++uiTreeIndex)
+  {
+    const Tree* pTree = m_Trees[uiTreeIndex].Borrow();
+    if (pTree == nullptr || (filterCategory != ezInvalidSpatialDataCategory && filterCategory.m_uiValue != uiTreeIndex))
+      continue;
+
+    pTree->ForEachNode([](const Node&)
+      { return true; },
+      [&](const Node& node)
+      {
+        out_boundingBoxes.PushBack(node.GetBoundingBox());
+        return ezVisitorExecution::Continue;
+      });
+  }
+}
+
+ezSpatialDataHandle ezSpatialSystem_LooseOctree::CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  return AddSpatialDataToTrees(bounds, pObject, uiCategoryBitmask, tags, false);
+}
+
+ezSpatialDataHandle ezSpatialSystem_LooseOctree::CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  // too large for any child node, so it ends up in the root which is visited by every query
+  const ezSimdBBox hugeBox = ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdVec4f::MakeZero(), ezSimdVec4f(m_fRootHalfExtents * 4.0f));
+
+  return AddSpatialDataToTrees(hugeBox, pObject, uiCategoryBitmask, tags, true);
+}
+
+void ezSpatialSystem_LooseOctree::DeleteSpatialData(const ezSpatialDataHandle& hData)
+{
+  Data oldData;
+  EZ_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  ForEachTree(oldData,
+    [&](Tree& ref_tree)
+    {
+      ref_tree.RemoveSpatialData(hData);
+      return ezVisitorExecution::Continue;
+    });
+}
+
+void ezSpatialSystem_LooseOctree::UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_uiAlwaysVisible != 0)
+    return;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(*pData,
+    [&](Tree& ref_tree)
+    {
+      const Tree::NodeDataMapping mapping = ref_tree.m_DataMappings[uiDataIndex];
+      Node& node = *ref_tree.m_Nodes[mapping.m_uiNodeIndex];
+
+      if (ref_tree.CanStayInNode(mapping.m_uiNodeIndex, bounds))
+      {
+        node.m_BoundingSpheres.Set(mapping.m_uiNodeDataIndex, bounds.GetSphere());
+        node.m_BoundingBoxHalfExtents[mapping.m_uiNodeDataIndex] = bounds.m_BoxHalfExtents;
+      }
+      else
+      {
+        const ezTagSet tags = node.m_TagSets[mapping.m_uiNodeDataIndex];
+        ezGameObject* pObject = node.m_ObjectPointers[mapping.m_uiNodeDataIndex];
+        const ezUInt64 uiLastVisibleFrameIdxAndVisType = node.m_LastVisibleFrameIdxAndVisType[mapping.m_uiNodeDataIndex];
+
+        ref_tree.RemoveSpatialData(hData);
+        ref_tree.AddSpatialData(bounds, tags, pObject, uiLastVisibleFrameIdxAndVisType, hData);
+      }
+
+      return ezVisitorExecution::Continue;
+    });
+}
+
+void ezSpatialSystem_LooseOctree::UpdateSpatialDataBoundsBatch(ezArrayPtr<const ezSpatialDataHandle> handles, ezArrayPtr<const ezSimdBBoxSphere> bounds)
+{
+  EZ_ASSERT_DEBUG(handles.GetCount() == bounds.GetCount(), "Number of handles and bounds must match");
+
+  for (ezUInt32 i = 0; i < handles.GetCount(); ++i)
+  {
+    // non-virtual call so the compiler can inline the update
+    ezSpatialSystem_LooseOctree::UpdateSpatialDataBounds(handles[i], bounds[i]);
+  }
+}
+
+void ezSpatialSystem_LooseOctree::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(*pData,
+    [&](const Tree& tree)
+    {
+      const Tree::NodeDataMapping& mapping = tree.m_DataMappings[uiDataIndex];
+      tree.m_Nodes[mapping.m_uiNodeIndex]->m_ObjectPointers[mapping.m_uiNodeDataIndex] = pObject;
+      return ezVisitorExecution::Continue;
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSphere");
+
+  const ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+
+  const bool bUseTagsFilter = ezInternal::UseTagsFilter(queryParams);
+
+  ForEachNodeInMatchingTrees(queryParams,
+    [&](const Node& node)
+    { return node.m_Bounds.GetBox().Overlaps(simdSphere); },
+    [&](const Node& node, Stats& ref_stats)
+    {
+      if (bUseTagsFilter)
+        return ezInternal::FindObjectsInCell<ezSimdBSphere, true>(node, simdSphere, queryParams, ref_stats, callback);
+      else
+        return ezInternal::FindObjectsInCell<ezSimdBSphere, false>(node, simdSphere, queryParams, ref_stats, callback);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInBox");
+
+  const ezSimdBBox simdBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+
+  const bool bUseTagsFilter = ezInternal::UseTagsFilter(queryParams);
+
+  ForEachNodeInMatchingTrees(queryParams,
+    [&](const Node& node)
+    { return node.m_Bounds.GetBox().Overlaps(simdBox); },
+    [&](const Node& node, Stats& ref_stats)
+    {
+      if (bUseTagsFilter)
+        return ezInternal::FindObjectsInCell<ezSimdBBox, true>(node, simdBox, queryParams, ref_stats, callback);
+      else
+        return ezInternal::FindObjectsInCell<ezSimdBBox, false>(node, simdBox, queryParams, ref_stats, callback);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, ezSpatialSystem::IsOccludedFunc isOccluded, ezVisibilityState visType) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjects");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  const ezInternal::FrustumPlaneData planeData = ezInternal::MakeFrustumPlaneData(frustum);
+  const ezUInt64 uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
+
+  const bool bUseTagsFilter = ezInternal::UseTagsFilter(queryParams);
+  const bool bUseOcclusionCallback = isOccluded.IsValid();
+
+  // The loose bounds of a node contain the bounds of all objects in its sub-tree,
+  // so a node that is outside the frustum or occluded can be skipped together with all its children.
+  ForEachNodeInMatchingTrees(queryParams,
+    [&](const Node& node)
+    {
+      if (!ezInternal::SphereFrustumIntersect(node.m_Bounds.GetSphere(), planeData))
+        return false;
+
+      return !bUseOcclusionCallback || !isOccluded(node.m_Bounds.GetBox());
+    },
+    [&](const Node& node, Stats& ref_stats)
+    {
+      if (bUseOcclusionCallback)
+      {
+        if (bUseTagsFilter)
+          ezInternal::FindVisibleObjectsInCell<true, true>(node, planeData, queryParams, ref_stats, isOccluded, uiFrameIdxAndType, out_objects);
+        else
+          ezInternal::FindVisibleObjectsInCell<false, true>(node, planeData, queryParams, ref_stats, isOccluded, uiFrameIdxAndType, out_objects);
+      }
+      else
+      {
+        if (bUseTagsFilter)
+          ezInternal::FindVisibleObjectsInCell<true, false>(node, planeData, queryParams, ref_stats, isOccluded, uiFrameIdxAndType, out_objects);
+        else
+          ezInternal::FindVisibleObjectsInCell<false, false>(node, planeData, queryParams, ref_stats, isOccluded, uiFrameIdxAndType, out_objects);
+      }
+
+      return ezVisitorExecution::Continue;
+    });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+ezVisibilityState ezSpatialSystem_LooseOctree::GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_uiAlwaysVisible != 0)
+    return ezVisibilityState::Direct;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ezUInt64 uiLastVisibleFrameIdxAndVisType = 0;
+  ForEachTree(*pData,
+    [&](const Tree& tree)
+    {
+      const Tree::NodeDataMapping& mapping = tree.m_DataMappings[uiDataIndex];
+      uiLastVisibleFrameIdxAndVisType = ezMath::Max<ezUInt64>(uiLastVisibleFrameIdxAndVisType, tree.m_Nodes[mapping.m_uiNodeIndex]->m_LastVisibleFrameIdxAndVisType[mapping.m_uiNodeDataIndex]);
+      return ezVisitorExecution::Continue;
+    });
+
+  const ezUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const ezUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<ezUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return ezVisibilityState::Invisible;
+
+  return static_cast<ezVisibilityState>(uiLastVisibilityType);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+void ezSpatialSystem_LooseOctree::GetInternalStats(ezStringBuilder& ref_sSb) const
+{
+  ezUInt32 uiNumActiveTrees = 0;
+  for (auto& pTree : m_Trees)
+  {
+    uiNumActiveTrees += (pTree != nullptr) ? 1 : 0;
+  }
+
+  ref_sSb.SetFormat("Num Trees: {}\n", uiNumActiveTrees);
+
+  for (auto& pTree : m_Trees)
+  {
+    if (pTree == nullptr)
+      continue;
+
+    const Node& root = *pTree->m_Nodes[s_uiRootNodeIndex];
+    ref_sSb.AppendFormat(" \nCategory: {}\nNodes: {}, Objects: {}, Objects in Root: {}\n", ezSpatialData::GetCategoryName(pTree->m_Category),
+      pTree->m_uiNumActiveNodes, root.m_uiNumObjectsInSubTree, root.m_BoundingSpheres.GetCount());
+  }
+}
+#endif
+
+ezSpatialDataHandle ezSpatialSystem_LooseOctree::AddSpatialDataToTrees(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible)
+{
+  Data data;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+  data.m_uiAlwaysVisible = bAlwaysVisible ? 1 : 0;
+
+  auto hData = ezSpatialDataHandle(m_DataTable.Insert(data));
+
+  ezUInt32 uiBitmask = uiCategoryBitmask;
+  while (uiBitmask > 0)
+  {
+    const ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiBitmask);
+    uiBitmask &= uiBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+    {
+      pTree = EZ_NEW(&m_Allocator, Tree, *this, ezSpatialData::Category(static_cast<ezUInt16>(uiTreeIndex)));
+    }
+
+    pTree->AddSpatialData(bounds, tags, pObject, m_uiFrameCounter, hData);
+  }
+
+  return hData;
+}
+
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_LooseOctree::ForEachTree(const Data& data, Functor func) const
+{
+  ezUInt32 uiBitmask = data.m_uiCategoryBitmask;
+
+  while (uiBitmask > 0)
+  {
+    const ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiBitmask);
+    uiBitmask &= uiBitmask - 1;
+
+    if (func(*m_Trees[uiTreeIndex]) == ezVisitorExecution::Stop)
+      break;
+  }
+}
+
+template <typename NodeFilter, typename Functor>
+void ezSpatialSystem_LooseOctree::ForEachNodeInMatchingTrees(const QueryParams& queryParams, NodeFilter nodeFilter, Functor func) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+  }
+#endif
+
+  ezUInt32 uiBitmask = queryParams.m_uiCategoryBitmask;
+
+  while (uiBitmask > 0)
+  {
+    const ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiBitmask);
+    uiBitmask &= uiBitmask - 1;
+
+    const Tree* pTree = m_Trees[uiTreeIndex].Borrow();
+    if (pTree == nullptr)
+      continue;
+
+    Stats stats;
+    bool bStop = false;
+
+    pTree->ForEachNode(nodeFilter,
+      [&](const Node& node)
+      {
+        if (func(node, stats) == ezVisitorExecution::Stop)
+        {
+          bStop = true;
+          return ezVisitorExecution::Stop;
+        }
+
+        return ezVisitorExecution::Continue;
+      });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (queryParams.m_pStats != nullptr)
+    {
+      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    }
+#endif
+
+    if (bStop)
+      return;
+  }
+}
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_LooseOctree);
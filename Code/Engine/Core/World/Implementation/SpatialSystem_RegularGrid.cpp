@@ -1,26 +1,13 @@
 #include <Core/CorePCH.h>
 
+#include <Core/World/Implementation/SpatialSystemHelpers.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
-#include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Time/Stopwatch.h>
 
 ezCVarInt cvar_SpatialQueriesCachingThreshold("Spatial.Queries.CachingThreshold", 100, ezCVarFlags::Default, "Number of objects that are tested for a query before it is considered for caching");
 
-struct PlaneData
-{
-  ezSimdVec4f m_x0x1x2x3;
-  ezSimdVec4f m_y0y1y2y3;
-  ezSimdVec4f m_z0z1z2z3;
-  ezSimdVec4f m_w0w1w2w3;
-
-  ezSimdVec4f m_x4x5x4x5;
-  ezSimdVec4f m_y4y5y4y5;
-  ezSimdVec4f m_z4z5z4z5;
-  ezSimdVec4f m_w4w5w4w5;
-};
-
 namespace
 {
   enum
@@ -70,17 +57,6 @@ namespace
     return a.IsEmpty();
   }
 
-  EZ_ALWAYS_INLINE bool FilterByTags(const ezTagSet& tags, const ezTagSet* pIncludeTags, const ezTagSet* pExcludeTags)
-  {
-    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
-      return true;
-
-    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
-      return true;
-
-    return false;
-  }
-
   EZ_ALWAYS_INLINE bool CanBeCached(ezSpatialData::Category category)
   {
     return ezSpatialData::GetCategoryFlags(category).IsSet(ezSpatialData::Flags::FrequentChanges) == false;
@@ -106,73 +82,6 @@ namespace
     out_sSb.Append(" }");
   }
 #endif
-
-  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
-  {
-    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
-    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
-    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
-    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
-
-    ezSimdVec4f dot_0123;
-    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
-
-    ezSimdVec4f dot_4545;
-    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
-
-    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
-    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
-    return (cmp_0123 || cmp_4545).NoneSet<4>();
-  }
-
-  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const PlaneData& planeData)
-  {
-    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotA_0123;
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotB_0123;
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
-    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
-    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
-    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
-
-    ezSimdVec4f dot_A45B45;
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
-    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
-
-    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
-  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -229,7 +138,7 @@ struct ezSpatialSystem_RegularGrid::Cell
 
   ezSimdBBoxSphere m_Bounds;
 
-  ezDynamicArray<ezSimdBSphere> m_BoundingSpheres;
+  ezInternal::BoundingSphereStreams m_BoundingSpheres;
   ezDynamicArray<ezSimdVec4f> m_BoundingBoxHalfExtents;
   ezDynamicArray<ezTagSet> m_TagSets;
   ezDynamicArray<ezGameObject*> m_ObjectPointers;
@@ -369,11 +278,11 @@ struct ezSpatialSystem_RegularGrid::Grid
     auto& pOtherCell = other.m_Cells[mapping.m_uiCellIndex];
 
     const ezTagSet& tags = pOtherCell->m_TagSets[mapping.m_uiCellDataIndex];
-    if (FilterByTags(tags, &m_IncludeTags, &m_ExcludeTags))
+    if (ezInternal::FilterByTags(tags, &m_IncludeTags, &m_ExcludeTags))
       return false;
 
     ezSimdBBoxSphere bounds;
-    bounds.m_CenterAndRadius = pOtherCell->m_BoundingSpheres[mapping.m_uiCellDataIndex].m_CenterAndRadius;
+    bounds.m_CenterAndRadius = pOtherCell->m_BoundingSpheres.Get(mapping.m_uiCellDataIndex).m_CenterAndRadius;
     bounds.m_BoxHalfExtents = pOtherCell->m_BoundingBoxHalfExtents[mapping.m_uiCellDataIndex];
     ezGameObject* objectPointer = pOtherCell->m_ObjectPointers[mapping.m_uiCellDataIndex];
     const ezUInt64 uiLastVisibleFrameIdxAndVisType = pOtherCell->m_LastVisibleFrameIdxAndVisType[mapping.m_uiCellDataIndex];
@@ -500,39 +409,12 @@ namespace ezInternal
       if (!cellBox.Overlaps(shape))
         return ezVisitorExecution::Continue;
 
-      auto boundingSpheres = cell.m_BoundingSpheres.GetData();
-      auto tagSets = cell.m_TagSets.GetData();
-      auto objectPointers = cell.m_ObjectPointers.GetData();
-
-      const ezUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
-      ref_stats.m_uiNumObjectsTested += numSpheres;
-
-      for (ezUInt32 i = 0; i < numSpheres; ++i)
-      {
-        if (!shape.Overlaps(boundingSpheres[i]))
-          continue;
-
-        if constexpr (UseTagsFilter)
-        {
-          if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
-          {
-            ref_stats.m_uiNumObjectsFiltered++;
-            continue;
-          }
-        }
-
-        ref_stats.m_uiNumObjectsPassed++;
-
-        if (pQueryData->m_Callback(objectPointers[i]) == ezVisitorExecution::Stop)
-          return ezVisitorExecution::Stop;
-      }
-
-      return ezVisitorExecution::Continue;
+      return FindObjectsInCell<T, UseTagsFilter>(cell, shape, queryParams, ref_stats, pQueryData->m_Callback);
     }
 
     struct FrustumQueryData
     {
-      PlaneData m_PlaneData;
+      FrustumPlaneData m_PlaneData;
       ezDynamicArray<const ezGameObject*>* m_pOutObjects;
       ezUInt64 m_uiFrameCounter;
       ezSpatialSystem::IsOccludedFunc m_IsOccludedCB;
@@ -542,7 +424,7 @@ namespace ezInternal
     static ezVisitorExecution::Enum FrustumQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState visType)
     {
       auto pQueryData = static_cast<FrustumQueryData*>(pUserData);
-      PlaneData planeData = pQueryData->m_PlaneData;
+      const FrustumPlaneData& planeData = pQueryData->m_PlaneData;
 
       ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
       if (!SphereFrustumIntersect(cellSphere, planeData))
@@ -556,96 +438,9 @@ namespace ezInternal
         }
       }
 
-      auto boundingSpheres = cell.m_BoundingSpheres.GetData();
-      auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
-      auto tagSets = cell.m_TagSets.GetData();
-      auto objectPointers = cell.m_ObjectPointers.GetData();
-      auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
-
-      const ezUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
-      ref_stats.m_uiNumObjectsTested += numSpheres;
-
-      ezUInt32 currentIndex = 0;
       const ezUInt64 uiFrameIdxAndType = (pQueryData->m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
 
-      while (currentIndex < numSpheres)
-      {
-        if (numSpheres - currentIndex >= 32)
-        {
-          ezUInt32 mask = 0;
-
-          for (ezUInt32 i = 0; i < 32; i += 2)
-          {
-            auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-            auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
-
-            mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
-          }
-
-          while (mask > 0)
-          {
-            ezUInt32 i = ezMath::FirstBitLow(mask) + currentIndex;
-            mask &= mask - 1;
-
-            if constexpr (UseTagsFilter)
-            {
-              if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
-              {
-                ref_stats.m_uiNumObjectsFiltered++;
-                continue;
-              }
-            }
-
-            if constexpr (UseOcclusionCallback)
-            {
-              const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-              if (pQueryData->m_IsOccludedCB(bbox))
-              {
-                continue;
-              }
-            }
-
-            lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-            pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
-
-            ref_stats.m_uiNumObjectsPassed++;
-          }
-
-          currentIndex += 32;
-        }
-        else
-        {
-          ezUInt32 i = currentIndex;
-          ++currentIndex;
-
-          if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
-            continue;
-
-          if constexpr (UseTagsFilter)
-          {
-            if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
-            {
-              ref_stats.m_uiNumObjectsFiltered++;
-              continue;
-            }
-          }
-
-          if constexpr (UseOcclusionCallback)
-          {
-            const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-
-            if (pQueryData->m_IsOccludedCB(bbox))
-            {
-              continue;
-            }
-          }
-
-          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-          pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
-
-          ref_stats.m_uiNumObjectsPassed++;
-        }
-      }
+      FindVisibleObjectsInCell<UseTagsFilter, UseOcclusionCallback>(cell, planeData, queryParams, ref_stats, pQueryData->m_IsOccludedCB, uiFrameIdxAndType, *pQueryData->m_pOutObjects);
 
       return ezVisitorExecution::Continue;
     }
@@ -828,7 +623,7 @@ void ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const ezSpatialDataHan
 
       if (pOldCell->m_Bounds.GetBox().Contains(bounds.GetBox()))
       {
-        pOldCell->m_BoundingSpheres[mapping.m_uiCellDataIndex] = bounds.GetSphere();
+        pOldCell->m_BoundingSpheres.Set(mapping.m_uiCellDataIndex, bounds.GetSphere());
         pOldCell->m_BoundingBoxHalfExtents[mapping.m_uiCellDataIndex] = bounds.m_BoxHalfExtents;
       }
       else
@@ -847,6 +642,17 @@ void ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const ezSpatialDataHan
     });
 }
 
+void ezSpatialSystem_RegularGrid::UpdateSpatialDataBoundsBatch(ezArrayPtr<const ezSpatialDataHandle> handles, ezArrayPtr<const ezSimdBBoxSphere> bounds)
+{
+  EZ_ASSERT_DEBUG(handles.GetCount() == bounds.GetCount(), "Number of handles and bounds must match");
+
+  for (ezUInt32 i = 0; i < handles.GetCount(); ++i)
+  {
+    // non-virtual call so the compiler can inline the update
+    ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(handles[i], bounds[i]);
+  }
+}
+
 void ezSpatialSystem_RegularGrid::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
 {
   Data* pData = nullptr;
@@ -911,35 +717,10 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
   const ezSimdBBox simdBox = ezSimdBBox::MakeFromPoints(simdCornerPoints, 8);
 
   ezInternal::QueryHelper::FrustumQueryData queryData;
-  {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    ezSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    queryData.m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    queryData.m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
-
-    queryData.m_pOutObjects = &out_Objects;
-    queryData.m_uiFrameCounter = m_uiFrameCounter;
-
-    queryData.m_IsOccludedCB = IsOccluded;
-  }
+  queryData.m_PlaneData = ezInternal::MakeFrustumPlaneData(frustum);
+  queryData.m_pOutObjects = &out_Objects;
+  queryData.m_uiFrameCounter = m_uiFrameCounter;
+  queryData.m_IsOccludedCB = IsOccluded;
 
   if (IsOccluded.IsValid())
   {
@@ -1066,7 +847,7 @@ ezSpatialDataHandle ezSpatialSystem_RegularGrid::AddSpatialDataToGrids(const ezS
       continue;
 
     if ((pGrid->m_Category.GetBitmask() & uiCategoryBitmask) == 0 ||
-        FilterByTags(tags, &pGrid->m_IncludeTags, &pGrid->m_ExcludeTags))
+        ezInternal::FilterByTags(tags, &pGrid->m_IncludeTags, &pGrid->m_ExcludeTags))
       continue;
 
     data.m_uiGridBitmask |= EZ_BIT(uiCachedGridIndex);
@@ -1155,7 +936,7 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
   }
 
   // then search for the rest
-  const bool useTagsFilter = (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
+  const bool useTagsFilter = ezInternal::UseTagsFilter(queryParams);
   CellCallback cellCallback = useTagsFilter ? filterByTagsCallback : noFilterCallback;
 
   while (uiGridBitmask > 0)
@@ -237,12 +237,24 @@ ezGameObjectHandle ezWorld::CreateObject(const ezGameObjectDesc& desc, ezGameObj
   // fix links
   LinkToParent(pNewObject);
 
+  // static objects are only moved explicitly, so their dynamic children do not need to be updated because of them
+  pTransformationData->m_uiGlobalTransformUpdateCounter = desc.m_bDynamic ? ezInvalidIndex : 0;
+
   pNewObject->UpdateActiveState(pParentObject == nullptr ? true : pParentObject->IsActive());
 
   out_pObject = pNewObject;
   return ezGameObjectHandle(newId);
 }
 
+void ezWorld::ReserveObjects(ezUInt32 uiCount)
+{
+  CheckForWriteAccess();
+
+  // +1 for the dummy entry with instance index 0
+  m_Data.m_Objects.Reserve(uiCount + 1);
+  m_Data.m_ObjectStorage.Reserve(uiCount);
+}
+
 void ezWorld::DeleteObjectNow(const ezGameObjectHandle& hObject0, bool bAlsoDeleteEmptyParents /*= true*/)
 {
   CheckForWriteAccess();
@@ -412,15 +424,16 @@ void ezWorld::PostMessage(const ezGameObjectHandle& receiverObject, const ezMess
   ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
   if (delay.IsPositive())
   {
+    // timed messages can stay in the queue for many frames, so they can't use a frame allocator
     ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
 
     metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    m_Data.m_TimedMessageQueues[queueType].EnqueueStaged(pMsgCopy, metaData);
   }
   else
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.GetMessageAllocatorForCurrentThread());
+    m_Data.m_MessageQueues[queueType].EnqueueStaged(pMsgCopy, metaData);
   }
 }
 
@@ -443,15 +456,16 @@ void ezWorld::PostMessage(const ezComponentHandle& hReceiverComponent, const ezM
   ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
   if (delay.IsPositive())
   {
+    // timed messages can stay in the queue for many frames, so they can't use a frame allocator
     ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
 
     metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    m_Data.m_TimedMessageQueues[queueType].EnqueueStaged(pMsgCopy, metaData);
   }
   else
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.GetMessageAllocatorForCurrentThread());
+    m_Data.m_MessageQueues[queueType].EnqueueStaged(pMsgCopy, metaData);
   }
 }
 
@@ -572,8 +586,13 @@ void ezWorld::Update()
     ProcessQueuedMessages(ezObjectMsgQueueType::AfterInitialized);
   }
 
-  // Swap our double buffered stack allocator
+  // Swap our double buffered stack allocators
   m_Data.m_StackAllocator.Swap();
+
+  for (auto& pMessageAllocator : m_Data.m_MessageAllocators)
+  {
+    pMessageAllocator->Swap();
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -720,6 +739,7 @@ void ezWorld::LinkToParent(ezGameObject* pObject)
     pParentObject->m_uiChildCount++;
 
     pObject->m_pTransformationData->m_pParentData = pParentObject->m_pTransformationData;
+    pObject->m_pTransformationData->MarkTransformChanged();
 
     if (pObject->m_Flags.IsSet(ezObjectFlags::ParentChangesNotifications))
     {
@@ -763,6 +783,7 @@ void ezWorld::UnlinkFromParent(ezGameObject* pObject)
     pParentObject->m_uiChildCount--;
     pObject->m_uiParentIndex = 0;
     pObject->m_pTransformationData->m_pParentData = nullptr;
+    pObject->m_pTransformationData->MarkTransformChanged();
 
     if (pObject->m_Flags.IsSet(ezObjectFlags::ParentChangesNotifications))
     {
@@ -920,6 +941,7 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
   // regular messages
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
+    queue.FlushStaged();
     queue.Sort(MessageComparer());
 
     m_Data.m_ProcessingMessageQueue = queueType;
@@ -937,6 +959,7 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
   // timed messages
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
+    queue.FlushStaged();
     queue.Sort(MessageComparer());
 
     const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
@@ -1439,6 +1462,7 @@ void ezWorld::PatchHierarchyData(ezGameObject* pObject, ezGameObject::TransformP
   RecreateHierarchyData(pObject, pObject->IsDynamic());
 
   pObject->m_pTransformationData->m_pParentData = pParent != nullptr ? pParent->m_pTransformationData : nullptr;
+  pObject->m_pTransformationData->MarkTransformChanged();
 
   if (preserve == ezGameObject::TransformPreservation::PreserveGlobal)
   {
@@ -51,6 +51,7 @@ namespace ezInternal
     , m_Clock(desc.m_sName)
     , m_WriteThreadID((ezThreadID)0)
     , m_bReportErrorWhenStaticObjectMoves(desc.m_bReportErrorWhenStaticObjectMoves)
+    , m_bTrackTransformChanges(desc.m_bTrackTransformChanges)
     , m_ReadMarker(*this)
     , m_WriteMarker(*this)
 
@@ -66,11 +67,20 @@ namespace ezInternal
       m_Random.Initialize(desc.m_uiRandomNumberGeneratorSeed);
     }
 
+    {
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < ezMessageQueueStaging::SlotCount; ++i)
+      {
+        sName.SetFormat("{} Messages {}_", desc.m_sName, i);
+        m_MessageAllocators[i] = EZ_NEW(&m_Allocator, ezDoubleBufferedLinearAllocator, sName, ezFoundation::GetAlignedAllocator());
+      }
+    }
+
     // insert dummy entry to save some checks
     m_Objects.Insert(nullptr);
 
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
-    static_assert(sizeof(ezGameObject::TransformationData) == 240);
+    static_assert(sizeof(ezGameObject::TransformationData) == 256);
 #else
     static_assert(sizeof(ezGameObject::TransformationData) == 192);
 #endif
@@ -173,6 +183,7 @@ namespace ezInternal
     {
       {
         MessageQueue& queue = m_MessageQueues[i];
+        queue.FlushStaged();
 
         // The messages in this queue are allocated through a frame allocator and thus mustn't (and don't need to be) deallocated
         queue.Clear();
@@ -180,6 +191,8 @@ namespace ezInternal
 
       {
         MessageQueue& queue = m_TimedMessageQueues[i];
+        queue.FlushStaged();
+
         while (!queue.IsEmpty())
         {
           MessageQueue::Entry& entry = queue.Peek();
@@ -191,6 +204,11 @@ namespace ezInternal
     }
   }
 
+  ezAllocator* WorldData::GetMessageAllocatorForCurrentThread() const
+  {
+    return m_MessageAllocators[ezMessageQueueStaging::GetCurrentThreadSlot()]->GetCurrentAllocator();
+  }
+
   ezGameObject::TransformationData* WorldData::CreateTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel)
   {
     Hierarchy& hierarchy = m_Hierarchies[GetHierarchyType(bDynamic)];
@@ -309,83 +327,175 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
-  void WorldData::UpdateGlobalTransforms()
+  /// Collects the spatial data bounds changes of one global transform update task and hands them over to the world in batches.
+  class WorldData::SpatialDataBoundsCollector
   {
-    struct UserData
+  public:
+    EZ_ALWAYS_INLINE SpatialDataBoundsCollector(SpatialDataBoundsUpdates& ref_updates)
+      : m_Updates(ref_updates)
     {
-      ezSpatialSystem* m_pSpatialSystem;
-      ezUInt32 m_uiUpdateCounter;
-    };
+    }
 
-    UserData userData;
-    userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
-    userData.m_uiUpdateCounter = m_uiUpdateCounter;
+    EZ_ALWAYS_INLINE ~SpatialDataBoundsCollector() { Flush(); }
 
-    struct RootLevel
+    EZ_FORCE_INLINE void Add(ezUInt64 uiSortingKey, const ezGameObject::TransformationData* pData)
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
+      if (m_uiNumEntries == BatchSize)
       {
-        auto pUserData = static_cast<const UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransform(pData, pUserData->m_uiUpdateCounter);
-        return ezVisitorExecution::Continue;
+        Flush();
       }
-    };
 
-    struct WithParent
-    {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
+      if (m_uiNumEntries == 0)
       {
-        auto pUserData = static_cast<const UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformWithParent(pData, pUserData->m_uiUpdateCounter);
-        return ezVisitorExecution::Continue;
+        m_uiSortingKey = uiSortingKey;
       }
-    };
 
-    struct RootLevelWithSpatialData
-    {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
-      {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
-      }
-    };
+      m_Handles[m_uiNumEntries] = pData->m_hSpatialData;
+      m_Bounds[m_uiNumEntries] = pData->m_globalBounds;
+      ++m_uiNumEntries;
+    }
 
-    struct WithParentWithSpatialData
+    void Flush()
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
-      {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
-      }
-    };
+      if (m_uiNumEntries == 0)
+        return;
 
-    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
-    if (!hierarchy.m_Data.IsEmpty())
-    {
-      auto dataPtr = hierarchy.m_Data.GetData();
+      EZ_LOCK(m_Updates.m_Mutex);
+
+      auto& batch = m_Updates.m_Batches.ExpandAndGetRef();
+      batch.m_uiSortingKey = m_uiSortingKey;
+      batch.m_uiFirstEntry = m_Updates.m_Handles.GetCount();
+      batch.m_uiNumEntries = m_uiNumEntries;
+
+      m_Updates.m_Handles.PushBackRange(ezMakeArrayPtr(m_Handles, m_uiNumEntries));
+      m_Updates.m_Bounds.PushBackRange(ezMakeArrayPtr(m_Bounds, m_uiNumEntries));
+
+      m_uiNumEntries = 0;
+    }
+
+  private:
+    static constexpr ezUInt32 BatchSize = 128;
+
+    SpatialDataBoundsUpdates& m_Updates;
+    ezUInt64 m_uiSortingKey = 0;
+    ezUInt32 m_uiNumEntries = 0;
+    ezSpatialDataHandle m_Handles[BatchSize];
+    ezSimdBBoxSphere m_Bounds[BatchSize];
+  };
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
-      if (m_pSpatialSystem == nullptr)
+  template <bool WithParent, bool OnlyChangedTransforms>
+  void WorldData::UpdateGlobalTransformsInLevel(Hierarchy::DataBlockArray& blocks, ezUInt32 uiHierarchyLevel)
+  {
+    ezParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 16; // in blocks, i.e. roughly 1000 objects
+    parallelForParams.m_Partitioning = ezParallelForPartitioning::Adaptive;
+    parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    ezTaskSystem::ParallelForIndexed(
+      0, blocks.GetCount(),
+      [this, &blocks, uiHierarchyLevel](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock)
       {
-        TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
+        const ezUInt32 uiUpdateCounter = m_uiUpdateCounter;
+        const bool bHasSpatialSystem = m_pSpatialSystem != nullptr;
+
+        SpatialDataBoundsCollector boundsCollector(m_SpatialDataBoundsUpdates);
 
-        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
+        for (ezUInt32 uiBlock = uiStartBlock; uiBlock < uiEndBlock; ++uiBlock)
         {
-          TraverseHierarchyLevelMultiThreaded<WithParent>(*dataPtr[i], &userData);
+          Hierarchy::DataBlock& block = blocks[uiBlock];
+
+          for (ezUInt32 i = 0; i < block.m_uiCount; ++i)
+          {
+            ezGameObject::TransformationData* pData = block.m_pData + i;
+
+            if constexpr (OnlyChangedTransforms)
+            {
+              if (!pData->NeedsGlobalTransformUpdate(uiUpdateCounter))
+              {
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+                // the last global transform has to catch up once after the object stopped moving
+                if (pData->m_uiGlobalTransformUpdateCounter + 1 == uiUpdateCounter)
+                {
+                  pData->UpdateLastGlobalTransform(uiUpdateCounter);
+                }
+#endif
+                continue;
+              }
+
+              pData->m_uiGlobalTransformUpdateCounter = uiUpdateCounter;
+            }
+
+            if constexpr (WithParent)
+            {
+              pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
+            }
+            else
+            {
+              pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
+            }
+
+            if (bHasSpatialSystem)
+            {
+              if (pData->UpdateGlobalBoundsAndCheckSpatialData())
+              {
+                const ezUInt64 uiSortingKey = (ezUInt64(uiHierarchyLevel) << 48) | (ezUInt64(uiBlock) << 16) | i;
+                boundsCollector.Add(uiSortingKey, pData);
+              }
+            }
+            else
+            {
+              pData->UpdateGlobalBounds();
+            }
+          }
         }
+      },
+      "World Global Transform Update Task", ezTaskNesting::Never, parallelForParams);
+  }
+
+  void WorldData::UpdateGlobalTransforms()
+  {
+    m_uiLastGlobalTransformUpdateCounter = m_uiUpdateCounter;
+
+    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
+    if (hierarchy.m_Data.IsEmpty())
+      return;
+
+    // All objects within one hierarchy level are independent of each other, so every level is updated in parallel.
+    // Spatial data bounds are not updated by the tasks directly since the spatial system does not support concurrent modification.
+    for (ezUInt32 uiLevel = 0; uiLevel < hierarchy.m_Data.GetCount(); ++uiLevel)
+    {
+      Hierarchy::DataBlockArray& blocks = *hierarchy.m_Data[uiLevel];
+
+      if (uiLevel == 0)
+      {
+        if (m_bTrackTransformChanges)
+          UpdateGlobalTransformsInLevel<false, true>(blocks, uiLevel);
+        else
+          UpdateGlobalTransformsInLevel<false, false>(blocks, uiLevel);
       }
       else
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        if (m_bTrackTransformChanges)
+          UpdateGlobalTransformsInLevel<true, true>(blocks, uiLevel);
+        else
+          UpdateGlobalTransformsInLevel<true, false>(blocks, uiLevel);
+      }
+    }
 
-        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
-        {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
-        }
+    SpatialDataBoundsUpdates& boundsUpdates = m_SpatialDataBoundsUpdates;
+    if (!boundsUpdates.m_Batches.IsEmpty())
+    {
+      boundsUpdates.m_Batches.Sort();
+
+      for (const auto& batch : boundsUpdates.m_Batches)
+      {
+        m_pSpatialSystem->UpdateSpatialDataBoundsBatch(boundsUpdates.m_Handles.GetArrayPtr().GetSubArray(batch.m_uiFirstEntry, batch.m_uiNumEntries),
+          boundsUpdates.m_Bounds.GetArrayPtr().GetSubArray(batch.m_uiFirstEntry, batch.m_uiNumEntries));
       }
+
+      boundsUpdates.m_Batches.Clear();
+      boundsUpdates.m_Handles.Clear();
+      boundsUpdates.m_Bounds.Clear();
     }
   }
 
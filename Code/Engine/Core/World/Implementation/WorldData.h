@@ -5,6 +5,7 @@
 #include <Foundation/Math/Random.h>
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Types/SharedPtr.h>
 
@@ -19,6 +20,7 @@ namespace ezInternal
   private:
     friend class ::ezWorld;
     friend class ::ezComponentManagerBase;
+    friend class ::ezGameObject;
 
     WorldData(ezWorldDesc& desc);
     ~WorldData();
@@ -31,6 +33,12 @@ namespace ezInternal
     ezInternal::WorldLargeBlockAllocator m_BlockAllocator;
     ezDoubleBufferedLinearAllocator m_StackAllocator;
 
+    /// \brief Frame allocators for queued messages, one per message queue staging slot, so that threads which post messages in parallel don't
+    /// contend on a single allocator.
+    ezUniquePtr<ezDoubleBufferedLinearAllocator> m_MessageAllocators[ezMessageQueueStaging::SlotCount];
+
+    ezAllocator* GetMessageAllocatorForCurrentThread() const;
+
     enum
     {
       GAME_OBJECTS_PER_BLOCK = ezDataBlock<ezGameObject, ezInternal::DEFAULT_BLOCK_SIZE>::CAPACITY,
@@ -126,22 +134,45 @@ namespace ezInternal
 
     template <typename VISITOR>
     static ezVisitorExecution::Enum TraverseHierarchyLevel(Hierarchy::DataBlockArray& blocks, void* pUserData = nullptr);
-    template <typename VISITOR>
-    ezVisitorExecution::Enum TraverseHierarchyLevelMultiThreaded(Hierarchy::DataBlockArray& blocks, void* pUserData = nullptr);
 
     using VisitorFunc = ezDelegate<ezVisitorExecution::Enum(ezGameObject*)>;
     void TraverseBreadthFirst(VisitorFunc& func);
     void TraverseDepthFirst(VisitorFunc& func);
     static ezVisitorExecution::Enum TraverseObjectDepthFirst(ezGameObject* pObject, VisitorFunc& func);
 
-    static void UpdateGlobalTransform(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter);
-    static void UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter);
-
-    static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
+    template <bool WithParent, bool OnlyChangedTransforms>
+    void UpdateGlobalTransformsInLevel(Hierarchy::DataBlockArray& blocks, ezUInt32 uiHierarchyLevel);
 
     void UpdateGlobalTransforms();
 
+    /// \brief Returns the update counter of the next UpdateGlobalTransforms() call, which may still be in the current world update.
+    ezUInt32 GetNextGlobalTransformUpdateCounter() const { return m_uiLastGlobalTransformUpdateCounter == m_uiUpdateCounter ? m_uiUpdateCounter + 1 : m_uiUpdateCounter; }
+
+    // Spatial data bounds changes are collected by the global transform update tasks and applied afterwards on the updating thread,
+    // sorted by object location to keep the order deterministic.
+    struct SpatialDataBoundsUpdates
+    {
+      struct Batch
+      {
+        EZ_DECLARE_POD_TYPE();
+
+        ezUInt64 m_uiSortingKey; // hierarchy level, block index and index within the block of the first entry
+        ezUInt32 m_uiFirstEntry;
+        ezUInt32 m_uiNumEntries;
+
+        EZ_ALWAYS_INLINE bool operator<(const Batch& other) const { return m_uiSortingKey < other.m_uiSortingKey; }
+      };
+
+      ezMutex m_Mutex;
+      ezDynamicArray<Batch> m_Batches;
+      ezDynamicArray<ezSpatialDataHandle> m_Handles;
+      ezDynamicArray<ezSimdBBoxSphere, ezAlignedAllocatorWrapper> m_Bounds;
+    };
+
+    SpatialDataBoundsUpdates m_SpatialDataBoundsUpdates;
+
+    class SpatialDataBoundsCollector;
+
     void ResourceEventHandler(const ezResourceEvent& e);
 
     // game object lookups
@@ -241,8 +272,10 @@ namespace ezInternal
     mutable ezAtomicInteger32 m_iReadCounter;
 
     ezUInt32 m_uiUpdateCounter = 0;
+    ezUInt32 m_uiLastGlobalTransformUpdateCounter = ezInvalidIndex; ///< The update counter at which UpdateGlobalTransforms() ran last.
     bool m_bSimulateWorld = true;
     bool m_bReportErrorWhenStaticObjectMoves = true;
+    bool m_bTrackTransformChanges = false;
 
     /// \brief Maps some data (given as void*) to an ezGameObjectHandle. Only available in special situations (e.g. editor use cases).
     ezDelegate<ezGameObjectHandle(const void*, ezComponentHandle, ezStringView)> m_GameObjectReferenceResolver;
@@ -29,65 +29,6 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
-  // static
-  template <typename VISITOR>
-  EZ_FORCE_INLINE ezVisitorExecution::Enum WorldData::TraverseHierarchyLevelMultiThreaded(
-    Hierarchy::DataBlockArray& blocks, void* pUserData /* = nullptr*/)
-  {
-    ezParallelForParams parallelForParams;
-    parallelForParams.m_uiBinSize = 100;
-    parallelForParams.m_uiMaxTasksPerThread = 2;
-    parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
-
-    ezTaskSystem::ParallelFor(
-      blocks.GetArrayPtr(),
-      [pUserData](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice)
-      {
-        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
-        {
-          ezGameObject::TransformationData* pCurrentData = block.m_pData;
-          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
-
-          while (pCurrentData < pEndData)
-          {
-            VISITOR::Visit(pCurrentData, pUserData);
-            ++pCurrentData;
-          }
-        }
-      },
-      "World DataBlock Traversal Task", parallelForParams);
-
-    return ezVisitorExecution::Continue;
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransform(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter)
-  {
-    pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
-    pData->UpdateGlobalBounds();
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter)
-  {
-    pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
-    pData->UpdateGlobalBounds();
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem)
-  {
-    pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem)
-  {
-    pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
-  }
-
   ///////////////////////////////////////////////////////////////////////////////////////////////////
 
   EZ_ALWAYS_INLINE const ezGameObject& WorldData::ConstObjectIterator::operator*() const
@@ -25,6 +25,13 @@ public:
   virtual void DeleteSpatialData(const ezSpatialDataHandle& hData) = 0;
 
   virtual void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) = 0;
+
+  /// \brief Updates the bounds of several spatial data entries at once. Both arrays must have the same number of elements.
+  ///
+  /// The world uses this to apply the bounds changes collected during the parallel global transform update.
+  /// The default implementation calls UpdateSpatialDataBounds for each entry.
+  virtual void UpdateSpatialDataBoundsBatch(ezArrayPtr<const ezSpatialDataHandle> handles, ezArrayPtr<const ezSimdBBoxSphere> bounds);
+
   virtual void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) = 0;
 
   ///@}
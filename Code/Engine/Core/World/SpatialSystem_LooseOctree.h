@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief A spatial system that stores the spatial data of every category in a sparse loose octree.
+///
+/// Every node covers a cubic cell, but accepts all objects whose center lies inside the cell and whose extents are at most half the cell size.
+/// Its 'loose' bounds are therefore twice as large as the cell. Objects are stored in the deepest node that fulfills this,
+/// so small objects end up in small nodes and huge objects stay close to the root without being duplicated or blowing up the number of nodes.
+/// Nodes are only created where objects exist and are removed again when they become empty.
+///
+/// Compared to ezSpatialSystem_RegularGrid this works better for very large and sparse worlds and worlds with a wide range of object sizes.
+/// It does not cache tag filtered queries, though. To use it, set ezWorldDesc::m_pSpatialSystem before creating the world.
+class EZ_CORE_DLL ezSpatialSystem_LooseOctree : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_LooseOctree, ezSpatialSystem);
+
+public:
+  /// \brief The root cell is centered at the origin and has the given half extents. Objects outside of it are stored in the root node.
+  /// Nodes are not subdivided further once their half extents would fall below fMinNodeHalfExtents.
+  ezSpatialSystem_LooseOctree(float fRootHalfExtents = 65536.0f, float fMinNodeHalfExtents = 64.0f);
+  ~ezSpatialSystem_LooseOctree();
+
+  /// \brief Returns the loose bounding box of the node that contains the given spatial data. Useful for debug visualizations.
+  ezResult GetNodeBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_boundingBox) const;
+
+  /// \brief Returns the loose bounding boxes of all existing nodes.
+  void GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezSpatialData::Category filterCategory = ezInvalidSpatialDataCategory) const;
+
+private:
+  // ezSpatialSystem implementation
+  ezSpatialDataHandle CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+  ezSpatialDataHandle CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+
+  void DeleteSpatialData(const ezSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataBoundsBatch(ezArrayPtr<const ezSpatialDataHandle> handles, ezArrayPtr<const ezSimdBBoxSphere> bounds) override;
+  void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) override;
+
+  void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, ezSpatialSystem::IsOccludedFunc isOccluded, ezVisibilityState visType) const override;
+
+  ezVisibilityState GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(ezStringBuilder& ref_sSb) const override;
+#endif
+
+  enum
+  {
+    MAX_NUM_TREES = (sizeof(ezSpatialData::Category::m_uiValue) * 8)
+  };
+
+  struct Node;
+  struct Tree;
+  struct Stats;
+
+  ezProxyAllocator m_AlignedAllocator;
+
+  float m_fRootHalfExtents;
+  float m_fMinNodeHalfExtents;
+
+  ezDynamicArray<ezUniquePtr<Tree>> m_Trees;
+
+  struct Data
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiCategoryBitmask;
+    ezUInt32 m_uiAlwaysVisible;
+  };
+
+  ezIdTable<ezSpatialDataId, Data, ezLocalAllocatorWrapper> m_DataTable;
+
+  ezSpatialDataHandle AddSpatialDataToTrees(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible);
+
+  template <typename Functor>
+  void ForEachTree(const Data& data, Functor func) const;
+
+  template <typename NodeFilter, typename Functor>
+  void ForEachNodeInMatchingTrees(const QueryParams& queryParams, NodeFilter nodeFilter, Functor func) const;
+};
@@ -36,6 +36,7 @@ private:
   void DeleteSpatialData(const ezSpatialDataHandle& hData) override;
 
   void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataBoundsBatch(ezArrayPtr<const ezSpatialDataHandle> handles, ezArrayPtr<const ezSimdBBoxSphere> bounds) override;
   void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) override;
 
   void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
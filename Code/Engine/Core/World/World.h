@@ -43,6 +43,11 @@ public:
   /// \brief Create a new game object from the given description, writes a pointer to it to out_pObject and returns a handle to it.
   ezGameObjectHandle CreateObject(const ezGameObjectDesc& desc, ezGameObject*& out_pObject);
 
+  /// \brief Pre-allocates the internal object tables so that the world can hold the given total number of objects without growing them.
+  ///
+  /// This is an optimization for creating many objects at once, e.g. when a level is instantiated.
+  void ReserveObjects(ezUInt32 uiCount);
+
   /// \brief Deletes the given object, its children and all components.
   /// \note This function deletes the object immediately! It is unsafe to use this during a game update loop, as other objects
   /// may rely on this object staying valid for the rest of the frame.
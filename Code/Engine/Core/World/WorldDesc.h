@@ -27,5 +27,9 @@ struct ezWorldDesc
 
   bool m_bReportErrorWhenStaticObjectMoves = true;
 
+  /// \brief If set, the world update only recomputes the global transforms of dynamic objects whose local transform, bounds or parent have changed
+  /// since the last update. This saves a lot of time in worlds with many dynamic objects that rarely move.
+  bool m_bTrackTransformChanges = false;
+
   ezTime m_MaxComponentInitializationTimePerFrame = ezTime::MakeFromHours(10000); // max time to spend on component initialization per frame
 };
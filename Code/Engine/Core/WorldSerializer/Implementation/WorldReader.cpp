@@ -1,12 +1,34 @@
 #include <Core/CorePCH.h>
 
+#include <Core/WorldSerializer/Implementation/WorldSnapshot.h>
 #include <Core/WorldSerializer/WorldReader.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
+#include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
 
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezConcurrentDeserializationAttribute, 1, ezRTTIDefaultAllocator<ezConcurrentDeserializationAttribute>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezCVarBool cvar_WorldReaderConcurrentDeserialization("World.ConcurrentDeserialization", true, ezCVarFlags::Default, "Whether component types with the ezConcurrentDeserializationAttribute are deserialized on worker threads");
+
 ezWorldReader::FindComponentTypeCallback ezWorldReader::s_FindComponentTypeCallback;
 
+namespace
+{
+  /// \brief The stream that GetStream() returns on the current thread, while it deserializes components concurrently.
+  struct ThreadStream
+  {
+    const ezWorldReader* m_pReader = nullptr;
+    ezStreamReader* m_pStream = nullptr;
+  };
+
+  thread_local ThreadStream s_ThreadStream;
+} // namespace
+
 ezWorldReader::ezWorldReader() = default;
 ezWorldReader::~ezWorldReader() = default;
 
@@ -14,6 +36,11 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& inout_stream, bool
 {
   m_pStream = &inout_stream;
 
+  m_bReadFromSnapshot = false;
+  m_SnapshotCreationData.m_Data = {};
+  m_SnapshotComponentData.m_Data = {};
+  m_SnapshotStrings.Clear();
+
   m_uiVersion = 0;
   inout_stream >> m_uiVersion;
 
@@ -77,6 +104,186 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& inout_stream, bool
   return EZ_SUCCESS;
 }
 
+ezResult ezWorldReader::ReadWorldSnapshot(ezArrayPtr<const ezUInt8> snapshot)
+{
+  using namespace ezInternal;
+
+  ClearAndCompact();
+
+  auto Corrupted = [this]()
+  {
+    ezLog::Error("World snapshot is corrupted.");
+    ClearAndCompact();
+    return EZ_FAILURE;
+  };
+
+  if (snapshot.GetCount() < sizeof(WorldSnapshotHeader) || !ezMemoryUtils::IsAligned(snapshot.GetPtr(), alignof(WorldSnapshotObject)))
+    return Corrupted();
+
+  const ezUInt8* pSnapshot = snapshot.GetPtr();
+  const WorldSnapshotHeader& header = *reinterpret_cast<const WorldSnapshotHeader*>(pSnapshot);
+
+  if (header.m_uiMagic != WorldSnapshotHeader::Magic || header.m_uiVersion != WorldSnapshotHeader::Version)
+  {
+    ezLog::Error("Invalid world snapshot version (got {}).", header.m_uiVersion);
+    return EZ_FAILURE;
+  }
+
+  if (header.m_uiTotalSize > snapshot.GetCount())
+    return Corrupted();
+
+  if (header.m_uiNumComponentTypes > ezMath::MaxValue<ezUInt16>())
+  {
+    ezLog::Error("World snapshot has too many component types, got {0} - maximum allowed are {1}", header.m_uiNumComponentTypes, ezMath::MaxValue<ezUInt16>());
+    return EZ_FAILURE;
+  }
+
+  const ezUInt64 uiNumObjects = static_cast<ezUInt64>(header.m_uiNumRootObjects) + header.m_uiNumChildObjects;
+
+  auto IsValidSection = [&](ezUInt32 uiOffset, ezUInt64 uiSize)
+  { return ezMemoryUtils::IsSizeAligned(uiOffset, WorldSnapshotHeader::SectionAlignment) && uiOffset + uiSize <= header.m_uiTotalSize; };
+
+  if (!IsValidSection(header.m_uiStringsOffset, header.m_uiNumStrings * static_cast<ezUInt64>(sizeof(WorldSnapshotString))) ||
+      !IsValidSection(header.m_uiStringDataOffset, header.m_uiStringDataSize) ||
+      !IsValidSection(header.m_uiObjectsOffset, uiNumObjects * sizeof(WorldSnapshotObject)) ||
+      !IsValidSection(header.m_uiTagsOffset, header.m_uiNumTagReferences * static_cast<ezUInt64>(sizeof(ezUInt32))) ||
+      !IsValidSection(header.m_uiComponentTypesOffset, header.m_uiNumComponentTypes * static_cast<ezUInt64>(sizeof(WorldSnapshotComponentType))) ||
+      !IsValidSection(header.m_uiCreationDataOffset, header.m_uiCreationDataSize) ||
+      !IsValidSection(header.m_uiComponentDataOffset, header.m_uiComponentDataSize))
+  {
+    return Corrupted();
+  }
+
+  // strings are referenced in place
+  {
+    const WorldSnapshotString* pStrings = reinterpret_cast<const WorldSnapshotString*>(pSnapshot + header.m_uiStringsOffset);
+    const char* szStringData = reinterpret_cast<const char*>(pSnapshot + header.m_uiStringDataOffset);
+
+    m_SnapshotStrings.SetCountUninitialized(header.m_uiNumStrings);
+
+    for (ezUInt32 i = 0; i < header.m_uiNumStrings; ++i)
+    {
+      const ezUInt64 uiEnd = static_cast<ezUInt64>(pStrings[i].m_uiOffset) + pStrings[i].m_uiLength;
+      if (uiEnd >= header.m_uiStringDataSize || szStringData[uiEnd] != '\0')
+        return Corrupted();
+
+      m_SnapshotStrings[i] = ezStringView(szStringData + pStrings[i].m_uiOffset, szStringData + uiEnd);
+    }
+  }
+
+  ezDynamicArray<const ezTag*> tags;
+  {
+    const ezUInt32* pTags = reinterpret_cast<const ezUInt32*>(pSnapshot + header.m_uiTagsOffset);
+
+    tags.SetCountUninitialized(header.m_uiNumTagReferences);
+
+    for (ezUInt32 i = 0; i < header.m_uiNumTagReferences; ++i)
+    {
+      if (pTags[i] >= header.m_uiNumStrings)
+        return Corrupted();
+
+      tags[i] = &ezTagRegistry::GetGlobalRegistry().RegisterTag(m_SnapshotStrings[pTags[i]]);
+    }
+  }
+
+  // game objects
+  {
+    const WorldSnapshotObject* pObjects = reinterpret_cast<const WorldSnapshotObject*>(pSnapshot + header.m_uiObjectsOffset);
+
+    m_RootObjectsToCreate.Reserve(header.m_uiNumRootObjects);
+    m_ChildObjectsToCreate.Reserve(header.m_uiNumChildObjects);
+
+    m_IndexToGameObjectHandle.SetCountUninitialized(static_cast<ezUInt32>(uiNumObjects + 1));
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const WorldSnapshotObject& object = pObjects[i];
+
+      // parents are always stored before their children
+      if (object.m_uiParentIndex > i || object.m_uiName >= header.m_uiNumStrings || object.m_uiGlobalKey >= header.m_uiNumStrings ||
+          static_cast<ezUInt64>(object.m_uiFirstTag) + object.m_uiNumTags > header.m_uiNumTagReferences)
+      {
+        return Corrupted();
+      }
+
+      GameObjectToCreate& godesc = i < header.m_uiNumRootObjects ? m_RootObjectsToCreate.ExpandAndGetRef() : m_ChildObjectsToCreate.ExpandAndGetRef();
+      godesc.m_uiParentHandleIdx = object.m_uiParentIndex;
+      godesc.m_sGlobalKey = m_SnapshotStrings[object.m_uiGlobalKey];
+
+      ezGameObjectDesc& desc = godesc.m_Desc;
+      desc.m_sName.Assign(m_SnapshotStrings[object.m_uiName]);
+      desc.m_LocalPosition = object.m_vLocalPosition;
+      desc.m_LocalRotation = object.m_qLocalRotation;
+      desc.m_LocalScaling = object.m_vLocalScaling;
+      desc.m_LocalUniformScaling = object.m_fLocalUniformScaling;
+      desc.m_bActiveFlag = (object.m_uiFlags & WorldSnapshotObject::Active) != 0;
+      desc.m_bDynamic = (object.m_uiFlags & WorldSnapshotObject::Dynamic) != 0;
+      desc.m_uiTeamID = object.m_uiTeamID;
+      desc.m_uiStableRandomSeed = object.m_uiStableRandomSeed;
+
+      for (ezUInt32 t = 0; t < object.m_uiNumTags; ++t)
+      {
+        desc.m_Tags.Set(*tags[object.m_uiFirstTag + t]);
+      }
+    }
+  }
+
+  // component types, the component data itself is read in place during instantiation
+  {
+    const WorldSnapshotComponentType* pComponentTypes = reinterpret_cast<const WorldSnapshotComponentType*>(pSnapshot + header.m_uiComponentTypesOffset);
+
+    m_ComponentTypes.SetCount(header.m_uiNumComponentTypes);
+    m_ComponentTypeVersions.Reserve(header.m_uiNumComponentTypes);
+
+    for (ezUInt32 i = 0; i < header.m_uiNumComponentTypes; ++i)
+    {
+      const WorldSnapshotComponentType& componentType = pComponentTypes[i];
+
+      if (componentType.m_uiTypeName >= header.m_uiNumStrings || componentType.m_uiComponentDataOffset > header.m_uiComponentDataSize ||
+          componentType.m_uiCreationDataOffset + static_cast<ezUInt64>(componentType.m_uiNumComponents) * WorldSnapshotComponentCreationDataSize > header.m_uiCreationDataSize)
+      {
+        return Corrupted();
+      }
+
+      // owners are looked up without further checks during instantiation
+      const ezUInt8* pCreationData = pSnapshot + header.m_uiCreationDataOffset + componentType.m_uiCreationDataOffset;
+      for (ezUInt32 c = 0; c < componentType.m_uiNumComponents; ++c, pCreationData += WorldSnapshotComponentCreationDataSize)
+      {
+        ezUInt32 uiOwnerIndex = 0;
+        ezUInt32 uiComponentIndex = 0;
+        ezMemoryUtils::RawByteCopy(&uiOwnerIndex, pCreationData, sizeof(ezUInt32));
+        ezMemoryUtils::RawByteCopy(&uiComponentIndex, pCreationData + sizeof(ezUInt32), sizeof(ezUInt32));
+
+        if (uiOwnerIndex == 0 || uiOwnerIndex > uiNumObjects || uiComponentIndex != c + 1)
+          return Corrupted();
+      }
+
+      InitComponentTypeInfo(i, m_SnapshotStrings[componentType.m_uiTypeName], componentType.m_uiTypeVersion);
+
+      ComponentTypeInfo& compTypeInfo = m_ComponentTypes[i];
+      compTypeInfo.m_uiCreationStreamOffset = componentType.m_uiCreationDataOffset;
+      compTypeInfo.m_uiDataStreamOffset = componentType.m_uiComponentDataOffset;
+
+      if (compTypeInfo.m_pRtti != nullptr)
+      {
+        compTypeInfo.m_uiNumComponents = componentType.m_uiNumComponents;
+        m_uiTotalNumComponents += componentType.m_uiNumComponents;
+      }
+    }
+  }
+
+  m_bReadFromSnapshot = true;
+  m_SnapshotCreationData.m_Data = snapshot.GetSubArray(header.m_uiCreationDataOffset, header.m_uiCreationDataSize);
+  m_SnapshotComponentData.m_Data = snapshot.GetSubArray(header.m_uiComponentDataOffset, header.m_uiComponentDataSize);
+
+  // destroy old context first
+  m_pStringDedupReadContext = nullptr;
+  m_pStringDedupReadContext = EZ_DEFAULT_NEW(ezStringDeduplicationReadContext, m_SnapshotStrings.GetArrayPtr());
+  m_pStringDedupReadContext->SetActive(false);
+
+  return EZ_SUCCESS;
+}
+
 ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateWorld(ezWorld& ref_world, const ezUInt16* pOverrideTeamID, ezTime maxStepTime, ezProgress* pProgress)
 {
   ezPrefabInstantiationOptions options;
@@ -93,10 +300,21 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(ref_world, true, rootTransform, options);
 }
 
+ezStreamReader& ezWorldReader::GetStream() const
+{
+  if (s_ThreadStream.m_pReader == this)
+    return *s_ThreadStream.m_pStream;
+
+  return *m_pStream;
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
-  *m_pStream >> idx;
+  GetStream() >> idx;
+
+  if (idx >= m_IndexToGameObjectHandle.GetCount())
+    return ezGameObjectHandle();
 
   return m_IndexToGameObjectHandle[idx];
 }
@@ -106,8 +324,9 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
   ezUInt16 uiTypeIndex = 0;
   ezUInt32 uiIndex = 0;
 
-  *m_pStream >> uiTypeIndex;
-  *m_pStream >> uiIndex;
+  ezStreamReader& s = GetStream();
+  s >> uiTypeIndex;
+  s >> uiIndex;
 
   out_hComponent.Invalidate();
 
@@ -156,12 +375,22 @@ void ezWorldReader::ClearAndCompact()
 
   m_ComponentDataStream.Clear();
   m_ComponentDataStream.Compact();
+
+  m_uiTotalNumComponents = 0;
+
+  m_pStringDedupReadContext = nullptr;
+
+  m_bReadFromSnapshot = false;
+  m_SnapshotCreationData.m_Data = {};
+  m_SnapshotComponentData.m_Data = {};
+  m_SnapshotStrings.Clear();
+  m_SnapshotStrings.Compact();
 }
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
   return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
-         m_ComponentDataStream.GetHeapMemoryUsage();
+         m_ComponentDataStream.GetHeapMemoryUsage() + m_SnapshotStrings.GetHeapMemoryUsage();
 }
 
 ezUInt32 ezWorldReader::GetRootObjectCount() const
@@ -226,24 +455,44 @@ void ezWorldReader::ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx)
   s >> sRttiName;
   s >> uiRttiVersion;
 
+  InitComponentTypeInfo(uiComponentTypeIdx, sRttiName, uiRttiVersion);
+}
+
+void ezWorldReader::InitComponentTypeInfo(ezUInt32 uiComponentTypeIdx, ezStringView sTypeName, ezUInt32 uiTypeVersion)
+{
   const ezRTTI* pRtti = nullptr;
 
   if (s_FindComponentTypeCallback.IsValid())
   {
-    pRtti = s_FindComponentTypeCallback(sRttiName);
+    pRtti = s_FindComponentTypeCallback(sTypeName);
   }
   else
   {
-    pRtti = ezRTTI::FindTypeByName(sRttiName);
+    pRtti = ezRTTI::FindTypeByName(sTypeName);
 
     if (pRtti == nullptr)
     {
-      ezLog::Error("Unknown component type '{0}'. Components of this type will be skipped.", sRttiName);
+      ezLog::Error("Unknown component type '{0}'. Components of this type will be skipped.", sTypeName);
     }
   }
 
   m_ComponentTypes[uiComponentTypeIdx].m_pRtti = pRtti;
-  m_ComponentTypeVersions[pRtti] = uiRttiVersion;
+  m_ComponentTypeVersions[pRtti] = uiTypeVersion;
+
+  m_ComponentTypes[uiComponentTypeIdx].m_bConcurrentDeserialization = false;
+
+  if (pRtti != nullptr)
+  {
+    // only look at the type itself, a derived type may deserialize more data than its base class
+    for (const ezPropertyAttribute* pAttribute : pRtti->GetAttributes())
+    {
+      if (pAttribute->IsInstanceOf<ezConcurrentDeserializationAttribute>())
+      {
+        m_ComponentTypes[uiComponentTypeIdx].m_bConcurrentDeserialization = true;
+        break;
+      }
+    }
+  }
 }
 
 void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
@@ -273,6 +522,13 @@ void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
           uiAllComponentsSize -= sizeof(ezUInt32);
 
           m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
+
+          compTypeInfo.m_uiCreationStreamOffset = ref_writer.GetWritePosition();
+        }
+        else
+        {
+          // the data of every type can be read independently, which allows to deserialize different types concurrently
+          compTypeInfo.m_uiDataStreamOffset = ref_writer.GetWritePosition();
         }
 
         while (uiAllComponentsSize > 0)
@@ -298,6 +554,22 @@ void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
   }
 }
 
+const ezMemoryStreamStorageInterface& ezWorldReader::GetComponentCreationStorage() const
+{
+  if (m_bReadFromSnapshot)
+    return m_SnapshotCreationStorage;
+
+  return m_ComponentCreationStream;
+}
+
+const ezMemoryStreamStorageInterface& ezWorldReader::GetComponentDataStorage() const
+{
+  if (m_bReadFromSnapshot)
+    return m_SnapshotComponentStorage;
+
+  return m_ComponentDataStream;
+}
+
 void ezWorldReader::ClearHandles()
 {
   m_IndexToGameObjectHandle.Clear();
@@ -363,6 +635,8 @@ ezWorldReader::InstantiationContext::InstantiationContext(ezWorldReader& ref_wor
 
 ezWorldReader::InstantiationContext::~InstantiationContext()
 {
+  WaitForConcurrentDeserialization();
+
   if (!m_hComponentInitBatch.IsInvalidated())
   {
     m_WorldReader.m_pWorld->DeleteComponentInitBatch(m_hComponentInitBatch);
@@ -382,6 +656,25 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
 
   if (m_Phase == Phase::CreateRootObjects)
   {
+    if (m_uiCurrentIndex == 0)
+    {
+      // the number of objects is known up front, so make room for all of them at once instead of growing the tables step by step
+      const ezUInt32 uiNumRootObjects = m_WorldReader.m_RootObjectsToCreate.GetCount();
+      const ezUInt32 uiNumChildObjects = m_WorldReader.m_ChildObjectsToCreate.GetCount();
+
+      m_WorldReader.m_pWorld->ReserveObjects(m_WorldReader.m_pWorld->GetObjectCount() + uiNumRootObjects + uiNumChildObjects);
+
+      if (m_Options.m_pCreatedRootObjectsOut)
+      {
+        m_Options.m_pCreatedRootObjectsOut->Reserve(m_Options.m_pCreatedRootObjectsOut->GetCount() + uiNumRootObjects);
+      }
+
+      if (m_Options.m_pCreatedChildObjectsOut)
+      {
+        m_Options.m_pCreatedChildObjectsOut->Reserve(m_Options.m_pCreatedChildObjectsOut->GetCount() + uiNumChildObjects);
+      }
+    }
+
     if (!m_Options.m_ReplaceNamedRootWithParent.IsEmpty())
     {
       EZ_ASSERT_DEBUG(!m_Options.m_hParent.IsInvalidated(), "Parent must be provided when m_ReplaceNamedRootWithParent is specified.");
@@ -427,14 +720,14 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime))
       return StepResult::Continue;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
+    m_CurrentReader.SetStorage(&m_WorldReader.GetComponentCreationStorage());
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize64() > 0)
+    if (m_WorldReader.GetComponentCreationStorage().GetStorageSize64() > 0)
     {
       m_WorldReader.m_pStringDedupReadContext->SetActive(true);
 
@@ -447,14 +740,14 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
         return StepResult::Continue;
     }
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
+    m_CurrentReader.SetStorage(&m_WorldReader.GetComponentDataStorage());
     m_Phase = Phase::DeserializeComponents;
     BeginNextProgressStep("DeserializeComponents");
   }
 
   if (m_Phase == Phase::DeserializeComponents)
   {
-    if (m_WorldReader.m_ComponentDataStream.GetStorageSize64() > 0)
+    if (m_WorldReader.GetComponentDataStorage().GetStorageSize64() > 0)
     {
       m_WorldReader.m_pStringDedupReadContext->SetActive(true);
 
@@ -503,6 +796,8 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
 
 void ezWorldReader::InstantiationContext::Cancel()
 {
+  WaitForConcurrentDeserialization();
+
   if (!m_hComponentInitBatch.IsInvalidated())
   {
     m_WorldReader.m_pWorld->CancelComponentInitBatch(m_hComponentInitBatch);
@@ -614,6 +909,15 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
     ezComponentManagerBase* pManager = m_WorldReader.m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
     EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
 
+    if (m_uiCurrentIndex == 0)
+    {
+      pManager->ReserveComponents(pManager->GetComponentCount() + compTypeInfo.m_uiNumComponents);
+      compTypeInfo.m_ComponentIndexToHandle.Reserve(compTypeInfo.m_uiNumComponents + 1);
+
+      // a snapshot also contains the data of unknown types, which has to be skipped
+      m_CurrentReader.SetReadPosition(compTypeInfo.m_uiCreationStreamOffset);
+    }
+
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
       const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
@@ -671,12 +975,24 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponents");
 
+  if (!m_bConcurrentDeserializationStarted)
+  {
+    StartConcurrentDeserialization();
+  }
+
+  // meanwhile deserialize all other component types on this thread
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
-    if (compTypeInfo.m_pRtti == nullptr)
+    if (compTypeInfo.m_pRtti == nullptr || (compTypeInfo.m_bConcurrentDeserialization && m_bConcurrentDeserializationEnabled))
       continue;
 
+    if (m_uiCurrentIndex == 0)
+    {
+      // skip the data of all types that are deserialized concurrently
+      m_CurrentReader.SetReadPosition(compTypeInfo.m_uiDataStreamOffset);
+    }
+
     while (m_uiCurrentIndex < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
       ezComponent* pComponent = nullptr;
@@ -698,6 +1014,11 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
     m_uiCurrentIndex = 0;
   }
 
+  WaitForConcurrentDeserialization();
+
+  m_bConcurrentDeserializationStarted = false;
+  m_ConcurrentlyDeserializedComponents.Clear();
+
   m_uiCurrentIndex = 0;
   m_uiCurrentComponentTypeIndex = 0;
   m_uiCurrentNumComponentsProcessed = 0;
@@ -705,6 +1026,103 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
   return true;
 }
 
+void ezWorldReader::InstantiationContext::StartConcurrentDeserialization()
+{
+  m_bConcurrentDeserializationStarted = true;
+
+  // When the instantiation is spread over multiple steps, the world is updated in between and may move or delete components,
+  // so the tasks could only run within a single step, which would make it impossible to stay within the step time.
+  m_bConcurrentDeserializationEnabled = cvar_WorldReaderConcurrentDeserialization && m_hComponentInitBatch.IsInvalidated();
+
+  if (!m_bConcurrentDeserializationEnabled)
+    return;
+
+  // look up all components up front, the tasks must not access the world
+  struct TypeRange
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiComponentTypeIdx;
+    ezUInt32 m_uiFirstComponent;
+    ezUInt32 m_uiNumComponents;
+  };
+
+  ezHybridArray<TypeRange, 32> typeRanges;
+
+  for (ezUInt32 uiTypeIdx = 0; uiTypeIdx < m_WorldReader.m_ComponentTypes.GetCount(); ++uiTypeIdx)
+  {
+    const auto& compTypeInfo = m_WorldReader.m_ComponentTypes[uiTypeIdx];
+    if (compTypeInfo.m_pRtti == nullptr || !compTypeInfo.m_bConcurrentDeserialization || compTypeInfo.m_ComponentIndexToHandle.GetCount() <= 1)
+      continue;
+
+    TypeRange& range = typeRanges.ExpandAndGetRef();
+    range.m_uiComponentTypeIdx = uiTypeIdx;
+    range.m_uiFirstComponent = m_ConcurrentlyDeserializedComponents.GetCount();
+
+    // index 0 is the invalid handle
+    for (ezUInt32 i = 1; i < compTypeInfo.m_ComponentIndexToHandle.GetCount(); ++i)
+    {
+      ezComponent* pComponent = nullptr;
+      if (m_WorldReader.m_pWorld->TryGetComponent(compTypeInfo.m_ComponentIndexToHandle[i], pComponent))
+      {
+        m_ConcurrentlyDeserializedComponents.PushBack(pComponent);
+      }
+    }
+
+    range.m_uiNumComponents = m_ConcurrentlyDeserializedComponents.GetCount() - range.m_uiFirstComponent;
+  }
+
+  if (typeRanges.IsEmpty())
+    return;
+
+  m_ConcurrentDeserializationGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+  for (const TypeRange& range : typeRanges)
+  {
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "DeserializeComponents", ezTaskNesting::Never, [this, range]()
+      { DeserializeComponentsConcurrently(range.m_uiComponentTypeIdx, range.m_uiFirstComponent, range.m_uiNumComponents); });
+
+    ezTaskSystem::AddTaskToGroup(m_ConcurrentDeserializationGroup, pTask);
+  }
+
+  ezTaskSystem::StartTaskGroup(m_ConcurrentDeserializationGroup);
+
+  m_uiCurrentNumComponentsProcessed += m_ConcurrentlyDeserializedComponents.GetCount();
+}
+
+void ezWorldReader::InstantiationContext::DeserializeComponentsConcurrently(ezUInt32 uiComponentTypeIdx, ezUInt32 uiFirstComponent, ezUInt32 uiNumComponents)
+{
+  EZ_PROFILE_SCOPE(m_WorldReader.m_ComponentTypes[uiComponentTypeIdx].m_pRtti->GetTypeName());
+
+  ezMemoryStreamReader reader(&m_WorldReader.GetComponentDataStorage());
+  reader.SetReadPosition(m_WorldReader.m_ComponentTypes[uiComponentTypeIdx].m_uiDataStreamOffset);
+
+  // the calling thread may execute one of the tasks while it waits, in which case it has to restore its own state afterwards
+  const ThreadStream prevThreadStream = s_ThreadStream;
+  s_ThreadStream.m_pReader = &m_WorldReader;
+  s_ThreadStream.m_pStream = &reader;
+
+  // the same goes for the string deduplication context, which may belong to another world reader
+  ezStringDeduplicationReadContext* pPrevStringDedupContext = ezStringDeduplicationReadContext::SwapActiveContext(m_WorldReader.m_pStringDedupReadContext.Borrow());
+
+  for (ezComponent* pComponent : m_ConcurrentlyDeserializedComponents.GetArrayPtr().GetSubArray(uiFirstComponent, uiNumComponents))
+  {
+    pComponent->DeserializeComponent(m_WorldReader);
+  }
+
+  ezStringDeduplicationReadContext::SwapActiveContext(pPrevStringDedupContext);
+  s_ThreadStream = prevThreadStream;
+}
+
+void ezWorldReader::InstantiationContext::WaitForConcurrentDeserialization()
+{
+  if (m_ConcurrentDeserializationGroup.IsValid())
+  {
+    ezTaskSystem::WaitForGroup(m_ConcurrentDeserializationGroup);
+    m_ConcurrentDeserializationGroup.Invalidate();
+  }
+}
+
 bool ezWorldReader::InstantiationContext::AddComponentsToBatch(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::AddComponentsToBatch");
@@ -785,3 +1203,5 @@ void ezWorldReader::InstantiationContext::SetSubProgressCompletion(double fCompl
     m_pSubProgressRange->SetCompletion(fCompletion);
   }
 }
+
+EZ_STATICLINK_FILE(Core, Core_WorldSerializer_Implementation_WorldReader);
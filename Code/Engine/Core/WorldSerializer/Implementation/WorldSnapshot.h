@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Foundation/Math/Quat.h>
+#include <Foundation/Math/Vec3.h>
+
+/// The binary layout of a baked world snapshot, as written by ezWorldWriter::WriteWorldSnapshot() and read by ezWorldReader::ReadWorldSnapshot().
+///
+/// A snapshot is a single memory image that doesn't contain any pointers. All references are either indices or byte offsets from the start
+/// of the snapshot, so it can be used directly from a memory mapped file. Every section starts at an offset that is a multiple of
+/// WorldSnapshotHeader::SectionAlignment. Layout:
+///
+///   WorldSnapshotHeader
+///   WorldSnapshotString[m_uiNumStrings]             offset and length of every string in the string data
+///   char[m_uiStringDataSize]                        all strings, each one null-terminated
+///   WorldSnapshotObject[m_uiNumRootObjects + m_uiNumChildObjects]   root objects first, parents always come before their children
+///   ezUInt32[m_uiNumTagReferences]                  string indices of the tags of all objects
+///   WorldSnapshotComponentType[m_uiNumComponentTypes]
+///   ezUInt8[m_uiCreationDataSize]                   per type: owner index, component index, active flag and user flags of every component
+///   ezUInt8[m_uiComponentDataSize]                  per type: the data of all components, as written by ezComponent::SerializeComponent()
+///
+/// Strings in the component data are written as indices into the string table.
+namespace ezInternal
+{
+  struct WorldSnapshotHeader
+  {
+    static constexpr ezUInt32 Magic = 0x53575A45; // 'EZWS'
+    static constexpr ezUInt32 Version = 1;
+    static constexpr ezUInt32 SectionAlignment = 16;
+
+    ezUInt32 m_uiMagic;
+    ezUInt32 m_uiVersion;
+    ezUInt32 m_uiTotalSize;
+
+    ezUInt32 m_uiNumRootObjects;
+    ezUInt32 m_uiNumChildObjects;
+    ezUInt32 m_uiNumComponentTypes;
+    ezUInt32 m_uiNumStrings;
+    ezUInt32 m_uiNumTagReferences;
+
+    ezUInt32 m_uiStringsOffset;
+    ezUInt32 m_uiStringDataOffset;
+    ezUInt32 m_uiStringDataSize;
+    ezUInt32 m_uiObjectsOffset;
+    ezUInt32 m_uiTagsOffset;
+    ezUInt32 m_uiComponentTypesOffset;
+    ezUInt32 m_uiCreationDataOffset;
+    ezUInt32 m_uiCreationDataSize;
+    ezUInt32 m_uiComponentDataOffset;
+    ezUInt32 m_uiComponentDataSize;
+  };
+
+  static_assert(sizeof(WorldSnapshotHeader) == 72);
+
+  struct WorldSnapshotString
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOffset; ///< Relative to the start of the string data.
+    ezUInt32 m_uiLength; ///< In bytes, without the terminator.
+  };
+
+  static_assert(sizeof(WorldSnapshotString) == 8);
+
+  struct WorldSnapshotObject
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    enum Flags : ezUInt8
+    {
+      Active = EZ_BIT(0),
+      Dynamic = EZ_BIT(1),
+    };
+
+    ezVec3 m_vLocalPosition;
+    ezQuat m_qLocalRotation;
+    ezVec3 m_vLocalScaling;
+    float m_fLocalUniformScaling;
+
+    ezUInt32 m_uiParentIndex; ///< 1-based object index, 0 for root objects.
+    ezUInt32 m_uiName;        ///< String index.
+    ezUInt32 m_uiGlobalKey;   ///< String index.
+    ezUInt32 m_uiFirstTag;    ///< Index into the tag references.
+    ezUInt32 m_uiNumTags;
+    ezUInt32 m_uiStableRandomSeed;
+    ezUInt16 m_uiTeamID;
+    ezUInt8 m_uiFlags;
+    ezUInt8 m_uiPadding;
+  };
+
+  static_assert(sizeof(WorldSnapshotObject) == 72);
+
+  struct WorldSnapshotComponentType
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiTypeName; ///< String index.
+    ezUInt32 m_uiTypeVersion;
+    ezUInt32 m_uiNumComponents;
+    ezUInt32 m_uiCreationDataOffset;  ///< Relative to the start of the creation data.
+    ezUInt32 m_uiComponentDataOffset; ///< Relative to the start of the component data.
+  };
+
+  static_assert(sizeof(WorldSnapshotComponentType) == 20);
+
+  /// \brief Size of the creation data of a single component in a snapshot.
+  static constexpr ezUInt32 WorldSnapshotComponentCreationDataSize = sizeof(ezUInt32) + sizeof(ezUInt32) + sizeof(ezUInt8) + sizeof(ezUInt8);
+} // namespace ezInternal
@@ -1,5 +1,6 @@
 #include <Core/CorePCH.h>
 
+#include <Core/WorldSerializer/Implementation/WorldSnapshot.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
@@ -34,6 +35,20 @@ void ezWorldWriter::WriteWorld(ezStreamWriter& inout_stream, ezWorld& ref_world,
   WriteToStream().IgnoreResult();
 }
 
+void ezWorldWriter::WriteWorldSnapshot(ezStreamWriter& inout_stream, ezWorld& ref_world, const ezTagSet* pExclude)
+{
+  Clear();
+
+  m_pStream = &inout_stream;
+  m_pExclude = pExclude;
+
+  EZ_LOCK(ref_world.GetReadMarker());
+
+  ref_world.Traverse(ezMakeDelegate(&ezWorldWriter::ObjectTraverser, this), ezWorld::TraversalMethod::DepthFirst);
+
+  WriteSnapshotToStream().IgnoreResult();
+}
+
 void ezWorldWriter::WriteObjects(ezStreamWriter& inout_stream, const ezDeque<const ezGameObject*>& rootObjects)
 {
   Clear();
@@ -125,6 +140,192 @@ ezResult ezWorldWriter::WriteToStream()
   return EZ_SUCCESS;
 }
 
+ezResult ezWorldWriter::WriteSnapshotToStream()
+{
+  using namespace ezInternal;
+
+  ezStreamWriter& stream = *m_pStream;
+
+  // collects all strings, including the ones that components write during serialization
+  ezStringDeduplicationWriteContext stringDedupWriteContext(stream);
+
+  IncludeAllComponentBaseTypes();
+
+  // this is used to sort all component types by name, to make the file serialization deterministic
+  ezMap<ezString, const ezRTTI*> sortedTypes;
+
+  for (auto it = m_AllComponents.GetIterator(); it.IsValid(); ++it)
+  {
+    sortedTypes[it.Key()->GetTypeName()] = it.Key();
+  }
+
+  AssignGameObjectIndices();
+  AssignComponentHandleIndices(sortedTypes);
+
+  ezDynamicArray<WorldSnapshotObject> objects;
+  objects.Reserve(m_AllRootObjects.GetCount() + m_AllChildObjects.GetCount());
+
+  ezDynamicArray<ezUInt32> tags;
+
+  auto AddObject = [&](const ezGameObject* pObject)
+  {
+    WorldSnapshotObject& object = objects.ExpandAndGetRef();
+    object.m_vLocalPosition = pObject->GetLocalPosition();
+    object.m_qLocalRotation = pObject->GetLocalRotation();
+    object.m_vLocalScaling = pObject->GetLocalScaling();
+    object.m_fLocalUniformScaling = pObject->GetLocalUniformScaling();
+    object.m_uiParentIndex = pObject->GetParent() ? m_WrittenGameObjectHandles.GetValueOrDefault(pObject->GetParent()->GetHandle(), 0) : 0;
+    object.m_uiName = stringDedupWriteContext.DeduplicateString(pObject->GetName());
+    object.m_uiGlobalKey = stringDedupWriteContext.DeduplicateString(pObject->GetGlobalKey());
+    object.m_uiFirstTag = tags.GetCount();
+
+    for (const ezTag& tag : pObject->GetTags())
+    {
+      tags.PushBack(stringDedupWriteContext.DeduplicateString(tag.GetTagString()));
+    }
+
+    object.m_uiNumTags = tags.GetCount() - object.m_uiFirstTag;
+    object.m_uiStableRandomSeed = pObject->GetStableRandomSeed();
+    object.m_uiTeamID = pObject->GetTeamID();
+    object.m_uiFlags = (pObject->GetActiveFlag() ? WorldSnapshotObject::Active : 0) | (pObject->IsDynamic() ? WorldSnapshotObject::Dynamic : 0);
+    object.m_uiPadding = 0;
+  };
+
+  for (const auto* pObject : m_AllRootObjects)
+  {
+    AddObject(pObject);
+  }
+
+  for (const auto* pObject : m_AllChildObjects)
+  {
+    AddObject(pObject);
+  }
+
+  ezDynamicArray<WorldSnapshotComponentType> componentTypes;
+  componentTypes.Reserve(sortedTypes.GetCount());
+
+  ezDefaultMemoryStreamStorage creationStorage;
+  ezMemoryStreamWriter creationWriter(&creationStorage);
+
+  ezDefaultMemoryStreamStorage dataStorage;
+  ezMemoryStreamWriter dataWriter(&dataStorage);
+
+  for (auto it = sortedTypes.GetIterator(); it.IsValid(); ++it)
+  {
+    const auto& components = m_AllComponents[it.Value()].m_Components;
+
+    WorldSnapshotComponentType& componentType = componentTypes.ExpandAndGetRef();
+    componentType.m_uiTypeName = stringDedupWriteContext.DeduplicateString(it.Value()->GetTypeName());
+    componentType.m_uiTypeVersion = it.Value()->GetTypeVersion();
+    componentType.m_uiNumComponents = components.GetCount();
+    componentType.m_uiCreationDataOffset = creationStorage.GetStorageSize32();
+    componentType.m_uiComponentDataOffset = dataStorage.GetStorageSize32();
+
+    m_pStream = &creationWriter;
+    WriteComponentCreationRecords(components);
+
+    m_pStream = &dataWriter;
+    for (auto pComp : components)
+    {
+      pComp->SerializeComponent(*this);
+    }
+  }
+
+  m_pStream = &stream;
+
+  ezDynamicArray<ezStringView> strings;
+  stringDedupWriteContext.GetUniqueStrings(strings);
+
+  ezDynamicArray<WorldSnapshotString> stringEntries;
+  stringEntries.SetCountUninitialized(strings.GetCount());
+
+  ezUInt64 uiStringDataSize = 0;
+  for (ezUInt32 i = 0; i < strings.GetCount(); ++i)
+  {
+    stringEntries[i].m_uiOffset = static_cast<ezUInt32>(uiStringDataSize);
+    stringEntries[i].m_uiLength = strings[i].GetElementCount();
+    uiStringDataSize += strings[i].GetElementCount() + 1;
+  }
+
+  // compute the layout
+  WorldSnapshotHeader header = {};
+  header.m_uiMagic = WorldSnapshotHeader::Magic;
+  header.m_uiVersion = WorldSnapshotHeader::Version;
+  header.m_uiNumRootObjects = m_AllRootObjects.GetCount();
+  header.m_uiNumChildObjects = m_AllChildObjects.GetCount();
+  header.m_uiNumComponentTypes = componentTypes.GetCount();
+  header.m_uiNumStrings = stringEntries.GetCount();
+  header.m_uiNumTagReferences = tags.GetCount();
+
+  ezUInt64 uiSize = sizeof(WorldSnapshotHeader);
+  auto AddSection = [&](ezUInt64 uiSectionSize) -> ezUInt32
+  {
+    uiSize = ezMemoryUtils::AlignSize<ezUInt64>(uiSize, WorldSnapshotHeader::SectionAlignment);
+    const ezUInt64 uiSectionOffset = uiSize;
+    uiSize += uiSectionSize;
+    return static_cast<ezUInt32>(uiSectionOffset);
+  };
+
+  header.m_uiStringsOffset = AddSection(stringEntries.GetArrayPtr().ToByteArray().GetCount());
+  header.m_uiStringDataOffset = AddSection(uiStringDataSize);
+  header.m_uiObjectsOffset = AddSection(objects.GetArrayPtr().ToByteArray().GetCount());
+  header.m_uiTagsOffset = AddSection(tags.GetArrayPtr().ToByteArray().GetCount());
+  header.m_uiComponentTypesOffset = AddSection(componentTypes.GetArrayPtr().ToByteArray().GetCount());
+  header.m_uiCreationDataOffset = AddSection(creationStorage.GetStorageSize64());
+  header.m_uiComponentDataOffset = AddSection(dataStorage.GetStorageSize64());
+
+  EZ_ASSERT_ALWAYS(uiSize <= ezMath::MaxValue<ezUInt32>(), "World snapshots are limited to 4GB.");
+
+  header.m_uiStringDataSize = static_cast<ezUInt32>(uiStringDataSize);
+  header.m_uiCreationDataSize = creationStorage.GetStorageSize32();
+  header.m_uiComponentDataSize = dataStorage.GetStorageSize32();
+  header.m_uiTotalSize = static_cast<ezUInt32>(uiSize);
+
+  // write the sections
+  ezUInt64 uiWritten = 0;
+  auto PadTo = [&](ezUInt32 uiSectionOffset) -> ezResult
+  {
+    static constexpr ezUInt8 padding[WorldSnapshotHeader::SectionAlignment] = {};
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(padding, uiSectionOffset - uiWritten));
+    uiWritten = uiSectionOffset;
+    return EZ_SUCCESS;
+  };
+
+  auto WriteSection = [&](ezUInt32 uiSectionOffset, ezArrayPtr<const ezUInt8> data) -> ezResult
+  {
+    EZ_SUCCEED_OR_RETURN(PadTo(uiSectionOffset));
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(data.GetPtr(), data.GetCount()));
+    uiWritten += data.GetCount();
+    return EZ_SUCCESS;
+  };
+
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(&header, sizeof(WorldSnapshotHeader)));
+  uiWritten = sizeof(WorldSnapshotHeader);
+
+  EZ_SUCCEED_OR_RETURN(WriteSection(header.m_uiStringsOffset, stringEntries.GetArrayPtr().ToByteArray()));
+
+  EZ_SUCCEED_OR_RETURN(PadTo(header.m_uiStringDataOffset));
+  for (ezStringView sString : strings)
+  {
+    const char terminator = '\0';
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(sString.GetStartPointer(), sString.GetElementCount()));
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(&terminator, 1));
+  }
+  uiWritten += uiStringDataSize;
+
+  EZ_SUCCEED_OR_RETURN(WriteSection(header.m_uiObjectsOffset, objects.GetArrayPtr().ToByteArray()));
+  EZ_SUCCEED_OR_RETURN(WriteSection(header.m_uiTagsOffset, tags.GetArrayPtr().ToByteArray()));
+  EZ_SUCCEED_OR_RETURN(WriteSection(header.m_uiComponentTypesOffset, componentTypes.GetArrayPtr().ToByteArray()));
+
+  EZ_SUCCEED_OR_RETURN(PadTo(header.m_uiCreationDataOffset));
+  EZ_SUCCEED_OR_RETURN(creationStorage.CopyToStream(stream));
+  uiWritten += creationStorage.GetStorageSize64();
+
+  EZ_SUCCEED_OR_RETURN(PadTo(header.m_uiComponentDataOffset));
+  EZ_SUCCEED_OR_RETURN(dataStorage.CopyToStream(stream));
+
+  return EZ_SUCCESS;
+}
 
 void ezWorldWriter::AssignGameObjectIndices()
 {
@@ -311,29 +512,9 @@ void ezWorldWriter::WriteComponentCreationData(const ezDeque<const ezComponent*>
 
   // write to memory stream
   {
-    ezStreamWriter& s = *m_pStream;
-    s << components.GetCount();
-
-    ezUInt32 uiComponentIndex = 1;
-    for (auto pComponent : components)
-    {
-      WriteGameObjectHandle(pComponent->GetOwner()->GetHandle());
-      s << uiComponentIndex;
-      ++uiComponentIndex;
-
-      s << pComponent->GetActiveFlag();
+    *m_pStream << components.GetCount();
 
-      // version 7
-      {
-        ezUInt8 userFlags = 0;
-        for (ezUInt8 i = 0; i < 8; ++i)
-        {
-          userFlags |= pComponent->GetUserFlag(i) ? EZ_BIT(i) : 0;
-        }
-
-        s << userFlags;
-      }
-    }
+    WriteComponentCreationRecords(components);
   }
 
   m_pStream = pPrevStream;
@@ -349,6 +530,32 @@ void ezWorldWriter::WriteComponentCreationData(const ezDeque<const ezComponent*>
   }
 }
 
+void ezWorldWriter::WriteComponentCreationRecords(const ezDeque<const ezComponent*>& components)
+{
+  ezStreamWriter& s = *m_pStream;
+
+  ezUInt32 uiComponentIndex = 1;
+  for (auto pComponent : components)
+  {
+    WriteGameObjectHandle(pComponent->GetOwner()->GetHandle());
+    s << uiComponentIndex;
+    ++uiComponentIndex;
+
+    s << pComponent->GetActiveFlag();
+
+    // version 7
+    {
+      ezUInt8 userFlags = 0;
+      for (ezUInt8 i = 0; i < 8; ++i)
+      {
+        userFlags |= pComponent->GetUserFlag(i) ? EZ_BIT(i) : 0;
+      }
+
+      s << userFlags;
+    }
+  }
+}
+
 void ezWorldWriter::WriteComponentSerializationData(const ezDeque<const ezComponent*>& components)
 {
   ezDefaultMemoryStreamStorage storage;
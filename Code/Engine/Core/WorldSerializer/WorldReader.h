@@ -3,6 +3,7 @@
 #include <Core/World/World.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -39,6 +40,20 @@ struct ezPrefabInstantiationOptions
   ezProgress* m_pProgress = nullptr;
 };
 
+/// \brief Add this attribute to a component type to allow ezWorldReader to deserialize all components of that type on a worker thread.
+///
+/// This is only allowed if the component's DeserializeComponent() function reads from the given ezWorldReader and writes to the component itself,
+/// but does not touch the world, its owner or any other object or component (other than through thread-safe systems, such as the resource manager).
+/// Components of all such types are deserialized concurrently, while the components of all other types are deserialized on the calling thread.
+/// This only happens when a world or prefab is instantiated in one go, ie. without a max step time.
+/// The cvar 'World.ConcurrentDeserialization' allows to disable this.
+///
+/// The attribute is not inherited, so every derived component type has to opt in separately.
+class EZ_CORE_DLL ezConcurrentDeserializationAttribute : public ezPropertyAttribute
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezConcurrentDeserializationAttribute, ezPropertyAttribute);
+};
+
 /// \brief Reads a world description from a stream. Allows to instantiate that world multiple times
 ///        in different locations and different ezWorld's.
 ///
@@ -84,6 +99,17 @@ public:
   /// types. The warnings can be suppressed by setting warningOnUnkownSkip to false.
   ezResult ReadWorldDescription(ezStreamReader& inout_stream, bool bWarningOnUnkownSkip = true);
 
+  /// \brief Reads a world snapshot that was written by ezWorldWriter::WriteWorldSnapshot().
+  ///
+  /// This is an alternative to ReadWorldDescription(), afterwards the world can be instantiated in the same way.
+  /// The snapshot is not parsed or copied. After validating it, a single fixup pass prepares the game object descriptions,
+  /// resolves the component types and tags and sets up a string table that references the strings in place.
+  /// During instantiation, the components are created and deserialized directly from the snapshot memory.
+  ///
+  /// Therefore \a snapshot must stay valid and unchanged as long as this reader is used, e.g. the ezMemoryMappedFile that it comes from must stay open,
+  /// until ClearAndCompact() is called or another world is read.
+  ezResult ReadWorldSnapshot(ezArrayPtr<const ezUInt8> snapshot);
+
   /// \brief Creates one instance of the world that was previously read by ReadWorldDescription().
   ///
   /// This is identical to calling InstantiatePrefab() with identity values, however, it is a bit
@@ -118,7 +144,9 @@ public:
   ezUniquePtr<InstantiationContextBase> InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
-  ezStreamReader& GetStream() const { return *m_pStream; }
+  ///
+  /// While components are deserialized concurrently (see ezConcurrentDeserializationAttribute), every worker thread gets its own stream.
+  ezStreamReader& GetStream() const;
 
   /// \brief Used during component deserialization to read a handle to a game object.
   ezGameObjectHandle ReadGameObjectHandle();
@@ -168,6 +196,7 @@ private:
 
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
+  void InitComponentTypeInfo(ezUInt32 uiComponentTypeIdx, ezStringView sTypeName, ezUInt32 uiTypeVersion);
   void ReadComponentDataToMemStream(bool warningOnUnknownSkip = true);
   void ClearHandles();
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
@@ -186,6 +215,9 @@ private:
     const ezRTTI* m_pRtti = nullptr;
     ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
     ezUInt32 m_uiNumComponents = 0;
+    ezUInt64 m_uiCreationStreamOffset = 0;
+    ezUInt64 m_uiDataStreamOffset = 0;
+    bool m_bConcurrentDeserialization = false;
   };
 
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
@@ -196,6 +228,26 @@ private:
 
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
+  /// \brief Adapts a piece of snapshot memory to ezMemoryStreamContainerWrapperStorage.
+  struct SnapshotData
+  {
+    const ezUInt8* GetData() const { return m_Data.GetPtr(); }
+    ezUInt32 GetCount() const { return m_Data.GetCount(); }
+    ezUInt64 GetHeapMemoryUsage() const { return 0; }
+
+    ezArrayPtr<const ezUInt8> m_Data;
+  };
+
+  const ezMemoryStreamStorageInterface& GetComponentCreationStorage() const;
+  const ezMemoryStreamStorageInterface& GetComponentDataStorage() const;
+
+  bool m_bReadFromSnapshot = false;
+  SnapshotData m_SnapshotCreationData;
+  SnapshotData m_SnapshotComponentData;
+  ezMemoryStreamContainerWrapperStorage<const SnapshotData> m_SnapshotCreationStorage{&m_SnapshotCreationData};
+  ezMemoryStreamContainerWrapperStorage<const SnapshotData> m_SnapshotComponentStorage{&m_SnapshotComponentData};
+  ezDynamicArray<ezStringView> m_SnapshotStrings;
+
   class InstantiationContext : public InstantiationContextBase
   {
   public:
@@ -210,6 +262,9 @@ private:
 
     bool CreateComponents(ezTime endTime);
     bool DeserializeComponents(ezTime endTime);
+    void StartConcurrentDeserialization();
+    void DeserializeComponentsConcurrently(ezUInt32 uiComponentTypeIdx, ezUInt32 uiFirstComponent, ezUInt32 uiNumComponents);
+    void WaitForConcurrentDeserialization();
     bool AddComponentsToBatch(ezTime endTime);
 
     void SetMaxStepTime(ezTime stepTime);
@@ -252,6 +307,11 @@ private:
     ezUInt64 m_uiCurrentNumComponentsProcessed = 0;
     ezMemoryStreamReader m_CurrentReader;
 
+    bool m_bConcurrentDeserializationStarted = false;
+    bool m_bConcurrentDeserializationEnabled = false;
+    ezTaskGroupID m_ConcurrentDeserializationGroup;
+    ezDynamicArray<ezComponent*> m_ConcurrentlyDeserializedComponents;
+
     ezUniquePtr<ezProgressRange> m_pOverallProgressRange;
     ezUniquePtr<ezProgressRange> m_pSubProgressRange;
   };
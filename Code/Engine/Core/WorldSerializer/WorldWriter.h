@@ -17,6 +17,16 @@ public:
   /// All game objects with tags that overlap with \a pExclude will be ignored.
   void WriteWorld(ezStreamWriter& inout_stream, ezWorld& ref_world, const ezTagSet* pExclude = nullptr);
 
+  /// \brief Writes all content in \a world to \a stream as a baked snapshot, which ezWorldReader::ReadWorldSnapshot() can load in place.
+  ///
+  /// The snapshot stores the same information as WriteWorld(), but as one relocatable memory image: game objects and their transforms are
+  /// stored in a fixed-layout array, the components as one block of data per component type and all strings in a single table.
+  /// The image doesn't contain any pointers, so it can be used directly from a memory mapped file.
+  /// This is meant for worlds that need to be loaded very quickly and repeatedly, e.g. for server restarts.
+  ///
+  /// All game objects with tags that overlap with \a pExclude will be ignored.
+  void WriteWorldSnapshot(ezStreamWriter& inout_stream, ezWorld& ref_world, const ezTagSet* pExclude = nullptr);
+
   /// \brief Only writes the given root objects and all their children to the stream.
   void WriteObjects(ezStreamWriter& inout_stream, const ezDeque<const ezGameObject*>& rootObjects);
 
@@ -48,6 +58,7 @@ public:
 private:
   void Clear();
   ezResult WriteToStream();
+  ezResult WriteSnapshotToStream();
   void AssignGameObjectIndices();
   void AssignComponentHandleIndices(const ezMap<ezString, const ezRTTI*>& sortedTypes);
   void IncludeAllComponentBaseTypes();
@@ -58,6 +69,7 @@ private:
   void WriteGameObject(const ezGameObject* pObject);
   void WriteComponentTypeInfo(const ezRTTI* pRtti);
   void WriteComponentCreationData(const ezDeque<const ezComponent*>& components);
+  void WriteComponentCreationRecords(const ezDeque<const ezComponent*>& components);
   void WriteComponentSerializationData(const ezDeque<const ezComponent*>& components);
 
   ezStreamWriter* m_pStream = nullptr;
@@ -0,0 +1,24 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+// static
+void ezSorting::RadixSortForEachChunk(ezUInt32 uiNumChunks, RadixSortChunkFunc func, void* pUserData)
+{
+  if (uiNumChunks == 1)
+  {
+    func(pUserData, 0);
+    return;
+  }
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumChunks, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 uiChunk = uiStartIndex; uiChunk < uiEndIndex; ++uiChunk)
+      {
+        func(pUserData, uiChunk);
+      }
+    },
+    "RadixSort");
+}
@@ -270,3 +270,131 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& inout_arrayPtr, ezUInt32 uiStartInd
     }
   }
 }
+
+template <typename T, typename KeyFunc>
+void ezSorting::RadixSort(ezArrayPtr<T> inout_arrayPtr, ezArrayPtr<T> inout_scratch, const KeyFunc& getKey)
+{
+  const ezUInt32 uiCount = inout_arrayPtr.GetCount();
+  EZ_ASSERT_DEV(inout_scratch.GetCount() >= uiCount, "The scratch array is too small, it needs at least {} elements", uiCount);
+
+  if (uiCount <= INSERTION_THRESHOLD)
+  {
+    InsertionSort(inout_arrayPtr, [&](const T& a, const T& b)
+      { return getKey(a) < getKey(b); });
+    return;
+  }
+
+  struct State
+  {
+    const KeyFunc* m_pGetKey;
+    T* m_pSource;
+    T* m_pTarget;
+    ezUInt32 m_uiCount;
+    ezUInt32 m_uiNumChunks;
+    ezUInt32 m_uiShift;
+
+    ezUInt64 m_ChunkAnd[RADIX_MAX_CHUNKS];
+    ezUInt64 m_ChunkOr[RADIX_MAX_CHUNKS];
+    ezUInt32 m_ChunkOffsets[RADIX_MAX_CHUNKS][256];
+
+    EZ_ALWAYS_INLINE ezUInt32 GetChunkStart(ezUInt32 uiChunk) const { return static_cast<ezUInt32>((ezUInt64)uiChunk * m_uiCount / m_uiNumChunks); }
+  };
+
+  State state;
+  state.m_pGetKey = &getKey;
+  state.m_pSource = inout_arrayPtr.GetPtr();
+  state.m_pTarget = inout_scratch.GetPtr();
+  state.m_uiCount = uiCount;
+  state.m_uiNumChunks = ezMath::Clamp<ezUInt32>(uiCount / RADIX_CHUNK_SIZE, 1, RADIX_MAX_CHUNKS);
+  state.m_uiShift = 0;
+
+  // find out which bytes actually differ between the keys, all others don't need a pass
+  RadixSortForEachChunk(state.m_uiNumChunks, [](void* pUserData, ezUInt32 uiChunk)
+    {
+      State& s = *static_cast<State*>(pUserData);
+
+      ezUInt64 uiAnd = 0xFFFFFFFFFFFFFFFFull;
+      ezUInt64 uiOr = 0;
+      for (ezUInt32 i = s.GetChunkStart(uiChunk), uiEnd = s.GetChunkStart(uiChunk + 1); i < uiEnd; ++i)
+      {
+        const ezUInt64 uiKey = (*s.m_pGetKey)(s.m_pSource[i]);
+        uiAnd &= uiKey;
+        uiOr |= uiKey;
+      }
+
+      s.m_ChunkAnd[uiChunk] = uiAnd;
+      s.m_ChunkOr[uiChunk] = uiOr;
+    },
+    &state);
+
+  ezUInt64 uiAnd = 0xFFFFFFFFFFFFFFFFull;
+  ezUInt64 uiOr = 0;
+  for (ezUInt32 uiChunk = 0; uiChunk < state.m_uiNumChunks; ++uiChunk)
+  {
+    uiAnd &= state.m_ChunkAnd[uiChunk];
+    uiOr |= state.m_ChunkOr[uiChunk];
+  }
+
+  const ezUInt64 uiDifferentBits = uiAnd ^ uiOr;
+
+  for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 8)
+  {
+    if (((uiDifferentBits >> uiShift) & 0xFF) == 0)
+      continue;
+
+    state.m_uiShift = uiShift;
+
+    // count the digits per chunk
+    RadixSortForEachChunk(state.m_uiNumChunks, [](void* pUserData, ezUInt32 uiChunk)
+      {
+        State& s = *static_cast<State*>(pUserData);
+
+        ezUInt32* pCounts = s.m_ChunkOffsets[uiChunk];
+        ezMemoryUtils::ZeroFill(pCounts, 256);
+
+        for (ezUInt32 i = s.GetChunkStart(uiChunk), uiEnd = s.GetChunkStart(uiChunk + 1); i < uiEnd; ++i)
+        {
+          ++pCounts[((*s.m_pGetKey)(s.m_pSource[i]) >> s.m_uiShift) & 0xFF];
+        }
+      },
+      &state);
+
+    // turn the counts into the target offsets, chunks with the same digit are placed in order to keep the sort stable
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 uiDigit = 0; uiDigit < 256; ++uiDigit)
+    {
+      for (ezUInt32 uiChunk = 0; uiChunk < state.m_uiNumChunks; ++uiChunk)
+      {
+        const ezUInt32 uiDigitCount = state.m_ChunkOffsets[uiChunk][uiDigit];
+        state.m_ChunkOffsets[uiChunk][uiDigit] = uiOffset;
+        uiOffset += uiDigitCount;
+      }
+    }
+
+    RadixSortForEachChunk(state.m_uiNumChunks, [](void* pUserData, ezUInt32 uiChunk)
+      {
+        State& s = *static_cast<State*>(pUserData);
+
+        ezUInt32* pOffsets = s.m_ChunkOffsets[uiChunk];
+
+        for (ezUInt32 i = s.GetChunkStart(uiChunk), uiEnd = s.GetChunkStart(uiChunk + 1); i < uiEnd; ++i)
+        {
+          const ezUInt32 uiDigit = ((*s.m_pGetKey)(s.m_pSource[i]) >> s.m_uiShift) & 0xFF;
+          s.m_pTarget[pOffsets[uiDigit]++] = std::move(s.m_pSource[i]);
+        }
+      },
+      &state);
+
+    ezMath::Swap(state.m_pSource, state.m_pTarget);
+  }
+
+  // after an odd number of passes the sorted elements are in the scratch array
+  if (state.m_pSource != inout_arrayPtr.GetPtr())
+  {
+    T* pTarget = inout_arrayPtr.GetPtr();
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      pTarget[i] = std::move(state.m_pSource[i]);
+    }
+  }
+}
@@ -8,7 +8,7 @@
 #include <Foundation/Types/ArrayPtr.h>
 
 /// \brief This class provides implementations of different sorting algorithms.
-class ezSorting
+class EZ_FOUNDATION_DLL ezSorting
 {
 public:
   /// \brief Sorts the elements in container using a in-place quick sort implementation (not stable).
@@ -28,12 +28,28 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& inout_arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+
+  /// \brief Sorts the elements in the array by a 64 bit key using a LSD radix sort (stable, not in-place).
+  ///
+  /// getKey(const T&) has to return the ezUInt64 key of an element. The scratch array must be at least as large as the array to sort
+  /// and is used as temporary storage. Bytes that are the same in all keys are skipped entirely.
+  /// Large arrays are split into chunks which are counted and scattered in parallel on the task system.
+  template <typename T, typename KeyFunc>
+  static void RadixSort(ezArrayPtr<T> inout_arrayPtr, ezArrayPtr<T> inout_scratch, const KeyFunc& getKey); // [tested]
+
 private:
   enum
   {
-    INSERTION_THRESHOLD = 16
+    INSERTION_THRESHOLD = 16,
+    RADIX_CHUNK_SIZE = 16 * 1024,
+    RADIX_MAX_CHUNKS = 16,
   };
 
+  using RadixSortChunkFunc = void (*)(void* pUserData, ezUInt32 uiChunk);
+
+  /// \brief Calls func for every chunk. Runs on the task system if there is more than one chunk.
+  static void RadixSortForEachChunk(ezUInt32 uiNumChunks, RadixSortChunkFunc func, void* pUserData);
+
   // Perform comparison either with "Less(a,b)" (prefered) or with operator ()(a,b)
   template <typename Element, typename Comparer>
   EZ_ALWAYS_INLINE constexpr static auto DoCompare(const Comparer& comparer, const Element& a, const Element& b, int) -> decltype(comparer.Less(a, b))
@@ -0,0 +1,21 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+namespace
+{
+  ezAtomicInteger32 s_iNextStagingSlot;
+  thread_local ezUInt32 tl_uiStagingSlot = ezInvalidIndex;
+} // namespace
+
+// static
+ezUInt32 ezMessageQueueStaging::GetCurrentThreadSlot()
+{
+  if (tl_uiStagingSlot == ezInvalidIndex)
+  {
+    tl_uiStagingSlot = static_cast<ezUInt32>(s_iNextStagingSlot.PostIncrement()) % SlotCount;
+  }
+
+  return tl_uiStagingSlot;
+}
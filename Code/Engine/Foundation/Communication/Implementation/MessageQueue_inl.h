@@ -1,17 +1,25 @@
 
 template <typename MetaDataType>
 ezMessageQueueBase<MetaDataType>::ezMessageQueueBase(ezAllocator* pAllocator)
-  : m_Queue(pAllocator)
+  : ezMessageQueueBase(pAllocator, std::make_index_sequence<ezMessageQueueStaging::SlotCount>())
 {
 }
 
 template <typename MetaDataType>
 ezMessageQueueBase<MetaDataType>::ezMessageQueueBase(const ezMessageQueueBase& rhs, ezAllocator* pAllocator)
-  : m_Queue(pAllocator)
+  : ezMessageQueueBase(pAllocator, std::make_index_sequence<ezMessageQueueStaging::SlotCount>())
 {
   m_Queue = rhs.m_Queue;
 }
 
+template <typename MetaDataType>
+template <size_t... SlotIndices>
+ezMessageQueueBase<MetaDataType>::ezMessageQueueBase(ezAllocator* pAllocator, std::index_sequence<SlotIndices...>)
+  : m_Queue(pAllocator)
+  , m_StagingSlots{StagingSlot((static_cast<void>(SlotIndices), pAllocator))...}
+{
+}
+
 template <typename MetaDataType>
 ezMessageQueueBase<MetaDataType>::~ezMessageQueueBase()
 {
@@ -21,6 +29,7 @@ ezMessageQueueBase<MetaDataType>::~ezMessageQueueBase()
 template <typename MetaDataType>
 void ezMessageQueueBase<MetaDataType>::operator=(const ezMessageQueueBase& rhs)
 {
+  ClearStaged();
   m_Queue = rhs.m_Queue;
 }
 
@@ -51,9 +60,20 @@ EZ_ALWAYS_INLINE bool ezMessageQueueBase<MetaDataType>::IsEmpty() const
 template <typename MetaDataType>
 void ezMessageQueueBase<MetaDataType>::Clear()
 {
+  ClearStaged();
   m_Queue.Clear();
 }
 
+template <typename MetaDataType>
+void ezMessageQueueBase<MetaDataType>::ClearStaged()
+{
+  for (StagingSlot& slot : m_StagingSlots)
+  {
+    EZ_LOCK(slot.m_Mutex);
+    slot.m_Entries.Clear();
+  }
+}
+
 template <typename MetaDataType>
 EZ_ALWAYS_INLINE void ezMessageQueueBase<MetaDataType>::Reserve(ezUInt32 uiCount)
 {
@@ -80,6 +100,39 @@ void ezMessageQueueBase<MetaDataType>::Enqueue(ezMessage* pMessage, const MetaDa
   }
 }
 
+template <typename MetaDataType>
+void ezMessageQueueBase<MetaDataType>::EnqueueStaged(ezMessage* pMessage, const MetaDataType& metaData)
+{
+  Entry entry;
+  entry.m_pMessage = pMessage;
+  entry.m_MetaData = metaData;
+
+  StagingSlot& slot = m_StagingSlots[ezMessageQueueStaging::GetCurrentThreadSlot()];
+
+  {
+    // only contended if several threads share this slot or the queue is flushed at the same time
+    EZ_LOCK(slot.m_Mutex);
+
+    slot.m_Entries.PushBack(entry);
+  }
+}
+
+template <typename MetaDataType>
+void ezMessageQueueBase<MetaDataType>::FlushStaged()
+{
+  for (StagingSlot& slot : m_StagingSlots)
+  {
+    EZ_LOCK(slot.m_Mutex);
+
+    for (const Entry& entry : slot.m_Entries)
+    {
+      m_Queue.PushBack(entry);
+    }
+
+    slot.m_Entries.Clear();
+  }
+}
+
 template <typename MetaDataType>
 bool ezMessageQueueBase<MetaDataType>::TryDequeue(ezMessage*& out_pMessage, MetaDataType& out_metaData)
 {
@@ -3,14 +3,31 @@
 
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
+/// \brief Assigns threads to the staging buffers of ezMessageQueueBase.
+struct EZ_FOUNDATION_DLL ezMessageQueueStaging
+{
+  /// \brief The number of staging buffers per queue. If more threads stage messages, some of them share a buffer.
+  static constexpr ezUInt32 SlotCount = 16;
+
+  /// \brief Returns the staging slot of the calling thread in the range [0, SlotCount).
+  ///
+  /// Threads are assigned round-robin the first time they call this function and keep their slot afterwards.
+  static ezUInt32 GetCurrentThreadSlot();
+};
+
 /// \brief Implementation of a message queue on top of a deque.
 ///
 /// Enqueue and TryDequeue/TryPeek methods are thread safe all the others are not. To ensure
 /// thread safety for all methods the queue can be locked using ezLock like a mutex.
 /// Every entry consists of a pointer to a message and some meta data.
+///
+/// If many threads produce messages at the same time, EnqueueStaged should be used instead of Enqueue.
+/// It writes into a staging buffer that belongs to the calling thread, so producers don't contend on the queue mutex.
+/// The consumer then moves all staged messages into the queue at once with FlushStaged.
 /// Lifetime of the enqueued messages needs to be managed by the user.
 /// \see ezMessage
 template <typename MetaDataType>
@@ -30,13 +47,13 @@ protected:
   /// \brief No memory is allocated during construction.
   ezMessageQueueBase(ezAllocator* pAllocator); // [tested]
 
-  /// \brief No memory is allocated during construction.
+  /// \brief No memory is allocated during construction. Only copies the queued messages, not the staged ones.
   ezMessageQueueBase(const ezMessageQueueBase& rhs, ezAllocator* pAllocator);
 
   /// \brief Destructor.
   ~ezMessageQueueBase(); // [tested]
 
-  /// \brief Assignment operator.
+  /// \brief Assignment operator. Only copies the queued messages, the staged messages of this queue are dropped and those of rhs are not copied.
   void operator=(const ezMessageQueueBase& rhs);
 
 public:
@@ -52,7 +69,7 @@ public:
   /// \brief Returns true, if the queue does not contain any elements.
   bool IsEmpty() const;
 
-  /// \brief Destructs all elements and sets the count to zero. Does not deallocate any data.
+  /// \brief Destructs all elements, including the staged ones, and sets the count to zero. Does not deallocate any data.
   void Clear();
 
   /// \brief Expands the queue so it can at least store the given capacity.
@@ -64,6 +81,14 @@ public:
   /// \brief Enqueues the given message and meta-data. This method is thread safe.
   void Enqueue(ezMessage* pMessage, const MetaDataType& metaData); // [tested]
 
+  /// \brief Enqueues the given message and meta-data into the staging buffer of the calling thread. This method is thread safe.
+  ///
+  /// The message is not part of the queue until FlushStaged has been called.
+  void EnqueueStaged(ezMessage* pMessage, const MetaDataType& metaData); // [tested]
+
+  /// \brief Appends all staged messages to the queue. Not thread safe, but other threads may call EnqueueStaged concurrently.
+  void FlushStaged(); // [tested]
+
   /// \brief Dequeues the first element if the queue is not empty and returns true. Returns false if the queue is empty. This method is thread safe.
   bool TryDequeue(ezMessage*& out_pMessage, MetaDataType& out_metaData); // [tested]
 
@@ -87,8 +112,26 @@ public:
   void Unlock(); // [tested]
 
 private:
+  template <size_t... SlotIndices>
+  ezMessageQueueBase(ezAllocator* pAllocator, std::index_sequence<SlotIndices...>);
+
+  void ClearStaged();
+
   ezDeque<Entry, ezNullAllocatorWrapper> m_Queue;
   ezMutex m_Mutex;
+
+  struct StagingSlot
+  {
+    explicit StagingSlot(ezAllocator* pAllocator)
+      : m_Entries(pAllocator)
+    {
+    }
+
+    ezMutex m_Mutex;
+    ezDynamicArray<Entry, ezNullAllocatorWrapper> m_Entries;
+  };
+
+  StagingSlot m_StagingSlots[ezMessageQueueStaging::SlotCount];
 };
 
 /// \brief \see ezMessageQueueBase
@@ -0,0 +1,86 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
+
+static_assert(sizeof(ezVec3) == 3 * sizeof(float), "Float3 streams are expected to be tightly packed");
+
+void ezProcessingStreamKernels::AddFloat3(ezVec3* pData, ezUInt64 uiCount, const ezVec3& vAdd)
+{
+  // four tightly packed elements fill three SIMD registers
+  const ezSimdVec4f add0(vAdd.x, vAdd.y, vAdd.z, vAdd.x);
+  const ezSimdVec4f add1(vAdd.y, vAdd.z, vAdd.x, vAdd.y);
+  const ezSimdVec4f add2(vAdd.z, vAdd.x, vAdd.y, vAdd.z);
+
+  float* pFloats = reinterpret_cast<float*>(pData);
+
+  ezUInt64 i = 0;
+  for (; i + 4 <= uiCount; i += 4, pFloats += 12)
+  {
+    ezSimdVec4f v0, v1, v2;
+    v0.Load<4>(pFloats + 0);
+    v1.Load<4>(pFloats + 4);
+    v2.Load<4>(pFloats + 8);
+
+    (v0 + add0).Store<4>(pFloats + 0);
+    (v1 + add1).Store<4>(pFloats + 4);
+    (v2 + add2).Store<4>(pFloats + 8);
+  }
+
+  for (; i < uiCount; ++i)
+  {
+    pData[i] += vAdd;
+  }
+}
+
+void ezProcessingStreamKernels::ScaleFloat3(ezVec3* pData, ezUInt64 uiCount, float fScale)
+{
+  // all components are scaled alike, so the elements are processed as a flat float array
+  const ezSimdVec4f vScale(fScale);
+
+  float* pFloats = reinterpret_cast<float*>(pData);
+  const ezUInt64 uiNumFloats = uiCount * 3;
+
+  ezUInt64 i = 0;
+  for (; i + 4 <= uiNumFloats; i += 4)
+  {
+    ezSimdVec4f v;
+    v.Load<4>(pFloats + i);
+    v.CompMul(vScale).Store<4>(pFloats + i);
+  }
+
+  for (; i < uiNumFloats; ++i)
+  {
+    pFloats[i] *= fScale;
+  }
+}
+
+void ezProcessingStreamKernels::MulAddFloat3ToFloat4(ezSimdVec4f* pData, const ezVec3* pAdd, ezUInt64 uiCount, float fScale)
+{
+  // the w component is multiplied by zero, so it stays untouched
+  const ezSimdVec4f vScale(fScale, fScale, fScale, 0.0f);
+
+  const float* pFloats = reinterpret_cast<const float*>(pAdd);
+
+  // four tightly packed Float3 elements fill three SIMD registers, shuffle them into one register per element
+  ezUInt64 i = 0;
+  for (; i + 4 <= uiCount; i += 4, pData += 4, pFloats += 12)
+  {
+    ezSimdVec4f v0, v1, v2;
+    v0.Load<4>(pFloats + 0); // x0 y0 z0 x1
+    v1.Load<4>(pFloats + 4); // y1 z1 x2 y2
+    v2.Load<4>(pFloats + 8); // z2 x3 y3 z3
+
+    pData[0] = ezSimdVec4f::MulAdd(v0, vScale, pData[0]);
+    pData[1] = ezSimdVec4f::MulAdd(v0.GetCombined<ezSwizzle::ZWXY>(v1).Get<ezSwizzle::YZWX>(), vScale, pData[1]);
+    pData[2] = ezSimdVec4f::MulAdd(v1.GetCombined<ezSwizzle::ZWXY>(v2), vScale, pData[2]);
+    pData[3] = ezSimdVec4f::MulAdd(v2.Get<ezSwizzle::YZWX>(), vScale, pData[3]);
+  }
+
+  for (; i < uiCount; ++i, ++pData, pFloats += 3)
+  {
+    ezSimdVec4f v;
+    v.Load<3>(pFloats);
+
+    *pData = ezSimdVec4f::MulAdd(v, vScale, *pData);
+  }
+}
@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezProcessingStreamProcessor, 1, ezRTTINoAllocator)
@@ -18,6 +19,37 @@ ezProcessingStreamProcessor::~ezProcessingStreamProcessor()
   m_pStreamGroup = nullptr;
 }
 
+ezUInt32 ezProcessingStreamProcessor::s_uiMinElementsPerTask = 4096;
+
+void ezProcessingStreamProcessor::ProcessInRanges(ezUInt64 uiNumElements, RangeFunction func, const char* szTaskName)
+{
+  if (uiNumElements == 0)
+    return;
+
+  // the work is split into blocks, so that every range starts at a multiple of ElementRangeAlignment
+  const ezUInt64 uiNumBlocks = (uiNumElements + ElementRangeAlignment - 1) / ElementRangeAlignment;
+  const ezUInt32 uiMinBlocksPerTask = ezMath::Max(s_uiMinElementsPerTask / ElementRangeAlignment, 1u);
+
+  if (uiNumBlocks <= uiMinBlocksPerTask)
+  {
+    func(0, uiNumElements);
+    return;
+  }
+
+  ezParallelForParams params;
+  params.m_uiBinSize = uiMinBlocksPerTask;
+
+  ezTaskSystem::ParallelForIndexed(
+    ezUInt64(0), uiNumBlocks, [&func, uiNumElements](ezUInt64 uiStartBlock, ezUInt64 uiEndBlock)
+    {
+      const ezUInt64 uiStartIndex = uiStartBlock * ElementRangeAlignment;
+      const ezUInt64 uiEndIndex = ezMath::Min(uiEndBlock * ElementRangeAlignment, uiNumElements);
+
+      func(uiStartIndex, uiEndIndex - uiStartIndex);
+    },
+    szTaskName, ezTaskNesting::Never, params);
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+
+/// \brief SIMD kernels for the common operations of stream processors, e.g. inside the callback of ezProcessingStreamProcessor::ProcessInRanges().
+///
+/// Float3 streams are tightly packed, so the kernels process four elements at a time as three SIMD registers and only fall back to
+/// scalar code for the remainder. The data does not need to be aligned.
+struct EZ_FOUNDATION_DLL ezProcessingStreamKernels
+{
+  /// \brief Adds \a vAdd to all \a uiCount elements of a Float3 stream.
+  static void AddFloat3(ezVec3* pData, ezUInt64 uiCount, const ezVec3& vAdd);
+
+  /// \brief Multiplies all \a uiCount elements of a Float3 stream with \a fScale.
+  static void ScaleFloat3(ezVec3* pData, ezUInt64 uiCount, float fScale);
+
+  /// \brief Adds the elements of a Float3 stream multiplied with \a fScale to the xyz components of a Float4 stream, w stays untouched.
+  ///
+  /// This is how positions are moved by their velocities.
+  static void MulAddFloat3ToFloat4(ezSimdVec4f* pData, const ezVec3* pAdd, ezUInt64 uiCount, float fScale);
+
+  /// \brief Returns the first index in the range starting at \a uiRangeStart that is hit when stepping from \a uiFirstIndex in steps of \a uiStride.
+  ///
+  /// Used by processors that only update every n-th element per frame, to find where to continue in a range.
+  static ezUInt64 GetFirstStridedIndex(ezUInt64 uiFirstIndex, ezUInt64 uiStride, ezUInt64 uiRangeStart)
+  {
+    if (uiFirstIndex >= uiRangeStart)
+      return uiFirstIndex;
+
+    return uiFirstIndex + (uiRangeStart - uiFirstIndex + uiStride - 1) / uiStride * uiStride;
+  }
+};
@@ -3,6 +3,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Types/Delegate.h>
 
 class ezProcessingStreamGroup;
 
@@ -21,6 +22,16 @@ public:
   /// Used for sorting processors, to ensure a certain order. Lower priority == executed first.
   float m_fPriority = 0.0f;
 
+  /// \brief Every range that ProcessInRanges() passes to its callback starts at a multiple of this many elements.
+  ///
+  /// Thus the data of every stream is 16 byte aligned at the start of a range (given that the element size is at least two bytes),
+  /// which allows SIMD kernels to process a range in blocks without any special handling for the start.
+  static constexpr ezUInt32 ElementRangeAlignment = 8;
+
+  /// \brief ProcessInRanges() only distributes the work across multiple threads, if there are more elements than this.
+  /// This is also the minimum number of elements per task.
+  static ezUInt32 s_uiMinElementsPerTask;
+
 protected:
   friend class ezProcessingStreamGroup;
 
@@ -35,6 +46,15 @@ protected:
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
   virtual void Process(ezUInt64 uiNumElements) = 0;
 
+  using RangeFunction = ezDelegate<void(ezUInt64 uiStartIndex, ezUInt64 uiNumElements), 48>;
+
+  /// \brief Splits the first \a uiNumElements elements into ranges and calls \a func for each of them, distributed across the worker threads.
+  ///
+  /// Use this inside Process() for work that only reads and writes the data of the elements in the given range, e.g. to integrate velocities.
+  /// \a func must neither remove nor spawn elements and must not modify any other state, as it may run concurrently for different ranges.
+  /// Returns once all ranges are processed. Small element counts are processed directly on the calling thread.
+  static void ProcessInRanges(ezUInt64 uiNumElements, RangeFunction func, const char* szTaskName = nullptr);
+
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
   ezProcessingStreamGroup* m_pStreamGroup = nullptr;
@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_blocks, ///< Compressed in independent blocks (see ezBlockCompressedStreamWriterZstd), allows fast random access into large files.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -31,6 +31,7 @@ public:
     Compress_zstd_average, ///< Add the file and try out compression. If compression does not help, the file will end up uncompressed in the archive.
     Compress_zstd_high,    ///< Add the file and try out compression. If compression does not help, the file will end up uncompressed in the archive.
     Compress_zstd_highest, ///< Add the file and try out compression. If compression does not help, the file will end up uncompressed in the archive.
+    Compress_zstd_blocks,  ///< Add the file and compress it in independent blocks, for large files that are read partially (e.g. audio banks). If compression does not help, the file will end up uncompressed in the archive.
   };
 
   /// \brief Custom decider whether to include a file into the archive
@@ -46,6 +47,9 @@ public:
   ezResult WriteArchive(ezStringView sFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// Files are read and compressed in parallel on the task system and written to the stream in order.
+  /// Files with identical content are only stored once, their TOC entries share the same data range.
   ezResult WriteArchive(ezStreamWriter& inout_stream) const;
 
 protected:
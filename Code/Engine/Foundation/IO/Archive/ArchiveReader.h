@@ -33,6 +33,19 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns a view of the given entry's data directly inside the memory mapped archive, without copying anything.
+  ///
+  /// This only works for entries that are stored uncompressed. For compressed entries (and entries too large for an ezArrayPtr)
+  /// an empty array is returned and CreateEntryReader() has to be used instead.
+  /// The view stays valid for as long as the archive is open.
+  ezArrayPtr<const ezUInt8> GetUncompressedEntryData(ezUInt32 uiEntryIdx) const;
+
+  /// \brief Hints the OS to start paging in the data of the given entries in the background.
+  ///
+  /// Use this when it is known which files are needed soon (e.g. everything a level is about to load),
+  /// so that the later reads don't stall on page faults. Entries that are stored close to each other are merged into one request.
+  void PrefetchEntries(ezArrayPtr<const ezUInt32> entryIndices) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
@@ -14,6 +14,7 @@ namespace ezDataDirectory
 {
   class ArchiveReaderUncompressed;
   class ArchiveReaderZstd;
+  class ArchiveReaderZstdBlocks;
   class ArchiveReaderZip;
 
   class EZ_FOUNDATION_DLL ArchiveType : public ezDataDirectoryType
@@ -26,6 +27,11 @@ namespace ezDataDirectory
 
     virtual const ezString128& GetRedirectedDataDirectoryPath() const override { return m_sRedirectedDataDirPath; }
 
+    /// \brief Hints the OS to start paging in the given files, if they are stored in this archive.
+    ///
+    /// Call this with the files that will be needed soon (e.g. everything a level references) to avoid stalling on page faults later.
+    void PrefetchFiles(ezArrayPtr<const ezStringView> files);
+
   protected:
     virtual ezDataDirectoryReader* OpenFileToRead(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bSpecificallyThisDataDir) override;
 
@@ -51,6 +57,8 @@ namespace ezDataDirectory
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZstd>, 4> m_ReadersZstd;
     ezHybridArray<ArchiveReaderZstd*, 4> m_FreeReadersZstd;
+    ezHybridArray<ezUniquePtr<ArchiveReaderZstdBlocks>, 4> m_ReadersZstdBlocks;
+    ezHybridArray<ArchiveReaderZstdBlocks*, 4> m_FreeReadersZstdBlocks;
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZip>, 4> m_ReadersZip;
@@ -66,10 +74,12 @@ namespace ezDataDirectory
     ArchiveReaderCommon(ezInt32 iDataDirUserData);
 
     virtual ezUInt64 GetFileSize() const override;
+    virtual ezArrayPtr<const ezUInt8> GetMappedData() const override { return m_MappedData; }
 
   protected:
     friend class ArchiveType;
 
+    ezArrayPtr<const ezUInt8> m_MappedData;
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
     ezRawMemoryStreamReader m_MemStreamReader;
@@ -106,6 +116,26 @@ namespace ezDataDirectory
 
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
   };
+
+  /// \brief Reads entries that are stored with ezArchiveCompressionMode::Compressed_zstd_blocks.
+  ///
+  /// Skipping does not decompress anything, so reading parts of large files only costs decompressing the blocks that are actually needed.
+  class EZ_FOUNDATION_DLL ArchiveReaderZstdBlocks : public ArchiveReaderCommon
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderZstdBlocks);
+
+  public:
+    ArchiveReaderZstdBlocks(ezInt32 iDataDirUserData);
+
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+    virtual void InternalClose() override;
+
+    ezBlockCompressedStreamReaderZstd m_BlockReader;
+  };
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
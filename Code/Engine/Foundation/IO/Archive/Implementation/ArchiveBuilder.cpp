@@ -3,10 +3,15 @@
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/ScopeExit.h>
 
 void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/, InclusionCallback callback /*= InclusionCallback()*/)
 {
@@ -63,6 +68,10 @@ void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressi
             compression = ezArchiveCompressionMode::Compressed_zstd;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Highest);
             break;
+          case InclusionMode::Compress_zstd_blocks:
+            compression = ezArchiveCompressionMode::Compressed_zstd_blocks;
+            iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Fast);
+            break;
 #  endif
         }
       }
@@ -97,6 +106,110 @@ ezResult ezArchiveBuilder::WriteArchive(ezStringView sFile) const
   return WriteArchive(file);
 }
 
+namespace
+{
+  // files up to this size are read and compressed in parallel, larger ones are streamed and compressed by zstd's own worker threads
+  constexpr ezUInt64 s_uiMaxPreparedEntrySize = 16 * 1024 * 1024;
+
+  struct PreparedEntry
+  {
+    ezResult m_Result = EZ_FAILURE;
+    bool m_bTooLarge = false;
+    ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+    ezUInt64 m_uiContentHash = 0;
+    ezDynamicArray<ezUInt8> m_UncompressedData;
+    ezDynamicArray<ezUInt8> m_CompressedData;
+
+    ezConstByteArrayPtr GetStoredData() const
+    {
+      return m_CompressionMode == ezArchiveCompressionMode::Uncompressed ? m_UncompressedData.GetArrayPtr() : m_CompressedData.GetArrayPtr();
+    }
+  };
+
+  void PrepareEntry(const ezArchiveBuilder::SourceEntry& entry, PreparedEntry& out_prepared)
+  {
+    ezFileReader file;
+    if (file.Open(entry.m_sAbsSourcePath, 1024 * 1024).Failed())
+      return;
+
+    const ezUInt64 uiFileSize = file.GetFileSize();
+
+    if (uiFileSize > s_uiMaxPreparedEntrySize)
+    {
+      out_prepared.m_bTooLarge = true;
+      out_prepared.m_Result = EZ_SUCCESS;
+      return;
+    }
+
+    out_prepared.m_UncompressedData.SetCountUninitialized(static_cast<ezUInt32>(uiFileSize));
+
+    if (file.ReadBytes(out_prepared.m_UncompressedData.GetData(), uiFileSize) != uiFileSize)
+      return;
+
+    out_prepared.m_uiContentHash = ezHashingUtils::xxHash64(out_prepared.m_UncompressedData.GetData(), out_prepared.m_UncompressedData.GetCount());
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd || entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_blocks)
+    {
+      ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&out_prepared.m_CompressedData);
+      ezMemoryStreamWriter writer(&storage);
+
+      const auto compressionLevel = static_cast<ezCompressedStreamWriterZstd::Compression>(entry.m_iCompressionLevel);
+
+      // entries are already compressed in parallel, so don't let zstd spawn additional threads
+      if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+      {
+        ezCompressedStreamWriterZstd zstdWriter(&writer, 0, compressionLevel);
+
+        if (zstdWriter.WriteBytes(out_prepared.m_UncompressedData.GetData(), uiFileSize).Failed() || zstdWriter.FinishCompressedStream().Failed())
+          return;
+      }
+      else
+      {
+        ezBlockCompressedStreamWriterZstd zstdWriter(&writer, false, compressionLevel);
+
+        if (zstdWriter.WriteBytes(out_prepared.m_UncompressedData.GetData(), uiFileSize).Failed() || zstdWriter.FinishCompressedStream().Failed())
+          return;
+      }
+
+      // same rule as ezArchiveUtils::WriteEntryOptimal(): less than 20% size saving -> go uncompressed
+      if (out_prepared.m_CompressedData.GetCount() * 12ull < uiFileSize * 10)
+      {
+        out_prepared.m_CompressionMode = entry.m_CompressionMode;
+      }
+      else
+      {
+        out_prepared.m_CompressedData.Clear();
+      }
+    }
+#endif
+
+    out_prepared.m_Result = EZ_SUCCESS;
+  }
+
+  /// Entries with the same content hash and size only share their data once this confirms that the bytes are really the same.
+  bool IsFileContentEqual(ezStringView sAbsSourcePath, ezConstByteArrayPtr data)
+  {
+    ezFileReader file;
+    if (file.Open(sAbsSourcePath, 1024 * 1024).Failed() || file.GetFileSize() != data.GetCount())
+      return false;
+
+    ezUInt8 buffer[1024 * 16];
+
+    for (ezUInt32 uiOffset = 0; uiOffset < data.GetCount();)
+    {
+      const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(EZ_ARRAY_SIZE(buffer), data.GetCount() - uiOffset);
+
+      if (file.ReadBytes(buffer, uiChunkSize) != uiChunkSize || ezMemoryUtils::RawByteCompare(buffer, data.GetPtr() + uiOffset, uiChunkSize) != 0)
+        return false;
+
+      uiOffset += uiChunkSize;
+    }
+
+    return true;
+  }
+} // namespace
+
 ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(inout_stream));
@@ -108,6 +221,46 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
+  // Entries are read and compressed by tasks, while this thread writes the finished ones in order.
+  // The window limits how many entries are in flight, which also bounds the memory usage.
+  const ezUInt32 uiWindowSize = ezMath::Max(4u, 2 * ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks));
+
+  ezDynamicArray<PreparedEntry> prepared;
+  prepared.SetCount(uiWindowSize);
+
+  ezDynamicArray<ezTaskGroupID> prepareGroups;
+  prepareGroups.SetCount(uiWindowSize);
+
+  // make sure no task accesses the prepared data anymore, when we leave early
+  EZ_SCOPE_EXIT(for (const ezTaskGroupID& group : prepareGroups) { ezTaskSystem::WaitForGroup(group); });
+
+  auto StartPreparing = [&](ezUInt32 uiEntry)
+  {
+    PreparedEntry* pPrepared = &prepared[uiEntry % uiWindowSize];
+    *pPrepared = PreparedEntry();
+
+    const SourceEntry* pEntry = &m_Entries[uiEntry];
+
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "Prepare Archive Entry", ezTaskNesting::Never, [pEntry, pPrepared]()
+      { PrepareEntry(*pEntry, *pPrepared); });
+
+    prepareGroups[uiEntry % uiWindowSize] = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+  };
+
+  for (ezUInt32 i = 0; i < ezMath::Min(uiWindowSize, uiNumEntries); ++i)
+  {
+    StartPreparing(i);
+  }
+
+  struct StoredEntry
+  {
+    ezUInt32 m_uiTocEntryIdx = ezInvalidIndex;
+    ezUInt32 m_uiSourceEntryIdx = ezInvalidIndex;
+  };
+
+  // maps the content hash of every stored entry to its TOC entry, so that identical files only get stored once
+  ezHashTable<ezUInt64, StoredEntry> contentToEntry;
+
   ezStopwatch sw;
 
   for (ezUInt32 i = 0; i < uiNumEntries; ++i)
@@ -124,9 +277,55 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
     if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
       return EZ_FAILURE;
 
+    ezTaskSystem::WaitForGroup(prepareGroups[i % uiWindowSize]);
+    PreparedEntry& prep = prepared[i % uiWindowSize];
+
+    if (prep.m_Result.Failed())
+    {
+      ezLog::Error("Could not read '{}'", e.m_sAbsSourcePath);
+      return EZ_FAILURE;
+    }
+
+    const ezUInt32 uiTocEntryIdx = toc.m_Entries.GetCount();
     ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+    if (prep.m_bTooLarge)
+    {
+      EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+    }
+    else
+    {
+      // the data of the earlier entry isn't kept around, so its source file is read again to rule out hash collisions
+      StoredEntry identical;
+      if (contentToEntry.TryGetValue(prep.m_uiContentHash, identical) && toc.m_Entries[identical.m_uiTocEntryIdx].m_uiUncompressedDataSize == prep.m_UncompressedData.GetCount() &&
+          IsFileContentEqual(m_Entries[identical.m_uiSourceEntryIdx].m_sAbsSourcePath, prep.m_UncompressedData))
+      {
+        // share the data range of the identical entry
+        tocEntry = toc.m_Entries[identical.m_uiTocEntryIdx];
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+      }
+      else
+      {
+        EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryPreprocessed(inout_stream, prep.GetStoredData(), uiPathStringOffset, prep.m_CompressionMode, prep.m_UncompressedData.GetCount(), tocEntry, uiStreamSize));
+
+        // on a collision the first entry stays the one that later entries are compared against
+        if (!contentToEntry.Contains(prep.m_uiContentHash))
+        {
+          contentToEntry.Insert(prep.m_uiContentHash, StoredEntry{uiTocEntryIdx, i});
+        }
+      }
+
+      if (!WriteFileProgressCallback(tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiUncompressedDataSize))
+        return EZ_FAILURE;
+    }
+
+    // free the memory right away and reuse the slot for the next entry
+    prep = PreparedEntry();
+
+    if (i + uiWindowSize < uiNumEntries)
+    {
+      StartPreparing(i + uiWindowSize);
+    }
 
     WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
   }
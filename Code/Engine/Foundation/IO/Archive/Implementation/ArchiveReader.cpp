@@ -127,6 +127,74 @@ ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryI
   return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
 }
 
+ezArrayPtr<const ezUInt8> ezArchiveReader::GetUncompressedEntryData(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Uncompressed || entry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+    return {};
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset)));
+  return ezArrayPtr<const ezUInt8>(pData, static_cast<ezUInt32>(entry.m_uiStoredDataSize));
+}
+
+void ezArchiveReader::PrefetchEntries(ezArrayPtr<const ezUInt32> entryIndices) const
+{
+  if (m_pDataStart == nullptr || entryIndices.IsEmpty())
+    return;
+
+  struct Range
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiStart;
+    ezUInt64 m_uiEnd;
+
+    bool operator<(const Range& rhs) const { return m_uiStart < rhs.m_uiStart; }
+  };
+
+  ezHybridArray<Range, 64> ranges;
+  ranges.Reserve(entryIndices.GetCount());
+
+  const ezUInt64 uiDataStartOffset = static_cast<ezUInt64>(static_cast<const ezUInt8*>(m_pDataStart) - static_cast<const ezUInt8*>(m_MemFile.GetReadPointer()));
+
+  for (ezUInt32 uiEntryIdx : entryIndices)
+  {
+    const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+    if (entry.m_uiStoredDataSize == 0)
+      continue;
+
+    Range& range = ranges.ExpandAndGetRef();
+    range.m_uiStart = uiDataStartOffset + entry.m_uiDataStartOffset;
+    range.m_uiEnd = range.m_uiStart + entry.m_uiStoredDataSize;
+  }
+
+  ranges.Sort();
+
+  // entries are usually stored in the order they were added, so files of the same level tend to be neighbors,
+  // reading a small gap along is much cheaper than issuing many tiny requests
+  constexpr ezUInt64 uiMaxGap = 64 * 1024;
+
+  ezUInt32 uiNumMerged = 0;
+  for (ezUInt32 i = 0; i < ranges.GetCount(); ++i)
+  {
+    if (uiNumMerged > 0 && ranges[i].m_uiStart <= ranges[uiNumMerged - 1].m_uiEnd + uiMaxGap)
+    {
+      ranges[uiNumMerged - 1].m_uiEnd = ezMath::Max(ranges[uiNumMerged - 1].m_uiEnd, ranges[i].m_uiEnd);
+    }
+    else
+    {
+      ranges[uiNumMerged++] = ranges[i];
+    }
+  }
+
+  for (ezUInt32 i = 0; i < uiNumMerged; ++i)
+  {
+    m_MemFile.Prefetch(ranges[i].m_uiStart, ranges[i].m_uiEnd - ranges[i].m_uiStart);
+  }
+}
+
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetFolder) const
 {
   ezStringView sFilePath = m_ArchiveTOC.GetEntryPathString(uiEntryIdx);
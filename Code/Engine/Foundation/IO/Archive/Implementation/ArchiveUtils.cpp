@@ -140,6 +140,7 @@ ezResult ezArchiveUtils::WriteEntry(
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
   ezCompressedStreamWriterZstd zstdWriter;
+  ezBlockCompressedStreamWriterZstd zstdBlockWriter;
 #endif
 
   switch (compression)
@@ -154,6 +155,13 @@ ezResult ezArchiveUtils::WriteEntry(
       pWriter = &zstdWriter;
     }
     break;
+
+    case ezArchiveCompressionMode::Compressed_zstd_blocks:
+    {
+      zstdBlockWriter.SetOutputStream(&inout_stream, uiWorkerThreadCount > 1, (ezCompressedStreamWriterZstd::Compression)iCompressionLevel);
+      pWriter = &zstdBlockWriter;
+    }
+    break;
 #endif
 
     default:
@@ -192,6 +200,11 @@ ezResult ezArchiveUtils::WriteEntry(
       EZ_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
       inout_tocEntry.m_uiStoredDataSize = zstdWriter.GetWrittenBytes();
       break;
+
+    case ezArchiveCompressionMode::Compressed_zstd_blocks:
+      EZ_SUCCEED_OR_RETURN(zstdBlockWriter.FinishCompressedStream());
+      inout_tocEntry.m_uiStoredDataSize = zstdBlockWriter.GetWrittenBytes();
+      break;
 #endif
 
     case ezArchiveCompressionMode::Uncompressed:
@@ -277,6 +290,18 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       pRawReader->SetInputStream(&pRawReader->m_Source);
       break;
     }
+
+    case ezArchiveCompressionMode::Compressed_zstd_blocks:
+    {
+      reader = EZ_DEFAULT_NEW(ezBlockCompressedStreamReaderZstd);
+      ezBlockCompressedStreamReaderZstd* pBlockReader = static_cast<ezBlockCompressedStreamReaderZstd*>(reader.Borrow());
+
+      if (pBlockReader->SetInputData(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset)), entry.m_uiStoredDataSize).Failed())
+      {
+        EZ_REPORT_FAILURE("Archive entry has an invalid block index");
+      }
+      break;
+    }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     case ezArchiveCompressionMode::Compressed_zip:
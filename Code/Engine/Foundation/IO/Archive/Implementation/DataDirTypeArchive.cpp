@@ -93,6 +93,21 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
         }
         break;
       }
+
+      case ezArchiveCompressionMode::Compressed_zstd_blocks:
+      {
+        if (!m_FreeReadersZstdBlocks.IsEmpty())
+        {
+          pReader = m_FreeReadersZstdBlocks.PeekBack();
+          m_FreeReadersZstdBlocks.PopBack();
+        }
+        else
+        {
+          m_ReadersZstdBlocks.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstdBlocks, 3));
+          pReader = m_ReadersZstdBlocks.PeekBack().Borrow();
+        }
+        break;
+      }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
       case ezArchiveCompressionMode::Compressed_zip:
@@ -121,6 +136,7 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  pReader->m_MappedData = m_ArchiveReader.GetUncompressedEntryData(uiEntryIndex);
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -131,6 +147,30 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
   return pReader;
 }
 
+void ezDataDirectory::ArchiveType::PrefetchFiles(ezArrayPtr<const ezStringView> files)
+{
+  const ezArchiveTOC& toc = m_ArchiveReader.GetArchiveTOC();
+
+  ezHybridArray<ezUInt32, 64> entries;
+  ezStringBuilder sArchivePath;
+
+  for (ezStringView sFile : files)
+  {
+    sArchivePath = m_sArchiveSubFolder;
+    sArchivePath.AppendPath(sFile);
+    sArchivePath.MakeCleanPath();
+
+    const ezUInt32 uiEntryIndex = toc.FindEntry(sArchivePath);
+
+    if (uiEntryIndex != ezInvalidIndex)
+    {
+      entries.PushBack(uiEntryIndex);
+    }
+  }
+
+  m_ArchiveReader.PrefetchEntries(entries);
+}
+
 void ezDataDirectory::ArchiveType::RemoveDataDirectory()
 {
   ArchiveType* pThis = this;
@@ -255,6 +295,12 @@ void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWrit
     m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
     return;
   }
+
+  if (pClosed->GetDataDirUserData() == 3)
+  {
+    m_FreeReadersZstdBlocks.PushBack(static_cast<ArchiveReaderZstdBlocks*>(pClosed));
+    return;
+  }
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
@@ -338,6 +384,36 @@ void ezDataDirectory::ArchiveReaderZstd::InternalClose()
 {
   // nothing to do
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderZstdBlocks::ArchiveReaderZstdBlocks(ezInt32 iDataDirUserData)
+  : ArchiveReaderCommon(iDataDirUserData)
+{
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdBlocks::Skip(ezUInt64 uiBytes)
+{
+  return m_BlockReader.SkipBytes(uiBytes);
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdBlocks::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_BlockReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderZstdBlocks::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_IGNORE_UNUSED(FileShareMode);
+  EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  return m_BlockReader.SetInputData(m_MemStreamReader.GetRawMemory(), m_uiCompressedSize);
+}
+
+void ezDataDirectory::ArchiveReaderZstdBlocks::InternalClose()
+{
+  // nothing to do
+}
 #endif
 
 //////////////////////////////////////////////////////////////////////////
@@ -154,4 +154,115 @@ private:
   ezDynamicArray<ezUInt8> m_CompressedCache;
 };
 
+/// \brief A stream writer that compresses all incoming data in blocks of a fixed size, each of which can be decompressed on its own.
+///
+/// The compression ratio is slightly worse than with ezCompressedStreamWriterZstd, but the data can be read with random access through
+/// ezBlockCompressedStreamReaderZstd, which only decompresses the blocks that are actually needed.
+/// The output consists of the compressed blocks, followed by a block index and a small footer, which are written by FinishCompressedStream().
+///
+/// Incoming data is gathered into batches of blocks, which are compressed in parallel on the task system, if allowed.
+class EZ_FOUNDATION_DLL ezBlockCompressedStreamWriterZstd final : public ezStreamWriter
+{
+public:
+  static constexpr ezUInt32 DefaultBlockSize = 64 * 1024;
+
+  ezBlockCompressedStreamWriterZstd();
+
+  /// \brief The constructor takes another stream writer to pass the output into, and a compression level.
+  ezBlockCompressedStreamWriterZstd(ezStreamWriter* pOutputStream, bool bCompressInParallel, ezCompressedStreamWriterZstd::Compression ratio = ezCompressedStreamWriterZstd::Compression::Default, ezUInt32 uiBlockSize = DefaultBlockSize);
+
+  /// \brief Calls FinishCompressedStream() internally.
+  ~ezBlockCompressedStreamWriterZstd();
+
+  /// \brief Configures to which other ezStreamWriter the compressed data should be passed along.
+  ///
+  /// \param bCompressInParallel If true, batches of blocks are compressed with ezTaskSystem::ParallelFor().
+  ///        Pass false when the writer is already used from within many tasks at once.
+  /// \param uiBlockSize The amount of uncompressed data per block. Smaller blocks make random access cheaper, but compress worse.
+  ///
+  /// If this is called a second time, the writer finishes up all work on the previous stream first.
+  void SetOutputStream(ezStreamWriter* pOutputStream, bool bCompressInParallel, ezCompressedStreamWriterZstd::Compression ratio = ezCompressedStreamWriterZstd::Compression::Default, ezUInt32 uiBlockSize = DefaultBlockSize);
+
+  /// \brief Compresses \a uiBytesToWrite from \a pWriteBuffer.
+  ///
+  /// Data is only passed to the output stream once a full batch of blocks has been gathered.
+  virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override;
+
+  /// \brief Compresses the remaining data and writes it to the output stream, followed by the block index.
+  ///
+  /// After calling this function, no more data can be written to the stream.
+  ezResult FinishCompressedStream();
+
+  /// \brief Returns the size of the data in its uncompressed state.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Returns the exact number of bytes written to the output stream so far, including the block index.
+  ezUInt64 GetWrittenBytes() const { return m_uiWrittenBytes; }
+
+private:
+  ezResult CompressPendingBlocks();
+
+  ezStreamWriter* m_pOutputStream = nullptr;
+  bool m_bCompressInParallel = false;
+  ezInt32 m_iCompressionLevel = 0;
+  ezUInt32 m_uiBlockSize = DefaultBlockSize;
+  ezUInt32 m_uiBlocksPerBatch = 1;
+
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiWrittenBytes = 0;
+
+  ezDynamicArray<ezUInt8> m_PendingData;
+  ezDynamicArray<ezDynamicArray<ezUInt8>> m_CompressedBlocks;
+  ezDynamicArray<ezUInt64> m_BlockEnds;
+};
+
+/// \brief A stream reader that decompresses data which was written with ezBlockCompressedStreamWriterZstd.
+///
+/// In contrast to the other compressed stream readers, the compressed data must be available in memory as a whole (e.g. in a memory mapped archive),
+/// because the reader jumps between blocks. SetReadPosition() and SkipBytes() don't decompress anything, the next read only decompresses
+/// the block that contains the read position. Reads that cover several complete blocks decompress those in parallel, straight into the target buffer.
+class EZ_FOUNDATION_DLL ezBlockCompressedStreamReaderZstd : public ezStreamReader
+{
+public:
+  ezBlockCompressedStreamReaderZstd();
+  ~ezBlockCompressedStreamReaderZstd();
+
+  /// \brief Configures the reader to decompress the given data. Returns EZ_FAILURE if the data does not contain a valid block index.
+  ///
+  /// The data must stay valid as long as it is read from. The read position is reset to the start.
+  ezResult SetInputData(const void* pData, ezUInt64 uiDataSize);
+
+  /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
+  ///
+  /// If pReadBuffer is nullptr, the read position is only advanced, without decompressing anything.
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
+
+  /// \brief Advances the read position without decompressing anything.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Moves the read position to the given byte offset in the uncompressed data.
+  void SetReadPosition(ezUInt64 uiReadPosition);
+
+  /// \brief Returns the current read position in the uncompressed data.
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+  /// \brief Returns the size of the uncompressed data.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+private:
+  ezUInt64 GetBlockStart(ezUInt32 uiBlock) const { return uiBlock == 0 ? 0 : m_BlockEnds[uiBlock - 1]; }
+  ezUInt32 GetBlockSize(ezUInt32 uiBlock) const;
+  ezResult DecompressBlock(ezUInt32 uiBlock, void* pTarget, /*ZSTD_DCtx*/ void* pContext) const;
+
+  const ezUInt8* m_pData = nullptr;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiBlockSize = 0;
+  ezDynamicArray<ezUInt64> m_BlockEnds;
+
+  ezUInt32 m_uiCachedBlock = ezInvalidIndex;
+  ezDynamicArray<ezUInt8> m_CachedBlock;
+  /*ZSTD_DCtx*/ void* m_pZstdDCtx = nullptr;
+};
+
 #endif // BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ReadWriteLock.h>
+#include <Foundation/Types/UniquePtr.h>
 
 namespace ezDataDirectory
 {
@@ -34,6 +38,17 @@ namespace ezDataDirectory
     /// access.
     static ezString s_sRedirectionPrefix;
 
+    /// If enabled, folder data directories that are mounted read-only build an in-memory index of all the files and folders that they
+    /// contain. File lookups (ExistsFile, GetFileStats, OpenFileToRead) that are not in the index are then rejected without asking the
+    /// OS, which is a lot cheaper when many data directories are mounted and most lookups fail in all but one of them.
+    ///
+    /// The index is built once (in parallel) when the data directory is mounted and is kept up to date through an ezDirectoryWatcher.
+    /// Changes done by other processes are picked up with a short delay. On platforms without directory watcher support, the content
+    /// of the data directory must not change while it is mounted.
+    ///
+    /// Only affects data directories that are mounted after this was changed.
+    static bool s_bUseFileIndex;
+
     /// \brief When s_sRedirectionFile and s_sRedirectionPrefix are used to enable file redirection, this will reload those config files.
     virtual void ReloadExternalConfigs() override;
 
@@ -61,6 +76,18 @@ namespace ezDataDirectory
 
     void LoadRedirectionFile();
 
+    /// \brief Scans the entire data directory and fills m_FileIndex.
+    void BuildFileIndex();
+
+    /// \brief Applies the changes that the directory watcher reported since the last call.
+    void UpdateFileIndex();
+
+    /// \brief Returns false if the file index is in use and knows that the given relative path does not exist in this data directory.
+    bool MayContainFile(ezStringView sRelativePath);
+
+    /// \brief Adds the given path and everything below it (if it is a folder) to the file index.
+    void AddToFileIndex(ezStringView sAbsolutePath, bool bIsFolder);
+
     mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
     ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
     ezHybridArray<ezDataDirectory::FolderWriter*, 4> m_Writers;
@@ -68,6 +95,17 @@ namespace ezDataDirectory
     mutable ezMutex m_RedirectionMutex;
     ezMap<ezString, ezString> m_FileRedirection;
     ezString128 m_sRedirectedDataDirPath;
+
+    bool m_bUseFileIndex = false;
+    ezReadWriteLock m_FileIndexLock; ///< Locks m_FileIndex. Lookups take a read lock, updates from the directory watcher the exclusive lock.
+    ezHashSet<ezString> m_FileIndex; ///< Lower-case, data directory relative paths of all files and folders.
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    ezMutex m_FileIndexWatcherMutex;
+    ezUniquePtr<ezDirectoryWatcher> m_pFileIndexWatcher;
+    ezTime m_LastFileIndexUpdate;
+    ezInt32 m_iLastFileIndexWriteCounter = 0;
+#endif
   };
 
 
@@ -6,6 +6,7 @@
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ReadWriteLock.h>
 
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
 ///
@@ -49,6 +50,9 @@ public:
   struct FileEvent;
 
   /// \brief Registers an Event Handler that will be informed about all the events that the file system broadcasts.
+  ///
+  /// Events about data directories are broadcast while the exclusive lock is held. Events about files are broadcast without holding the lock,
+  /// so their handlers may mount or unmount data directories.
   static ezEventSubscriptionID RegisterEventHandler(ezEvent<const FileEvent&>::Handler handler);
 
   /// \brief Unregisters a previously registered Event Handler.
@@ -183,9 +187,12 @@ public:
   /// \name Misc
   ///@{
 
-  /// \brief Returns the (recursive) mutex that is used internally by the file system which can be used to guard bundled operations on the file
+  /// \brief Returns the (recursive) lock that is used internally by the file system which can be used to guard bundled operations on the file
   /// system.
-  static ezMutex& GetMutex();
+  ///
+  /// File lookups only take a read lock (EZ_LOCK_READ), so that loading threads don't block each other. Mounting and unmounting data
+  /// directories takes the exclusive lock (EZ_LOCK). A thread that only holds the read lock must not mount or unmount data directories.
+  static ezReadWriteLock& GetMutex();
 
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
   /// \brief Starts a multi-folder search for \a szSearchTerm on all current data directories.
@@ -275,7 +282,6 @@ private:
   /// itself, which should not trigger an endless recursion of file events.
   static ezDataDirectoryWriter* GetFileWriter(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents);
 
-
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, FileSystem);
 
@@ -300,7 +306,7 @@ private:
     ezHybridArray<ezDataDirectoryInfo, 16> m_DataDirectories;
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
-    ezMutex m_FsMutex;
+    ezReadWriteLock m_FsMutex;
   };
 
   /// \brief Extracts the root name in a rooted path, e.g. for ":bin/stuff" it would extract "bin". Returns the relative path (here "stuff") or an empty string if it is a root only.
@@ -311,6 +317,18 @@ private:
 
   static ezDataDirectoryInfo* GetDataDirForRoot(const ezString& sRoot);
 
+  /// \brief A data directory that a file operation tries, together with the path relative to it.
+  struct DataDirCandidate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezDataDirectoryType* m_pDataDir;
+    ezStringView m_sRelPath;
+  };
+
+  /// \brief Returns whether the given data directory is still mounted. The caller must hold the lock.
+  static bool IsDataDirMounted(const ezDataDirectoryType* pDataDir);
+
   static void CleanUpRootName(ezStringBuilder& sRoot);
 
   static ezString s_sSdkRootDir;
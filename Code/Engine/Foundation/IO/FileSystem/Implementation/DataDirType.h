@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/IO/FileEnums.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Types/ArrayPtr.h>
 
 class ezDataDirectoryReaderWriterBase;
 class ezDataDirectoryReader;
@@ -190,6 +191,11 @@ public:
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
 
+  /// \brief If the entire file content is available in memory (e.g. uncompressed files inside a memory mapped archive), returns a view of it.
+  ///
+  /// The default implementation returns an empty array, which means the data must be read through Read().
+  virtual ezArrayPtr<const ezUInt8> GetMappedData() const { return {}; }
+
   /// \brief Helper method to skip a number of bytes (implementations of the directory reader may implement this more efficiently for example)
   virtual ezUInt64 Skip(ezUInt64 uiBytes)
   {
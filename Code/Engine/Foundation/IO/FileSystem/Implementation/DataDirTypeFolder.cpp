@@ -3,6 +3,7 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FolderDataDirectory)
@@ -23,6 +24,15 @@ namespace ezDataDirectory
 {
   ezString FolderType::s_sRedirectionFile;
   ezString FolderType::s_sRedirectionPrefix;
+  bool FolderType::s_bUseFileIndex = false;
+
+  // Incremented whenever a file is written through any folder data directory.
+  // Allows file indices to pick up local changes immediately, instead of waiting for the next regular update.
+  static ezAtomicInteger32 s_iFolderWriteCounter;
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  static constexpr ezTime s_FileIndexUpdateInterval = ezTime::MakeFromMilliseconds(100);
+#endif
 
   ezResult FolderReader::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
@@ -71,7 +81,9 @@ namespace ezDataDirectory
     ezStringBuilder sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
     sPath.AppendPath(GetFilePath());
 
-    return m_File.Open(sPath.GetData(), ezFileOpenMode::Write, FileShareMode);
+    const ezResult res = m_File.Open(sPath.GetData(), ezFileOpenMode::Write, FileShareMode);
+    s_iFolderWriteCounter.Increment();
+    return res;
   }
 
   void FolderWriter::InternalClose()
@@ -93,9 +105,9 @@ namespace ezDataDirectory
   {
     EZ_IGNORE_UNUSED(sGroup);
     EZ_IGNORE_UNUSED(sRootName);
-    EZ_IGNORE_UNUSED(usage);
 
     FolderType* pDataDir = EZ_DEFAULT_NEW(FolderType);
+    pDataDir->m_bUseFileIndex = s_bUseFileIndex && usage == ezDataDirUsage::ReadOnly;
 
     if (pDataDir->InitializeDataDirectory(sDataDirectory) == EZ_SUCCESS)
       return pDataDir;
@@ -210,6 +222,9 @@ namespace ezDataDirectory
     ezStringBuilder sRedirectedAsset;
     ResolveAssetRedirection(sFile, sRedirectedAsset);
 
+    if (!MayContainFile(sRedirectedAsset))
+      return false;
+
     ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
     sPath.AppendPath(sRedirectedAsset);
     sPath.MakeCleanPath();
@@ -233,6 +248,10 @@ namespace ezDataDirectory
 
       sPath.Clear();
     }
+    else if (!MayContainFile(sRedirectedAsset))
+    {
+      return EZ_FAILURE;
+    }
 
     sPath.AppendPath(sRedirectedAsset);
 
@@ -267,9 +286,178 @@ namespace ezDataDirectory
 
     ReloadExternalConfigs();
 
+    if (m_bUseFileIndex)
+    {
+      BuildFileIndex();
+    }
+
     return EZ_SUCCESS;
   }
 
+  void FolderType::BuildFileIndex()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    EZ_LOG_BLOCK("BuildFileIndex", m_sRedirectedDataDirPath.GetData());
+
+#  if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    // start watching before scanning, so that nothing that changes in between is missed
+    m_pFileIndexWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+    if (m_pFileIndexWatcher->OpenDirectory(m_sRedirectedDataDirPath, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Failed())
+    {
+      ezLog::Warning("Can't watch data directory '{}' for changes, file index is disabled.", m_sRedirectedDataDirPath.GetView());
+      m_pFileIndexWatcher.Clear();
+      m_bUseFileIndex = false;
+      return;
+    }
+
+    m_LastFileIndexUpdate = ezTime::Now();
+    m_iLastFileIndexWriteCounter = s_iFolderWriteCounter;
+#  endif
+
+    ezStringBuilder sRoot = m_sRedirectedDataDirPath;
+    sRoot.MakeCleanPath();
+    sRoot.Trim(nullptr, "/");
+
+    EZ_LOCK(m_FileIndexLock);
+    m_FileIndex.Clear();
+
+    // the top-level folders are scanned in parallel, since the OS calls for iterating directories are the expensive part
+    ezDynamicArray<ezString> topLevelFolders;
+
+    ezFileSystemIterator it;
+    ezStringBuilder sPath;
+    for (it.StartSearch(sRoot, ezFileSystemIteratorFlags::ReportFiles | ezFileSystemIteratorFlags::ReportFolders); it.IsValid(); it.Next())
+    {
+      it.GetStats().GetFullPath(sPath);
+      AddToFileIndex(sPath, false);
+
+      if (it.GetStats().m_bIsDirectory)
+      {
+        topLevelFolders.PushBack(sPath);
+      }
+    }
+
+    ezDynamicArray<ezDynamicArray<ezString>> subFolderContent;
+    subFolderContent.SetCount(topLevelFolders.GetCount());
+
+    // folder sizes differ a lot, so let the workers balance them dynamically
+    ezParallelForParams params;
+    params.m_Partitioning = ezParallelForPartitioning::Adaptive;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, topLevelFolders.GetCount(), [&topLevelFolders, &subFolderContent](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        ezStringBuilder sPath;
+
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          ezFileSystemIterator it;
+          for (it.StartSearch(topLevelFolders[i], ezFileSystemIteratorFlags::ReportFilesAndFoldersRecursive); it.IsValid(); it.Next())
+          {
+            it.GetStats().GetFullPath(sPath);
+            subFolderContent[i].PushBack(sPath);
+          }
+        }
+      },
+      "BuildFileIndex", ezTaskNesting::Never, params);
+
+    for (const auto& content : subFolderContent)
+    {
+      for (const ezString& sFile : content)
+      {
+        AddToFileIndex(sFile, false);
+      }
+    }
+
+    ezLog::Dev("Indexed {} files and folders.", m_FileIndex.GetCount());
+#else
+    m_bUseFileIndex = false;
+#endif
+  }
+
+  void FolderType::AddToFileIndex(ezStringView sAbsolutePath, bool bIsFolder)
+  {
+    ezStringBuilder sKey = sAbsolutePath;
+    if (sKey.MakeRelativeTo(m_sRedirectedDataDirPath).Failed() || sKey.IsEmpty() || sKey.StartsWith(".."))
+      return;
+
+    sKey.ToLower();
+    m_FileIndex.Insert(sKey);
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    if (bIsFolder)
+    {
+      // when a folder gets moved into the data directory, no events are sent for its content
+      ezFileSystemIterator it;
+      ezStringBuilder sPath;
+      for (it.StartSearch(sAbsolutePath, ezFileSystemIteratorFlags::ReportFilesAndFoldersRecursive); it.IsValid(); it.Next())
+      {
+        it.GetStats().GetFullPath(sPath);
+        AddToFileIndex(sPath, false);
+      }
+    }
+#endif
+  }
+
+  void FolderType::UpdateFileIndex()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    if (m_pFileIndexWatcher == nullptr)
+      return;
+
+    // if another thread is already applying the changes, don't wait for it
+    if (m_FileIndexWatcherMutex.TryLock().Failed())
+      return;
+
+    const ezInt32 iWriteCounter = s_iFolderWriteCounter;
+    const ezTime tNow = ezTime::Now();
+
+    if (iWriteCounter != m_iLastFileIndexWriteCounter || tNow - m_LastFileIndexUpdate >= s_FileIndexUpdateInterval)
+    {
+      m_iLastFileIndexWriteCounter = iWriteCounter;
+      m_LastFileIndexUpdate = tNow;
+
+      m_pFileIndexWatcher->EnumerateChanges([this](ezStringView sFilename, ezDirectoryWatcherAction action, ezDirectoryWatcherType type)
+        {
+          // removed files are kept in the index, that only costs a failing lookup
+          if (action != ezDirectoryWatcherAction::Added && action != ezDirectoryWatcherAction::RenamedNewName)
+            return;
+
+          ezStringBuilder sPath = sFilename;
+          if (!sPath.IsAbsolutePath())
+          {
+            sPath.Set(m_sRedirectedDataDirPath, "/", sFilename);
+          }
+          sPath.MakeCleanPath();
+
+          EZ_LOCK(m_FileIndexLock);
+          AddToFileIndex(sPath, type == ezDirectoryWatcherType::Directory); });
+    }
+
+    m_FileIndexWatcherMutex.Unlock();
+#endif
+  }
+
+  bool FolderType::MayContainFile(ezStringView sRelativePath)
+  {
+    if (!m_bUseFileIndex)
+      return true;
+
+    ezStringBuilder sKey = sRelativePath;
+    sKey.MakeCleanPath();
+    sKey.Trim(nullptr, "/");
+
+    if (sKey.IsEmpty() || sKey.IsAbsolutePath() || sKey.StartsWith(".."))
+      return true;
+
+    sKey.ToLower();
+
+    UpdateFileIndex();
+
+    EZ_LOCK_READ(m_FileIndexLock);
+    return m_FileIndex.Contains(sKey);
+  }
+
   void FolderType::OnReaderWriterClose(ezDataDirectoryReaderWriterBase* pClosed)
   {
     EZ_LOCK(m_ReaderWriterMutex);
@@ -306,6 +494,9 @@ namespace ezDataDirectory
     if (ezConversionUtils::IsStringUuid(sFileToOpen))
       return nullptr;
 
+    if (!MayContainFile(sFileToOpen))
+      return nullptr;
+
     FolderReader* pReader = nullptr;
     {
       EZ_LOCK(m_ReaderWriterMutex);
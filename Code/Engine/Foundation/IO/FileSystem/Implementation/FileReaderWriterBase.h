@@ -36,6 +36,13 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns the entire file content as a read-only view into memory, if the data directory provides one.
+  ///
+  /// This is the case for uncompressed files inside memory mapped archives. It allows to parse the data without copying it first.
+  /// If an empty array is returned, the data has to be read through the stream interface.
+  /// The view is independent of the current read position and stays valid at least until the file is closed.
+  ezArrayPtr<const ezUInt8> GetMappedData() const { return m_pDataDirReader->GetMappedData(); }
+
 protected:
   ezDataDirectoryReader* GetFileReader(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
@@ -252,7 +252,7 @@ const ezDataDirectoryInfo* ezFileSystem::FindDataDirectoryWithRoot(ezStringView
     return nullptr;
 
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   for (const auto& dd : s_pData->m_DataDirectories)
   {
@@ -289,7 +289,7 @@ const ezDataDirectoryInfo& ezFileSystem::GetDataDirectoryInfo(ezUInt32 uiDataDir
 ezStringView ezFileSystem::GetDataDirRelativePath(ezStringView sPath, ezUInt32 uiDataDir)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   // if an absolute path is given, this will check whether the absolute path would fall into this data directory
   // if yes, the prefix path is removed and then only the relative path is given to the data directory type
@@ -333,10 +333,21 @@ ezStringView ezFileSystem::GetDataDirRelativePath(ezStringView sPath, ezUInt32 u
 }
 
 
+bool ezFileSystem::IsDataDirMounted(const ezDataDirectoryType* pDataDir)
+{
+  for (const ezDataDirectoryInfo& dataDir : s_pData->m_DataDirectories)
+  {
+    if (dataDir.m_pDataDirType == pDataDir)
+      return true;
+  }
+
+  return false;
+}
+
 ezDataDirectoryInfo* ezFileSystem::GetDataDirForRoot(const ezString& sRoot)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
@@ -366,31 +377,44 @@ void ezFileSystem::DeleteFile(ezStringView sFile)
   if (sRootName.IsEmpty())
     return;
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  // file events are broadcast without holding the lock, so that event handlers may mount or unmount data directories
+  ezHybridArray<DataDirCandidate, 16> candidates;
 
-  for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    // do not delete data from directories that are mounted as read only
-    if (s_pData->m_DataDirectories[i].m_Usage != ezDataDirUsage::AllowWrites)
-      continue;
+    EZ_LOCK_READ(s_pData->m_FsMutex);
 
-    if (s_pData->m_DataDirectories[i].m_sRootName != sRootName)
-      continue;
+    for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+    {
+      // do not delete data from directories that are mounted as read only
+      if (s_pData->m_DataDirectories[i].m_Usage != ezDataDirUsage::AllowWrites)
+        continue;
 
-    ezStringView sRelPath = GetDataDirRelativePath(sFile, i);
+      if (s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+        continue;
 
+      candidates.PushBack({s_pData->m_DataDirectories[i].m_pDataDirType, GetDataDirRelativePath(sFile, i)});
+    }
+  }
+
+  for (const DataDirCandidate& candidate : candidates)
+  {
     {
       // Broadcast that a file is about to be deleted
       // This can be used to check out files or mark them as deleted in a revision control system
       FileEvent fe;
       fe.m_EventType = FileEventType::DeleteFile;
-      fe.m_sFileOrDirectory = sRelPath;
-      fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirType;
+      fe.m_sFileOrDirectory = candidate.m_sRelPath;
+      fe.m_pDataDir = candidate.m_pDataDir;
       fe.m_sOther = sRootName;
       s_pData->m_Event.Broadcast(fe);
     }
 
-    s_pData->m_DataDirectories[i].m_pDataDirType->DeleteFile(sRelPath);
+    EZ_LOCK_READ(s_pData->m_FsMutex);
+
+    if (IsDataDirMounted(candidate.m_pDataDir))
+    {
+      candidate.m_pDataDir->DeleteFile(candidate.m_sRelPath);
+    }
   }
 }
 
@@ -403,7 +427,7 @@ bool ezFileSystem::ExistsFile(ezStringView sFile)
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
@@ -424,7 +448,7 @@ ezResult ezFileSystem::GetFileStats(ezStringView sFileOrFolder, ezFileStats& out
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   if (sFileOrFolder.IsEmpty())
   {
@@ -468,8 +492,6 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(ezStringView sFile, ezFileSha
   if (sFile.IsEmpty())
     return nullptr;
 
-  EZ_LOCK(s_pData->m_FsMutex);
-
   ezString sRootName;
   sFile = ExtractRootName(sFile, sRootName);
 
@@ -479,29 +501,48 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(ezStringView sFile, ezFileSha
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  // file events are broadcast without holding the lock, so that event handlers may mount or unmount data directories
+  ezHybridArray<DataDirCandidate, 16> candidates;
+
   {
-    // if a root is used, ignore all directories that do not have the same root name
-    if (bOneSpecificDataDir && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
-      continue;
+    EZ_LOCK_READ(s_pData->m_FsMutex);
+
+    // the last added data directory has the highest priority
+    for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+    {
+      // if a root is used, ignore all directories that do not have the same root name
+      if (bOneSpecificDataDir && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+        continue;
 
-    ezStringView sRelPath = GetDataDirRelativePath(sPath, i);
+      candidates.PushBack({s_pData->m_DataDirectories[i].m_pDataDirType, GetDataDirRelativePath(sPath, i)});
+    }
+  }
 
+  for (const DataDirCandidate& candidate : candidates)
+  {
     if (bAllowFileEvents)
     {
       // Broadcast that we now try to open this file
       // Could be useful to check this file out before it is accessed
       FileEvent fe;
       fe.m_EventType = FileEventType::OpenFileAttempt;
-      fe.m_sFileOrDirectory = sRelPath;
+      fe.m_sFileOrDirectory = candidate.m_sRelPath;
       fe.m_sOther = sRootName;
-      fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirType;
+      fe.m_pDataDir = candidate.m_pDataDir;
       s_pData->m_Event.Broadcast(fe);
     }
 
-    // Let the data directory try to open the file.
-    ezDataDirectoryReader* pReader = s_pData->m_DataDirectories[i].m_pDataDirType->OpenFileToRead(sRelPath, FileShareMode, bOneSpecificDataDir);
+    ezDataDirectoryReader* pReader = nullptr;
+
+    {
+      EZ_LOCK_READ(s_pData->m_FsMutex);
+
+      // Let the data directory try to open the file, unless an event handler has unmounted it in the meantime.
+      if (IsDataDirMounted(candidate.m_pDataDir))
+      {
+        pReader = candidate.m_pDataDir->OpenFileToRead(candidate.m_sRelPath, FileShareMode, bOneSpecificDataDir);
+      }
+    }
 
     if (pReader != nullptr)
     {
@@ -510,9 +551,9 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(ezStringView sFile, ezFileSha
         // Broadcast that this file has been opened.
         FileEvent fe;
         fe.m_EventType = FileEventType::OpenFileSucceeded;
-        fe.m_sFileOrDirectory = sRelPath;
+        fe.m_sFileOrDirectory = candidate.m_sRelPath;
         fe.m_sOther = sRootName;
-        fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirType;
+        fe.m_pDataDir = candidate.m_pDataDir;
         s_pData->m_Event.Broadcast(fe);
       }
 
@@ -539,8 +580,6 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(ezStringView sFile, ezFileSha
   if (sFile.IsEmpty())
     return nullptr;
 
-  EZ_LOCK(s_pData->m_FsMutex);
-
   ezString sRootName;
 
   if (!ezPathUtils::IsAbsolutePath(sFile))
@@ -556,31 +595,51 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(ezStringView sFile, ezFileSha
   ezStringBuilder sPath = sFile;
   sPath.MakeCleanPath();
 
-  // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  // file events are broadcast without holding the lock, so that event handlers may mount or unmount data directories
+  ezHybridArray<DataDirCandidate, 16> candidates;
+
   {
-    if (s_pData->m_DataDirectories[i].m_Usage != ezDataDirUsage::AllowWrites)
-      continue;
+    EZ_LOCK_READ(s_pData->m_FsMutex);
 
-    // ignore all directories that have not the category that is currently requested
-    if (s_pData->m_DataDirectories[i].m_sRootName != sRootName)
-      continue;
+    // the last added data directory has the highest priority
+    for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+    {
+      if (s_pData->m_DataDirectories[i].m_Usage != ezDataDirUsage::AllowWrites)
+        continue;
 
-    ezStringView sRelPath = GetDataDirRelativePath(sPath, i);
+      // ignore all directories that have not the category that is currently requested
+      if (s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+        continue;
 
+      candidates.PushBack({s_pData->m_DataDirectories[i].m_pDataDirType, GetDataDirRelativePath(sPath, i)});
+    }
+  }
+
+  for (const DataDirCandidate& candidate : candidates)
+  {
     if (bAllowFileEvents)
     {
       // Broadcast that we now try to open this file
       // Could be useful to check this file out before it is accessed
       FileEvent fe;
       fe.m_EventType = FileEventType::CreateFileAttempt;
-      fe.m_sFileOrDirectory = sRelPath;
+      fe.m_sFileOrDirectory = candidate.m_sRelPath;
       fe.m_sOther = sRootName;
-      fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirType;
+      fe.m_pDataDir = candidate.m_pDataDir;
       s_pData->m_Event.Broadcast(fe);
     }
 
-    ezDataDirectoryWriter* pWriter = s_pData->m_DataDirectories[i].m_pDataDirType->OpenFileToWrite(sRelPath, FileShareMode);
+    ezDataDirectoryWriter* pWriter = nullptr;
+
+    {
+      EZ_LOCK_READ(s_pData->m_FsMutex);
+
+      // an event handler may have unmounted the data directory in the meantime
+      if (IsDataDirMounted(candidate.m_pDataDir))
+      {
+        pWriter = candidate.m_pDataDir->OpenFileToWrite(candidate.m_sRelPath, FileShareMode);
+      }
+    }
 
     if (pWriter != nullptr)
     {
@@ -589,9 +648,9 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(ezStringView sFile, ezFileSha
         // Broadcast that this file has been created.
         FileEvent fe;
         fe.m_EventType = FileEventType::CreateFileSucceeded;
-        fe.m_sFileOrDirectory = sRelPath;
+        fe.m_sFileOrDirectory = candidate.m_sRelPath;
         fe.m_sOther = sRootName;
-        fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirType;
+        fe.m_pDataDir = candidate.m_pDataDir;
         s_pData->m_Event.Broadcast(fe);
       }
 
@@ -615,7 +674,7 @@ ezResult ezFileSystem::ResolvePath(ezStringView sPath, ezStringBuilder* out_pAbs
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   ezStringBuilder absPath, relPath;
 
@@ -785,7 +844,7 @@ ezResult ezFileSystem::FindFolderWithSubPath(ezStringBuilder& out_sResult, ezStr
 bool ezFileSystem::ResolveAssetRedirection(ezStringView sPathOrAssetGuid, ezStringBuilder& out_sRedirection)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   for (auto& dd : s_pData->m_DataDirectories)
   {
@@ -844,7 +903,7 @@ void ezFileSystem::ReloadAllExternalDataDirectoryConfigs()
   EZ_LOG_BLOCK("ReloadAllExternalDataDirectoryConfigs");
 
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   for (auto& dd : s_pData->m_DataDirectories)
   {
@@ -998,7 +1057,7 @@ ezResult ezFileSystem::ResolveSpecialDirectory(ezStringView sDirectory, ezString
 }
 
 
-ezMutex& ezFileSystem::GetMutex()
+ezReadWriteLock& ezFileSystem::GetMutex()
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
   return s_pData->m_FsMutex;
@@ -1009,7 +1068,7 @@ ezMutex& ezFileSystem::GetMutex()
 void ezFileSystem::StartSearch(ezFileSystemIterator& ref_iterator, ezStringView sSearchTerm, ezBitflags<ezFileSystemIteratorFlags> flags /*= ezFileSystemIteratorFlags::Default*/)
 {
   EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
-  EZ_LOCK(s_pData->m_FsMutex);
+  EZ_LOCK_READ(s_pData->m_FsMutex);
 
   ezHybridArray<ezString, 16> folders;
   ezStringBuilder sDdPath, sRelPath;
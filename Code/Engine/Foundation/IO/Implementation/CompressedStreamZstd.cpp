@@ -4,7 +4,12 @@
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+#  include <Foundation/IO/MemoryStream.h>
+#  include <Foundation/Memory/EndianHelper.h>
 #  include <Foundation/System/SystemInformation.h>
+#  include <Foundation/Threading/AtomicInteger.h>
+#  include <Foundation/Threading/TaskSystem.h>
+#  include <Foundation/Types/ScopeExit.h>
 #  include <zstd/zstd.h>
 
 ezCompressedStreamReaderZstd::ezCompressedStreamReaderZstd() = default;
@@ -304,4 +309,349 @@ ezResult ezCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUI
   return EZ_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+// The block compressed format is:
+//   compressed blocks (each one an independent zstd frame)
+//   ezUInt64 end offset of every block, relative to the start of the data
+//   footer: ezUInt64 uncompressed size, ezUInt32 block size, ezUInt32 number of blocks
+static constexpr ezUInt32 s_uiBlockCompressedFooterSize = sizeof(ezUInt64) + sizeof(ezUInt32) + sizeof(ezUInt32);
+
+ezBlockCompressedStreamWriterZstd::ezBlockCompressedStreamWriterZstd() = default;
+
+ezBlockCompressedStreamWriterZstd::ezBlockCompressedStreamWriterZstd(ezStreamWriter* pOutputStream, bool bCompressInParallel, ezCompressedStreamWriterZstd::Compression ratio /*= ezCompressedStreamWriterZstd::Compression::Default*/, ezUInt32 uiBlockSize /*= DefaultBlockSize*/)
+{
+  SetOutputStream(pOutputStream, bCompressInParallel, ratio, uiBlockSize);
+}
+
+ezBlockCompressedStreamWriterZstd::~ezBlockCompressedStreamWriterZstd()
+{
+  FinishCompressedStream().IgnoreResult();
+}
+
+void ezBlockCompressedStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream, bool bCompressInParallel, ezCompressedStreamWriterZstd::Compression ratio /*= ezCompressedStreamWriterZstd::Compression::Default*/, ezUInt32 uiBlockSize /*= DefaultBlockSize*/)
+{
+  EZ_ASSERT_DEV(uiBlockSize > 0, "Invalid block size");
+
+  // finish anything done on a previous output stream
+  FinishCompressedStream().IgnoreResult();
+
+  m_pOutputStream = pOutputStream;
+  m_bCompressInParallel = bCompressInParallel;
+  m_iCompressionLevel = static_cast<ezInt32>(ratio);
+  m_uiBlockSize = uiBlockSize;
+  m_uiBlocksPerBatch = bCompressInParallel ? ezMath::Max(1u, 2 * ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks)) : 1u;
+
+  m_uiUncompressedSize = 0;
+  m_uiWrittenBytes = 0;
+  m_PendingData.Clear();
+  m_BlockEnds.Clear();
+}
+
+ezResult ezBlockCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite)
+{
+  EZ_ASSERT_DEV(m_pOutputStream != nullptr, "The output stream is not set up or FinishCompressedStream() has already been called.");
+
+  const ezUInt64 uiBatchSize = static_cast<ezUInt64>(m_uiBlockSize) * m_uiBlocksPerBatch;
+  const ezUInt8* pSource = static_cast<const ezUInt8*>(pWriteBuffer);
+
+  while (uiBytesToWrite > 0)
+  {
+    const ezUInt32 uiPending = m_PendingData.GetCount();
+    const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToWrite, uiBatchSize - uiPending));
+
+    m_PendingData.SetCountUninitialized(uiPending + uiToCopy);
+    ezMemoryUtils::Copy(m_PendingData.GetData() + uiPending, pSource, uiToCopy);
+
+    pSource += uiToCopy;
+    uiBytesToWrite -= uiToCopy;
+    m_uiUncompressedSize += uiToCopy;
+
+    if (m_PendingData.GetCount() == uiBatchSize)
+    {
+      EZ_SUCCEED_OR_RETURN(CompressPendingBlocks());
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezBlockCompressedStreamWriterZstd::FinishCompressedStream()
+{
+  if (m_pOutputStream == nullptr)
+    return EZ_SUCCESS;
+
+  EZ_SCOPE_EXIT(m_pOutputStream = nullptr);
+
+  EZ_SUCCEED_OR_RETURN(CompressPendingBlocks());
+
+  for (const ezUInt64& uiBlockEnd : m_BlockEnds)
+  {
+    EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteQWordValue(&uiBlockEnd));
+  }
+
+  const ezUInt32 uiNumBlocks = m_BlockEnds.GetCount();
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteQWordValue(&m_uiUncompressedSize));
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteDWordValue(&m_uiBlockSize));
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteDWordValue(&uiNumBlocks));
+
+  m_uiWrittenBytes += uiNumBlocks * sizeof(ezUInt64) + s_uiBlockCompressedFooterSize;
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezBlockCompressedStreamWriterZstd::CompressPendingBlocks()
+{
+  if (m_PendingData.IsEmpty())
+    return EZ_SUCCESS;
+
+  const ezUInt32 uiNumBlocks = (m_PendingData.GetCount() + m_uiBlockSize - 1) / m_uiBlockSize;
+
+  if (m_CompressedBlocks.GetCount() < uiNumBlocks)
+  {
+    m_CompressedBlocks.SetCount(uiNumBlocks);
+  }
+
+  auto compressBlocks = [this](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock)
+  {
+    ZSTD_CCtx* pContext = ZSTD_createCCtx();
+
+    for (ezUInt32 uiBlock = uiStartBlock; uiBlock < uiEndBlock; ++uiBlock)
+    {
+      const ezUInt32 uiOffset = uiBlock * m_uiBlockSize;
+      const ezUInt32 uiSize = ezMath::Min(m_uiBlockSize, m_PendingData.GetCount() - uiOffset);
+
+      ezDynamicArray<ezUInt8>& compressed = m_CompressedBlocks[uiBlock];
+      compressed.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(uiSize)));
+
+      const size_t res = ZSTD_compressCCtx(pContext, compressed.GetData(), compressed.GetCount(), m_PendingData.GetData() + uiOffset, uiSize, m_iCompressionLevel);
+
+      // an empty block signals the error, a valid zstd frame is never empty
+      compressed.SetCountUninitialized(ZSTD_isError(res) ? 0u : static_cast<ezUInt32>(res));
+    }
+
+    ZSTD_freeCCtx(pContext);
+  };
+
+  if (m_bCompressInParallel && uiNumBlocks > 1)
+  {
+    ezTaskSystem::ParallelForIndexed(0, uiNumBlocks, compressBlocks, "Compress Blocks");
+  }
+  else
+  {
+    compressBlocks(0, uiNumBlocks);
+  }
+
+  m_PendingData.Clear();
+
+  for (ezUInt32 uiBlock = 0; uiBlock < uiNumBlocks; ++uiBlock)
+  {
+    const ezDynamicArray<ezUInt8>& compressed = m_CompressedBlocks[uiBlock];
+
+    if (compressed.IsEmpty())
+      return EZ_FAILURE;
+
+    EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(compressed.GetData(), compressed.GetCount()));
+
+    m_uiWrittenBytes += compressed.GetCount();
+    m_BlockEnds.PushBack(m_uiWrittenBytes);
+  }
+
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezBlockCompressedStreamReaderZstd::ezBlockCompressedStreamReaderZstd() = default;
+
+ezBlockCompressedStreamReaderZstd::~ezBlockCompressedStreamReaderZstd()
+{
+  if (m_pZstdDCtx != nullptr)
+  {
+    ZSTD_freeDCtx(reinterpret_cast<ZSTD_DCtx*>(m_pZstdDCtx));
+    m_pZstdDCtx = nullptr;
+  }
+}
+
+ezResult ezBlockCompressedStreamReaderZstd::SetInputData(const void* pData, ezUInt64 uiDataSize)
+{
+  m_pData = nullptr;
+  m_uiUncompressedSize = 0;
+  m_uiReadPosition = 0;
+  m_uiBlockSize = 0;
+  m_uiCachedBlock = ezInvalidIndex;
+  m_BlockEnds.Clear();
+
+  if (uiDataSize < s_uiBlockCompressedFooterSize)
+    return EZ_FAILURE;
+
+  const ezUInt8* pBytes = static_cast<const ezUInt8*>(pData);
+
+  ezUInt64 uiUncompressedSize = 0;
+  ezUInt32 uiBlockSize = 0;
+  ezUInt32 uiNumBlocks = 0;
+
+  ezRawMemoryStreamReader footer(pBytes + uiDataSize - s_uiBlockCompressedFooterSize, s_uiBlockCompressedFooterSize);
+  footer >> uiUncompressedSize;
+  footer >> uiBlockSize;
+  footer >> uiNumBlocks;
+
+  if (uiBlockSize == 0 || (uiUncompressedSize + uiBlockSize - 1) / uiBlockSize != uiNumBlocks)
+    return EZ_FAILURE;
+
+  const ezUInt64 uiIndexSize = static_cast<ezUInt64>(uiNumBlocks) * sizeof(ezUInt64);
+  if (uiIndexSize + s_uiBlockCompressedFooterSize > uiDataSize)
+    return EZ_FAILURE;
+
+  const ezUInt64 uiIndexOffset = uiDataSize - s_uiBlockCompressedFooterSize - uiIndexSize;
+
+  m_BlockEnds.SetCountUninitialized(uiNumBlocks);
+  ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(m_BlockEnds.GetData()), pBytes + uiIndexOffset, static_cast<size_t>(uiIndexSize));
+  ezEndianHelper::LittleEndianToNative(m_BlockEnds.GetData(), uiNumBlocks);
+
+  ezUInt64 uiPrevEnd = 0;
+  for (ezUInt64 uiBlockEnd : m_BlockEnds)
+  {
+    if (uiBlockEnd < uiPrevEnd || uiBlockEnd > uiIndexOffset)
+    {
+      m_BlockEnds.Clear();
+      return EZ_FAILURE;
+    }
+
+    uiPrevEnd = uiBlockEnd;
+  }
+
+  m_pData = pBytes;
+  m_uiUncompressedSize = uiUncompressedSize;
+  m_uiBlockSize = uiBlockSize;
+
+  return EZ_SUCCESS;
+}
+
+ezUInt32 ezBlockCompressedStreamReaderZstd::GetBlockSize(ezUInt32 uiBlock) const
+{
+  return static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiBlockSize, m_uiUncompressedSize - static_cast<ezUInt64>(uiBlock) * m_uiBlockSize));
+}
+
+ezResult ezBlockCompressedStreamReaderZstd::DecompressBlock(ezUInt32 uiBlock, void* pTarget, void* pContext) const
+{
+  const ezUInt64 uiStart = GetBlockStart(uiBlock);
+  const ezUInt32 uiSize = GetBlockSize(uiBlock);
+
+  const size_t res = ZSTD_decompressDCtx(reinterpret_cast<ZSTD_DCtx*>(pContext), pTarget, uiSize, m_pData + uiStart, ezMath::SafeConvertToSizeT(m_BlockEnds[uiBlock] - uiStart));
+
+  if (ZSTD_isError(res) || res != uiSize)
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezBlockCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiUncompressedSize - m_uiReadPosition);
+
+  if (pReadBuffer == nullptr)
+    return SkipBytes(uiBytesToRead);
+
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  if (m_pZstdDCtx == nullptr && uiBytesToRead > 0)
+  {
+    m_pZstdDCtx = ZSTD_createDCtx();
+  }
+
+  while (uiBytesRead < uiBytesToRead)
+  {
+    const ezUInt32 uiBlock = static_cast<ezUInt32>(m_uiReadPosition / m_uiBlockSize);
+    const ezUInt32 uiOffsetInBlock = static_cast<ezUInt32>(m_uiReadPosition - static_cast<ezUInt64>(uiBlock) * m_uiBlockSize);
+    const ezUInt64 uiRemaining = uiBytesToRead - uiBytesRead;
+
+    if (uiOffsetInBlock == 0)
+    {
+      // only the very last block may be smaller than the block size, so if the read goes up to the end, all remaining blocks are complete
+      const ezUInt32 uiNumBlocksLeft = m_BlockEnds.GetCount() - uiBlock;
+      const ezUInt32 uiNumCompleteBlocks = (m_uiReadPosition + uiRemaining == m_uiUncompressedSize) ? uiNumBlocksLeft : static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiRemaining / m_uiBlockSize, uiNumBlocksLeft));
+
+      if (uiNumCompleteBlocks > 0)
+      {
+        // decompress straight into the target buffer, no need to go through the cache
+        const ezUInt64 uiBytes = static_cast<ezUInt64>(uiNumCompleteBlocks - 1) * m_uiBlockSize + GetBlockSize(uiBlock + uiNumCompleteBlocks - 1);
+
+        if (uiNumCompleteBlocks == 1)
+        {
+          if (DecompressBlock(uiBlock, pTarget, m_pZstdDCtx).Failed())
+            break;
+        }
+        else
+        {
+          ezAtomicBool bFailed;
+
+          ezTaskSystem::ParallelForIndexed(uiBlock, uiNumCompleteBlocks, [this, pTarget, uiBlock, &bFailed](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock)
+            {
+              ZSTD_DCtx* pContext = ZSTD_createDCtx();
+
+              for (ezUInt32 uiCurBlock = uiStartBlock; uiCurBlock < uiEndBlock; ++uiCurBlock)
+              {
+                if (DecompressBlock(uiCurBlock, pTarget + static_cast<ezUInt64>(uiCurBlock - uiBlock) * m_uiBlockSize, pContext).Failed())
+                {
+                  bFailed = true;
+                }
+              }
+
+              ZSTD_freeDCtx(pContext); },
+            "Decompress Blocks");
+
+          if (bFailed)
+            break;
+        }
+
+        pTarget += uiBytes;
+        uiBytesRead += uiBytes;
+        m_uiReadPosition += uiBytes;
+        continue;
+      }
+    }
+
+    if (m_uiCachedBlock != uiBlock)
+    {
+      m_CachedBlock.SetCountUninitialized(m_uiBlockSize);
+
+      if (DecompressBlock(uiBlock, m_CachedBlock.GetData(), m_pZstdDCtx).Failed())
+      {
+        m_uiCachedBlock = ezInvalidIndex;
+        break;
+      }
+
+      m_uiCachedBlock = uiBlock;
+    }
+
+    const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiRemaining, GetBlockSize(uiBlock) - uiOffsetInBlock));
+    ezMemoryUtils::Copy(pTarget, m_CachedBlock.GetData() + uiOffsetInBlock, uiToCopy);
+
+    pTarget += uiToCopy;
+    uiBytesRead += uiToCopy;
+    m_uiReadPosition += uiToCopy;
+  }
+
+  return uiBytesRead;
+}
+
+ezUInt64 ezBlockCompressedStreamReaderZstd::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  uiBytesToSkip = ezMath::Min(uiBytesToSkip, m_uiUncompressedSize - m_uiReadPosition);
+  m_uiReadPosition += uiBytesToSkip;
+  return uiBytesToSkip;
+}
+
+void ezBlockCompressedStreamReaderZstd::SetReadPosition(ezUInt64 uiReadPosition)
+{
+  EZ_ASSERT_DEV(uiReadPosition <= m_uiUncompressedSize, "Read position {} is outside of the data (size {})", uiReadPosition, m_uiUncompressedSize);
+  m_uiReadPosition = ezMath::Min(uiReadPosition, m_uiUncompressedSize);
+}
+
 #endif
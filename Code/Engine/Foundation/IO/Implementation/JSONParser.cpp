@@ -8,7 +8,6 @@ ezJSONParser::ezJSONParser()
 {
   m_uiCurByte = '\0';
   m_uiNextByte = '\0';
-  m_pInput = nullptr;
   m_bSkippingMode = false;
   m_pLogInterface = nullptr;
   m_uiCurLine = 1;
@@ -16,6 +15,18 @@ ezJSONParser::ezJSONParser()
 }
 
 void ezJSONParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset)
+{
+  m_Input.SetInputStream(stream);
+  StartInput(uiFirstLineOffset);
+}
+
+void ezJSONParser::SetInputData(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  m_Input.SetInputData(data);
+  StartInput(uiFirstLineOffset);
+}
+
+void ezJSONParser::StartInput(ezUInt32 uiFirstLineOffset)
 {
   m_StateStack.Clear();
   m_uiCurByte = '\0';
@@ -24,8 +35,6 @@ void ezJSONParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOf
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
 
-  m_pInput = &stream;
-
   m_uiNextByte = ' ';
   ReadCharacter(true);
 
@@ -475,7 +484,7 @@ void ezJSONParser::ContinueSeparator()
 
 void ezJSONParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  m_uiNextByte = m_Input.ReadByte();
 
   if (m_uiNextByte == '\n')
   {
@@ -486,6 +495,22 @@ void ezJSONParser::ReadNextByte()
     ++m_uiCurColumn;
 }
 
+void ezJSONParser::SkipBufferedBytes(ezUInt32 uiNumBytes)
+{
+  // This is the same as calling ReadCharacter(false) for m_uiNextByte and the next uiNumBytes buffered bytes.
+  // The caller must make sure that none of them is treated specially (comments, end of the document).
+  if (uiNumBytes > 0)
+  {
+    m_uiCurByte = m_Input.SkipBufferedData(uiNumBytes, m_uiCurLine, m_uiCurColumn);
+  }
+  else
+  {
+    m_uiCurByte = m_uiNextByte;
+  }
+
+  ReadNextByte();
+}
+
 bool ezJSONParser::ReadCharacter(bool bSkipComments)
 {
   m_uiCurByte = m_uiNextByte;
@@ -533,10 +558,17 @@ bool ezJSONParser::ReadCharacter(bool bSkipComments)
 
 void ezJSONParser::SkipWhitespace()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsInitialized(), "Input Stream is not set up.");
 
   do
   {
+    if (ezStringUtils::IsWhiteSpace(m_uiNextByte))
+    {
+      // skip all whitespace that is already buffered at once
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      SkipBufferedBytes(ezInternal::TextParserInput::CountWhitespace(buffered.GetPtr(), buffered.GetCount()));
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(true))
@@ -546,7 +578,7 @@ void ezJSONParser::SkipWhitespace()
 
 void ezJSONParser::SkipString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsInitialized(), "Input Stream is not set up.");
 
   m_TempString.Clear();
   m_TempString.PushBack('\0');
@@ -555,6 +587,12 @@ void ezJSONParser::SkipString()
 
   do
   {
+    if (m_uiCurByte != '\\' && ezInternal::TextParserInput::IsStringCharacter(m_uiNextByte))
+    {
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      SkipBufferedBytes(ezInternal::TextParserInput::CountStringCharacters(buffered.GetPtr(), buffered.GetCount()));
+    }
+
     bEscapeSequence = (m_uiCurByte == '\\');
 
     m_uiCurByte = '\0';
@@ -570,7 +608,7 @@ void ezJSONParser::SkipString()
 
 void ezJSONParser::ReadString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsInitialized(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -578,6 +616,18 @@ void ezJSONParser::ReadString()
 
   while (true)
   {
+    if (m_uiCurByte != '\\' && ezInternal::TextParserInput::IsStringCharacter(m_uiNextByte))
+    {
+      // copy all buffered characters up to the next quote, escape sequence or line break at once
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      const ezUInt32 uiNumBytes = ezInternal::TextParserInput::CountStringCharacters(buffered.GetPtr(), buffered.GetCount());
+
+      m_TempString.PushBack(m_uiNextByte);
+      m_TempString.PushBackRange(buffered.GetSubArray(0, uiNumBytes));
+      SkipBufferedBytes(uiNumBytes);
+      continue;
+    }
+
     bEscapeSequence = (m_uiCurByte == '\\');
 
     m_uiCurByte = '\0';
@@ -706,7 +756,7 @@ void ezJSONParser::ReadString()
 
 void ezJSONParser::ReadWord()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsInitialized(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -725,7 +775,7 @@ void ezJSONParser::ReadWord()
 
 double ezJSONParser::ReadNumber()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_Input.IsInitialized(), "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -733,6 +783,16 @@ double ezJSONParser::ReadNumber()
   {
     m_TempString.PushBack(m_uiCurByte);
 
+    if (ezInternal::TextParserInput::IsNumberCharacter(m_uiNextByte, false))
+    {
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      const ezUInt32 uiNumBytes = ezInternal::TextParserInput::CountNumberCharacters(buffered.GetPtr(), buffered.GetCount(), false);
+
+      m_TempString.PushBack(m_uiNextByte);
+      m_TempString.PushBackRange(buffered.GetSubArray(0, uiNumBytes));
+      SkipBufferedBytes(uiNumBytes);
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(true))
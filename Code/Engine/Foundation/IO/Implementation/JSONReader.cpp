@@ -9,13 +9,30 @@ ezJSONReader::ezJSONReader()
 }
 
 ezResult ezJSONReader::Parse(ezStreamReader& ref_inputStream, ezUInt32 uiFirstLineOffset)
+{
+  ResetState();
+  SetInputStream(ref_inputStream, uiFirstLineOffset);
+
+  return ParseInput();
+}
+
+ezResult ezJSONReader::Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  ResetState();
+  SetInputData(data, uiFirstLineOffset);
+
+  return ParseInput();
+}
+
+void ezJSONReader::ResetState()
 {
   m_bParsingError = false;
   m_Stack.Clear();
   m_sLastName.Clear();
+}
 
-  SetInputStream(ref_inputStream, uiFirstLineOffset);
-
+ezResult ezJSONReader::ParseInput()
+{
   while (!m_bParsingError && ContinueParsing())
   {
   }
@@ -37,10 +37,22 @@ bool IsDdlIdentifierCharacter(ezUInt32 uiByte)
 
 void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset /*= 0*/)
 {
-  EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
+  EZ_ASSERT_DEV(m_StateStack.IsEmpty() && !m_Input.IsInitialized(), "OpenDDL Parser cannot be restarted");
 
-  m_pInput = &stream;
+  m_Input.SetInputStream(stream);
+  StartInput(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::SetInputData(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  EZ_ASSERT_DEV(m_StateStack.IsEmpty() && !m_Input.IsInitialized(), "OpenDDL Parser cannot be restarted");
+
+  m_Input.SetInputData(data);
+  StartInput(uiFirstLineOffset);
+}
 
+void ezOpenDdlParser::StartInput(ezUInt32 uiFirstLineOffset)
+{
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
@@ -184,7 +196,7 @@ void ezOpenDdlParser::ParsingError(ezStringView sMessage, bool bFatal)
 
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  m_uiNextByte = m_Input.ReadByte();
 
   if (m_uiNextByte == '\n')
   {
@@ -195,6 +207,39 @@ void ezOpenDdlParser::ReadNextByte()
     ++m_uiCurColumn;
 }
 
+void ezOpenDdlParser::SkipBufferedBytes(ezUInt32 uiNumBytes)
+{
+  // This is the same as calling ReadCharacter() for m_uiNextByte and the next uiNumBytes buffered bytes.
+  // The caller must make sure that none of them is treated specially (comments, end of the document).
+  if (uiNumBytes > 0)
+  {
+    m_uiCurByte = m_Input.SkipBufferedData(uiNumBytes, m_uiCurLine, m_uiCurColumn);
+  }
+  else
+  {
+    m_uiCurByte = m_uiNextByte;
+  }
+
+  ReadNextByte();
+}
+
+void ezOpenDdlParser::AppendBufferedBytesToTempString(ezUInt32 uiNumBytes)
+{
+  // appends m_uiNextByte and the next uiNumBytes buffered bytes, and keeps room for two more bytes, like ReadString() does
+  const ezUInt32 uiRequired = m_uiTempStringLength + 1 + uiNumBytes + 2;
+
+  if (uiRequired >= m_TempString.GetCount())
+  {
+    m_TempString.SetCountUninitialized(ezMath::Max(uiRequired + 1, m_TempString.GetCount() * 2));
+  }
+
+  m_TempString[m_uiTempStringLength] = m_uiNextByte;
+  ezMemoryUtils::Copy(&m_TempString[m_uiTempStringLength + 1], m_Input.GetBufferedData().GetPtr(), uiNumBytes);
+  m_uiTempStringLength += 1 + uiNumBytes;
+
+  SkipBufferedBytes(uiNumBytes);
+}
+
 bool ezOpenDdlParser::ReadCharacter()
 {
   m_uiCurByte = m_uiNextByte;
@@ -254,6 +299,13 @@ void ezOpenDdlParser::SkipWhitespace()
 {
   do
   {
+    if (ezStringUtils::IsWhiteSpace(m_uiNextByte))
+    {
+      // skip all whitespace that is already buffered at once
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      SkipBufferedBytes(ezInternal::TextParserInput::CountWhitespace(buffered.GetPtr(), buffered.GetCount()));
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacterSkipComments())
@@ -594,6 +646,14 @@ void ezOpenDdlParser::ReadString()
 
   while (true)
   {
+    if (m_uiCurByte != '\\' && ezInternal::TextParserInput::IsStringCharacter(m_uiNextByte))
+    {
+      // copy all buffered characters up to the next quote, escape sequence or line break at once
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      AppendBufferedBytesToTempString(ezInternal::TextParserInput::CountStringCharacters(buffered.GetPtr(), buffered.GetCount()));
+      continue;
+    }
+
     const bool bEscapeSequence = (m_uiCurByte == '\\');
 
     m_uiCurByte = '\0';
@@ -832,6 +892,12 @@ void ezOpenDdlParser::SkipString()
 
   do
   {
+    if (m_uiCurByte != '\\' && ezInternal::TextParserInput::IsStringCharacter(m_uiNextByte))
+    {
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      SkipBufferedBytes(ezInternal::TextParserInput::CountStringCharacters(buffered.GetPtr(), buffered.GetCount()));
+    }
+
     bEscapeSequence = (m_uiCurByte == '\\');
 
     m_uiCurByte = '\0';
@@ -1157,6 +1223,12 @@ void ezOpenDdlParser::ReadDecimalFloat()
     m_TempString[m_uiTempStringLength] = m_uiCurByte;
     ++m_uiTempStringLength;
 
+    if (ezInternal::TextParserInput::IsNumberCharacter(m_uiNextByte, true))
+    {
+      const ezArrayPtr<const ezUInt8> buffered = m_Input.GetBufferedData();
+      AppendBufferedBytesToTempString(ezInternal::TextParserInput::CountNumberCharacters(buffered.GetPtr(), buffered.GetCount(), true));
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacterSkipComments())
@@ -56,6 +56,11 @@ ezResult ezStringDeduplicationWriteContext::End()
 }
 
 void ezStringDeduplicationWriteContext::SerializeString(const ezStringView& sString, ezStreamWriter& ref_writer)
+{
+  ref_writer << DeduplicateString(sString);
+}
+
+ezUInt32 ezStringDeduplicationWriteContext::DeduplicateString(ezStringView sString)
 {
   bool bAlreadDeduplicated = false;
   auto it = m_DeduplicatedStrings.FindOrAdd(sString, &bAlreadDeduplicated);
@@ -65,7 +70,7 @@ void ezStringDeduplicationWriteContext::SerializeString(const ezStringView& sStr
     it.Value() = m_DeduplicatedStrings.GetCount() - 1;
   }
 
-  ref_writer << it.Value();
+  return it.Value();
 }
 
 ezUInt32 ezStringDeduplicationWriteContext::GetUniqueStringCount() const
@@ -73,6 +78,16 @@ ezUInt32 ezStringDeduplicationWriteContext::GetUniqueStringCount() const
   return m_DeduplicatedStrings.GetCount();
 }
 
+void ezStringDeduplicationWriteContext::GetUniqueStrings(ezDynamicArray<ezStringView>& out_strings) const
+{
+  out_strings.SetCount(m_DeduplicatedStrings.GetCount());
+
+  for (const auto& it : m_DeduplicatedStrings)
+  {
+    out_strings[it.Value()] = it.Key().GetView();
+  }
+}
+
 
 EZ_IMPLEMENT_SERIALIZATION_CONTEXT(ezStringDeduplicationReadContext)
 
@@ -101,6 +116,12 @@ ezStringDeduplicationReadContext::ezStringDeduplicationReadContext(ezStreamReade
   SetContext(this);
 }
 
+ezStringDeduplicationReadContext::ezStringDeduplicationReadContext(ezArrayPtr<const ezStringView> strings)
+  : ezSerializationContext()
+  , m_ExternalStrings(strings)
+{
+}
+
 ezStringDeduplicationReadContext::~ezStringDeduplicationReadContext() = default;
 
 ezStringView ezStringDeduplicationReadContext::DeserializeString(ezStreamReader& ref_reader)
@@ -108,6 +129,17 @@ ezStringView ezStringDeduplicationReadContext::DeserializeString(ezStreamReader&
   ezUInt32 uiIndex = ezInvalidIndex;
   ref_reader >> uiIndex;
 
+  if (!m_ExternalStrings.IsEmpty())
+  {
+    if (uiIndex >= m_ExternalStrings.GetCount())
+    {
+      EZ_ASSERT_DEBUG(uiIndex < m_ExternalStrings.GetCount(), "Failed to read data from file.");
+      return {};
+    }
+
+    return m_ExternalStrings[uiIndex];
+  }
+
   if (uiIndex >= m_DeduplicatedStrings.GetCount())
   {
     EZ_ASSERT_DEBUG(uiIndex < m_DeduplicatedStrings.GetCount(), "Failed to read data from file.");
@@ -0,0 +1,207 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/Implementation/TextParserInput.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+
+namespace
+{
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  /// Returns the index of the first byte for which MatchMask doesn't report a match, only looking at complete blocks of 16 bytes.
+  /// If all those bytes match, the index after the last complete block is returned, the rest needs to be checked by the caller.
+  template <typename MatchMask>
+  EZ_ALWAYS_INLINE ezUInt32 CountMatchingBlocks(const ezUInt8* pData, ezUInt32 uiCount, MatchMask matchMask)
+  {
+    ezUInt32 i = 0;
+
+    for (; i + 16 <= uiCount; i += 16)
+    {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+      const ezUInt32 uiMismatch = ~matchMask(bytes) & 0xFFFFu;
+
+      if (uiMismatch != 0)
+        return i + ezMath::FirstBitLow(uiMismatch);
+    }
+
+    return i;
+  }
+#endif
+} // namespace
+
+void ezInternal::TextParserInput::SetInputStream(ezStreamReader& inout_stream)
+{
+  m_bInitialized = true;
+  m_pStream = &inout_stream;
+  m_pData = nullptr;
+  m_uiReadPos = 0;
+  m_uiDataSize = 0;
+}
+
+void ezInternal::TextParserInput::SetInputData(ezArrayPtr<const ezUInt8> data)
+{
+  m_bInitialized = true;
+  m_pStream = nullptr;
+  m_pData = data.GetPtr();
+  m_uiReadPos = 0;
+  m_uiDataSize = data.GetCount();
+}
+
+ezUInt8 ezInternal::TextParserInput::ReadNextChunk()
+{
+  if (m_pStream == nullptr)
+    return '\0';
+
+  if (m_Chunk.IsEmpty())
+  {
+    m_Chunk.SetCountUninitialized(ChunkSize);
+  }
+
+  m_pData = m_Chunk.GetData();
+  m_uiReadPos = 0;
+  m_uiDataSize = static_cast<ezUInt32>(m_pStream->ReadBytes(m_Chunk.GetData(), ChunkSize));
+
+  if (m_uiDataSize == 0)
+  {
+    // end of the stream, don't try to read from it again
+    m_pStream = nullptr;
+    return '\0';
+  }
+
+  return m_pData[m_uiReadPos++];
+}
+
+ezUInt8 ezInternal::TextParserInput::SkipBufferedData(ezUInt32 uiNumBytes, ezUInt32& inout_uiLine, ezUInt32& inout_uiColumn)
+{
+  EZ_ASSERT_DEBUG(uiNumBytes > 0 && m_uiReadPos + uiNumBytes <= m_uiDataSize, "Can only skip data that is buffered.");
+
+  const ezUInt8* pBytes = m_pData + m_uiReadPos;
+
+  ezUInt32 uiLastLineBreak = 0;
+  const ezUInt32 uiNumLineBreaks = CountLineBreaks(pBytes, uiNumBytes, uiLastLineBreak);
+
+  if (uiNumLineBreaks > 0)
+  {
+    inout_uiLine += uiNumLineBreaks;
+    inout_uiColumn = uiNumBytes - 1 - uiLastLineBreak;
+  }
+  else
+  {
+    inout_uiColumn += uiNumBytes;
+  }
+
+  m_uiReadPos += uiNumBytes;
+  return pBytes[uiNumBytes - 1];
+}
+
+ezUInt32 ezInternal::TextParserInput::CountWhitespace(const ezUInt8* pData, ezUInt32 uiCount)
+{
+  ezUInt32 i = 0;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  // bytes are compared as signed values, so everything above 127 is negative and not whitespace
+  const __m128i lower = _mm_setzero_si128();
+  const __m128i upper = _mm_set1_epi8(33);
+
+  i = CountMatchingBlocks(pData, uiCount, [&](__m128i bytes)
+    { return (ezUInt32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(bytes, lower), _mm_cmplt_epi8(bytes, upper))); });
+#endif
+
+  for (; i < uiCount; ++i)
+  {
+    if (pData[i] < 1 || pData[i] > 32)
+      break;
+  }
+
+  return i;
+}
+
+ezUInt32 ezInternal::TextParserInput::CountStringCharacters(const ezUInt8* pData, ezUInt32 uiCount)
+{
+  ezUInt32 i = 0;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  const __m128i quote = _mm_set1_epi8('\"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i lineBreak = _mm_set1_epi8('\n');
+  const __m128i zero = _mm_setzero_si128();
+
+  i = CountMatchingBlocks(pData, uiCount, [&](__m128i bytes)
+    {
+      const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, lineBreak), _mm_cmpeq_epi8(bytes, zero)));
+      return ~(ezUInt32)_mm_movemask_epi8(special); });
+#endif
+
+  for (; i < uiCount; ++i)
+  {
+    if (!IsStringCharacter(pData[i]))
+      break;
+  }
+
+  return i;
+}
+
+ezUInt32 ezInternal::TextParserInput::CountNumberCharacters(const ezUInt8* pData, ezUInt32 uiCount, bool bAllowUnderscore)
+{
+  ezUInt32 i = 0;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  const __m128i digitLower = _mm_set1_epi8('0' - 1);
+  const __m128i digitUpper = _mm_set1_epi8('9' + 1);
+  const __m128i dot = _mm_set1_epi8('.');
+  const __m128i lowerE = _mm_set1_epi8('e');
+  const __m128i upperE = _mm_set1_epi8('E');
+  const __m128i plus = _mm_set1_epi8('+');
+  const __m128i minus = _mm_set1_epi8('-');
+  // if underscores are not allowed, compare against a byte that never passes the scalar check either
+  const __m128i underscore = _mm_set1_epi8(bAllowUnderscore ? '_' : '.');
+
+  i = CountMatchingBlocks(pData, uiCount, [&](__m128i bytes)
+    {
+      const __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(bytes, digitLower), _mm_cmplt_epi8(bytes, digitUpper));
+      const __m128i signs = _mm_or_si128(_mm_cmpeq_epi8(bytes, plus), _mm_cmpeq_epi8(bytes, minus));
+      const __m128i other = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, dot), _mm_cmpeq_epi8(bytes, underscore)),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, lowerE), _mm_cmpeq_epi8(bytes, upperE)));
+      return (ezUInt32)_mm_movemask_epi8(_mm_or_si128(digits, _mm_or_si128(signs, other))); });
+#endif
+
+  for (; i < uiCount; ++i)
+  {
+    if (!IsNumberCharacter(pData[i], bAllowUnderscore))
+      break;
+  }
+
+  return i;
+}
+
+ezUInt32 ezInternal::TextParserInput::CountLineBreaks(const ezUInt8* pData, ezUInt32 uiCount, ezUInt32& out_uiLastLineBreak)
+{
+  ezUInt32 uiNumLineBreaks = 0;
+  ezUInt32 i = 0;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  const __m128i lineBreak = _mm_set1_epi8('\n');
+
+  for (; i + 16 <= uiCount; i += 16)
+  {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+    const ezUInt32 uiMask = (ezUInt32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lineBreak));
+
+    if (uiMask != 0)
+    {
+      uiNumLineBreaks += ezMath::CountBits(uiMask);
+      out_uiLastLineBreak = i + ezMath::FirstBitHigh(uiMask);
+    }
+  }
+#endif
+
+  for (; i < uiCount; ++i)
+  {
+    if (pData[i] == '\n')
+    {
+      ++uiNumLineBreaks;
+      out_uiLastLineBreak = i;
+    }
+  }
+
+  return uiNumLineBreaks;
+}
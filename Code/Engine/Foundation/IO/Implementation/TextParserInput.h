@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+
+namespace ezInternal
+{
+  /// \brief The input of ezJSONParser and ezOpenDdlParser.
+  ///
+  /// Streams are read in large chunks, so that the parsers don't pay for a virtual function call per byte.
+  /// Documents that are already in memory (e.g. memory mapped files) are parsed directly, without any copy.
+  /// Since the stream is read ahead, its read position is undefined after parsing.
+  ///
+  /// The Count functions find the end of runs of whitespace, string or number characters in the buffered data with SIMD instructions,
+  /// which allows the parsers to consume those runs at once.
+  class EZ_FOUNDATION_DLL TextParserInput
+  {
+  public:
+    static constexpr ezUInt32 ChunkSize = 16 * 1024;
+
+    void SetInputStream(ezStreamReader& inout_stream);
+    void SetInputData(ezArrayPtr<const ezUInt8> data);
+
+    bool IsInitialized() const { return m_bInitialized; }
+
+    /// \brief Returns the next byte, or '\0' when the end of the input is reached.
+    EZ_ALWAYS_INLINE ezUInt8 ReadByte()
+    {
+      if (m_uiReadPos < m_uiDataSize)
+        return m_pData[m_uiReadPos++];
+
+      return ReadNextChunk();
+    }
+
+    /// \brief Returns the bytes that have been buffered, but were not read yet.
+    ///
+    /// This may be empty, even though the end of the input is not reached yet.
+    EZ_ALWAYS_INLINE ezArrayPtr<const ezUInt8> GetBufferedData() const { return ezArrayPtr<const ezUInt8>(m_pData + m_uiReadPos, m_uiDataSize - m_uiReadPos); }
+
+    /// \brief Marks the first uiNumBytes of GetBufferedData() as read and returns the last of them.
+    ///
+    /// The line and column are advanced as if the bytes were read one by one, a '\n' starts the next line at column 0.
+    /// uiNumBytes must not be zero.
+    ezUInt8 SkipBufferedData(ezUInt32 uiNumBytes, ezUInt32& inout_uiLine, ezUInt32& inout_uiColumn);
+
+    /// \brief Returns how many bytes at the start of the data are whitespace, as defined by ezStringUtils::IsWhiteSpace().
+    static ezUInt32 CountWhitespace(const ezUInt8* pData, ezUInt32 uiCount);
+
+    /// \brief Returns how many bytes at the start of the data are neither '\"', '\\', '\n' nor '\0'.
+    static ezUInt32 CountStringCharacters(const ezUInt8* pData, ezUInt32 uiCount);
+
+    /// \brief Returns how many bytes at the start of the data can be part of a decimal number (0-9 . e E + -, and optionally _).
+    static ezUInt32 CountNumberCharacters(const ezUInt8* pData, ezUInt32 uiCount, bool bAllowUnderscore);
+
+    /// \brief Returns how many '\n' the data contains. out_uiLastLineBreak is the index of the last one.
+    static ezUInt32 CountLineBreaks(const ezUInt8* pData, ezUInt32 uiCount, ezUInt32& out_uiLastLineBreak);
+
+    EZ_ALWAYS_INLINE static bool IsStringCharacter(ezUInt8 uiByte) { return uiByte != '\"' && uiByte != '\\' && uiByte != '\n' && uiByte != '\0'; }
+
+    EZ_ALWAYS_INLINE static bool IsNumberCharacter(ezUInt8 uiByte, bool bAllowUnderscore)
+    {
+      return (uiByte >= '0' && uiByte <= '9') || uiByte == '.' || uiByte == 'e' || uiByte == 'E' || uiByte == '-' || uiByte == '+' || (bAllowUnderscore && uiByte == '_');
+    }
+
+  private:
+    ezUInt8 ReadNextChunk();
+
+    bool m_bInitialized = false;
+    ezStreamReader* m_pStream = nullptr;
+    const ezUInt8* m_pData = nullptr;
+    ezUInt32 m_uiReadPos = 0;
+    ezUInt32 m_uiDataSize = 0;
+    ezDynamicArray<ezUInt8> m_Chunk;
+  };
+} // namespace ezInternal
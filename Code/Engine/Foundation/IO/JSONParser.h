@@ -2,6 +2,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/IO/Implementation/TextParserInput.h>
 #include <Foundation/IO/Stream.h>
 
 class ezLogInterface;
@@ -22,8 +23,15 @@ public:
 
 protected:
   /// \brief Resets the parser to the start state and configures it to read from the given stream.
+  ///
+  /// The stream is read ahead in large chunks, so its read position is undefined afterwards.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Resets the parser to the start state and configures it to read directly from the given memory, e.g. a memory mapped file.
+  ///
+  /// The memory must stay valid until parsing is finished.
+  void SetInputData(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Does one parsing step.
   ///
   /// While this function returns true, the document has not been parsed completely.
@@ -122,6 +130,7 @@ private:
     State m_State;
   };
 
+  void StartInput(ezUInt32 uiFirstLineOffset);
   void StartParsing();
   void SkipWhitespace();
   void SkipString();
@@ -137,6 +146,7 @@ private:
 
   bool ReadCharacter(bool bSkipComments);
   void ReadNextByte();
+  void SkipBufferedBytes(ezUInt32 uiNumBytes);
 
   void SkipStack(State s);
 
@@ -145,7 +155,7 @@ private:
   ezUInt32 m_uiCurLine;
   ezUInt32 m_uiCurColumn;
 
-  ezStreamReader* m_pInput;
+  ezInternal::TextParserInput m_Input;
   ezHybridArray<JSONState, 32> m_StateStack;
   ezHybridArray<ezUInt8, 4096> m_TempString;
 
@@ -26,6 +26,9 @@ public:
   /// error occurred.
   ezResult Parse(ezStreamReader& ref_input, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Same as above, but parses the document directly from memory (e.g. a memory mapped file), which is faster than going through a stream.
+  ezResult Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Returns the top-level object of the JSON document.
   const ezVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -36,6 +39,9 @@ public:
   ElementType GetTopLevelElementType() const { return m_Stack.PeekBack().m_Mode; }
 
 private:
+  void ResetState();
+  ezResult ParseInput();
+
   /// \brief This function can be overridden to skip certain variables, however the overriding function must still call this.
   virtual bool OnVariable(ezStringView sVarName) override;
 
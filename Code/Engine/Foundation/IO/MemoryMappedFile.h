@@ -61,6 +61,12 @@ public:
   /// \brief Returns a pointer for writing the mapped file. Asserts that the memory mapping was successful and the mode was ReadWrite.
   void* GetWritePointer(ezUInt64 uiOffset = 0, OffsetBase base = OffsetBase::Start);
 
+  /// \brief Hints the OS that the given byte range of the mapping will be accessed soon, so that it can start paging it in asynchronously.
+  ///
+  /// This is purely a performance hint, it never blocks on IO and is silently ignored on platforms that do not support it.
+  /// The range is clamped to the size of the mapping.
+  void Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const;
+
 private:
   ezUniquePtr<ezMemoryMappedFileImpl> m_pImpl;
 };
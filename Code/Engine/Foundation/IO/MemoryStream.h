@@ -423,6 +423,9 @@ public:
   /// \brief Returns the total available bytes in the memory stream
   ezUInt64 GetByteCount() const; // [tested]
 
+  /// \brief Returns the start of the memory block that is read from.
+  const void* GetRawMemory() const { return m_pRawMemory; }
+
   /// \brief Allows to set a string as the source of information in the memory stream for debug purposes.
   void SetDebugSourceInformation(ezStringView sDebugSourceInformation);
 
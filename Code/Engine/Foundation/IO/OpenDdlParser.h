@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/IO/Implementation/TextParserInput.h>
 #include <Foundation/IO/Stream.h>
 
 class ezLogInterface;
@@ -52,8 +53,15 @@ protected:
   void SetCacheSize(ezUInt32 uiSizeInKB);
 
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
+  ///
+  /// The stream is read ahead in large chunks, so its read position is undefined afterwards.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
+  /// \brief Configures the parser to read directly from the given memory, e.g. a memory mapped file. This can only be called once on a parser instance.
+  ///
+  /// The memory must stay valid until parsing is finished.
+  void SetInputData(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
   ///
   /// This function returns false when the end of the document has been reached, or a fatal parsing error has been reported.
@@ -166,7 +174,10 @@ private:
     State m_State;
   };
 
+  void StartInput(ezUInt32 uiFirstLineOffset);
   void ReadNextByte();
+  void SkipBufferedBytes(ezUInt32 uiNumBytes);
+  void AppendBufferedBytesToTempString(ezUInt32 uiNumBytes);
   bool ReadCharacter();
   bool ReadCharacterSkipComments();
   void SkipWhitespace();
@@ -187,7 +198,7 @@ private:
   void ReadHexString();
 
   ezHybridArray<DdlState, 32> m_StateStack;
-  ezStreamReader* m_pInput;
+  ezInternal::TextParserInput m_Input;
   ezDynamicArray<ezUInt8> m_Cache;
 
   static constexpr ezUInt32 s_uiMaxIdentifierLength = 64;
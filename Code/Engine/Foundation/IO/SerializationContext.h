@@ -19,6 +19,18 @@ public:
   /// It can be useful to manually set a context as active if a serialization process is spread across multiple scopes
   /// and other serialization can happen in between.
   void SetActive(bool bActive) { Derived::SetContext(bActive ? this : nullptr); }
+
+  /// \brief Makes \a pContext the active context on the current thread, even if another one is active, and returns the previously active one.
+  ///
+  /// This is needed when a thread may interleave work for different contexts, e.g. while it helps executing tasks.
+  /// Pass the returned context to this function again to restore it afterwards.
+  static Derived* SwapActiveContext(Derived* pContext)
+  {
+    Derived* pPrevContext = Derived::GetContext();
+    Derived::SetContext(nullptr);
+    Derived::SetContext(pContext);
+    return pPrevContext;
+  }
 };
 
 /// \brief Declares the necessary functions to access a serialization context
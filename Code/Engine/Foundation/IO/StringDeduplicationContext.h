@@ -33,9 +33,19 @@ public:
   /// \brief Internal method to serialize a string.
   void SerializeString(const ezStringView& sString, ezStreamWriter& ref_writer);
 
+  /// \brief Adds the string to the table of unique strings (if necessary) and returns its index.
+  ///
+  /// This allows to reference strings from custom data structures, e.g. fixed-layout records, that are not written through a stream.
+  ezUInt32 DeduplicateString(ezStringView sString);
+
   /// \brief Returns the number of unique strings which were serialized with this instance.
   ezUInt32 GetUniqueStringCount() const;
 
+  /// \brief Returns all unique strings, sorted by their index.
+  ///
+  /// The string views stay valid as long as this context is alive.
+  void GetUniqueStrings(ezDynamicArray<ezStringView>& out_strings) const;
+
   /// \brief Returns the original stream that was passed to the constructor.
   ezStreamWriter& GetOriginalStream() { return m_OriginalStream; }
 
@@ -56,6 +66,13 @@ class EZ_FOUNDATION_DLL ezStringDeduplicationReadContext : public ezSerializatio
 public:
   /// \brief Setup the string table used internally.
   ezStringDeduplicationReadContext(ezStreamReader& inout_stream);
+
+  /// \brief Uses the given strings as the string table, without copying them.
+  ///
+  /// The strings (and the array itself) must stay valid as long as this context is used.
+  /// This is meant for string tables that are stored in a memory mapped file.
+  ezStringDeduplicationReadContext(ezArrayPtr<const ezStringView> strings);
+
   ~ezStringDeduplicationReadContext();
 
   /// \brief Internal method to deserialize a string.
@@ -63,4 +80,5 @@ public:
 
 protected:
   ezDynamicArray<ezHybridString<64>> m_DeduplicatedStrings;
+  ezArrayPtr<const ezStringView> m_ExternalStrings;
 };
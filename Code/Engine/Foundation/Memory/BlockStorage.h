@@ -60,6 +60,9 @@ public:
 
   void Clear();
 
+  /// \brief Reserves space for the block pointers of the given number of objects, so that creating that many objects doesn't need to grow the internal array.
+  void Reserve(ezUInt32 uiCount);
+
   T* Create();
   void Delete(T* pObject);
   void Delete(T* pObject, T*& out_pMovedObject);
@@ -143,6 +143,12 @@ void ezBlockStorage<T, BlockSize, StorageType>::Clear()
   m_Blocks.Clear();
 }
 
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::Reserve(ezUInt32 uiCount)
+{
+  m_Blocks.Reserve((uiCount + ezDataBlock<T, BlockSize>::CAPACITY - 1) / ezDataBlock<T, BlockSize>::CAPACITY);
+}
+
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 T* ezBlockStorage<T, BlockSize, StorageType>::Create()
 {
@@ -164,6 +164,10 @@ void* ezLargeBlockAllocator<BlockSize>::Allocate(size_t uiAlign)
   {
     ezMemoryTracker::AddAllocation(m_Id, m_TrackingMode, ptr, BlockSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
+  else if (m_TrackingMode == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::AddSampledAllocation(m_Id, ptr, BlockSize, uiAlign);
+  }
 
   return ptr;
 }
@@ -177,6 +181,10 @@ void ezLargeBlockAllocator<BlockSize>::Deallocate(void* ptr)
   {
     ezMemoryTracker::RemoveAllocation(m_Id, ptr);
   }
+  else if (m_TrackingMode == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::RemoveSampledAllocation(m_Id, ptr);
+  }
 
   // find super block
   bool bFound = false;
@@ -74,6 +74,10 @@ void ezLinearAllocator<TrackingMode, OverwriteMemoryOnReset>::Reset()
   {
     ezMemoryTracker::RemoveAllAllocations(this->m_Id);
   }
+  else if constexpr (TrackingMode == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::RemoveAllAllocations(this->m_Id);
+  }
   else if constexpr (TrackingMode >= ezAllocatorTrackingMode::Basics)
   {
     ezAllocator::Stats stats;
@@ -1,5 +1,7 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Logging/Log.h>
@@ -7,6 +9,7 @@
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicUtils.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -38,6 +41,15 @@ namespace
   };
 
 
+  struct SampledAllocationInfo
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezMemoryTracker::AllocationInfo m_Info;
+    ezUInt64 m_uiEstimatedCount = 0; ///< How many allocations this sample stands in for.
+    ezUInt64 m_uiEstimatedBytes = 0; ///< How many bytes this sample stands in for.
+  };
+
   struct AllocatorData
   {
     EZ_ALWAYS_INLINE AllocatorData() = default;
@@ -50,6 +62,7 @@ namespace
     ezAllocator::Stats m_Stats;
 
     ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    ezHashTable<const void*, SampledAllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_SampledAllocations;
   };
 
   struct TrackerData
@@ -67,6 +80,62 @@ namespace
   static bool s_bIsInitialized = false;
   static bool s_bIsInitializing = false;
 
+  // Sampled tracking
+  //
+  // All of these are zero- or constant-initialized, so that they are valid even for allocations that happen during static initialization.
+
+  static ezUInt32 s_uiSamplingInterval = 512 * 1024;
+
+  thread_local ezInt64 t_iBytesUntilNextSample = 0;
+  thread_local ezUInt64 t_uiSamplingRandomState = 0;
+
+  // Counts the sampled allocations per pointer hash. Allows to skip the tracker mutex for all deallocations that were not sampled.
+  constexpr ezUInt32 SampledPointerFilterSizeLog2 = 14;
+  static ezInt32 s_SampledPointerFilter[1u << SampledPointerFilterSizeLog2];
+
+  EZ_ALWAYS_INLINE ezInt32& GetSampledPointerFilter(const void* pPtr)
+  {
+    const ezUInt64 uiHash = (reinterpret_cast<ezUInt64>(pPtr) >> 4) * 0x9E3779B97F4A7C15ull;
+    return s_SampledPointerFilter[uiHash >> (64 - SampledPointerFilterSizeLog2)];
+  }
+
+  /// Returns the next value of the per-thread random sequence.
+  static ezUInt64 DrawRandom()
+  {
+    if (t_uiSamplingRandomState == 0)
+    {
+      // seed with something that differs between threads
+      t_uiSamplingRandomState = (reinterpret_cast<ezUInt64>(&t_uiSamplingRandomState) ^ static_cast<ezUInt64>(ezTime::Now().GetNanoseconds())) | 1;
+    }
+
+    // xorshift64
+    ezUInt64 x = t_uiSamplingRandomState;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    t_uiSamplingRandomState = x;
+
+    return x;
+  }
+
+  /// Returns the number of bytes until the next sample, drawn from an exponential distribution with the sampling interval as the mean.
+  static ezInt64 DrawSamplingDistance()
+  {
+    // uniform in (0, 1]
+    const float fUniform = static_cast<float>((DrawRandom() >> 40) + 1) / static_cast<float>(1u << 24);
+    return static_cast<ezInt64>(-ezMath::Ln(fUniform) * s_uiSamplingInterval) + 1;
+  }
+
+  /// Rounds up or down at random, such that the expected result equals \a fValue.
+  static ezUInt64 RoundStochastically(double fValue)
+  {
+    const double fFloor = ezMath::Floor(fValue);
+
+    // uniform in [0, 1)
+    const double fUniform = static_cast<double>(DrawRandom() >> 11) / static_cast<double>(1ull << 53);
+    return static_cast<ezUInt64>(fFloor) + (fUniform < fValue - fFloor ? 1 : 0);
+  }
+
   static void Initialize()
   {
     if (s_bIsInitialized)
@@ -184,6 +253,15 @@ void ezMemoryTracker::DeregisterAllocator(ezAllocatorId allocatorId)
     EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
   }
 
+  // samples are not complete enough to report leaks
+  for (auto it = data.m_SampledAllocations.GetIterator(); it.IsValid(); ++it)
+  {
+    ezAtomicUtils::Decrement(GetSampledPointerFilter(it.Key()));
+
+    ezArrayPtr<void*> stackTrace = it.Value().m_Info.GetStackTrace();
+    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
+  }
+
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
 }
 
@@ -264,6 +342,188 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pP
   EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
 }
 
+// static
+void ezMemoryTracker::SetSamplingInterval(ezUInt32 uiAverageBytes)
+{
+  s_uiSamplingInterval = ezMath::Max(uiAverageBytes, 1u);
+  t_iBytesUntilNextSample = DrawSamplingDistance();
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetSamplingInterval()
+{
+  return s_uiSamplingInterval;
+}
+
+// static
+void ezMemoryTracker::AddSampledAllocation(ezAllocatorId allocatorId, const void* pPtr, size_t uiSize, size_t uiAlign)
+{
+  t_iBytesUntilNextSample -= static_cast<ezInt64>(uiSize);
+
+  if (t_iBytesUntilNextSample > 0)
+    return;
+
+  if (t_uiSamplingRandomState == 0)
+  {
+    // first allocation on this thread, only pick the first sample point
+    t_iBytesUntilNextSample = DrawSamplingDistance() - static_cast<ezInt64>(uiSize);
+
+    if (t_iBytesUntilNextSample > 0)
+      return;
+  }
+
+  // pick the next sample point before anything else, in case capturing the stack trace allocates memory itself
+  t_iBytesUntilNextSample = DrawSamplingDistance();
+
+  EZ_ASSERT_DEV(uiAlign < 0xFFFF, "Alignment too big");
+
+  // The probability that an allocation of size S contains a sample point is 1 - e^(-S / interval).
+  // Weighting each sample with the inverse of that probability makes the estimates unbiased.
+  const double fProbability = 1.0 - ezMath::Exp(-static_cast<float>(uiSize) / static_cast<float>(s_uiSamplingInterval));
+  const double fWeight = fProbability > 0.0 ? 1.0 / fProbability : 1.0;
+
+  SampledAllocationInfo sample;
+  sample.m_Info.m_uiSize = uiSize;
+  sample.m_Info.m_uiAlignment = (ezUInt16)uiAlign;
+  // the stats are integers, rounding to the nearest one would bias the estimates, e.g. every weight below 1.5 would count as a single allocation
+  sample.m_uiEstimatedCount = RoundStochastically(fWeight);
+  sample.m_uiEstimatedBytes = RoundStochastically(uiSize * fWeight);
+
+  {
+    void* pBuffer[64];
+    ezArrayPtr<void*> tempTrace(pBuffer);
+    const ezUInt32 uiNumTraces = ezStackTracer::GetStackTrace(tempTrace);
+
+    ezArrayPtr<void*> stackTrace = EZ_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
+    ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
+    sample.m_Info.SetStackTrace(stackTrace);
+  }
+
+  EZ_LOCK(*s_pTrackerData);
+
+  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  data.m_Stats.m_uiNumAllocations += sample.m_uiEstimatedCount;
+  data.m_Stats.m_uiAllocationSize += sample.m_uiEstimatedBytes;
+  data.m_Stats.m_uiPerFrameAllocationSize += sample.m_uiEstimatedBytes;
+
+  data.m_SampledAllocations.Insert(pPtr, sample);
+  ezAtomicUtils::Increment(GetSampledPointerFilter(pPtr));
+}
+
+// static
+void ezMemoryTracker::RemoveSampledAllocation(ezAllocatorId allocatorId, const void* pPtr)
+{
+  // the filter is incremented before the allocation is handed out, so it can't miss a sampled pointer
+  if (ezAtomicUtils::Read(GetSampledPointerFilter(pPtr)) == 0)
+    return;
+
+  ezArrayPtr<void*> stackTrace;
+
+  {
+    EZ_LOCK(*s_pTrackerData);
+
+    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+
+    SampledAllocationInfo sample;
+    if (!data.m_SampledAllocations.Remove(pPtr, &sample))
+      return;
+
+    ezAtomicUtils::Decrement(GetSampledPointerFilter(pPtr));
+
+    data.m_Stats.m_uiNumDeallocations += sample.m_uiEstimatedCount;
+    data.m_Stats.m_uiAllocationSize -= sample.m_uiEstimatedBytes;
+
+    stackTrace = sample.m_Info.GetStackTrace();
+  }
+
+  EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetSampledHeapProfile(ezArrayPtr<HeapProfileEntry> out_entries, ezAllocatorId allocatorId)
+{
+  if (s_pTrackerData == nullptr)
+    return 0;
+
+  ezDynamicArray<HeapProfileEntry, TrackerDataAllocatorWrapper> entries;
+
+  {
+    ezHashTable<ezUInt64, ezUInt32, ezHashHelper<ezUInt64>, TrackerDataAllocatorWrapper> stackToEntry;
+
+    EZ_LOCK(*s_pTrackerData);
+
+    for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
+    {
+      if (!allocatorId.IsInvalidated() && it.Id() != allocatorId)
+        continue;
+
+      for (auto it2 = it.Value().m_SampledAllocations.GetIterator(); it2.IsValid(); ++it2)
+      {
+        const SampledAllocationInfo& sample = it2.Value();
+        const ezArrayPtr<void*> stackTrace = sample.m_Info.GetStackTrace().GetSubArray(0, ezMath::Min(sample.m_Info.m_uiStackTraceLength, (ezUInt16)EZ_ARRAY_SIZE(HeapProfileEntry::m_StackTrace)));
+
+        const ezUInt64 uiKey = ezHashingUtils::xxHash64(stackTrace.GetPtr(), stackTrace.GetCount() * sizeof(void*), it.Id().m_Data);
+
+        ezUInt32 uiEntry = 0;
+        if (!stackToEntry.TryGetValue(uiKey, uiEntry))
+        {
+          uiEntry = entries.GetCount();
+          stackToEntry.Insert(uiKey, uiEntry);
+
+          HeapProfileEntry& entry = entries.ExpandAndGetRef();
+          entry.m_AllocatorId = it.Id();
+          entry.m_uiStackTraceLength = stackTrace.GetCount();
+          ezMemoryUtils::Copy(entry.m_StackTrace, stackTrace.GetPtr(), stackTrace.GetCount());
+        }
+
+        HeapProfileEntry& entry = entries[uiEntry];
+        entry.m_uiNumSamples++;
+        entry.m_uiEstimatedCount += sample.m_uiEstimatedCount;
+        entry.m_uiEstimatedBytes += sample.m_uiEstimatedBytes;
+      }
+    }
+  }
+
+  entries.Sort([](const HeapProfileEntry& a, const HeapProfileEntry& b)
+    { return a.m_uiEstimatedBytes > b.m_uiEstimatedBytes; });
+
+  const ezUInt32 uiNumToCopy = ezMath::Min(out_entries.GetCount(), entries.GetCount());
+  ezMemoryUtils::Copy(out_entries.GetPtr(), entries.GetData(), uiNumToCopy);
+
+  return entries.GetCount();
+}
+
+// static
+void ezMemoryTracker::PrintSampledHeapProfile(PrintFunc printfunc, ezUInt32 uiMaxEntries)
+{
+  ezDynamicArray<HeapProfileEntry, TrackerDataAllocatorWrapper> entries;
+  entries.SetCountUninitialized(uiMaxEntries);
+  const ezUInt32 uiTotalEntries = GetSampledHeapProfile(entries);
+  entries.SetCount(ezMath::Min(uiMaxEntries, uiTotalEntries));
+
+  char szBuffer[512];
+  ezStringUtils::snprintf(szBuffer, EZ_ARRAY_SIZE(szBuffer), "\n--------------------------------------------------------------------\n"
+                                                             "Sampled Heap Profile (%u of %u call stacks, sampling interval %u bytes):"
+                                                             "\n--------------------------------------------------------------------\n\n",
+    entries.GetCount(), uiTotalEntries, s_uiSamplingInterval);
+  printfunc(szBuffer);
+
+  for (HeapProfileEntry& entry : entries)
+  {
+    ezStringBuilder sName;
+    {
+      EZ_LOCK(*s_pTrackerData);
+      sName = s_pTrackerData->m_AllocatorData[entry.m_AllocatorId].m_sName;
+    }
+
+    ezStringUtils::snprintf(szBuffer, EZ_ARRAY_SIZE(szBuffer), "~%llu bytes in ~%llu allocations by '%s' (%u samples)\n", entry.m_uiEstimatedBytes, entry.m_uiEstimatedCount, sName.GetData(), entry.m_uiNumSamples);
+    printfunc(szBuffer);
+
+    ezStackTracer::ResolveStackTrace(entry.GetStackTrace(), printfunc);
+    printfunc("--------------------------------------------------------------------\n\n");
+  }
+}
+
 // static
 void ezMemoryTracker::RemoveAllAllocations(ezAllocatorId allocatorId)
 {
@@ -295,6 +555,19 @@ void ezMemoryTracker::RemoveAllAllocations(ezAllocatorId allocatorId)
     EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
   }
   data.m_Allocations.Clear();
+
+  for (auto it = data.m_SampledAllocations.GetIterator(); it.IsValid(); ++it)
+  {
+    const SampledAllocationInfo& sample = it.Value();
+    data.m_Stats.m_uiNumDeallocations += sample.m_uiEstimatedCount;
+    data.m_Stats.m_uiAllocationSize -= sample.m_uiEstimatedBytes;
+
+    ezAtomicUtils::Decrement(GetSampledPointerFilter(it.Key()));
+
+    ezArrayPtr<void*> stackTrace = sample.m_Info.GetStackTrace();
+    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
+  }
+  data.m_SampledAllocations.Clear();
 }
 
 // static
@@ -10,6 +10,7 @@ enum class ezAllocatorTrackingMode : ezUInt32
 {
   Nothing,                       ///< The allocator doesn't track anything. Use this for best performance.
   Basics,                        ///< The allocator will be known to the system, so it can show up in debugging tools, but barely anything more.
+  Sampled,                       ///< Only a random subset of the allocations is recorded (including stack traces), see ezMemoryTracker::SetSamplingInterval(). Allocation stats and heap profiles are statistical estimates, but the overhead is very low.
   AllocationStats,               ///< The allocator keeps track of how many allocations and deallocations it did and how large its memory usage is.
   AllocationStatsIgnoreLeaks,    ///< Same as AllocationStats, but any remaining allocations at shutdown are not reported as leaks.
   AllocationStatsAndStacktraces, ///< The allocator will record stack traces for each allocation, which can be used to find memory leaks.
@@ -72,6 +73,9 @@ public:
     void* m_pData;
   };
 
+  /// \brief Callback for printing strings.
+  using PrintFunc = void (*)(const char* szLine);
+
   static ezAllocatorId RegisterAllocator(ezStringView sName, ezAllocatorTrackingMode mode, ezAllocatorId parentId);
   static void DeregisterAllocator(ezAllocatorId allocatorId);
 
@@ -82,6 +86,53 @@ public:
 
   static void ResetPerFrameAllocatorStats();
 
+  /// \name Sampled tracking
+  ///
+  /// Allocators that use ezAllocatorTrackingMode::Sampled don't record every allocation. Instead, on average every N-th allocated byte
+  /// is picked (with exponentially distributed distances, i.e. a Poisson process), and the allocation that contains that byte is recorded
+  /// together with its stack trace. Each recorded allocation stands in for the number of allocations of the same size that statistically
+  /// went unrecorded, so that the allocator stats and the heap profile are unbiased estimates of the real numbers.
+  ///
+  /// Allocations that are not sampled only cost decrementing a thread-local counter, and deallocations only cost a lookup in a small
+  /// lock-free filter. Only sampled allocations take the tracker mutex.
+  ///@{
+
+  /// \brief Sets the average number of bytes between two sampled allocations. Smaller values are more accurate, but more expensive.
+  ///
+  /// The default is 512 KB. Other threads pick up the new value after their next sampled allocation.
+  static void SetSamplingInterval(ezUInt32 uiAverageBytes);
+  static ezUInt32 GetSamplingInterval();
+
+  static void AddSampledAllocation(ezAllocatorId allocatorId, const void* pPtr, size_t uiSize, size_t uiAlign);
+  static void RemoveSampledAllocation(ezAllocatorId allocatorId, const void* pPtr);
+
+  /// \brief The estimated memory usage of all live allocations of one allocator that were made from the same call stack.
+  struct HeapProfileEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezAllocatorId m_AllocatorId;
+    ezUInt32 m_uiNumSamples = 0;
+    ezUInt64 m_uiEstimatedCount = 0;
+    ezUInt64 m_uiEstimatedBytes = 0;
+
+    void* m_StackTrace[32];
+    ezUInt32 m_uiStackTraceLength = 0;
+
+    EZ_ALWAYS_INLINE ezArrayPtr<void*> GetStackTrace() { return ezArrayPtr<void*>(m_StackTrace, m_uiStackTraceLength); }
+  };
+
+  /// \brief Fills out_entries with the heap profile of all sampled allocators, sorted by estimated size, largest first.
+  ///
+  /// If allocatorId is valid, only the allocations of that allocator are reported.
+  /// Returns the total number of entries, which may be larger than the size of out_entries.
+  static ezUInt32 GetSampledHeapProfile(ezArrayPtr<HeapProfileEntry> out_entries, ezAllocatorId allocatorId = ezAllocatorId());
+
+  /// \brief Prints the uiMaxEntries largest entries of the heap profile, including their resolved stack traces.
+  static void PrintSampledHeapProfile(PrintFunc printfunc, ezUInt32 uiMaxEntries = 20);
+
+  ///@}
+
   static ezStringView GetAllocatorName(ezAllocatorId allocatorId);
   static const ezAllocator::Stats& GetAllocatorStats(ezAllocatorId allocatorId);
   static ezAllocatorId GetAllocatorParentId(ezAllocatorId allocatorId);
@@ -89,9 +140,6 @@ public:
 
   static Iterator GetIterator();
 
-  /// \brief Callback for printing strings.
-  using PrintFunc = void (*)(const char* szLine);
-
   /// \brief Reports back information about all currently known root memory leaks.
   ///
   /// Returns the number of found memory leaks.
@@ -54,3 +54,9 @@ ezUInt64 ezMemoryMappedFile::GetFileSize() const
 {
   return m_pImpl->m_uiFileSize;
 }
+
+void ezMemoryMappedFile::Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const
+{
+  EZ_IGNORE_UNUSED(uiOffset);
+  EZ_IGNORE_UNUSED(uiSize);
+}
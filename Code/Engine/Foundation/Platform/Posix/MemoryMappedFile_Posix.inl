@@ -6,6 +6,7 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 struct ezMemoryMappedFileImpl
 {
@@ -211,3 +212,17 @@ ezUInt64 ezMemoryMappedFile::GetFileSize() const
 {
   return m_pImpl->m_uiFileSize;
 }
+
+void ezMemoryMappedFile::Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const
+{
+  if (m_pImpl->m_pMappedFilePtr == nullptr || uiOffset >= m_pImpl->m_uiFileSize || uiSize == 0)
+    return;
+
+  uiSize = ezMath::Min(uiSize, m_pImpl->m_uiFileSize - uiOffset);
+
+  // madvise requires a page aligned start address
+  const ezUInt64 uiPageSize = static_cast<ezUInt64>(sysconf(_SC_PAGESIZE));
+  const ezUInt64 uiAlignedOffset = uiOffset - (uiOffset % uiPageSize);
+
+  madvise(ezMemoryUtils::AddByteOffset(m_pImpl->m_pMappedFilePtr, static_cast<std::ptrdiff_t>(uiAlignedOffset)), static_cast<size_t>(uiSize + uiOffset - uiAlignedOffset), MADV_WILLNEED);
+}
@@ -20,6 +20,10 @@ void* ezPageAllocator::AllocatePage(size_t uiSize)
   {
     ezMemoryTracker::AddAllocation(ezPageAllocator::GetId(), ezAllocatorTrackingMode::Default, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
+  else if constexpr (ezAllocatorTrackingMode::Default == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::AddSampledAllocation(ezPageAllocator::GetId(), ptr, uiSize, uiAlign);
+  }
 
   return ptr;
 }
@@ -31,6 +35,10 @@ void ezPageAllocator::DeallocatePage(void* ptr)
   {
     ezMemoryTracker::RemoveAllocation(ezPageAllocator::GetId(), ptr);
   }
+  else if constexpr (ezAllocatorTrackingMode::Default == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::RemoveSampledAllocation(ezPageAllocator::GetId(), ptr);
+  }
 
   free(ptr);
 }
@@ -196,4 +196,21 @@ ezUInt64 ezMemoryMappedFile::GetFileSize() const
   return m_pImpl->m_uiFileSize;
 }
 
+void ezMemoryMappedFile::Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const
+{
+#  if _WIN32_WINNT >= _WIN32_WINNT_WIN8
+  if (m_pImpl->m_pMappedFilePtr == nullptr || uiOffset >= m_pImpl->m_uiFileSize || uiSize == 0)
+    return;
+
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = ezMemoryUtils::AddByteOffset(m_pImpl->m_pMappedFilePtr, static_cast<std::ptrdiff_t>(uiOffset));
+  range.NumberOfBytes = static_cast<SIZE_T>(ezMath::Min(uiSize, m_pImpl->m_uiFileSize - uiOffset));
+
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#  else
+  EZ_IGNORE_UNUSED(uiOffset);
+  EZ_IGNORE_UNUSED(uiSize);
+#  endif
+}
+
 #endif
@@ -22,6 +22,10 @@ void* ezPageAllocator::AllocatePage(size_t uiSize)
   {
     ezMemoryTracker::AddAllocation(ezPageAllocator::GetId(), ezAllocatorTrackingMode::Default, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
+  else if constexpr (ezAllocatorTrackingMode::Default == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::AddSampledAllocation(ezPageAllocator::GetId(), ptr, uiSize, uiAlign);
+  }
 
   return ptr;
 }
@@ -33,6 +37,10 @@ void ezPageAllocator::DeallocatePage(void* pPtr)
   {
     ezMemoryTracker::RemoveAllocation(ezPageAllocator::GetId(), pPtr);
   }
+  else if constexpr (ezAllocatorTrackingMode::Default == ezAllocatorTrackingMode::Sampled)
+  {
+    ezMemoryTracker::RemoveSampledAllocation(ezPageAllocator::GetId(), pPtr);
+  }
 
   EZ_VERIFY(::VirtualFree(pPtr, 0, MEM_RELEASE), "Could not free memory pages. Error Code '{0}'", ezArgErrorCode(::GetLastError()));
 }
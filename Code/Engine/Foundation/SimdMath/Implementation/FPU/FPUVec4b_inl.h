@@ -161,6 +161,11 @@ EZ_ALWAYS_INLINE bool ezSimdVec4b::NoneSet() const
   return !AnySet<N>();
 }
 
+EZ_ALWAYS_INLINE ezUInt32 ezSimdVec4b::GetMask() const
+{
+  return (m_v.x ? 1u : 0u) | (m_v.y ? 2u : 0u) | (m_v.z ? 4u : 0u) | (m_v.w ? 8u : 0u);
+}
+
 // static
 EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec4b::Select(const ezSimdVec4b& cmp, const ezSimdVec4b& ifTrue, const ezSimdVec4b& ifFalse)
 {
@@ -103,6 +103,11 @@ EZ_ALWAYS_INLINE bool ezSimdVec4b::NoneSet() const
   return (ezInternal::NeonMoveMask(m_v) & mask) == 0;
 }
 
+EZ_ALWAYS_INLINE ezUInt32 ezSimdVec4b::GetMask() const
+{
+  return static_cast<ezUInt32>(ezInternal::NeonMoveMask(m_v));
+}
+
 // static
 EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec4b::Select(const ezSimdVec4b& vCmp, const ezSimdVec4b& vTrue, const ezSimdVec4b& vFalse)
 {
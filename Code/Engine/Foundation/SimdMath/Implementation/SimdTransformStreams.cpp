@@ -0,0 +1,159 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/SimdMath/SimdTransformStreams.h>
+
+ezSimdTransformStreams::ezSimdTransformStreams() = default;
+
+void ezSimdTransformStreams::SetCount(ezUInt32 uiCount)
+{
+  // when shrinking, the elements behind the new count become padding and have to be reset as well
+  const ezUInt32 uiFirstToInitialize = ezMath::Min(m_uiCount, uiCount);
+  const ezUInt32 uiNumVectors = (uiCount + 3) / 4;
+
+  for (ezUInt32 i = 0; i < StreamCount; ++i)
+  {
+    m_Streams[i].SetCountUninitialized(uiNumVectors);
+  }
+
+  m_uiCount = uiCount;
+
+  // initialize new elements as well as the padding
+  const float identity[StreamCount] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+  for (ezUInt32 i = 0; i < StreamCount; ++i)
+  {
+    float* pData = GetStreamData(static_cast<Stream>(i));
+
+    for (ezUInt32 j = uiFirstToInitialize; j < uiNumVectors * 4; ++j)
+    {
+      pData[j] = identity[i];
+    }
+  }
+}
+
+void ezSimdTransformStreams::Clear()
+{
+  for (ezUInt32 i = 0; i < StreamCount; ++i)
+  {
+    m_Streams[i].Clear();
+  }
+
+  m_uiCount = 0;
+}
+
+void ezSimdTransformStreams::SetTransform(ezUInt32 uiIndex, const ezSimdTransform& transform)
+{
+  EZ_ASSERT_DEBUG(uiIndex < m_uiCount, "Out of bounds access. Transform stream has {0} elements, trying to access element at index {1}.", m_uiCount, uiIndex);
+
+  float position[4];
+  float rotation[4];
+  float scale[4];
+  transform.m_Position.Store<4>(position);
+  transform.m_Rotation.m_v.Store<4>(rotation);
+  transform.m_Scale.Store<4>(scale);
+
+  GetStreamData(PositionX)[uiIndex] = position[0];
+  GetStreamData(PositionY)[uiIndex] = position[1];
+  GetStreamData(PositionZ)[uiIndex] = position[2];
+  GetStreamData(RotationX)[uiIndex] = rotation[0];
+  GetStreamData(RotationY)[uiIndex] = rotation[1];
+  GetStreamData(RotationZ)[uiIndex] = rotation[2];
+  GetStreamData(RotationW)[uiIndex] = rotation[3];
+  GetStreamData(ScaleX)[uiIndex] = scale[0];
+  GetStreamData(ScaleY)[uiIndex] = scale[1];
+  GetStreamData(ScaleZ)[uiIndex] = scale[2];
+}
+
+ezSimdTransform ezSimdTransformStreams::GetTransform(ezUInt32 uiIndex) const
+{
+  EZ_ASSERT_DEBUG(uiIndex < m_uiCount, "Out of bounds access. Transform stream has {0} elements, trying to access element at index {1}.", m_uiCount, uiIndex);
+
+  ezSimdTransform result;
+  result.m_Position.Set(GetStreamData(PositionX)[uiIndex], GetStreamData(PositionY)[uiIndex], GetStreamData(PositionZ)[uiIndex], 0.0f);
+  result.m_Rotation.m_v.Set(GetStreamData(RotationX)[uiIndex], GetStreamData(RotationY)[uiIndex], GetStreamData(RotationZ)[uiIndex], GetStreamData(RotationW)[uiIndex]);
+  result.m_Scale.Set(GetStreamData(ScaleX)[uiIndex], GetStreamData(ScaleY)[uiIndex], GetStreamData(ScaleZ)[uiIndex], 1.0f);
+  return result;
+}
+
+// static
+void ezSimdTransformStreams::MakeGlobalTransforms(const ezSimdTransformStreams& parentGlobalTransforms, ezArrayPtr<const ezUInt32> parentIndices,
+  const ezSimdTransformStreams& localTransforms, ezSimdTransformStreams& out_globalTransforms)
+{
+  EZ_ASSERT_DEV(&parentGlobalTransforms != &out_globalTransforms, "Parent and output transforms must not be the same streams");
+  EZ_ASSERT_DEV(parentIndices.GetCount() == localTransforms.m_uiCount, "Need exactly one parent index per local transform");
+
+  const ezUInt32 uiCount = localTransforms.m_uiCount;
+  out_globalTransforms.SetCount(uiCount);
+
+  const float* pParentData[StreamCount];
+  for (ezUInt32 i = 0; i < StreamCount; ++i)
+  {
+    pParentData[i] = parentGlobalTransforms.GetStreamData(static_cast<Stream>(i));
+  }
+
+  const ezUInt32 uiNumVectors = (uiCount + 3) / 4;
+  for (ezUInt32 v = 0; v < uiNumVectors; ++v)
+  {
+    const ezUInt32 uiFirst = v * 4;
+
+    // padding elements use the parent of the first element in the group
+    ezUInt32 uiParentIndices[4];
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      uiParentIndices[i] = parentIndices[ezMath::Min(uiFirst + i, uiCount - 1)];
+      EZ_ASSERT_DEBUG(uiParentIndices[i] < parentGlobalTransforms.m_uiCount, "Invalid parent index {0}", uiParentIndices[i]);
+    }
+
+    ezSimdVec4f p[StreamCount];
+    if (uiParentIndices[0] == uiParentIndices[1] && uiParentIndices[0] == uiParentIndices[2] && uiParentIndices[0] == uiParentIndices[3])
+    {
+      for (ezUInt32 i = 0; i < StreamCount; ++i)
+      {
+        p[i] = ezSimdVec4f(pParentData[i][uiParentIndices[0]]);
+      }
+    }
+    else
+    {
+      for (ezUInt32 i = 0; i < StreamCount; ++i)
+      {
+        const float* pData = pParentData[i];
+        p[i] = ezSimdVec4f(pData[uiParentIndices[0]], pData[uiParentIndices[1]], pData[uiParentIndices[2]], pData[uiParentIndices[3]]);
+      }
+    }
+
+    ezSimdVec4f l[StreamCount];
+    for (ezUInt32 i = 0; i < StreamCount; ++i)
+    {
+      l[i] = localTransforms.m_Streams[i][v];
+    }
+
+    // position = parentRotation * (localPosition * parentScale) + parentPosition
+    const ezSimdVec4f vx = l[PositionX].CompMul(p[ScaleX]);
+    const ezSimdVec4f vy = l[PositionY].CompMul(p[ScaleY]);
+    const ezSimdVec4f vz = l[PositionZ].CompMul(p[ScaleZ]);
+
+    // t = 2 * cross(q.xyz, v)
+    ezSimdVec4f tx = p[RotationY].CompMul(vz) - p[RotationZ].CompMul(vy);
+    ezSimdVec4f ty = p[RotationZ].CompMul(vx) - p[RotationX].CompMul(vz);
+    ezSimdVec4f tz = p[RotationX].CompMul(vy) - p[RotationY].CompMul(vx);
+    tx += tx;
+    ty += ty;
+    tz += tz;
+
+    // v + t * q.w + cross(q.xyz, t)
+    out_globalTransforms.m_Streams[PositionX][v] = vx + tx.CompMul(p[RotationW]) + p[RotationY].CompMul(tz) - p[RotationZ].CompMul(ty) + p[PositionX];
+    out_globalTransforms.m_Streams[PositionY][v] = vy + ty.CompMul(p[RotationW]) + p[RotationZ].CompMul(tx) - p[RotationX].CompMul(tz) + p[PositionY];
+    out_globalTransforms.m_Streams[PositionZ][v] = vz + tz.CompMul(p[RotationW]) + p[RotationX].CompMul(ty) - p[RotationY].CompMul(tx) + p[PositionZ];
+
+    // rotation = parentRotation * localRotation
+    out_globalTransforms.m_Streams[RotationX][v] = l[RotationX].CompMul(p[RotationW]) + p[RotationX].CompMul(l[RotationW]) + p[RotationY].CompMul(l[RotationZ]) - p[RotationZ].CompMul(l[RotationY]);
+    out_globalTransforms.m_Streams[RotationY][v] = l[RotationY].CompMul(p[RotationW]) + p[RotationY].CompMul(l[RotationW]) + p[RotationZ].CompMul(l[RotationX]) - p[RotationX].CompMul(l[RotationZ]);
+    out_globalTransforms.m_Streams[RotationZ][v] = l[RotationZ].CompMul(p[RotationW]) + p[RotationZ].CompMul(l[RotationW]) + p[RotationX].CompMul(l[RotationY]) - p[RotationY].CompMul(l[RotationX]);
+    out_globalTransforms.m_Streams[RotationW][v] = p[RotationW].CompMul(l[RotationW]) - p[RotationX].CompMul(l[RotationX]) - p[RotationY].CompMul(l[RotationY]) - p[RotationZ].CompMul(l[RotationZ]);
+
+    // scale = parentScale * localScale
+    out_globalTransforms.m_Streams[ScaleX][v] = p[ScaleX].CompMul(l[ScaleX]);
+    out_globalTransforms.m_Streams[ScaleY][v] = p[ScaleY].CompMul(l[ScaleY]);
+    out_globalTransforms.m_Streams[ScaleZ][v] = p[ScaleZ].CompMul(l[ScaleZ]);
+  }
+}
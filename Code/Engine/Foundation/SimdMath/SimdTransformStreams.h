@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/SimdMath/SimdTransform.h>
+
+/// \brief Stores a number of transforms in structure-of-arrays layout, i.e. every component (position x, y, z, rotation x, y, z, w and
+/// scale x, y, z) is stored in its own aligned stream.
+///
+/// In this layout four consecutive transforms can be loaded into SIMD registers without any shuffling,
+/// which allows to process four transforms with each instruction, see MakeGlobalTransforms().
+/// The streams are always padded to a multiple of four elements.
+///
+/// The w components of position and scale are not stored. GetTransform() returns 0 for the position w and 1 for the scale w.
+class EZ_FOUNDATION_DLL ezSimdTransformStreams
+{
+public:
+  ezSimdTransformStreams();
+
+  /// \brief Resizes all streams. New elements and the padding are set to the identity transform.
+  void SetCount(ezUInt32 uiCount); // [tested]
+
+  /// \brief Returns the number of transforms.
+  ezUInt32 GetCount() const { return m_uiCount; } // [tested]
+
+  /// \brief Removes all transforms but keeps the allocated memory.
+  void Clear();
+
+  /// \brief Writes the transform at the given index.
+  void SetTransform(ezUInt32 uiIndex, const ezSimdTransform& transform); // [tested]
+
+  /// \brief Reads the transform at the given index.
+  ezSimdTransform GetTransform(ezUInt32 uiIndex) const; // [tested]
+
+  /// \brief Computes out_globalTransforms[i] = parentGlobalTransforms[parentIndices[i]] * localTransforms[i] for all elements of localTransforms.
+  ///
+  /// This is the same as calling ezSimdTransform::MakeGlobalTransform for every element, but four elements are processed at once.
+  /// Consecutive elements that share the same parent are faster to process, since the parent does not need to be gathered from four places.
+  /// out_globalTransforms is resized to the number of local transforms and must not be the same object as parentGlobalTransforms.
+  static void MakeGlobalTransforms(const ezSimdTransformStreams& parentGlobalTransforms, ezArrayPtr<const ezUInt32> parentIndices,
+    const ezSimdTransformStreams& localTransforms, ezSimdTransformStreams& out_globalTransforms); // [tested]
+
+private:
+  enum Stream
+  {
+    PositionX,
+    PositionY,
+    PositionZ,
+    RotationX,
+    RotationY,
+    RotationZ,
+    RotationW,
+    ScaleX,
+    ScaleY,
+    ScaleZ,
+    StreamCount
+  };
+
+  EZ_ALWAYS_INLINE float* GetStreamData(Stream stream) { return reinterpret_cast<float*>(m_Streams[stream].GetData()); }
+  EZ_ALWAYS_INLINE const float* GetStreamData(Stream stream) const { return reinterpret_cast<const float*>(m_Streams[stream].GetData()); }
+
+  ezUInt32 m_uiCount = 0;
+
+  // every vector holds the values of four consecutive transforms
+  ezDynamicArray<ezSimdVec4f, ezAlignedAllocatorWrapper> m_Streams[StreamCount];
+};
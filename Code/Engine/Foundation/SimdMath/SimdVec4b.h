@@ -42,6 +42,9 @@ public:
   template <int N = 4>
   bool NoneSet() const;                                                                                    // [tested]
 
+  /// \brief Returns one bit per component, bit 0 for x, bit 1 for y and so on. Useful to iterate over the set components with ezMath::FirstBitLow.
+  ezUInt32 GetMask() const;                                                                                // [tested]
+
   static ezSimdVec4b Select(const ezSimdVec4b& vCmp, const ezSimdVec4b& vTrue, const ezSimdVec4b& vFalse); // [tested]
 
 public:
@@ -5,10 +5,23 @@
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
-struct HashedStringData
+// The storage is split into shards, selected by the upper bits of the string hash, so that threads that hash strings concurrently
+// (e.g. while deserializing resources) rarely contend on the same mutex.
+// Each shard gets its own cache line, to prevent false sharing between the mutexes.
+struct alignas(64) HashedStringShard
 {
   ezMutex m_Mutex;
   ezHashedString::StringStorage m_Storage;
+};
+
+struct HashedStringData
+{
+  static constexpr ezUInt32 NumShardsLog2 = 6;
+  static constexpr ezUInt32 NumShards = 1u << NumShardsLog2;
+
+  HashedStringShard& GetShard(ezUInt64 uiHash) { return m_Shards[uiHash >> (64 - NumShardsLog2)]; }
+
+  HashedStringShard m_Shards[NumShards];
   ezHashedString::HashedType m_Empty;
 };
 
@@ -23,11 +36,12 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView sString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  EZ_LOCK(s_pHSData->m_Mutex);
+  HashedStringShard& shard = s_pHSData->GetShard(uiHash);
+  EZ_LOCK(shard.m_Mutex);
 
   // try to find the existing string
   bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  auto ret = shard.m_Storage.FindOrAdd(uiHash, &bExisted);
 
   // if it already exists, just increase the refcount
   if (bExisted)
@@ -79,19 +93,22 @@ void ezHashedString::InitHashedString()
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
 ezUInt32 ezHashedString::ClearUnusedStrings()
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
-
   ezUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
+    EZ_LOCK(shard.m_Mutex);
+
+    for (auto it = shard.m_Storage.GetIterator(); it.IsValid();)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      if (it.Value().m_iRefCount == 0)
+      {
+        it = shard.m_Storage.Remove(it);
+        ++uiDeleted;
+      }
+      else
+        ++it;
     }
-    else
-      ++it;
   }
 
   return uiDeleted;
@@ -142,8 +159,9 @@ void ezHashedString::Clear()
 
 ezResult ezHashedString::LookupStringHash(ezUInt64 uiHash, ezStringView& out_sResult)
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
-  auto it = s_pHSData->m_Storage.Find(uiHash);
+  HashedStringShard& shard = s_pHSData->GetShard(uiHash);
+  EZ_LOCK(shard.m_Mutex);
+  auto it = shard.m_Storage.Find(uiHash);
 
   if (!it.IsValid())
     return EZ_FAILURE;
@@ -23,7 +23,7 @@ public:
 
   void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
   {
-    const IndexType uiSliceStartIndex = uiInvocation * m_uiItemsPerInvocation;
+    const IndexType uiSliceStartIndex = m_uiStartIndex + uiInvocation * m_uiItemsPerInvocation;
     const IndexType uiSliceEndIndex = ezMath::Min(uiSliceStartIndex + m_uiItemsPerInvocation, m_uiStartIndex + m_uiNumItems);
 
     EZ_ASSERT_DEV(uiSliceStartIndex < uiSliceEndIndex, "ParallelFor start/end indices given to index task are invalid: {} -> {}", uiSliceStartIndex, uiSliceEndIndex);
@@ -76,6 +76,182 @@ void ParallelForIndexedInternal(IndexType uiStartIndex, IndexType uiNumItems, co
   }
 }
 
+/// \brief Implements ezParallelForPartitioning::Adaptive.
+///
+/// The index range is initially split into one sub-range per participating thread. Each sub-range is stored in a single atomic,
+/// so that the owner can take small chunks from its front, while other threads can split off its back half at the same time.
+/// Chunks get smaller the less work is left in a sub-range, so there is always something left to steal until the very end.
+class AdaptiveRangeTask final : public ezTask
+{
+public:
+  AdaptiveRangeTask(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezUInt32 uiNumRanges, ezUInt32 uiMinChunkSize, const ezParallelForIndexedFunction32& taskCallback, ezAllocator* pAllocator)
+    : m_uiStartIndex(uiStartIndex)
+    , m_uiMinChunkSize(ezMath::Max(uiMinChunkSize, 1u))
+    , m_TaskCallback(taskCallback)
+    , m_Ranges(pAllocator)
+  {
+    m_Ranges.SetCount(uiNumRanges);
+
+    for (ezUInt32 i = 0; i < uiNumRanges; ++i)
+    {
+      const ezUInt32 uiBegin = static_cast<ezUInt32>((static_cast<ezUInt64>(uiNumItems) * i) / uiNumRanges);
+      const ezUInt32 uiEnd = static_cast<ezUInt32>((static_cast<ezUInt64>(uiNumItems) * (i + 1)) / uiNumRanges);
+      m_Ranges[i].m_iRange = Pack(uiBegin, uiEnd);
+    }
+  }
+
+  void Execute() override
+  {
+    // the calling thread works on the last range, the task invocations on all others
+    ProcessRange(m_Ranges.GetCount() - 1);
+  }
+
+  void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
+  {
+    ProcessRange(uiInvocation);
+  }
+
+private:
+  struct Range
+  {
+    // begin index in the lower 32 bits, end index (exclusive) in the upper 32 bits, both relative to m_uiStartIndex
+    ezAtomicInteger64 m_iRange;
+    ezUInt8 m_Padding[64 - sizeof(ezAtomicInteger64)];
+  };
+
+  static ezInt64 Pack(ezUInt32 uiBegin, ezUInt32 uiEnd) { return static_cast<ezInt64>((static_cast<ezUInt64>(uiEnd) << 32) | uiBegin); }
+  static ezUInt32 GetBegin(ezInt64 iRange) { return static_cast<ezUInt32>(static_cast<ezUInt64>(iRange) & 0xFFFFFFFFu); }
+  static ezUInt32 GetEnd(ezInt64 iRange) { return static_cast<ezUInt32>(static_cast<ezUInt64>(iRange) >> 32); }
+
+  void ProcessRange(ezUInt32 uiOwnRange) const
+  {
+    ezAtomicInteger64& ownRange = m_Ranges[uiOwnRange].m_iRange;
+
+    while (true)
+    {
+      ezUInt32 uiBegin, uiEnd;
+      while (TakeChunk(ownRange, uiBegin, uiEnd))
+      {
+        m_TaskCallback(m_uiStartIndex + uiBegin, m_uiStartIndex + uiEnd);
+      }
+
+      // Only the owner ever refills its range and it only does so while the range is empty, so other threads never modify it in between.
+      if (!StealRange(uiOwnRange, uiBegin, uiEnd))
+        return;
+
+      ownRange = Pack(uiBegin, uiEnd);
+    }
+  }
+
+  /// Takes a chunk from the front of the given range. The chunk size shrinks with the amount of remaining work.
+  bool TakeChunk(ezAtomicInteger64& ref_range, ezUInt32& out_uiBegin, ezUInt32& out_uiEnd) const
+  {
+    while (true)
+    {
+      const ezInt64 iRange = ref_range;
+      const ezUInt32 uiBegin = GetBegin(iRange);
+      const ezUInt32 uiEnd = GetEnd(iRange);
+
+      if (uiBegin >= uiEnd)
+        return false;
+
+      const ezUInt32 uiRemaining = uiEnd - uiBegin;
+      const ezUInt32 uiChunk = (uiRemaining <= 2 * m_uiMinChunkSize) ? uiRemaining : ezMath::Max(m_uiMinChunkSize, uiRemaining / 8);
+
+      if (ref_range.TestAndSet(iRange, Pack(uiBegin + uiChunk, uiEnd)))
+      {
+        out_uiBegin = uiBegin;
+        out_uiEnd = uiBegin + uiChunk;
+        return true;
+      }
+    }
+  }
+
+  /// Splits off the back half of the range with the most remaining work. Returns false once all ranges are empty.
+  bool StealRange(ezUInt32 uiOwnRange, ezUInt32& out_uiBegin, ezUInt32& out_uiEnd) const
+  {
+    while (true)
+    {
+      ezUInt32 uiVictim = ezInvalidIndex;
+      ezUInt32 uiMostRemaining = 0;
+      ezInt64 iVictimRange = 0;
+
+      for (ezUInt32 i = 0; i < m_Ranges.GetCount(); ++i)
+      {
+        if (i == uiOwnRange)
+          continue;
+
+        const ezInt64 iRange = m_Ranges[i].m_iRange;
+        const ezUInt32 uiBegin = GetBegin(iRange);
+        const ezUInt32 uiEnd = GetEnd(iRange);
+
+        if (uiBegin < uiEnd && uiEnd - uiBegin > uiMostRemaining)
+        {
+          uiVictim = i;
+          uiMostRemaining = uiEnd - uiBegin;
+          iVictimRange = iRange;
+        }
+      }
+
+      if (uiVictim == ezInvalidIndex)
+        return false;
+
+      const ezUInt32 uiBegin = GetBegin(iVictimRange);
+      const ezUInt32 uiEnd = GetEnd(iVictimRange);
+
+      // don't split ranges that would yield chunks below the minimum size, take them entirely instead
+      const ezUInt32 uiSplit = (uiMostRemaining < 2 * m_uiMinChunkSize) ? uiBegin : uiBegin + uiMostRemaining / 2;
+
+      if (m_Ranges[uiVictim].m_iRange.TestAndSet(iVictimRange, Pack(uiBegin, uiSplit)))
+      {
+        out_uiBegin = uiSplit;
+        out_uiEnd = uiEnd;
+        return true;
+      }
+    }
+  }
+
+  ezUInt32 m_uiStartIndex;
+  ezUInt32 m_uiMinChunkSize;
+  const ezParallelForIndexedFunction32& m_TaskCallback;
+  mutable ezDynamicArray<Range> m_Ranges;
+};
+
+void ezTaskSystem::ParallelForAdaptive(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, const ezParallelForIndexedFunction32& taskCallback, const char* szTaskName, ezTaskNesting taskNesting, const ezParallelForParams& params)
+{
+  if (!szTaskName)
+  {
+    szTaskName = "Generic Adaptive Task";
+  }
+
+  const ezUInt32 uiMinChunkSize = ezMath::Max(params.m_uiBinSize, 1u);
+  const ezUInt32 uiNumThreads = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1;
+  const ezUInt32 uiNumRanges = ezMath::Clamp(uiNumItems / uiMinChunkSize, 1u, uiNumThreads);
+
+  if (uiNumRanges == 1)
+  {
+    EZ_PROFILE_SCOPE(szTaskName);
+    taskCallback(uiStartIndex, uiStartIndex + uiNumItems);
+    return;
+  }
+
+  ezAllocator* pAllocator = (params.m_pTaskAllocator != nullptr) ? params.m_pTaskAllocator : ezFoundation::GetDefaultAllocator();
+
+  ezSharedPtr<AdaptiveRangeTask> pTask = EZ_NEW(pAllocator, AdaptiveRangeTask, uiStartIndex, uiNumItems, uiNumRanges, uiMinChunkSize, taskCallback, pAllocator);
+  pTask->ConfigureTask(szTaskName, taskNesting);
+  pTask->SetMultiplicity(uiNumRanges - 1);
+
+  ezTaskGroupID taskGroupId = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame);
+
+  {
+    // instead of just waiting, the calling thread takes part in the work
+    EZ_PROFILE_SCOPE(szTaskName);
+    pTask->Execute();
+  }
+
+  ezTaskSystem::WaitForGroup(taskGroupId);
+}
+
 void ezParallelForParams::DetermineThreading(ezUInt64 uiNumItemsToExecute, ezUInt32& out_uiNumTasksToRun, ezUInt64& out_uiNumItemsPerTask) const
 {
   // we create a single task, but we set it's multiplicity to M (= out_uiNumTasksToRun)
@@ -131,10 +307,26 @@ void ezParallelForParams::DetermineThreading(ezUInt64 uiNumItemsToExecute, ezUIn
 
 void ezTaskSystem::ParallelForIndexed(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction32 taskCallback, const char* szTaskName, ezTaskNesting taskNesting, const ezParallelForParams& params)
 {
+  if (params.m_Partitioning == ezParallelForPartitioning::Adaptive && uiNumItems > params.m_uiBinSize)
+  {
+    ParallelForAdaptive(uiStartIndex, uiNumItems, taskCallback, szTaskName, taskNesting, params);
+    return;
+  }
+
   ParallelForIndexedInternal<ezUInt32, ezParallelForIndexedFunction32>(uiStartIndex, uiNumItems, std::move(taskCallback), szTaskName, params, taskNesting);
 }
 
 void ezTaskSystem::ParallelForIndexed(ezUInt64 uiStartIndex, ezUInt64 uiNumItems, ezParallelForIndexedFunction64 taskCallback, const char* szTaskName, ezTaskNesting taskNesting, const ezParallelForParams& params)
 {
+  // the adaptive ranges are packed into 32 bit indices, larger item counts always use static partitioning
+  if (params.m_Partitioning == ezParallelForPartitioning::Adaptive && uiNumItems > params.m_uiBinSize && uiNumItems <= 0xFFFFFFFFllu)
+  {
+    auto wrappedCallback = [uiStartIndex, &taskCallback](ezUInt32 uiBegin, ezUInt32 uiEnd)
+    { taskCallback(uiStartIndex + uiBegin, uiStartIndex + uiEnd); };
+
+    ParallelForAdaptive(0, static_cast<ezUInt32>(uiNumItems), wrappedCallback, szTaskName, taskNesting, params);
+    return;
+  }
+
   ParallelForIndexedInternal<ezUInt64, ezParallelForIndexedFunction64>(uiStartIndex, uiNumItems, std::move(taskCallback), szTaskName, params, taskNesting);
 }
@@ -52,6 +52,13 @@ void ezTaskSystem::ParallelForInternal(ezArrayPtr<ElemType> taskItems, ezParalle
     EZ_PROFILE_SCOPE(arrayPtrTask.m_sTaskName);
     arrayPtrTask.Execute();
   }
+  else if (params.m_Partitioning == ezParallelForPartitioning::Adaptive)
+  {
+    auto rangeCallback = [taskItems, &taskCallback](ezUInt32 uiBegin, ezUInt32 uiEnd)
+    { taskCallback(uiBegin, taskItems.GetSubArray(uiBegin, uiEnd - uiBegin)); };
+
+    ParallelForAdaptive(0, taskItems.GetCount(), rangeCallback, taskName ? taskName : "Generic ArrayPtr Task", params.m_NestingMode, params);
+  }
   else
   {
     ezUInt32 uiMultiplicity;
@@ -0,0 +1,137 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/ReadWriteLock.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+ezReadWriteLock::ezReadWriteLock() = default;
+
+ezReadWriteLock::~ezReadWriteLock()
+{
+  EZ_ASSERT_DEV(m_Readers.IsEmpty() && m_uiWriteLockCount == 0, "ezReadWriteLock is destroyed while it is still locked.");
+}
+
+bool ezReadWriteLock::IsWriteLocked() const
+{
+  EZ_LOCK(m_State);
+
+  return m_uiWriteLockCount > 0;
+}
+
+bool ezReadWriteLock::IsWriterThread(ezThreadID threadId) const
+{
+  return m_uiWriteLockCount > 0 && m_WriterThread == threadId;
+}
+
+ezUInt32 ezReadWriteLock::FindReader(ezThreadID threadId) const
+{
+  for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
+  {
+    if (m_Readers[i].m_ThreadId == threadId)
+      return i;
+  }
+
+  return ezInvalidIndex;
+}
+
+void ezReadWriteLock::LockRead()
+{
+  const ezThreadID threadId = ezThreadUtils::GetCurrentThreadID();
+
+  EZ_LOCK(m_State);
+
+  // the writer may read as well, this is just treated as another recursion of its exclusive lock
+  if (IsWriterThread(threadId))
+  {
+    ++m_uiWriteLockCount;
+    return;
+  }
+
+  // a recursive read lock must not wait for writers, since those wait for this thread to release its read lock
+  const ezUInt32 uiReader = FindReader(threadId);
+  if (uiReader != ezInvalidIndex)
+  {
+    ++m_Readers[uiReader].m_uiLockCount;
+    return;
+  }
+
+  // new readers let waiting writers go first
+  while (m_uiWriteLockCount > 0 || m_uiNumWaitingWriters > 0)
+  {
+    m_State.UnlockWaitForSignalAndLock();
+  }
+
+  m_Readers.PushBack({threadId, 1});
+}
+
+void ezReadWriteLock::UnlockRead()
+{
+  const ezThreadID threadId = ezThreadUtils::GetCurrentThreadID();
+
+  EZ_LOCK(m_State);
+
+  if (IsWriterThread(threadId))
+  {
+    --m_uiWriteLockCount;
+
+    if (m_uiWriteLockCount == 0)
+    {
+      m_State.SignalAll();
+    }
+
+    return;
+  }
+
+  const ezUInt32 uiReader = FindReader(threadId);
+  EZ_ASSERT_DEV(uiReader != ezInvalidIndex, "ezReadWriteLock::UnlockRead() was called more often than LockRead().");
+
+  if (--m_Readers[uiReader].m_uiLockCount > 0)
+    return;
+
+  m_Readers.RemoveAtAndSwap(uiReader);
+
+  if (m_Readers.IsEmpty())
+  {
+    m_State.SignalAll();
+  }
+}
+
+void ezReadWriteLock::Lock()
+{
+  const ezThreadID threadId = ezThreadUtils::GetCurrentThreadID();
+
+  EZ_LOCK(m_State);
+
+  if (IsWriterThread(threadId))
+  {
+    ++m_uiWriteLockCount;
+    return;
+  }
+
+  EZ_ASSERT_DEV(FindReader(threadId) == ezInvalidIndex, "ezReadWriteLock::Lock() was called by a thread that holds a read lock, which would deadlock.");
+
+  ++m_uiNumWaitingWriters;
+
+  while (m_uiWriteLockCount > 0 || !m_Readers.IsEmpty())
+  {
+    m_State.UnlockWaitForSignalAndLock();
+  }
+
+  --m_uiNumWaitingWriters;
+
+  m_WriterThread = threadId;
+  m_uiWriteLockCount = 1;
+}
+
+void ezReadWriteLock::Unlock()
+{
+  EZ_LOCK(m_State);
+
+  EZ_ASSERT_DEV(IsWriterThread(ezThreadUtils::GetCurrentThreadID()), "ezReadWriteLock::Unlock() was called by a thread that does not hold the exclusive lock.");
+  --m_uiWriteLockCount;
+
+  if (m_uiWriteLockCount == 0)
+  {
+    m_State.SignalAll();
+  }
+}
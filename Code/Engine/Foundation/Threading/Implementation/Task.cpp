@@ -11,6 +11,8 @@ void ezTask::Reset()
   m_iRemainingRuns = (int)ezMath::Max(1u, m_uiMultiplicity);
   m_bCancelExecution = false;
   m_bTaskIsScheduled = false;
+  m_bInWorkStealingQueue = false;
+  m_iDequeuedRuns = 0;
   m_bUsesMultiplicity = m_uiMultiplicity > 0;
 }
 
@@ -79,6 +79,7 @@ private:
   // The task system and its worker threads implement most of the functionality of the task handling.
   // Therefore they are allowed to modify all this internal state.
   friend class ezTaskSystem;
+  friend class ezTaskGraph;
 
   void Reset();
 
@@ -94,6 +95,12 @@ private:
   /// \brief Whether this task has been scheduled for execution already, or is still waiting for dependencies to finish.
   bool m_bTaskIsScheduled = false;
 
+  /// \brief Whether the task's invocations were put into a worker's work-stealing queue instead of the shared task lists.
+  bool m_bInWorkStealingQueue = false;
+
+  /// \brief Number of invocations that were taken out of a work-stealing queue for execution. Set to -1 when the task got canceled before that.
+  ezAtomicInteger32 m_iDequeuedRuns;
+
   /// \brief Double buffers the state whether this task uses multiplicity, since it can't read m_uiMultiplicity while the task is scheduled.
   bool m_bUsesMultiplicity = false;
 
@@ -108,5 +115,9 @@ private:
   /// \brief The parent group to which this task belongs.
   ezTaskGroupID m_BelongsToGroup;
 
+  /// \brief Set while this task is a node of an ezTaskGraph, so that the graph can schedule the dependent nodes once this one is finished.
+  ezTaskGraph* m_pTaskGraph = nullptr;
+  ezUInt32 m_uiTaskGraphNode = 0;
+
   ezString m_sTaskName;
 };
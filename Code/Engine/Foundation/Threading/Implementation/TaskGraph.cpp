@@ -0,0 +1,187 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskGraph.h>
+
+ezTaskGraph::ezTaskGraph() = default;
+
+ezTaskGraph::~ezTaskGraph()
+{
+  EZ_ASSERT_DEV(!IsRunning(), "A task graph must not be destroyed while it is running.");
+
+  Clear();
+}
+
+ezUInt32 ezTaskGraph::AddNode(const ezSharedPtr<ezTask>& pTask)
+{
+  EZ_ASSERT_DEV(!IsRunning(), "A task graph must not be modified while it is running.");
+  EZ_ASSERT_DEBUG(pTask != nullptr, "Cannot add nullptr tasks.");
+  EZ_ASSERT_DEV(pTask->m_pTaskGraph == nullptr, "Task '{}' is already a node of a task graph.", pTask->m_sTaskName);
+
+  const ezUInt32 uiNode = m_Nodes.GetCount();
+
+  pTask->m_pTaskGraph = this;
+  pTask->m_uiTaskGraphNode = uiNode;
+
+  m_Nodes.ExpandAndGetRef().m_pTask = pTask;
+  m_bCompiled = false;
+
+  return uiNode;
+}
+
+void ezTaskGraph::AddDependency(ezUInt32 uiNode, ezUInt32 uiDependsOnNode)
+{
+  EZ_ASSERT_DEV(!IsRunning(), "A task graph must not be modified while it is running.");
+  EZ_ASSERT_DEV(uiNode < m_Nodes.GetCount() && uiDependsOnNode < m_Nodes.GetCount(), "Invalid node index");
+  EZ_ASSERT_DEV(uiNode != uiDependsOnNode, "A node cannot depend on itself");
+
+  auto& dep = m_Dependencies.ExpandAndGetRef();
+  dep.m_uiNode = uiNode;
+  dep.m_uiDependsOnNode = uiDependsOnNode;
+
+  m_bCompiled = false;
+}
+
+void ezTaskGraph::Clear()
+{
+  EZ_ASSERT_DEV(!IsRunning(), "A task graph must not be modified while it is running.");
+
+  for (auto& node : m_Nodes)
+  {
+    node.m_pTask->m_pTaskGraph = nullptr;
+  }
+
+  m_Nodes.Clear();
+  m_Dependencies.Clear();
+  m_Dependents.Clear();
+  m_bCompiled = true;
+}
+
+ezResult ezTaskGraph::Compile()
+{
+  EZ_ASSERT_DEV(!IsRunning(), "A task graph must not be modified while it is running.");
+
+  for (auto& node : m_Nodes)
+  {
+    node.m_uiNumDependencies = 0;
+    node.m_uiNumDependents = 0;
+  }
+
+  for (const auto& dep : m_Dependencies)
+  {
+    ++m_Nodes[dep.m_uiNode].m_uiNumDependencies;
+    ++m_Nodes[dep.m_uiDependsOnNode].m_uiNumDependents;
+  }
+
+  // store the dependents of every node consecutively, the edges are then filled in from the back
+  ezUInt32 uiFirstDependent = 0;
+  for (auto& node : m_Nodes)
+  {
+    uiFirstDependent += node.m_uiNumDependents;
+    node.m_uiFirstDependent = uiFirstDependent;
+  }
+
+  m_Dependents.SetCountUninitialized(m_Dependencies.GetCount());
+
+  for (const auto& dep : m_Dependencies)
+  {
+    m_Dependents[--m_Nodes[dep.m_uiDependsOnNode].m_uiFirstDependent] = dep.m_uiNode;
+  }
+
+  // check for cycles, by repeatedly removing nodes without pending dependencies
+  ezDynamicArray<ezUInt32> pendingDependencies;
+  ezDynamicArray<ezUInt32> readyNodes;
+  pendingDependencies.SetCountUninitialized(m_Nodes.GetCount());
+
+  for (ezUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
+  {
+    pendingDependencies[i] = m_Nodes[i].m_uiNumDependencies;
+
+    if (pendingDependencies[i] == 0)
+    {
+      readyNodes.PushBack(i);
+    }
+  }
+
+  ezUInt32 uiNumVisited = 0;
+  while (!readyNodes.IsEmpty())
+  {
+    const Node& node = m_Nodes[readyNodes.PeekBack()];
+    readyNodes.PopBack();
+    ++uiNumVisited;
+
+    for (ezUInt32 i = 0; i < node.m_uiNumDependents; ++i)
+    {
+      const ezUInt32 uiDependent = m_Dependents[node.m_uiFirstDependent + i];
+
+      if (--pendingDependencies[uiDependent] == 0)
+      {
+        readyNodes.PushBack(uiDependent);
+      }
+    }
+  }
+
+  if (uiNumVisited != m_Nodes.GetCount())
+  {
+    ezLog::Error("Task graph contains a cyclic dependency.");
+    return EZ_FAILURE;
+  }
+
+  m_bCompiled = true;
+  return EZ_SUCCESS;
+}
+
+ezTaskGroupID ezTaskGraph::Launch(ezTaskPriority::Enum priority, ezTaskGroupID dependency, ezOnTaskGroupFinishedCallback callback)
+{
+  EZ_ASSERT_DEV(!IsRunning(), "A task graph cannot be launched again before the previous launch has finished.");
+
+  if (!m_bCompiled)
+  {
+    EZ_VERIFY(Compile().Succeeded(), "Task graph cannot be launched.");
+  }
+
+  ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(priority, callback);
+
+  if (dependency.IsValid())
+  {
+    ezTaskSystem::AddTaskGroupDependency(group, dependency);
+  }
+
+  for (auto& node : m_Nodes)
+  {
+    node.m_iPendingDependencies = static_cast<ezInt32>(node.m_uiNumDependencies);
+    node.m_iFinished = 0;
+
+    if (node.m_uiNumDependencies == 0)
+    {
+      ezTaskSystem::AddTaskToGroup(group, node.m_pTask);
+    }
+    else
+    {
+      ezTaskSystem::AddDeferredTaskToGroup(group, node.m_pTask);
+    }
+  }
+
+  m_LastLaunch = group;
+  ezTaskSystem::StartTaskGroup(group);
+
+  return group;
+}
+
+void ezTaskGraph::NodeHasFinished(ezUInt32 uiNode, ezTaskGroup* pGroup)
+{
+  Node& node = m_Nodes[uiNode];
+
+  if (!node.m_iFinished.TestAndSet(0, 1))
+    return;
+
+  for (ezUInt32 i = 0; i < node.m_uiNumDependents; ++i)
+  {
+    Node& dependent = m_Nodes[m_Dependents[node.m_uiFirstDependent + i]];
+
+    if (dependent.m_iPendingDependencies.Decrement() == 0)
+    {
+      ezTaskSystem::ScheduleDeferredTask(pGroup, dependent.m_pTask);
+    }
+  }
+}
@@ -9,6 +9,7 @@
 
 class ezTask;
 class ezTaskGroup;
+class ezTaskGraph;
 class ezTaskWorkerThread;
 class ezTaskSystemState;
 class ezTaskSystemThreadState;
@@ -162,6 +163,19 @@ enum class ezTaskNesting
   Never,
 };
 
+/// \brief How ezTaskSystem::ParallelFor distributes the task items across the worker threads.
+enum class ezParallelForPartitioning
+{
+  /// The items are split into equally sized slices up front, according to m_uiBinSize and m_uiMaxTasksPerThread.
+  /// Cheapest option when every item takes roughly the same amount of time.
+  Static,
+
+  /// Every worker starts with an equal share of the items, but only takes small chunks of it at a time.
+  /// Workers that run out of work split the largest remaining range of another worker in half and continue with that.
+  /// Use this when the cost per item varies a lot, so that the last few expensive items don't leave the other cores idle.
+  Adaptive,
+};
+
 /// \brief Settings for ezTaskSystem::ParallelFor invocations.
 struct EZ_FOUNDATION_DLL ezParallelForParams
 {
@@ -170,6 +184,8 @@ struct EZ_FOUNDATION_DLL ezParallelForParams
   /// The minimum number of items that must be processed by a task instance.
   /// If the overall number of tasks lies below this value, all work will be executed purely serially
   /// without involving any tasks at all.
+  /// With ezParallelForPartitioning::Adaptive this is also the smallest chunk that is ever handed to the callback
+  /// (except for the very last chunk of a range).
   ezUInt32 m_uiBinSize = 1;
 
   /// Indicates how many tasks per thread may be spawned at most by a ParallelFor invocation.
@@ -178,8 +194,12 @@ struct EZ_FOUNDATION_DLL ezParallelForParams
   /// low numbers (usually 1) are recommended, while higher numbers (initially test with 2 or 3)
   /// might yield better results for workloads where task items may take vastly different amounts
   /// of time, such that scheduling in a balanced fashion becomes more difficult.
+  /// Ignored with ezParallelForPartitioning::Adaptive.
   ezUInt32 m_uiMaxTasksPerThread = 2;
 
+  /// Whether the work is split up front or balanced dynamically while it is processed. See ezParallelForPartitioning.
+  ezParallelForPartitioning m_Partitioning = ezParallelForPartitioning::Static;
+
   ezTaskNesting m_NestingMode = ezTaskNesting::Never;
 
   /// The allocator used to for the tasks that the parallel-for uses internally. If null, will use the default allocator.
@@ -160,78 +160,168 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
 
     pGroup->m_iNumRemainingTasks = iRemainingTasks;
 
+    // 'this frame' tasks go into the work-stealing queue of the scheduling thread, if it has one
+    // that thread will work on them first, idle threads steal from there, without taking the task system mutex
+    ezTaskWorkStealingQueue* pWorkQueue = nullptr;
+    if (pGroup->m_Priority <= ezTaskPriority::LateThisFrame && tl_TaskWorkerInfo.m_pWorkQueues != nullptr)
+    {
+      pWorkQueue = &tl_TaskWorkerInfo.m_pWorkQueues[pGroup->m_Priority - ezTaskPriority::EarlyThisFrame];
+    }
 
     for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
     {
       auto& pTask = pGroup->m_Tasks[task];
+      pTask->m_bTaskIsScheduled = true;
+
+      // only tasks that never wait may be queued there, because a waiting thread can't be picky about what it takes from a queue
+      pTask->m_bInWorkStealingQueue = pWorkQueue != nullptr && pTask->m_NestingMode == ezTaskNesting::Never;
 
       for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
       {
+        if (pTask->m_bInWorkStealingQueue)
+        {
+          ezTaskWorkStealingQueue::Entry entry;
+          entry.m_pTask = &pTask;
+          entry.m_uiInvocation = mult;
+
+          if (pWorkQueue->Push(entry))
+            continue;
+
+          // the queue is full, fall back to the shared list
+        }
+
         TaskData td;
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
         td.m_uiInvocation = mult;
 
         if (bHighPriority)
           s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
         else
           s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+
+        s_pState->m_iNumTasks[pGroup->m_Priority].Increment();
       }
     }
 
     // send the proper thread signal, to make sure one of the correct worker threads is awake
-    switch (pGroup->m_Priority)
+    WakeUpThreadsForPriority(pGroup->m_Priority, iRemainingTasks);
+  }
+}
+
+void ezTaskSystem::DependencyHasFinished(ezTaskGroup* pGroup)
+{
+  // remove one dependency from the group
+  if (pGroup->m_iNumActiveDependencies.Decrement() == 0)
+  {
+    // if there are no remaining dependencies, kick off all tasks in this group
+    ScheduleGroupTasks(pGroup, true);
+  }
+}
+
+void ezTaskSystem::AddDeferredTaskToGroup(ezTaskGroupID groupID, const ezSharedPtr<ezTask>& pTask)
+{
+  EZ_ASSERT_DEBUG(pTask != nullptr, "Cannot add nullptr tasks.");
+  EZ_ASSERT_DEV(pTask->IsTaskFinished(), "The given task is not finished! Cannot reuse a task before it is done.");
+
+  ezTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
+
+  // the task is not added to the group's task list, the group only learns about it once it gets scheduled
+  pTask->Reset();
+  pTask->m_BelongsToGroup = groupID;
+}
+
+void ezTaskSystem::ScheduleDeferredTask(ezTaskGroup* pGroup, ezSharedPtr<ezTask>& ref_pTask)
+{
+  const ezUInt32 uiNumRuns = ezMath::Max(1u, ref_pTask->m_uiMultiplicity);
+
+  // the task that schedules this one has not yet finished, so the group can't finish before this is added
+  pGroup->m_iNumRemainingTasks.Add(static_cast<ezInt32>(uiNumRuns));
+
+  ref_pTask->m_iRemainingRuns = static_cast<ezInt32>(uiNumRuns);
+  ref_pTask->m_bTaskIsScheduled = true;
+
+  ezUInt32 uiFirstUnqueuedRun = 0;
+
+  // same as in ScheduleGroupTasks(), except that this does not need the task system mutex, unless the queue is full
+  if (pGroup->m_Priority <= ezTaskPriority::LateThisFrame && tl_TaskWorkerInfo.m_pWorkQueues != nullptr && ref_pTask->m_NestingMode == ezTaskNesting::Never)
+  {
+    ezTaskWorkStealingQueue& workQueue = tl_TaskWorkerInfo.m_pWorkQueues[pGroup->m_Priority - ezTaskPriority::EarlyThisFrame];
+    ref_pTask->m_bInWorkStealingQueue = true;
+
+    ezTaskWorkStealingQueue::Entry entry;
+    entry.m_pTask = &ref_pTask;
+
+    for (; uiFirstUnqueuedRun < uiNumRuns; ++uiFirstUnqueuedRun)
     {
-      case ezTaskPriority::EarlyThisFrame:
-      case ezTaskPriority::ThisFrame:
-      case ezTaskPriority::LateThisFrame:
-      case ezTaskPriority::EarlyNextFrame:
-      case ezTaskPriority::NextFrame:
-      case ezTaskPriority::LateNextFrame:
-      case ezTaskPriority::In2Frames:
-      case ezTaskPriority::In3Frames:
-      case ezTaskPriority::In4Frames:
-      case ezTaskPriority::In5Frames:
-      case ezTaskPriority::In6Frames:
-      case ezTaskPriority::In7Frames:
-      case ezTaskPriority::In8Frames:
-      case ezTaskPriority::In9Frames:
-      {
-        WakeUpThreads(ezWorkerThreadType::ShortTasks, iRemainingTasks);
-        break;
-      }
+      entry.m_uiInvocation = uiFirstUnqueuedRun;
 
-      case ezTaskPriority::LongRunning:
-      case ezTaskPriority::LongRunningHighPriority:
-      {
-        WakeUpThreads(ezWorkerThreadType::LongTasks, iRemainingTasks);
+      if (!workQueue.Push(entry))
         break;
-      }
+    }
+  }
 
-      case ezTaskPriority::FileAccess:
-      case ezTaskPriority::FileAccessHighPriority:
-      {
-        WakeUpThreads(ezWorkerThreadType::FileAccess, iRemainingTasks);
-        break;
-      }
+  if (uiFirstUnqueuedRun < uiNumRuns)
+  {
+    EZ_LOCK(s_TaskSystemMutex);
 
-      case ezTaskPriority::SomeFrameMainThread:
-      case ezTaskPriority::ThisFrameMainThread:
-      case ezTaskPriority::ENUM_COUNT:
-        // nothing to do for these enum values
-        break;
+    for (ezUInt32 mult = uiFirstUnqueuedRun; mult < uiNumRuns; ++mult)
+    {
+      TaskData td;
+      td.m_pBelongsToGroup = pGroup;
+      td.m_pTask = ref_pTask;
+      td.m_uiInvocation = mult;
+
+      s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+      s_pState->m_iNumTasks[pGroup->m_Priority].Increment();
     }
   }
+
+  WakeUpThreadsForPriority(pGroup->m_Priority, uiNumRuns);
 }
 
-void ezTaskSystem::DependencyHasFinished(ezTaskGroup* pGroup)
+void ezTaskSystem::WakeUpThreadsForPriority(ezTaskPriority::Enum priority, ezUInt32 uiNumThreads)
 {
-  // remove one dependency from the group
-  if (pGroup->m_iNumActiveDependencies.Decrement() == 0)
+  switch (priority)
   {
-    // if there are no remaining dependencies, kick off all tasks in this group
-    ScheduleGroupTasks(pGroup, true);
+    case ezTaskPriority::EarlyThisFrame:
+    case ezTaskPriority::ThisFrame:
+    case ezTaskPriority::LateThisFrame:
+    case ezTaskPriority::EarlyNextFrame:
+    case ezTaskPriority::NextFrame:
+    case ezTaskPriority::LateNextFrame:
+    case ezTaskPriority::In2Frames:
+    case ezTaskPriority::In3Frames:
+    case ezTaskPriority::In4Frames:
+    case ezTaskPriority::In5Frames:
+    case ezTaskPriority::In6Frames:
+    case ezTaskPriority::In7Frames:
+    case ezTaskPriority::In8Frames:
+    case ezTaskPriority::In9Frames:
+    {
+      WakeUpThreads(ezWorkerThreadType::ShortTasks, uiNumThreads);
+      break;
+    }
+
+    case ezTaskPriority::LongRunning:
+    case ezTaskPriority::LongRunningHighPriority:
+    {
+      WakeUpThreads(ezWorkerThreadType::LongTasks, uiNumThreads);
+      break;
+    }
+
+    case ezTaskPriority::FileAccess:
+    case ezTaskPriority::FileAccessHighPriority:
+    {
+      WakeUpThreads(ezWorkerThreadType::FileAccess, uiNumThreads);
+      break;
+    }
+
+    case ezTaskPriority::SomeFrameMainThread:
+    case ezTaskPriority::ThisFrameMainThread:
+    case ezTaskPriority::ENUM_COUNT:
+      // nothing to do for these enum values
+      break;
   }
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Threading/Implementation/TaskWorkStealingQueue.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 class ezTaskSystemThreadState
@@ -16,6 +17,9 @@ private:
 
   // the maximum number of worker threads that should be non-idle (and not blocked) at any time
   ezUInt32 m_uiMaxWorkersToUse[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  // The work-stealing queues of the main thread. Workers steal the main thread's tasks from here.
+  ezTaskWorkStealingQueue m_MainThreadWorkQueues[ezTaskWorkStealingQueue::NumQueuedPriorities];
 };
 
 class ezTaskSystemState
@@ -30,5 +34,10 @@ private:
   ezDeque<ezTaskGroup> m_TaskGroups;
 
   // The lists of all scheduled tasks, for each priority.
+  // 'This frame' tasks that never wait are usually put into the per-thread work-stealing queues instead.
   ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+
+  // The number of entries in each of the m_Tasks lists. Can be read without holding the task system mutex,
+  // which allows threads to skip empty lists without locking.
+  ezAtomicInteger32 m_iNumTasks[ezTaskPriority::ENUM_COUNT];
 };
@@ -5,6 +5,7 @@
 #include <Foundation/Threading/Implementation/TaskSystemState.h>
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
 #include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/TaskGraph.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 ezTaskGroupID ezTaskSystem::StartSingleTask(const ezSharedPtr<ezTask>& pTask, ezTaskPriority::Enum priority, ezTaskGroupID dependency,
@@ -31,20 +32,36 @@ void ezTaskSystem::TaskHasFinished(ezSharedPtr<ezTask>&& pTask, ezTaskGroup* pGr
   // call task finished callback and deallocate the task (if last reference)
   if (pTask && pTask->m_iRemainingRuns == 0)
   {
+    if (pTask->m_pTaskGraph != nullptr)
+    {
+      // this has to happen before the group is notified below, so that the dependent nodes are added to the group in time
+      pTask->m_pTaskGraph->NodeHasFinished(pTask->m_uiTaskGraphNode, pGroup);
+    }
+
     if (pTask->m_OnTaskFinished.IsValid())
     {
       pTask->m_OnTaskFinished(pTask);
     }
-
-    // make sure to clear the task sharedptr BEFORE we mark the task (group) as finished,
-    // so that if this is the last reference, the task gets deallocated first
-    pTask.Clear();
   }
 
+  // make sure to clear the task sharedptr BEFORE we mark the task (group) as finished,
+  // so that if this is the last reference, the task gets deallocated first.
+  // This also applies to invocations of tasks with multiplicity that are not the last one to finish,
+  // otherwise the task might be deallocated after the group is finished, e.g. after its allocator has already been reset.
+  pTask.Clear();
+
   if (pGroup->m_iNumRemainingTasks.Decrement() == 0)
   {
     // If this was the last task that had to be finished from this group, make sure all dependent groups are started
 
+    {
+      EZ_LOCK(s_TaskSystemMutex);
+
+      // unless an outside reference is held onto a task, this will deallocate the tasks
+      // this has to happen before the group is marked as finished, since waiting threads may release the memory the tasks were allocated from
+      pGroup->m_Tasks.Clear();
+    }
+
     ezUInt32 groupCounter = 0;
     {
       // see ezTaskGroup::WaitForFinish() for why we need this lock here
@@ -61,9 +78,6 @@ void ezTaskSystem::TaskHasFinished(ezSharedPtr<ezTask>&& pTask, ezTaskGroup* pGr
     {
       EZ_LOCK(s_TaskSystemMutex);
 
-      // unless an outside reference is held onto a task, this will deallocate the tasks
-      pGroup->m_Tasks.Clear();
-
       for (ezUInt32 dep = 0; dep < pGroup->m_OthersDependingOnMe.GetCount(); ++dep)
       {
         DependencyHasFinished(pGroup->m_OthersDependingOnMe[dep].m_pTaskGroup);
@@ -94,29 +108,112 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  EZ_LOCK(s_TaskSystemMutex);
+  TaskData td;
+
+  if (TryGetNextTask(FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+    return td;
+
+  if (pWorkerState)
+  {
+    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+    // Tasks are published without a common lock, so whoever scheduled a task right before we went idle
+    // may still have seen this thread as 'active' and therefore did not wake anyone up.
+    // Having announced the idle state, look once more, to not go to sleep while work is pending.
+    if (TryGetNextTask(FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+    {
+      // if someone woke us up in the meantime, the state is already 'active' again and the wake-up signal is just consumed later
+      pWorkerState->CompareAndSwap((int)ezTaskWorkerState::Idle, (int)ezTaskWorkerState::Active);
+      return td;
+    }
+  }
+
+  return TaskData();
+}
 
+bool ezTaskSystem::TryGetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
+  const ezTaskGroupID& WaitingForGroup, TaskData& out_taskData)
+{
   // go through all the task lists that this thread is willing to work on
   for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
   {
+    // tasks in the work-stealing queues never wait, so any thread may execute them, no matter what it is waiting for
+    if (prio <= ezTaskPriority::LateThisFrame && TryGetQueuedTask((ezTaskPriority::Enum)prio, out_taskData))
+      return true;
+
+    // don't bother locking the mutex for empty lists
+    if (s_pState->m_iNumTasks[prio] == 0)
+      continue;
+
+    EZ_LOCK(s_TaskSystemMutex);
+
     for (auto it = s_pState->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
     {
       if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
       {
-        TaskData td = *it;
+        out_taskData = *it;
 
         s_pState->m_Tasks[prio].Remove(it);
-        return td;
+        s_pState->m_iNumTasks[prio].Decrement();
+        return true;
       }
     }
   }
 
-  if (pWorkerState)
+  return false;
+}
+
+bool ezTaskSystem::TryGetQueuedTask(ezTaskPriority::Enum priority, TaskData& out_taskData)
+{
+  const ezUInt32 uiQueue = priority - ezTaskPriority::EarlyThisFrame;
+  ezTaskWorkStealingQueue* pOwnQueues = tl_TaskWorkerInfo.m_pWorkQueues;
+
+  ezTaskWorkStealingQueue::Entry entry;
+  bool bFound = false;
+
+  // prefer the most recently scheduled work of this thread, its data is most likely still in the cache
+  if (pOwnQueues != nullptr)
   {
-    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+    bFound = pOwnQueues[uiQueue].Pop(entry);
   }
 
-  return TaskData();
+  if (!bFound)
+  {
+    ezTaskWorkStealingQueue* pMainThreadQueues = s_pThreadState->m_MainThreadWorkQueues;
+
+    if (pMainThreadQueues != pOwnQueues)
+    {
+      bFound = pMainThreadQueues[uiQueue].Steal(entry);
+    }
+  }
+
+  if (!bFound)
+  {
+    const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[ezWorkerThreadType::ShortTasks];
+
+    // start with the next worker, so that not all threads try to steal from the same queue
+    const ezUInt32 uiFirstWorker = static_cast<ezUInt32>(tl_TaskWorkerInfo.m_iWorkerIndex + 1);
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      ezTaskWorkStealingQueue* pQueues = s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][(uiFirstWorker + i) % uiNumWorkers]->m_WorkQueues;
+
+      if (pQueues != pOwnQueues && pQueues[uiQueue].Steal(entry))
+      {
+        bFound = true;
+        break;
+      }
+    }
+  }
+
+  if (!bFound)
+    return false;
+
+  // the group's task array keeps the task alive until all of its scheduled invocations have finished
+  out_taskData.m_pTask = *entry.m_pTask;
+  out_taskData.m_pBelongsToGroup = out_taskData.m_pTask->m_BelongsToGroup.m_pTaskGroup;
+  out_taskData.m_uiInvocation = entry.m_uiInvocation;
+  return true;
 }
 
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -135,11 +232,44 @@ bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriorit
     EZ_ASSERT_DEV(td.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup, "");
   }
 
-  tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != ezTaskNesting::Never;
-  tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
-  td.m_pTask->Run(td.m_uiInvocation);
-  tl_TaskWorkerInfo.m_bAllowNestedTasks = true;
-  tl_TaskWorkerInfo.m_szTaskName = nullptr;
+  bool bCanceled = false;
+
+  if (td.m_pTask->m_bInWorkStealingQueue)
+  {
+    // CancelTask() cannot remove the task from the work-stealing queues,
+    // instead it marks it as canceled, if none of its invocations has been picked up yet
+    while (true)
+    {
+      const ezInt32 iDequeuedRuns = td.m_pTask->m_iDequeuedRuns;
+
+      if (iDequeuedRuns < 0)
+      {
+        bCanceled = true;
+        break;
+      }
+
+      if (td.m_pTask->m_iDequeuedRuns.TestAndSet(iDequeuedRuns, iDequeuedRuns + 1))
+        break;
+    }
+  }
+
+  if (bCanceled)
+  {
+    // every invocation of the task is still queued and gets discarded one by one,
+    // only the last one finishes the task, so that the callbacks run once and IsTaskFinished() doesn't turn true too early
+    if (td.m_pTask->m_iRemainingRuns.Decrement() > 0)
+    {
+      td.m_pTask.Clear();
+    }
+  }
+  else
+  {
+    tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != ezTaskNesting::Never;
+    tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
+    td.m_pTask->Run(td.m_uiInvocation);
+    tl_TaskWorkerInfo.m_bAllowNestedTasks = true;
+    tl_TaskWorkerInfo.m_szTaskName = nullptr;
+  }
 
   // notify the group, that a task is finished, which might trigger other tasks to be executed
   TaskHasFinished(std::move(td.m_pTask), td.m_pBelongsToGroup);
@@ -191,6 +321,7 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
             TaskHasFinished(std::move(it->m_pTask), it->m_pBelongsToGroup);
 
             s_pState->m_Tasks[i].Remove(it);
+            s_pState->m_iNumTasks[i].Decrement();
             return EZ_SUCCESS;
           }
 
@@ -200,6 +331,19 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
     }
   }
 
+  // tasks in the work-stealing queues can't be removed, but as long as no invocation has been dequeued yet,
+  // we can flag them such that they get discarded instead of executed
+  if (pTask->m_bInWorkStealingQueue && pTask->m_iDequeuedRuns.TestAndSet(0, -1))
+  {
+    if (onTaskRunning == ezOnTaskRunning::WaitTillFinished)
+    {
+      WaitForCondition([pTask]()
+        { return pTask->IsTaskFinished(); });
+    }
+
+    return EZ_SUCCESS;
+  }
+
   // if we made it here, the task was already running
   // thus we just wait for it to finish
 
@@ -277,6 +421,11 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     // remove the tasks from their current queue
     s_pState->m_Tasks[i].Clear();
   }
+
+  for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
+  {
+    s_pState->m_iNumTasks[i] = s_pState->m_Tasks[i].GetCount();
+  }
 }
 
 void ezTaskSystem::ExecuteSomeFrameTasks(ezTime smoothFrameTime)
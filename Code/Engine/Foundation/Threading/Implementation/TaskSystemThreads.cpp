@@ -93,13 +93,39 @@ void ezTaskSystem::StopWorkerThreads()
   {
     const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
 
+    // prevent others from stealing from threads that are about to be deleted
+    s_pThreadState->m_iAllocatedWorkers[type] = 0;
+
     for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
     {
-      s_pThreadState->m_Workers[type][i]->Join();
-      EZ_DEFAULT_DELETE(s_pThreadState->m_Workers[type][i]);
+      ezTaskWorkerThread* pWorker = s_pThreadState->m_Workers[type][i];
+      pWorker->Join();
+
+      // the thread is gone, so we can act as the owner of its queues and move the remaining tasks into the shared lists
+      {
+        EZ_LOCK(s_TaskSystemMutex);
+
+        for (ezUInt32 q = 0; q < ezTaskWorkStealingQueue::NumQueuedPriorities; ++q)
+        {
+          const ezUInt32 uiPriority = ezTaskPriority::EarlyThisFrame + q;
+
+          ezTaskWorkStealingQueue::Entry entry;
+          while (pWorker->m_WorkQueues[q].Pop(entry))
+          {
+            TaskData td;
+            td.m_pTask = *entry.m_pTask;
+            td.m_pBelongsToGroup = td.m_pTask->m_BelongsToGroup.m_pTaskGroup;
+            td.m_uiInvocation = entry.m_uiInvocation;
+
+            s_pState->m_Tasks[uiPriority].PushBack(td);
+            s_pState->m_iNumTasks[uiPriority].Increment();
+          }
+        }
+      }
+
+      EZ_DEFAULT_DELETE(pWorker);
     }
 
-    s_pThreadState->m_iAllocatedWorkers[type] = 0;
     s_pThreadState->m_uiMaxWorkersToUse[type] = 0;
     s_pThreadState->m_Workers[type].Clear();
   }
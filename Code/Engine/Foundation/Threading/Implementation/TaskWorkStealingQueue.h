@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+
+/// \internal A fixed-size, lock-free work-stealing deque (Chase-Lev) that holds scheduled task invocations.
+///
+/// Every short-task worker thread (and the main thread) owns one such queue per 'this frame' priority.
+/// Only the owning thread may call Push() and Pop(), which operate on the 'bottom' end of the queue (LIFO),
+/// which keeps recently scheduled, cache-hot work on the thread that created it.
+/// Any other thread may call Steal() at the same time, which takes the oldest entry from the 'top' end (FIFO).
+///
+/// The queue never grows. If it is full, Push() fails and the caller has to put the task into the shared task lists instead.
+class ezTaskWorkStealingQueue
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingQueue);
+
+public:
+  /// \brief Only tasks with a priority from 'EarlyThisFrame' to 'LateThisFrame' are put into work-stealing queues.
+  static constexpr ezUInt32 NumQueuedPriorities = ezTaskPriority::LateThisFrame - ezTaskPriority::EarlyThisFrame + 1;
+
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    /// Points into the ezTaskGroup::m_Tasks array of the group that scheduled the task. That array stays untouched while the group's tasks are queued.
+    ezSharedPtr<ezTask>* m_pTask = nullptr;
+    ezUInt32 m_uiInvocation = 0;
+  };
+
+  ezTaskWorkStealingQueue() = default;
+
+  /// \brief Adds an entry at the bottom of the queue. Returns false if the queue is full. May only be called by the owning thread.
+  bool Push(const Entry& entry)
+  {
+    const ezInt64 iBottom = m_iBottom;
+    const ezInt64 iTop = m_iTop;
+
+    if (iBottom - iTop >= Capacity)
+      return false;
+
+    m_Entries[iBottom & CapacityMask] = entry;
+
+    // publishes the entry to thieves, the atomic write acts as a full memory barrier
+    m_iBottom = iBottom + 1;
+    return true;
+  }
+
+  /// \brief Takes the most recently pushed entry. Returns false if the queue is empty. May only be called by the owning thread.
+  bool Pop(Entry& out_entry)
+  {
+    const ezInt64 iBottom = m_iBottom - 1;
+
+    // reserve the bottom entry before looking at 'top', thieves will not take it anymore unless they already started doing so
+    m_iBottom = iBottom;
+
+    const ezInt64 iTop = m_iTop;
+
+    if (iTop > iBottom)
+    {
+      // queue was empty, restore the canonical empty state
+      m_iBottom = iTop;
+      return false;
+    }
+
+    out_entry = m_Entries[iBottom & CapacityMask];
+
+    if (iTop != iBottom)
+    {
+      // more than one entry left, no thief can compete for this one
+      return true;
+    }
+
+    // this was the last entry, race against thieves for it
+    const bool bWon = m_iTop.TestAndSet(iTop, iTop + 1);
+    m_iBottom = iTop + 1;
+    return bWon;
+  }
+
+  /// \brief Takes the oldest entry. Returns false if the queue is empty or another thread won the race for that entry. May be called by any thread.
+  bool Steal(Entry& out_entry)
+  {
+    const ezInt64 iTop = m_iTop;
+    const ezInt64 iBottom = m_iBottom;
+
+    if (iTop >= iBottom)
+      return false;
+
+    // If the owner has wrapped around in the meantime, this read may observe an entry that is being overwritten.
+    // In that case 'top' has moved on as well and the compare-and-swap below rejects the stale copy.
+    out_entry = m_Entries[iTop & CapacityMask];
+
+    return m_iTop.TestAndSet(iTop, iTop + 1);
+  }
+
+  /// \brief Returns whether the queue currently appears to be empty. The result may be outdated by the time it is used.
+  bool IsEmpty() const { return m_iTop >= m_iBottom; }
+
+private:
+  static constexpr ezInt64 Capacity = 256;
+  static constexpr ezInt64 CapacityMask = Capacity - 1;
+  static_assert((Capacity & CapacityMask) == 0, "Capacity must be a power of two");
+
+  // 'top' is written by thieves, 'bottom' only by the owner, keep them on separate cache lines
+  ezAtomicInteger64 m_iTop;
+  ezUInt8 m_Padding0[64 - sizeof(ezAtomicInteger64)];
+  ezAtomicInteger64 m_iBottom;
+  ezUInt8 m_Padding1[64 - sizeof(ezAtomicInteger64)];
+
+  Entry m_Entries[Capacity];
+};
@@ -50,6 +50,12 @@ ezUInt32 ezTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_iWorkerState;
 
+  // only short task workers take part in work stealing, other thread types never execute 'this frame' tasks
+  if (m_WorkerType == ezWorkerThreadType::ShortTasks)
+  {
+    tl_TaskWorkerInfo.m_pWorkQueues = m_WorkQueues;
+  }
+
   const bool bIsReserve = m_uiWorkerThreadNumber >= ezTaskSystem::s_pThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
   ezTaskPriority::Enum FirstPriority;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkStealingQueue.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -75,6 +76,18 @@ private:
   ezAtomicInteger32 m_iWorkerState; // ezTaskWorkerState
 
   ///@}
+
+  /// \name Work Stealing
+  ///@{
+
+private:
+  friend class ezTaskSystem;
+
+  // tasks that were scheduled by this thread, one queue per 'this frame' priority
+  // other threads steal from these when they run out of work
+  ezTaskWorkStealingQueue m_WorkQueues[ezTaskWorkStealingQueue::NumQueuedPriorities];
+
+  ///@}
 };
 
 /// \internal Thread local state used by the task system (and for better debugging)
@@ -85,6 +98,7 @@ struct ezTaskWorkerInfo
   ezInt32 m_iWorkerIndex = -1;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkStealingQueue* m_pWorkQueues = nullptr; ///< The work-stealing queues owned by this thread, if any.
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
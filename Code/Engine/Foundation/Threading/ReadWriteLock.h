@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Threading/ConditionVariable.h>
+
+/// \brief A lock that allows any number of concurrent readers, but only one writer at a time.
+///
+/// Use LockRead() / UnlockRead() (or EZ_LOCK_READ) to guard code that only inspects shared state and Lock() / Unlock() (or EZ_LOCK)
+/// for code that modifies it.
+///
+/// Both kinds of locks may be taken recursively. The thread that holds the exclusive lock may also take read locks.
+/// However, a thread that only holds a read lock must NOT try to acquire the exclusive lock, as that would deadlock.
+///
+/// Writers are preferred over readers: once a thread waits for the exclusive lock, new readers have to wait until it is done, so that
+/// writers can't starve. Threads that already hold a read lock may still take it again, which keeps recursive read locks safe.
+/// The lock is meant for data that is read a lot and modified rarely.
+class EZ_FOUNDATION_DLL ezReadWriteLock
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezReadWriteLock);
+
+public:
+  ezReadWriteLock();
+  ~ezReadWriteLock();
+
+  /// \brief Acquires shared access. Blocks while another thread holds or waits for the exclusive lock, unless this thread already holds a read lock.
+  void LockRead();
+
+  /// \brief Releases shared access. Must be called as often as LockRead() was called.
+  void UnlockRead();
+
+  /// \brief Acquires exclusive access. Blocks until no other thread holds a read or write lock.
+  void Lock();
+
+  /// \brief Releases exclusive access. Must be called as often as Lock() was called.
+  void Unlock();
+
+  /// \brief Returns true if any thread currently holds the exclusive lock.
+  bool IsWriteLocked() const;
+
+private:
+  struct Reader
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezThreadID m_ThreadId;
+    ezUInt32 m_uiLockCount;
+  };
+
+  bool IsWriterThread(ezThreadID threadId) const;
+  ezUInt32 FindReader(ezThreadID threadId) const;
+
+  mutable ezConditionVariable m_State;
+  ezHybridArray<Reader, 8> m_Readers;
+  ezUInt32 m_uiNumWaitingWriters = 0;
+  ezUInt32 m_uiWriteLockCount = 0;
+  ezThreadID m_WriterThread = {};
+};
+
+/// \brief Manages a read lock on an ezReadWriteLock and ensures that it is properly released as the lock object goes out of scope.
+template <typename T>
+class ezReadLock
+{
+public:
+  EZ_ALWAYS_INLINE explicit ezReadLock(T& ref_lock)
+    : m_Lock(ref_lock)
+  {
+    m_Lock.LockRead();
+  }
+
+  EZ_ALWAYS_INLINE ~ezReadLock() { m_Lock.UnlockRead(); }
+
+private:
+  ezReadLock();
+  ezReadLock(const ezReadLock<T>& rhs);
+  void operator=(const ezReadLock<T>& rhs);
+
+  T& m_Lock;
+};
+
+/// \brief Shortcut for ezReadLock<Type> l(lock)
+#define EZ_LOCK_READ(lock) ezReadLock<decltype(lock)> EZ_PP_CONCAT(l_, EZ_SOURCE_LINE)(lock)
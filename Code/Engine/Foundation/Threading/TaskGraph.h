@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \brief A reusable graph of tasks with direct dependencies between individual tasks.
+///
+/// Task groups are the dependency unit of the ezTaskSystem. Expressing fine-grained dependencies with groups requires one group per task
+/// and a lot of bookkeeping for every edge. An ezTaskGraph instead stores a dependency counter per node. When a node is finished,
+/// it decrements the counters of its dependent nodes and schedules those that have no pending dependencies left.
+///
+/// The graph is built once through AddNode() and AddDependency() and can then be launched over and over again (e.g. once per frame),
+/// without any further allocations. Every launch runs all nodes as part of a single task group, which is returned by Launch(),
+/// so that the whole graph can be waited on and other task groups can depend on it.
+///
+/// The graph must not be modified or destroyed while it is running. Canceling a launched graph through ezTaskSystem::CancelGroup()
+/// is not supported.
+class EZ_FOUNDATION_DLL ezTaskGraph
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskGraph);
+
+public:
+  ezTaskGraph();
+  ~ezTaskGraph();
+
+  /// \brief Adds a task as a new node and returns the node index. A task may only be a node of one graph at a time.
+  ezUInt32 AddNode(const ezSharedPtr<ezTask>& pTask); // [tested]
+
+  /// \brief Makes \a uiNode wait for \a uiDependsOnNode to finish, before it gets scheduled.
+  void AddDependency(ezUInt32 uiNode, ezUInt32 uiDependsOnNode); // [tested]
+
+  /// \brief Removes all nodes and dependencies.
+  void Clear(); // [tested]
+
+  /// \brief Returns the number of nodes in the graph.
+  ezUInt32 GetNodeCount() const { return m_Nodes.GetCount(); }
+
+  /// \brief Returns the task of the given node.
+  const ezSharedPtr<ezTask>& GetNodeTask(ezUInt32 uiNode) const { return m_Nodes[uiNode].m_pTask; }
+
+  /// \brief Flattens the dependencies for fast access at runtime. Fails if the dependencies contain a cycle.
+  ///
+  /// Launch() does this automatically when the graph was modified, so calling this is only necessary to detect errors early.
+  ezResult Compile(); // [tested]
+
+  /// \brief Starts executing the graph. Nodes without dependencies are scheduled right away, all others once their dependencies are finished.
+  ///
+  /// The returned group finishes once all nodes are finished. If \a dependency is valid, the graph only starts once that group is finished.
+  ezTaskGroupID Launch(ezTaskPriority::Enum priority = ezTaskPriority::ThisFrame, ezTaskGroupID dependency = ezTaskGroupID(),
+    ezOnTaskGroupFinishedCallback callback = ezOnTaskGroupFinishedCallback()); // [tested]
+
+  /// \brief Returns whether the last launch of the graph has not yet finished.
+  bool IsRunning() const { return !ezTaskSystem::IsTaskGroupFinished(m_LastLaunch); } // [tested]
+
+  /// \brief Returns the task group of the last launch.
+  ezTaskGroupID GetLastLaunchGroup() const { return m_LastLaunch; }
+
+private:
+  friend class ezTaskSystem;
+
+  /// \brief Called by the ezTaskSystem when the task of the given node is finished.
+  void NodeHasFinished(ezUInt32 uiNode, ezTaskGroup* pGroup);
+
+  struct Node
+  {
+    ezSharedPtr<ezTask> m_pTask;
+    ezUInt32 m_uiNumDependencies = 0;
+    ezUInt32 m_uiFirstDependent = 0;
+    ezUInt32 m_uiNumDependents = 0;
+
+    /// Counts down during a launch, the node gets scheduled when this reaches zero.
+    ezAtomicInteger32 m_iPendingDependencies;
+
+    /// Tasks with multiplicity may report being finished more than once, this makes sure the dependents are only notified once.
+    ezAtomicInteger32 m_iFinished;
+  };
+
+  struct Dependency
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNode;
+    ezUInt32 m_uiDependsOnNode;
+  };
+
+  bool m_bCompiled = true;
+  ezTaskGroupID m_LastLaunch;
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<Dependency> m_Dependencies;
+
+  /// For every node, the indices of the nodes that depend on it, stored consecutively. Built by Compile().
+  ezDynamicArray<ezUInt32> m_Dependents;
+};
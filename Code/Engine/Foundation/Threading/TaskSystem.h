@@ -67,6 +67,10 @@ public:
   /// In case of failure, \a bWaitForIt determines whether 'WaitForTask' is called (with all its consequences),
   /// or whether the function will return immediately.
   ///
+  /// Tasks that were scheduled into a work-stealing queue cannot be taken out of it again. If none of their invocations has
+  /// been started yet, they are flagged to be discarded once they get dequeued and the function returns EZ_SUCCESS.
+  /// With ezOnTaskRunning::WaitTillFinished, it additionally waits until that has happened.
+  ///
   /// The cancel flag is set on the task, such that tasks that support canceling might terminate earlier.
   /// However, there is no guarantee how long it takes for already running tasks to actually finish.
   /// Therefore when bWaitForIt is true, this function might block for a very long time.
@@ -83,9 +87,19 @@ public:
 
 private:
   /// \brief Searches for a task of priority between \a FirstPriority and \a LastPriority (inclusive).
+  ///
+  /// If \a pWorkerState is given and no task is found, the worker state is set to 'idle'.
   static TaskData GetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
+  /// \brief Looks for a task in the work-stealing queues and the shared task lists, without changing any worker state.
+  static bool TryGetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
+    const ezTaskGroupID& WaitingForGroup, TaskData& out_taskData);
+
+  /// \brief Takes a task of the given 'this frame' priority from the calling thread's own work-stealing queue,
+  /// or steals one from the queue of another thread.
+  static bool TryGetQueuedTask(ezTaskPriority::Enum priority, TaskData& out_taskData);
+
   /// \brief Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
@@ -171,11 +185,28 @@ public:
 
 private:
   /// \brief Takes all the tasks in the given group and schedules them for execution, by inserting them into the proper task lists.
+  ///
+  /// With bHighPriority the tasks are inserted at the front of the shared task list of their priority.
+  /// Tasks that go into a work-stealing queue ignore it. All threads look at the work-stealing queues before the shared list of the same priority,
+  /// and the scheduling thread takes its most recently queued tasks first, so these tasks are already preferred.
   static void ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority);
 
   /// \brief Is called whenever a dependency of pGroup has finished. Once all dependencies are finished, the group's tasks will get scheduled.
   static void DependencyHasFinished(ezTaskGroup* pGroup);
 
+  /// \brief Wakes up worker threads of the type that is responsible for the given priority.
+  static void WakeUpThreadsForPriority(ezTaskPriority::Enum priority, ezUInt32 uiNumThreads);
+
+  friend class ezTaskGraph;
+
+  /// \brief Prepares a task of an ezTaskGraph, that does not get scheduled right away, to run as part of the given (not yet started) group.
+  static void AddDeferredTaskToGroup(ezTaskGroupID group, const ezSharedPtr<ezTask>& pTask);
+
+  /// \brief Schedules a task that was added through AddDeferredTaskToGroup(), while its group is running.
+  ///
+  /// Must be called before the task that triggered this has marked itself as finished in the group, so that the group can't finish in between.
+  static void ScheduleDeferredTask(ezTaskGroup* pGroup, ezSharedPtr<ezTask>& ref_pTask);
+
   ///@}
 
   /// \name Thread Management
@@ -224,6 +255,8 @@ private:
   static void AllocateThreads(ezWorkerThreadType::Enum type, ezUInt32 uiAddThreads);
 
   /// \brief Shuts down all worker threads. Does NOT finish the remaining tasks that were not started yet. Does not clear them either, though.
+  ///
+  /// Tasks that are still in the work-stealing queues of the stopped threads are moved into the shared task lists.
   static void StopWorkerThreads();
 
   /// \brief Uses a thread local variable to know the current thread type and to decide the range of task priorities that it may execute
@@ -275,6 +308,10 @@ private:
   static void ParallelForInternal(
     ezArrayPtr<ElemType> taskItems, ezParallelForFunction<ElemType> taskCallback, const char* taskName, const ezParallelForParams& params);
 
+  /// Implements ezParallelForPartitioning::Adaptive for all ParallelFor variants. The callback receives [start; end) index ranges.
+  static void ParallelForAdaptive(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, const ezParallelForIndexedFunction32& taskCallback,
+    const char* szTaskName, ezTaskNesting taskNesting, const ezParallelForParams& params);
+
   ///@}
 
   /// \name Utilities
@@ -39,6 +39,7 @@
 #  define EZ_USE_PROFILING EZ_ON
 
 // Tracking of memory allocations.
+// ezAllocatorTrackingMode::Sampled is a low-overhead alternative, which only records a statistical heap profile.
 #  undef EZ_ALLOC_TRACKING_DEFAULT
 #  define EZ_ALLOC_TRACKING_DEFAULT ezAllocatorTrackingMode::AllocationStatsAndStacktraces
 
@@ -51,6 +51,8 @@ private:
   struct DataPerCategory
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
+    ezDynamicArray<const ezRenderData*> m_RenderData;
+    ezDynamicArray<ezUInt64> m_SortingKeys;
     ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortableRenderData;
   };
 
@@ -63,5 +65,6 @@ private:
   ezDebugRendererContext m_ViewDebugContext;
 
   ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
+  ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortScratch;
   ezHybridArray<const ezRenderData*, 16> m_FrameData;
 };
@@ -1,5 +1,6 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Foundation/Algorithm/Sorting.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
@@ -9,9 +10,8 @@ void ezExtractedRenderData::AddRenderData(const ezRenderData* pRenderData, ezRen
 {
   m_DataPerCategory.EnsureCount(category.m_uiValue + 1);
 
-  auto& sortableRenderData = m_DataPerCategory[category.m_uiValue].m_SortableRenderData.ExpandAndGetRef();
-  sortableRenderData.m_pRenderData = pRenderData;
-  sortableRenderData.m_uiSortingKey = pRenderData->GetCategorySortingKey(category, m_Camera);
+  // sorting keys are computed for all render data of a category at once in SortAndBatch
+  m_DataPerCategory[category.m_uiValue].m_RenderData.PushBack(pRenderData);
 }
 
 void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
@@ -23,28 +23,35 @@ void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
+  for (ezUInt32 uiCategory = 0; uiCategory < m_DataPerCategory.GetCount(); ++uiCategory)
   {
-    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
-    {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
-      {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
-      }
+    auto& dataPerCategory = m_DataPerCategory[uiCategory];
 
-      return a.m_uiSortingKey < b.m_uiSortingKey;
-    }
-  };
-
-  for (auto& dataPerCategory : m_DataPerCategory)
-  {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
+    const ezUInt32 uiCount = dataPerCategory.m_RenderData.GetCount();
+    if (uiCount == 0)
       continue;
 
+    // Compute sorting keys
+    dataPerCategory.m_SortingKeys.SetCountUninitialized(uiCount);
+    ezRenderData::GetCategorySortingKeys(ezRenderData::Category(static_cast<ezUInt16>(uiCategory)), dataPerCategory.m_RenderData, m_Camera, dataPerCategory.m_SortingKeys);
+
     auto& data = dataPerCategory.m_SortableRenderData;
+    data.SetCountUninitialized(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      data[i].m_pRenderData = dataPerCategory.m_RenderData[i];
+      data[i].m_uiSortingKey = dataPerCategory.m_SortingKeys[i];
+    }
 
     // Sort
-    data.Sort(RenderDataComparer());
+    // Render data with equal sorting keys is ordered by batch id, so that it ends up in as few batches as possible.
+    // The radix sort is stable, so sorting by batch id first and then by sorting key gives exactly that order.
+    m_SortScratch.SetCountUninitialized(uiCount);
+    ezSorting::RadixSort(data.GetArrayPtr(), m_SortScratch.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d)
+      { return static_cast<ezUInt64>(d.m_pRenderData->m_uiBatchId); });
+    ezSorting::RadixSort(data.GetArrayPtr(), m_SortScratch.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d)
+      { return d.m_uiSortingKey; });
 
     // Find batches
     ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
@@ -74,6 +81,8 @@ void ezExtractedRenderData::Clear()
   for (auto& dataPerCategory : m_DataPerCategory)
   {
     dataPerCategory.m_Batches.Clear();
+    dataPerCategory.m_RenderData.Clear();
+    dataPerCategory.m_SortingKeys.Clear();
     dataPerCategory.m_SortableRenderData.Clear();
   }
 
@@ -65,7 +65,7 @@ ezDynamicArray<ezUniquePtr<ezRenderer>> ezRenderData::s_RendererInstances;
 bool ezRenderData::s_bRendererInstancesDirty = false;
 
 // static
-ezRenderData::Category ezRenderData::RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc)
+ezRenderData::Category ezRenderData::RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc, SortingKeysFunc sortingKeysFunc)
 {
   ezHashedString sCategoryName;
   sCategoryName.Assign(szCategoryName);
@@ -79,10 +79,29 @@ ezRenderData::Category ezRenderData::RegisterCategory(const char* szCategoryName
   auto& data = s_CategoryData.ExpandAndGetRef();
   data.m_sName = sCategoryName;
   data.m_sortingKeyFunc = sortingKeyFunc;
+  data.m_sortingKeysFunc = sortingKeysFunc;
 
   return newCategory;
 }
 
+// static
+void ezRenderData::GetCategorySortingKeys(Category category, ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys)
+{
+  EZ_ASSERT_DEBUG(out_sortingKeys.GetCount() == renderData.GetCount(), "Invalid number of sorting keys");
+
+  const CategoryData& data = s_CategoryData[category.m_uiValue];
+  if (data.m_sortingKeysFunc != nullptr)
+  {
+    data.m_sortingKeysFunc(renderData, camera, out_sortingKeys);
+    return;
+  }
+
+  for (ezUInt32 i = 0; i < renderData.GetCount(); ++i)
+  {
+    out_sortingKeys[i] = data.m_sortingKeyFunc(renderData[i], camera);
+  }
+}
+
 // static
 ezRenderData::Category ezRenderData::FindCategory(ezTempHashedString sCategoryName)
 {
@@ -180,20 +199,20 @@ void ezRenderData::ClearRendererInstances()
 
 //////////////////////////////////////////////////////////////////////////
 
-ezRenderData::Category ezDefaultRenderDataCategories::Light = ezRenderData::RegisterCategory("Light", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::Decal = ezRenderData::RegisterCategory("Decal", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::ReflectionProbe = ezRenderData::RegisterCategory("ReflectionProbe", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::Sky = ezRenderData::RegisterCategory("Sky", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::LitOpaque = ezRenderData::RegisterCategory("LitOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::LitMasked = ezRenderData::RegisterCategory("LitMasked", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::LitTransparent = ezRenderData::RegisterCategory("LitTransparent", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
-ezRenderData::Category ezDefaultRenderDataCategories::LitForeground = ezRenderData::RegisterCategory("LitForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::LitScreenFX = ezRenderData::RegisterCategory("LitScreenFX", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
-ezRenderData::Category ezDefaultRenderDataCategories::SimpleOpaque = ezRenderData::RegisterCategory("SimpleOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::SimpleTransparent = ezRenderData::RegisterCategory("SimpleTransparent", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
-ezRenderData::Category ezDefaultRenderDataCategories::SimpleForeground = ezRenderData::RegisterCategory("SimpleForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::Selection = ezRenderData::RegisterCategory("Selection", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack);
-ezRenderData::Category ezDefaultRenderDataCategories::GUI = ezRenderData::RegisterCategory("GUI", &ezRenderSortingFunctions::BackToFrontThenByRenderData);
+ezRenderData::Category ezDefaultRenderDataCategories::Light = ezRenderData::RegisterCategory("Light", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::Decal = ezRenderData::RegisterCategory("Decal", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::ReflectionProbe = ezRenderData::RegisterCategory("ReflectionProbe", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::Sky = ezRenderData::RegisterCategory("Sky", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::LitOpaque = ezRenderData::RegisterCategory("LitOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::LitMasked = ezRenderData::RegisterCategory("LitMasked", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::LitTransparent = ezRenderData::RegisterCategory("LitTransparent", &ezRenderSortingFunctions::BackToFrontThenByRenderData, &ezRenderSortingFunctions::BackToFrontThenByRenderDataBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::LitForeground = ezRenderData::RegisterCategory("LitForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::LitScreenFX = ezRenderData::RegisterCategory("LitScreenFX", &ezRenderSortingFunctions::BackToFrontThenByRenderData, &ezRenderSortingFunctions::BackToFrontThenByRenderDataBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::SimpleOpaque = ezRenderData::RegisterCategory("SimpleOpaque", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::SimpleTransparent = ezRenderData::RegisterCategory("SimpleTransparent", &ezRenderSortingFunctions::BackToFrontThenByRenderData, &ezRenderSortingFunctions::BackToFrontThenByRenderDataBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::SimpleForeground = ezRenderData::RegisterCategory("SimpleForeground", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::Selection = ezRenderData::RegisterCategory("Selection", &ezRenderSortingFunctions::ByRenderDataThenFrontToBack, &ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch);
+ezRenderData::Category ezDefaultRenderDataCategories::GUI = ezRenderData::RegisterCategory("GUI", &ezRenderSortingFunctions::BackToFrontThenByRenderData, &ezRenderSortingFunctions::BackToFrontThenByRenderDataBatch);
 
 //////////////////////////////////////////////////////////////////////////
 
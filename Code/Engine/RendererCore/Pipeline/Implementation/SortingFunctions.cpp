@@ -1,14 +1,16 @@
 #include <RendererCore/RendererCorePCH.h>
 
 #include <Core/Graphics/Camera.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdVec4i.h>
 #include <RendererCore/Pipeline/RenderData.h>
 #include <RendererCore/Pipeline/SortingFunctions.h>
 
 namespace
 {
-  EZ_ALWAYS_INLINE ezUInt32 CalculateTypeHash(const ezRenderData* pRenderData)
+  EZ_ALWAYS_INLINE ezUInt32 CalculateTypeHash(const ezRTTI* pRtti)
   {
-    ezUInt32 uiTypeHash = ezHashingUtils::StringHashTo32(pRenderData->GetDynamicRTTI()->GetTypeNameHash());
+    ezUInt32 uiTypeHash = ezHashingUtils::StringHashTo32(pRtti->GetTypeNameHash());
     return (uiTypeHash >> 16) ^ (uiTypeHash & 0xFFFF);
   }
 
@@ -19,26 +21,116 @@ namespace
     const float fNormalizedDistance = ezMath::Clamp(fDistance / camera.GetFarPlane(), 0.0f, 1.0f);
     return static_cast<ezUInt32>(fNormalizedDistance * 65535.0f);
   }
+
+  EZ_ALWAYS_INLINE ezUInt64 MakeRenderDataThenFrontToBackKey(ezUInt64 uiTypeHash, ezUInt64 uiRenderDataSortingKey, ezUInt64 uiDistance)
+  {
+    return (uiTypeHash << 48) | (uiRenderDataSortingKey << 16) | uiDistance;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt64 MakeBackToFrontThenRenderDataKey(ezUInt64 uiTypeHash, ezUInt64 uiRenderDataSortingKey, ezUInt64 uiDistance)
+  {
+    const ezUInt64 uiInvDistance = 0xFFFF - uiDistance;
+    return (uiInvDistance << 48) | (uiTypeHash << 32) | uiRenderDataSortingKey;
+  }
+
+  /// Computes the distances of four render data at once and only looks up the type hash again when the type changes,
+  /// which is rare since render data of the same type is usually extracted in sequence.
+  template <typename MakeKeyFunc>
+  void CalculateSortingKeys(ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys, MakeKeyFunc makeKey)
+  {
+    const ezSimdVec4f vCameraPos = ezSimdConversion::ToVec3(camera.GetPosition());
+    const ezSimdVec4f vCameraX = vCameraPos.Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f vCameraY = vCameraPos.Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f vCameraZ = vCameraPos.Get<ezSwizzle::ZZZZ>();
+    const ezSimdVec4f vFarPlane(camera.GetFarPlane());
+    const ezSimdVec4f vMaxDistance(65535.0f);
+
+    const ezRTTI* pLastType = nullptr;
+    ezUInt64 uiLastTypeHash = 0;
+
+    const ezUInt32 uiCount = renderData.GetCount();
+    for (ezUInt32 uiStart = 0; uiStart < uiCount; uiStart += 4)
+    {
+      const ezUInt32 uiNum = ezMath::Min(uiCount - uiStart, 4u);
+
+      float x[4] = {};
+      float y[4] = {};
+      float z[4] = {};
+      float offset[4] = {};
+
+      for (ezUInt32 i = 0; i < uiNum; ++i)
+      {
+        const ezRenderData* pRenderData = renderData[uiStart + i];
+        const ezVec3& vPosition = pRenderData->m_GlobalTransform.m_vPosition;
+        x[i] = vPosition.x;
+        y[i] = vPosition.y;
+        z[i] = vPosition.z;
+        offset[i] = pRenderData->m_fSortingDepthOffset;
+      }
+
+      ezSimdVec4f vX, vY, vZ, vOffset;
+      vX.Load<4>(x);
+      vY.Load<4>(y);
+      vZ.Load<4>(z);
+      vOffset.Load<4>(offset);
+
+      vX -= vCameraX;
+      vY -= vCameraY;
+      vZ -= vCameraZ;
+
+      ///\todo far-plane is not enough to normalize distance
+      const ezSimdVec4f vDistance = (vX.CompMul(vX) + vY.CompMul(vY) + vZ.CompMul(vZ)).GetSqrt() + vOffset;
+      // not operator/(ezSimdFloat), which multiplies with the reciprocal in the FPU implementation and would give different keys than the per-item functions
+      const ezSimdVec4f vNormalizedDistance = vDistance.CompDiv(vFarPlane).CompMax(ezSimdVec4f::MakeZero()).CompMin(ezSimdVec4f(1.0f));
+
+      ezInt32 distances[4];
+      ezSimdVec4i::Truncate(vNormalizedDistance.CompMul(vMaxDistance)).Store<4>(distances);
+
+      for (ezUInt32 i = 0; i < uiNum; ++i)
+      {
+        const ezRenderData* pRenderData = renderData[uiStart + i];
+
+        const ezRTTI* pType = pRenderData->GetDynamicRTTI();
+        if (pType != pLastType)
+        {
+          pLastType = pType;
+          uiLastTypeHash = CalculateTypeHash(pType);
+        }
+
+        out_sortingKeys[uiStart + i] = makeKey(uiLastTypeHash, pRenderData->m_uiSortingKey, static_cast<ezUInt64>(distances[i]));
+      }
+    }
+  }
 } // namespace
 
 // static
 ezUInt64 ezRenderSortingFunctions::ByRenderDataThenFrontToBack(const ezRenderData* pRenderData, const ezCamera& camera)
 {
-  const ezUInt64 uiTypeHash = CalculateTypeHash(pRenderData);
+  const ezUInt64 uiTypeHash = CalculateTypeHash(pRenderData->GetDynamicRTTI());
   const ezUInt64 uiRenderDataSortingKey64 = pRenderData->m_uiSortingKey;
   const ezUInt64 uiDistance = CalculateDistance(pRenderData, camera);
 
-  const ezUInt64 uiSortingKey = (uiTypeHash << 48) | (uiRenderDataSortingKey64 << 16) | uiDistance;
-  return uiSortingKey;
+  return MakeRenderDataThenFrontToBackKey(uiTypeHash, uiRenderDataSortingKey64, uiDistance);
 }
 
 // static
 ezUInt64 ezRenderSortingFunctions::BackToFrontThenByRenderData(const ezRenderData* pRenderData, const ezCamera& camera)
 {
-  const ezUInt64 uiTypeHash = CalculateTypeHash(pRenderData);
+  const ezUInt64 uiTypeHash = CalculateTypeHash(pRenderData->GetDynamicRTTI());
   const ezUInt64 uiRenderDataSortingKey64 = pRenderData->m_uiSortingKey;
-  const ezUInt64 uiInvDistance = 0xFFFF - CalculateDistance(pRenderData, camera);
+  const ezUInt64 uiDistance = CalculateDistance(pRenderData, camera);
+
+  return MakeBackToFrontThenRenderDataKey(uiTypeHash, uiRenderDataSortingKey64, uiDistance);
+}
 
-  const ezUInt64 uiSortingKey = (uiInvDistance << 48) | (uiTypeHash << 32) | uiRenderDataSortingKey64;
-  return uiSortingKey;
+// static
+void ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch(ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys)
+{
+  CalculateSortingKeys(renderData, camera, out_sortingKeys, &MakeRenderDataThenFrontToBackKey);
+}
+
+// static
+void ezRenderSortingFunctions::BackToFrontThenByRenderDataBatch(ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys)
+{
+  CalculateSortingKeys(renderData, camera, out_sortingKeys, &MakeBackToFrontThenRenderDataKey);
 }
@@ -39,7 +39,11 @@ public:
   /// \brief This function generates a 64bit sorting key for the given render data. Data with lower sorting key is rendered first.
   using SortingKeyFunc = ezUInt64 (*)(const ezRenderData*, const ezCamera&);
 
-  static Category RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc);
+  /// \brief Batched version of SortingKeyFunc. Has to write the sorting key of every render data to the same index in out_sortingKeys.
+  using SortingKeysFunc = void (*)(ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys);
+
+  /// \brief Registers a new render data category. If a batched sorting key function is given, it is used to compute the sorting keys of all render data at once.
+  static Category RegisterCategory(const char* szCategoryName, SortingKeyFunc sortingKeyFunc, SortingKeysFunc sortingKeysFunc = nullptr);
   static Category FindCategory(ezTempHashedString sCategoryName);
 
   static void GetAllCategoryNames(ezDynamicArray<ezHashedString>& out_categoryNames);
@@ -50,6 +54,9 @@ public:
 
   ezUInt64 GetCategorySortingKey(Category category, const ezCamera& camera) const;
 
+  /// \brief Computes the sorting keys of all given render data, using the batched sorting key function of the category if it has one.
+  static void GetCategorySortingKeys(Category category, ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys);
+
   ezTransform m_GlobalTransform = ezTransform::MakeIdentity();
   ezBoundingBoxSphere m_GlobalBounds;
 
@@ -76,6 +83,7 @@ private:
   {
     ezHashedString m_sName;
     SortingKeyFunc m_sortingKeyFunc;
+    SortingKeysFunc m_sortingKeysFunc;
 
     ezHashTable<const ezRTTI*, ezUInt32> m_TypeToRendererIndex;
   };
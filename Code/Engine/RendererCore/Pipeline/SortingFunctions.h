@@ -7,4 +7,8 @@ class EZ_RENDERERCORE_DLL ezRenderSortingFunctions
 public:
   static ezUInt64 ByRenderDataThenFrontToBack(const ezRenderData* pRenderData, const ezCamera& camera);
   static ezUInt64 BackToFrontThenByRenderData(const ezRenderData* pRenderData, const ezCamera& camera);
+
+  /// \brief Batched versions of the functions above, which compute the distances of four render data at once.
+  static void ByRenderDataThenFrontToBackBatch(ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys);
+  static void BackToFrontThenByRenderDataBatch(ezArrayPtr<const ezRenderData* const> renderData, const ezCamera& camera, ezArrayPtr<ezUInt64> out_sortingKeys);
 };
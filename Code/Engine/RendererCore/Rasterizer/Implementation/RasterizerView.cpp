@@ -5,6 +5,7 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
 #include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
@@ -12,6 +13,7 @@
 
 ezCVarInt cvar_SpatialCullingOcclusionMaxResolution("Spatial.Occlusion.MaxResolution", 512, ezCVarFlags::Default, "Max resolution for occlusion buffers.");
 ezCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, ezCVarFlags::Default, "Max number of occluders to rasterize per frame.");
+ezCVarInt cvar_SpatialCullingOcclusionNumTiles("Spatial.Occlusion.NumTiles", 1, ezCVarFlags::Default, "Number of horizontal tiles that the occlusion buffer is split into for parallel rasterization. With more than one tile, hidden occluders count towards MaxOccluders.");
 
 ezRasterizerView::ezRasterizerView() = default;
 ezRasterizerView::~ezRasterizerView() = default;
@@ -63,8 +65,29 @@ void ezRasterizerView::EndScene()
 
   UpdateViewProjectionMatrix();
 
+  const ezUInt32 uiNumTiles = m_uiNumTiles > 0 ? m_uiNumTiles : static_cast<ezUInt32>(ezMath::Max<int>(cvar_SpatialCullingOcclusionNumTiles, 1));
+  m_uiNumActiveTiles = ezMath::Clamp<ezUInt32>(uiNumTiles, 1u, m_pRasterizer->getBlocksY());
+
   // only rasterize a limited number of the closest objects
-  RasterizeObjects(cvar_SpatialCullingOcclusionMaxOccluders);
+  if (m_uiNumActiveTiles == 1)
+  {
+    RasterizeObjects(cvar_SpatialCullingOcclusionMaxOccluders);
+  }
+  else
+  {
+    BinObjects(cvar_SpatialCullingOcclusionMaxOccluders);
+
+    if (!m_BinnedOccluders.IsEmpty())
+    {
+      ezParallelForParams params;
+      params.m_uiBinSize = 1;
+      params.m_uiMaxTasksPerThread = 1;
+
+      ezTaskSystem::ParallelForIndexed(0, m_uiNumActiveTiles, ezMakeDelegate(&ezRasterizerView::RasterizeTiles, this), "Occlusion::RasterizeTiles", ezTaskNesting::Never, params);
+
+      m_BinnedOccluders.Clear();
+    }
+  }
 
   m_Instances.Clear();
 
@@ -104,6 +127,103 @@ void ezRasterizerView::RasterizeObjects(ezUInt32 uiMaxObjects)
 #endif
 }
 
+void ezRasterizerView::BinObjects(ezUInt32 uiMaxObjects)
+{
+  m_BinnedOccluders.Clear();
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+
+  EZ_PROFILE_SCOPE("Occlusion::BinObjects");
+
+  const ezUInt32 uiBlocksY = m_pRasterizer->getBlocksY();
+  const float fRowScale = (m_uiResolutionY * 0.5f - 4.0f) / 8.0f;
+
+  for (const Instance& inst : m_Instances)
+  {
+    const ezMat4 mMVP = m_mViewProjection * inst.m_Transform.GetAsMat4();
+
+    BinnedOccluder binned;
+    binned.m_pObject = inst.m_pObject;
+    m_pRasterizer->bakeModelViewProjection(mMVP.m_fElementsCM, binned.m_fBakedModelViewProjection);
+
+    // The occlusion buffer is still empty at this point, so this only rejects occluders that are not on screen.
+    bool bNeedsClipping;
+    const Occluder& occluder = inst.m_pObject->m_Occluder;
+    if (!m_pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping, binned.m_fBakedModelViewProjection, 0, uiBlocksY))
+      continue;
+
+    binned.m_bNeedsClipping = bNeedsClipping;
+    binned.m_uiMinBlockY = 0;
+    binned.m_uiMaxBlockY = uiBlocksY;
+
+    if (!bNeedsClipping)
+    {
+      // Compute the range of block rows that the occluder's bounding box covers on screen.
+      // This is padded by a block in each direction, since the rasterizer rounds differently than this.
+      const ezVec3 vMin = ezSimdConversion::ToVec3(ezSimdVec4f(occluder.m_boundsMin));
+      const ezVec3 vMax = ezSimdConversion::ToVec3(ezSimdVec4f(occluder.m_boundsMax));
+
+      float fMinY = ezMath::MaxValue<float>();
+      float fMaxY = -ezMath::MaxValue<float>();
+
+      for (ezUInt32 i = 0; i < 8; ++i)
+      {
+        const ezVec4 vCorner(i & 1 ? vMax.x : vMin.x, i & 2 ? vMax.y : vMin.y, i & 4 ? vMax.z : vMin.z, 1.0f);
+        const ezVec4 vProjected = mMVP * vCorner;
+        const float fBlockY = (vProjected.y / vProjected.w + 1.0f) * fRowScale;
+
+        fMinY = ezMath::Min(fMinY, fBlockY);
+        fMaxY = ezMath::Max(fMaxY, fBlockY);
+      }
+
+      binned.m_uiMinBlockY = static_cast<ezUInt32>(ezMath::Clamp(ezMath::Floor(fMinY) - 1.0f, 0.0f, (float)uiBlocksY));
+      binned.m_uiMaxBlockY = static_cast<ezUInt32>(ezMath::Clamp(ezMath::Floor(fMaxY) + 2.0f, 0.0f, (float)uiBlocksY));
+    }
+
+    m_BinnedOccluders.PushBack(binned);
+    m_bAnyOccludersRasterized = true;
+
+    if (--uiMaxObjects == 0)
+      return;
+  }
+#endif
+}
+
+void ezRasterizerView::RasterizeTiles(ezUInt32 uiStartTile, ezUInt32 uiEndTile)
+{
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+
+  EZ_PROFILE_SCOPE("Occlusion::RasterizeTiles");
+
+  const ezUInt32 uiBlocksY = m_pRasterizer->getBlocksY();
+
+  for (ezUInt32 uiTile = uiStartTile; uiTile < uiEndTile; ++uiTile)
+  {
+    const ezUInt32 uiMinBlockY = uiTile * uiBlocksY / m_uiNumActiveTiles;
+    const ezUInt32 uiMaxBlockY = (uiTile + 1) * uiBlocksY / m_uiNumActiveTiles;
+
+    // Every tile only reads and writes its own rows of the occlusion buffer. Occluders (or parts of them) that are hidden
+    // behind closer ones are rejected by the hierarchical depth test inside the rasterizer, which is why they can't be skipped up front.
+    for (const BinnedOccluder& binned : m_BinnedOccluders)
+    {
+      if (binned.m_uiMaxBlockY <= uiMinBlockY || binned.m_uiMinBlockY >= uiMaxBlockY)
+        continue;
+
+      const Occluder& occluder = binned.m_pObject->m_Occluder;
+
+      if (binned.m_bNeedsClipping)
+      {
+        m_pRasterizer->rasterize<true>(occluder, binned.m_fBakedModelViewProjection, uiMinBlockY, uiMaxBlockY);
+      }
+      else
+      {
+        m_pRasterizer->rasterize<false>(occluder, binned.m_fBakedModelViewProjection, uiMinBlockY, uiMaxBlockY);
+      }
+    }
+  }
+#endif
+}
+
 void ezRasterizerView::UpdateViewProjectionMatrix()
 {
   ezMat4 mProjection;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Transform.h>
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/ArrayPtr.h>
@@ -26,10 +27,20 @@ public:
   ezUInt32 GetResolutionX() const { return m_uiResolutionX; }
   ezUInt32 GetResolutionY() const { return m_uiResolutionY; }
 
+  /// \brief Sets into how many horizontal tiles the occlusion buffer is split. The tiles are rasterized in parallel.
+  ///
+  /// 0 means the value of the CVar 'Spatial.Occlusion.NumTiles' is used. 1 rasterizes the whole buffer on the calling thread.
+  /// With a single tile, occluders that are hidden behind closer ones are skipped before rasterization and don't count towards
+  /// 'Spatial.Occlusion.MaxOccluders'. With several tiles that isn't possible, so the limit applies to all occluders on screen.
+  void SetNumTiles(ezUInt32 uiNumTiles) { m_uiNumTiles = uiNumTiles; }
+
   /// \brief Prepares the view to rasterize a new scene.
   void BeginScene();
 
   /// \brief Finishes rasterizing the scene. Visibility queries only work after this.
+  ///
+  /// With more than one tile, the occluders are binned into horizontal screen tiles, which are then rasterized in parallel on the task system.
+  /// Every tile only writes to its own rows of the occlusion buffer, so the result does not depend on the number of tiles.
   void EndScene();
 
   /// \brief Writes an RGBA8 representation of the depth values to targetBuffer.
@@ -53,7 +64,7 @@ public:
 
   /// \brief Checks whether a box would be visible, or is fully occluded by the existing scene geometry.
   ///
-  /// Note: This only works after EndScene().
+  /// Note: This only works after EndScene(). Once the scene is finished, this function may be called from multiple threads at the same time.
   bool IsVisible(const ezSimdBBox& aabb) const;
 
   /// \brief Wether any occluder was actually added and also rasterized. If not, no need to do any visibility checks.
@@ -65,6 +76,8 @@ public:
 private:
   void SortObjectsFrontToBack();
   void RasterizeObjects(ezUInt32 uiMaxObjects);
+  void BinObjects(ezUInt32 uiMaxObjects);
+  void RasterizeTiles(ezUInt32 uiStartTile, ezUInt32 uiEndTile);
   void UpdateViewProjectionMatrix();
   void ApplyModelViewProjectionMatrix(const ezTransform& modelTransform);
 
@@ -73,6 +86,8 @@ private:
   ezUInt32 m_uiResolutionX = 0;
   ezUInt32 m_uiResolutionY = 0;
   float m_fAspectRation = 1.0f;
+  ezUInt32 m_uiNumTiles = 0;
+  ezUInt32 m_uiNumActiveTiles = 1;
   ezUniquePtr<Rasterizer> m_pRasterizer;
 
   struct Instance
@@ -83,6 +98,19 @@ private:
 
   ezDeque<Instance> m_Instances;
   ezMat4 m_mViewProjection;
+
+  struct BinnedOccluder
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fBakedModelViewProjection[16];
+    const ezRasterizerObject* m_pObject;
+    ezUInt32 m_uiMinBlockY;
+    ezUInt32 m_uiMaxBlockY;
+    bool m_bNeedsClipping;
+  };
+
+  ezDynamicArray<BinnedOccluder> m_BinnedOccluders;
 };
 
 class ezRasterizerViewPool
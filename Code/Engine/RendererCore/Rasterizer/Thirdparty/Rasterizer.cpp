@@ -317,6 +317,18 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _mm_storeu_ps(m_modelViewProjectionRaw + 8, mat2);
   _mm_storeu_ps(m_modelViewProjectionRaw + 12, mat3);
 
+  bakeModelViewProjection(matrix, m_modelViewProjection);
+}
+
+void Rasterizer::bakeModelViewProjection(const float* matrix, float* bakedMatrix) const
+{
+  __m128 mat0 = _mm_loadu_ps(matrix + 0);
+  __m128 mat1 = _mm_loadu_ps(matrix + 4);
+  __m128 mat2 = _mm_loadu_ps(matrix + 8);
+  __m128 mat3 = _mm_loadu_ps(matrix + 12);
+
+  _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
+
   // Bake viewport transform into matrix and 6shift by half a block
   mat0 = _mm_mul_ps(_mm_add_ps(mat0, mat3), _mm_set1_ps(m_width * 0.5f - 4.0f));
   mat1 = _mm_mul_ps(_mm_add_ps(mat1, mat3), _mm_set1_ps(m_height * 0.5f - 4.0f));
@@ -327,10 +339,10 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
 
   // Store prebaked cols
-  _mm_storeu_ps(m_modelViewProjection + 0, mat0);
-  _mm_storeu_ps(m_modelViewProjection + 4, mat1);
-  _mm_storeu_ps(m_modelViewProjection + 8, mat2);
-  _mm_storeu_ps(m_modelViewProjection + 12, mat3);
+  _mm_storeu_ps(bakedMatrix + 0, mat0);
+  _mm_storeu_ps(bakedMatrix + 4, mat1);
+  _mm_storeu_ps(bakedMatrix + 8, mat2);
+  _mm_storeu_ps(bakedMatrix + 12, mat3);
 }
 
 void Rasterizer::clear()
@@ -349,7 +361,12 @@ void Rasterizer::clear()
   }
 }
 
-bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping)
+bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping) const
+{
+  return queryVisibility(boundsMin, boundsMax, needsClipping, m_modelViewProjection, 0, m_blocksY);
+}
+
+bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY) const
 {
   // Frustum culling is not necessary, because EZ only calls this functions for objects that are definitely inside the frustum
   //
@@ -398,10 +415,10 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   // }
 
   // Load prebaked projection matrix
-  __m128 col0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 col1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 col2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 col3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 col0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 col1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 col2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 col3 = _mm_loadu_ps(bakedMatrix + 12);
 
   // Transform edges
   __m128 egde0 = _mm_mul_ps(col0, _mm_broadcastss_ps(extents));
@@ -473,9 +490,11 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   minsXY = _mm_sub_ps(minsXY, _mm_setr_ps(inc, inc, inc, inc));
   maxsXY = _mm_add_ps(maxsXY, _mm_setr_ps(inc, inc, inc, inc));
 
-  // Clamp bounds
-  minsXY = _mm_max_ps(minsXY, _mm_setzero_ps());
-  maxsXY = _mm_min_ps(maxsXY, _mm_setr_ps(float(m_width - 1), float(m_height - 1), float(m_width - 1), float(m_height - 1)));
+  // Clamp bounds to the queried rows of the screen
+  const float minRow = float(minBlockY * 8);
+  const float maxRow = float(maxBlockY * 8 - 1);
+  minsXY = _mm_max_ps(minsXY, _mm_setr_ps(0.0f, minRow, 0.0f, minRow));
+  maxsXY = _mm_min_ps(maxsXY, _mm_setr_ps(float(m_width - 1), maxRow, float(m_width - 1), maxRow));
 
   // Negate maxes so we can round in the same direction
   maxsXY = _mm_xor_ps(maxsXY, minusZero);
@@ -854,6 +873,12 @@ void Rasterizer::precomputeRasterizationTable()
 
 template <bool possiblyNearClipped>
 void Rasterizer::rasterize(const Occluder& occluder)
+{
+  rasterize<possiblyNearClipped>(occluder, m_modelViewProjection, 0, m_blocksY);
+}
+
+template <bool possiblyNearClipped>
+void Rasterizer::rasterize(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY)
 {
   const __m256i* vertexData = occluder.m_vertexData;
   size_t packetCount = occluder.m_packetCount;
@@ -862,10 +887,10 @@ void Rasterizer::rasterize(const Occluder& occluder)
   __m256i maskZ = _mm256_set1_epi32(1023);
 
   // Note that unaligned loads do not have a latency penalty on CPUs with SSE4 support
-  __m128 mat0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 mat1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 mat2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 mat3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 mat0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 mat1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 mat2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 mat3 = _mm_loadu_ps(bakedMatrix + 12);
 
   __m128 boundsMin = occluder.m_refMin;
   __m128 boundsExtents = _mm_sub_ps(occluder.m_refMax, boundsMin);
@@ -1168,14 +1193,18 @@ void Rasterizer::rasterize(const Occluder& occluder)
     }
 
     // Clamp and round
+    // The setup below is relative to the first block row on screen, not to minBlockY. Rows above minBlockY are skipped in the block loop instead,
+    // so that the depth and edge values of a block are exactly the same, no matter into which row ranges the buffer is split.
     __m256i minX, minY, maxX, maxY;
     minX = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFx, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
     minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
     maxX = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFx, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksX));
-    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksY));
+    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(maxBlockY));
+
+    __m256i firstY = _mm256_max_epi32(minY, _mm256_set1_epi32(minBlockY));
 
     // Check overlap between bounding box and frustum
-    __m256i inFrustum = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, minX), _mm256_cmpgt_epi32(maxY, minY));
+    __m256i inFrustum = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, minX), _mm256_cmpgt_epi32(maxY, firstY));
     primitiveValid = _mm256_and_si256(inFrustum, primitiveValid);
 
     if (_mm256_testz_si256(primitiveValid, primitiveValid))
@@ -1311,6 +1340,9 @@ void Rasterizer::rasterize(const Occluder& occluder)
     uint32_t rangesY[8];
     _mm256_storeu_si256(reinterpret_cast<__m256i*>(rangesY), rangeY);
 
+    uint32_t skipsY[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(skipsY), _mm256_sub_epi32(firstY, minY));
+
     // Transpose into AoS
     __m128 depthPlane[8];
     transpose256(depthPlane0, depthPlane1, depthPlane2, _mm256_setzero_ps(), depthPlane);
@@ -1365,6 +1397,7 @@ void Rasterizer::rasterize(const Occluder& occluder)
       const uint32_t firstBlock = firstBlocks[primitiveIdx];
       const uint32_t blockRangeX = rangesX[primitiveIdx];
       const uint32_t blockRangeY = rangesY[primitiveIdx];
+      const uint32_t blockSkipY = skipsY[primitiveIdx];
 
       uint16_t* pPrimitiveHiZ = pHiZBuffer + firstBlock;
       __m256i* pPrimitiveOut = reinterpret_cast<__m256i*>(pDepthBuffer) + 4 * firstBlock;
@@ -1379,6 +1412,12 @@ void Rasterizer::rasterize(const Occluder& occluder)
                     lineDepth = _mm256_add_ps(lineDepth, depthDy),
                     lineOffset = _mm_add_ps(lineOffset, edgeNormalY))
       {
+        // rows outside of the rasterized range still have to be stepped over to accumulate the same depth and edge values
+        if (blockY < blockSkipY)
+        {
+          continue;
+        }
+
         uint16_t* pBlockRowHiZ = pPrimitiveHiZ;
         __m256i* out = pPrimitiveOut;
 
@@ -1546,5 +1585,7 @@ void Rasterizer::rasterize(const Occluder& occluder)
 // Force template instantiations
 template void Rasterizer::rasterize<true>(const Occluder& occluder);
 template void Rasterizer::rasterize<false>(const Occluder& occluder);
+template void Rasterizer::rasterize<true>(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY);
+template void Rasterizer::rasterize<false>(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY);
 
 #endif
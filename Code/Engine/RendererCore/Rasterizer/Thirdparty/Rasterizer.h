@@ -17,10 +17,22 @@ public:
   void setModelViewProjection(const float* matrix);
   void clear();
 
+  // Bakes the viewport transform into the given column-major matrix. The result can be passed to the functions below that take a prebaked matrix,
+  // which don't touch any state of the rasterizer other than the depth buffer rows in [minBlockY, maxBlockY). Thus several threads can rasterize into
+  // disjoint row ranges at the same time.
+  void bakeModelViewProjection(const float* matrix, float* bakedMatrix) const;
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder);
 
-  bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping);
+  template <bool possiblyNearClipped>
+  void rasterize(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY);
+
+  bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping) const;
+
+  bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY) const;
+
+  uint32_t getBlocksY() const { return m_blocksY; }
 
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const;
 
@@ -33,16 +45,25 @@ public:
   void setModelViewProjection(const float* pMatrix) {}
   void clear() {}
 
+  void bakeModelViewProjection(const float* pMatrix, float* pBakedMatrix) const {}
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder)
   {
   }
 
-  bool queryVisibility(...)
+  template <bool possiblyNearClipped>
+  void rasterize(const Occluder& occluder, const float* pBakedMatrix, uint32_t uiMinBlockY, uint32_t uiMaxBlockY)
+  {
+  }
+
+  bool queryVisibility(...) const
   {
     return true;
   }
 
+  uint32_t getBlocksY() const { return 1; }
+
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const
   {
     return true;
@@ -91,6 +91,7 @@ void ezAiNavMeshPathTestComponent::Update()
   {
     m_Navigation.SetNavmesh(pNavMeshModule->GetNavMesh(m_sNavmeshConfig));
     m_Navigation.SetQueryFilter(pNavMeshModule->GetPathSearchFilter(m_sPathSearchConfig));
+    m_Navigation.SetPathQueryService(pNavMeshModule->GetPathQueryService());
   }
 
   m_Navigation.Update();
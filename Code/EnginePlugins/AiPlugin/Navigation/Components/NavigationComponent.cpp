@@ -187,6 +187,7 @@ void ezAiNavigationComponent::Steer(ezTransform& transform, float tDiff)
   {
     m_Navigation.SetNavmesh(pNavMeshModule->GetNavMesh(m_sNavmeshConfig));
     m_Navigation.SetQueryFilter(pNavMeshModule->GetPathSearchFilter(m_sPathSearchConfig));
+    m_Navigation.SetPathQueryService(pNavMeshModule->GetPathQueryService());
   }
 
   m_Navigation.SetCurrentPosition(GetOwner()->GetGlobalPosition());
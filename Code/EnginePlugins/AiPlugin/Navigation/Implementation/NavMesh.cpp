@@ -161,8 +161,9 @@ void ezAiNavMesh::FinalizeSectorUpdates()
 {
   EZ_LOCK(m_Mutex);
 
-  for (auto sectorID : m_UpdatingSectors)
+  for (auto& update : m_UpdatingSectors)
   {
+    const SectorID sectorID = update.m_SectorID;
     const auto coord = CalculateSectorCoord(sectorID);
 
     auto& sector = m_Sectors[sectorID];
@@ -181,9 +182,7 @@ void ezAiNavMesh::FinalizeSectorUpdates()
       }
     }
 
-    sector.m_NavmeshDataCur.Swap(sector.m_NavmeshDataNew);
-    sector.m_NavmeshDataNew.Clear();
-    sector.m_NavmeshDataNew.Compact();
+    sector.m_NavmeshDataCur.Swap(update.m_NavmeshData);
 
     if (!sector.m_NavmeshDataCur.IsEmpty())
     {
@@ -212,10 +211,20 @@ void ezAiNavMesh::FinalizeSectorUpdates()
 
   m_UpdatingSectors.Clear();
 
-  for (auto sectorID : m_UnloadingSectors)
+  for (ezUInt32 i = 0; i < m_UnloadingSectors.GetCount();)
   {
+    const SectorID sectorID = m_UnloadingSectors[i];
     auto& sector = m_Sectors[sectorID];
 
+    // Sector is still being built, unload it once that is finished.
+    if (sector.m_FlagUpdateAvailable == 1)
+    {
+      ++i;
+      continue;
+    }
+
+    m_UnloadingSectors.RemoveAtAndSwap(i);
+
     // Sector has been requested since then, don't unload it.
     if (sector.m_FlagRequested == 1)
       continue;
@@ -238,19 +247,26 @@ void ezAiNavMesh::FinalizeSectorUpdates()
     sector.m_FlagUpdateAvailable = 0;
     sector.m_FlagUsable = 0;
   }
-
-  m_UnloadingSectors.Clear();
 }
 
 ezAiNavMesh::SectorID ezAiNavMesh::RetrieveRequestedSector()
 {
-  if (m_RequestedSectors.IsEmpty())
-    return ezInvalidIndex;
+  for (ezUInt32 i = 0; i < m_RequestedSectors.GetCount(); ++i)
+  {
+    const ezAiNavMesh::SectorID id = m_RequestedSectors[i];
+    auto& sector = m_Sectors[id];
+
+    // the sector was requested again while it is being built, rebuild it once that is finished
+    if (sector.m_FlagUpdateAvailable == 1)
+      continue;
 
-  ezAiNavMesh::SectorID id = m_RequestedSectors.PeekFront();
-  m_RequestedSectors.PopFront();
+    m_RequestedSectors.RemoveAtAndCopy(i);
+    sector.m_FlagUpdateAvailable = 1;
+
+    return id;
+  }
 
-  return id;
+  return ezInvalidIndex;
 }
 
 ezVec2 ezAiNavMesh::GetSectorPositionOffset(ezVec2I32 vCoord) const
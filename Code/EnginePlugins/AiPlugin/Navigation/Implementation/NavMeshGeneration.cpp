@@ -4,9 +4,16 @@
 #include <Core/Physics/SurfaceResource.h>
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Types/Uuid.h>
 #include <Recast.h>
 #include <cstdint>
 
+ezCVarBool cvar_NavMeshTileCache("AI.Navmesh.TileCache", true, ezCVarFlags::Save, "Load navmesh sectors from the tile cache on disk, if they were built from the same geometry before.");
+
 void FillOutConfig(rcConfig& ref_cfg, const ezAiNavmeshConfig& config, const ezBoundingBox& bbox)
 {
   ezMemoryUtils::ZeroFill(&ref_cfg, 1);
@@ -220,6 +227,140 @@ void ezNavMeshSectorGenerationTask::Execute()
   m_pWorldNavMesh->BuildSector(m_SectorID, m_pNavGeo);
 }
 
+/// The key of a tile in the tile cache. It covers everything that affects the generated navmesh data of a sector.
+static ezUInt64 ComputeTileCacheKey(const ezAiNavmeshConfig& config, ezVec2I32 vSectorCoord, const ezAiNavMeshInputGeo& inputGeo)
+{
+  // The triangle order depends on the physics query and on unstable sorts, so it changes between runs.
+  // Therefore every triangle is hashed on its own and the hashes are summed up, which doesn't depend on the order.
+  ezUInt64 uiGeoHash = 0;
+
+  for (ezUInt32 tri = 0; tri < inputGeo.m_Triangles.GetCount(); ++tri)
+  {
+    const ezAiNavMeshTriangle& triangle = inputGeo.m_Triangles[tri];
+
+    const ezVec3 vertices[] = {
+      inputGeo.m_Vertices[triangle.m_VertexIdx[0]],
+      inputGeo.m_Vertices[triangle.m_VertexIdx[1]],
+      inputGeo.m_Vertices[triangle.m_VertexIdx[2]],
+    };
+
+    uiGeoHash += ezHashingUtils::xxHash64(vertices, sizeof(vertices), inputGeo.m_TriangleAreaIDs[tri]);
+  }
+
+  const ezUInt64 uiGeoInfo[] = {uiGeoHash, inputGeo.m_Triangles.GetCount()};
+  ezUInt64 uiKey = ezHashingUtils::xxHash64(uiGeoInfo, sizeof(uiGeoInfo));
+
+  const float fConfig[] = {
+    config.m_fSectorSize,
+    config.m_fCellSize,
+    config.m_fCellHeight,
+    config.m_fAgentRadius,
+    config.m_fAgentHeight,
+    config.m_fAgentStepHeight,
+    config.m_WalkableSlope.GetRadian(),
+    config.m_fMaxEdgeLength,
+    config.m_fMaxSimplificationError,
+    config.m_fMinRegionSize,
+    config.m_fRegionMergeSize,
+    config.m_fDetailMeshSampleDistanceFactor,
+    config.m_fDetailMeshSampleErrorFactor,
+  };
+
+  // the tile coordinate is part of the navmesh data and the sector count determines the navmesh origin
+  const ezInt32 iSectorLayout[] = {vSectorCoord.x, vSectorCoord.y, config.m_uiNumSectorsX, config.m_uiNumSectorsY};
+
+  uiKey = ezHashingUtils::xxHash64(fConfig, sizeof(fConfig), uiKey);
+  uiKey = ezHashingUtils::xxHash64(iSectorLayout, sizeof(iSectorLayout), uiKey);
+
+  return uiKey;
+}
+
+static constexpr ezUInt32 s_uiTileCacheMagic = 0x4C544E45; // 'ENTL'
+static constexpr ezUInt32 s_uiTileCacheVersion = 1;
+static constexpr ezUInt64 s_uiTileCacheHeaderSize = sizeof(ezUInt32) + sizeof(ezUInt32) + sizeof(ezUInt64) + sizeof(ezUInt32);
+static constexpr ezUInt32 s_uiTileCacheMaxDataSize = 64 * 1024 * 1024;
+
+static void GetTileCachePath(ezUInt64 uiKey, ezStringBuilder& out_sPath)
+{
+  out_sPath.SetFormat(":appdata/AiNavMeshTileCache/{}.ezNavMeshTile", ezArgU(uiKey, 16, true, 16));
+}
+
+static ezResult LoadCachedTile(ezUInt64 uiKey, ezDataBuffer& out_navmeshData)
+{
+  ezStringBuilder sPath;
+  GetTileCachePath(uiKey, sPath);
+
+  ezFileReader file;
+  if (file.Open(sPath).Failed())
+    return EZ_FAILURE;
+
+  ezUInt32 uiMagic = 0;
+  ezUInt32 uiVersion = 0;
+  ezUInt64 uiStoredKey = 0;
+  ezUInt32 uiDataSize = 0;
+  file >> uiMagic;
+  file >> uiVersion;
+  file >> uiStoredKey;
+  file >> uiDataSize;
+
+  if (uiMagic != s_uiTileCacheMagic || uiVersion != s_uiTileCacheVersion || uiStoredKey != uiKey)
+    return EZ_FAILURE;
+
+  // don't trust the size stored in a (possibly truncated or corrupted) file before allocating memory for it
+  if (uiDataSize > s_uiTileCacheMaxDataSize || s_uiTileCacheHeaderSize + uiDataSize > file.GetFileSize())
+    return EZ_FAILURE;
+
+  out_navmeshData.SetCountUninitialized(uiDataSize);
+
+  if (file.ReadBytes(out_navmeshData.GetData(), uiDataSize) != uiDataSize)
+  {
+    out_navmeshData.Clear();
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+static void StoreCachedTile(ezUInt64 uiKey, const ezDataBuffer& navmeshData)
+{
+  ezStringBuilder sPath;
+  GetTileCachePath(uiKey, sPath);
+
+  // several sector builds may store the same tile at the same time, so every build writes its own file and moves it into place once it is complete
+  ezUInt64 uiTempIdLow = 0;
+  ezUInt64 uiTempIdHigh = 0;
+  ezUuid::MakeUuid().GetValues(uiTempIdLow, uiTempIdHigh);
+
+  ezStringBuilder sTempPath;
+  sTempPath.SetFormat("{}.{}.tmp", sPath, ezArgU(uiTempIdLow ^ uiTempIdHigh, 16, true, 16));
+
+  {
+    ezFileWriter file;
+    if (file.Open(sTempPath).Failed())
+      return;
+
+    file << s_uiTileCacheMagic;
+    file << s_uiTileCacheVersion;
+    file << uiKey;
+    file << navmeshData.GetCount();
+
+    if (file.WriteBytes(navmeshData.GetData(), navmeshData.GetCount()).Failed())
+    {
+      file.Close();
+      ezFileSystem::DeleteFile(sTempPath);
+      return;
+    }
+  }
+
+  ezStringBuilder sAbsPath, sAbsTempPath;
+  if (ezFileSystem::ResolvePath(sPath, &sAbsPath, nullptr).Failed() || ezFileSystem::ResolvePath(sTempPath, &sAbsTempPath, nullptr).Failed() ||
+      ezOSFile::MoveFileOrDirectory(sAbsTempPath, sAbsPath).Failed())
+  {
+    // on some platforms the move fails if another build stored the same tile first, which has the same content
+    ezFileSystem::DeleteFile(sTempPath);
+  }
+}
+
 static ezInt8 GetSurfaceGroundType(const ezSurfaceResource* pSurf)
 {
   while (pSurf)
@@ -308,10 +449,8 @@ static void QueryInputGeo(const ezNavmeshGeoWorldModuleInterface* pGeo, ezUInt32
 
 void ezAiNavMesh::BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo)
 {
+  // this runs concurrently to other sector builds and the main thread, so don't access m_Sectors here
   const ezVec2I32 sectorCoord = CalculateSectorCoord(sectorID);
-  auto& sector = m_Sectors[sectorID];
-
-  EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 0, "Shouldn't update a sector that is already being updated");
 
   const ezBoundingBox bounds = GetSectorBounds(sectorCoord, -1000, +1000);
 
@@ -326,24 +465,45 @@ void ezAiNavMesh::BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleIn
     boundsWithBorder.m_vMax.y += borderSize * cs;
     QueryInputGeo(pGeo, m_NavmeshConfig.m_uiCollisionLayer, boundsWithBorder, inputGeo);
   }
+
+  ezDataBuffer navmeshData;
+
   if (!inputGeo.m_Vertices.IsEmpty())
   {
-    rcContext recastContext;
-    rcPolyMesh polyMesh;
+    const bool bUseTileCache = cvar_NavMeshTileCache;
+    const ezUInt64 uiTileCacheKey = bUseTileCache ? ComputeTileCacheKey(m_NavmeshConfig, sectorCoord, inputGeo) : 0;
 
-    BuildRecastPolyMesh(m_NavmeshConfig, bounds, polyMesh, &recastContext, inputGeo.m_Vertices, inputGeo.m_Triangles, inputGeo.m_TriangleAreaIDs).AssertSuccess();
-
-    if (polyMesh.nverts > 0 && polyMesh.npolys > 0)
+    if (!bUseTileCache || LoadCachedTile(uiTileCacheKey, navmeshData).Failed())
     {
-      BuildDetourNavMeshData(m_NavmeshConfig, polyMesh, sector.m_NavmeshDataNew, sectorCoord).AssertSuccess();
+      {
+        rcContext recastContext;
+        rcPolyMesh polyMesh;
+
+        BuildRecastPolyMesh(m_NavmeshConfig, bounds, polyMesh, &recastContext, inputGeo.m_Vertices, inputGeo.m_Triangles, inputGeo.m_TriangleAreaIDs).AssertSuccess();
+
+        if (polyMesh.nverts > 0 && polyMesh.npolys > 0)
+        {
+          BuildDetourNavMeshData(m_NavmeshConfig, polyMesh, navmeshData, sectorCoord).AssertSuccess();
+        }
+      }
+
+      // sectors without any walkable area are stored as well, they are just as expensive to build
+      if (bUseTileCache)
+      {
+        StoreCachedTile(uiTileCacheKey, navmeshData);
+      }
     }
   }
 
   {
-    EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 0, "Race condition in navmesh sector update");
-    sector.m_FlagUpdateAvailable = 1;
-
     EZ_LOCK(m_Mutex);
-    m_UpdatingSectors.PushBack(sectorID);
+
+    auto& update = m_UpdatingSectors.ExpandAndGetRef();
+    update.m_SectorID = sectorID;
+    update.m_NavmeshData.Swap(navmeshData);
   }
 }
+
+
+
+EZ_STATICLINK_FILE(AiPlugin, AiPlugin_Navigation_Implementation_NavMeshGeneration);
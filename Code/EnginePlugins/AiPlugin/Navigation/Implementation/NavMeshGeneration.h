@@ -5,6 +5,9 @@
 
 class ezNavmeshGeoWorldModuleInterface;
 
+/// \brief Builds a single navmesh sector.
+///
+/// ezAiNavMeshWorldModule keeps one task per concurrent sector build and reuses it for subsequent builds.
 class ezNavMeshSectorGenerationTask : public ezTask
 {
 public:
@@ -4,8 +4,11 @@
 #include <Core/World/World.h>
 #include <DetourNavMesh.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Utilities/Stats.h>
 
 ezCVarInt cvar_NavMeshVisualize("AI.Navmesh.Visualize", -1, ezCVarFlags::None, "Visualize the n-th navmesh.");
+ezCVarBool cvar_AiPathQueryBatched("AI.PathQuery.Batched", true, ezCVarFlags::Default, "Compute the paths of all agents in batches, instead of each agent searching on its own.");
+ezCVarInt cvar_NavMeshMaxConcurrentSectorBuilds("AI.Navmesh.MaxConcurrentSectorBuilds", 4, ezCVarFlags::Default, "How many navmesh sectors may be built in parallel.");
 
 // clang-format off
 EZ_IMPLEMENT_WORLD_MODULE(ezAiNavMeshWorldModule);
@@ -73,16 +76,24 @@ void ezAiNavMeshWorldModule::Initialize()
     // TODO: make tile size etc configurable
     m_WorldNavMeshes[cfg.m_sName] = EZ_DEFAULT_NEW(ezAiNavMesh, cfg);
   }
-
-  m_pGenerateSectorTask = EZ_DEFAULT_NEW(ezNavMeshSectorGenerationTask);
-  m_pGenerateSectorTask->ConfigureTask("Generate Navmesh Sector", ezTaskNesting::Maybe);
 }
 
 void ezAiNavMeshWorldModule::Deinitialize()
 {
-  m_pGenerateSectorTask = nullptr;
-  ezTaskSystem::CancelGroup(m_GenerateSectorTaskID).IgnoreResult();
-  ezTaskSystem::WaitForGroup(m_GenerateSectorTaskID);
+  m_PathQueryService.ClearRequests();
+
+  for (const ezTaskGroupID& taskID : m_GenerateSectorTaskIDs)
+  {
+    ezTaskSystem::CancelGroup(taskID).IgnoreResult();
+  }
+
+  for (const ezTaskGroupID& taskID : m_GenerateSectorTaskIDs)
+  {
+    ezTaskSystem::WaitForGroup(taskID);
+  }
+
+  m_GenerateSectorTaskIDs.Clear();
+  m_GenerateSectorTasks.Clear();
 }
 
 ezAiNavMesh* ezAiNavMeshWorldModule::GetNavMesh(ezStringView sName)
@@ -111,6 +122,10 @@ void ezAiNavMeshWorldModule::Update(const UpdateContext& ctxt)
     return;
   }
 
+  // process the requests before any tiles are replaced, so that the requested polygons are still valid
+  m_PathQueryService.ProcessRequests();
+  UpdatePathQueryStats();
+
   for (auto& nm : m_WorldNavMeshes)
   {
     nm.Value()->FinalizeSectorUpdates();
@@ -129,29 +144,102 @@ void ezAiNavMeshWorldModule::Update(const UpdateContext& ctxt)
     }
   }
 
-  if (!ezTaskSystem::IsTaskGroupFinished(m_GenerateSectorTaskID))
+  const ezUInt32 uiMaxConcurrentBuilds = static_cast<ezUInt32>(ezMath::Max(cvar_NavMeshMaxConcurrentSectorBuilds.GetValue(), 1));
+
+  while (m_GenerateSectorTasks.GetCount() < uiMaxConcurrentBuilds)
+  {
+    auto& pTask = m_GenerateSectorTasks.ExpandAndGetRef();
+    pTask = EZ_DEFAULT_NEW(ezNavMeshSectorGenerationTask);
+    pTask->ConfigureTask("Generate Navmesh Sector", ezTaskNesting::Maybe);
+
+    m_GenerateSectorTaskIDs.ExpandAndGetRef();
+  }
+
+  ezHybridArray<ezUInt32, 8> freeSlots;
+  for (ezUInt32 i = 0; i < uiMaxConcurrentBuilds; ++i)
+  {
+    if (ezTaskSystem::IsTaskGroupFinished(m_GenerateSectorTaskIDs[i]))
+    {
+      freeSlots.PushBack(i);
+    }
+  }
+
+  if (freeSlots.IsEmpty())
     return;
 
   auto pNavGeo = GetWorld()->GetOrCreateModule<ezNavmeshGeoWorldModuleInterface>();
   if (pNavGeo == nullptr)
     return;
 
-  for (auto& nm : m_WorldNavMeshes)
+  // distribute the free slots round-robin, so that every navmesh makes progress
+  bool bAnyStarted = true;
+  while (bAnyStarted && !freeSlots.IsEmpty())
   {
-    auto sectorID = nm.Value()->RetrieveRequestedSector();
-    if (sectorID == ezInvalidIndex)
-      continue;
+    bAnyStarted = false;
+
+    for (auto& nm : m_WorldNavMeshes)
+    {
+      if (freeSlots.IsEmpty())
+        break;
+
+      auto sectorID = nm.Value()->RetrieveRequestedSector();
+      if (sectorID == ezInvalidIndex)
+        continue;
 
-    m_pGenerateSectorTask->m_pWorldNavMesh = nm.Value();
-    m_pGenerateSectorTask->m_SectorID = sectorID;
-    m_pGenerateSectorTask->m_pNavGeo = pNavGeo;
+      const ezUInt32 uiSlot = freeSlots.PeekBack();
+      freeSlots.PopBack();
 
-    m_GenerateSectorTaskID = ezTaskSystem::StartSingleTask(m_pGenerateSectorTask, ezTaskPriority::LongRunning);
+      auto& pTask = m_GenerateSectorTasks[uiSlot];
+      pTask->m_pWorldNavMesh = nm.Value();
+      pTask->m_SectorID = sectorID;
+      pTask->m_pNavGeo = pNavGeo;
 
-    break;
+      m_GenerateSectorTaskIDs[uiSlot] = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+      bAnyStarted = true;
+    }
   }
 }
 
+ezAiPathQueryService* ezAiNavMeshWorldModule::GetPathQueryService()
+{
+  if (!cvar_AiPathQueryBatched)
+    return nullptr;
+
+  return &m_PathQueryService;
+}
+
+void ezAiNavMeshWorldModule::UpdatePathQueryStats()
+{
+  const ezAiPathQueryStats& stats = m_PathQueryService.GetStats();
+
+  // searches of earlier frames may still be queued or running while no new requests come in
+  if (stats.m_uiNumRequests == 0 && stats.m_uiNumSearches == 0 && stats.m_uiNumQueuedSearches == 0)
+    return;
+
+  ezStringBuilder sStatName;
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Requests", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_uiNumRequests);
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Shared Requests", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_uiNumSharedRequests);
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Searches", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_uiNumSearches);
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Queued Searches", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_uiNumQueuedSearches);
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Searches per Second", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_ProcessingTime.IsPositive() ? stats.m_uiNumSearches / stats.m_ProcessingTime.GetSeconds() : 0.0);
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Average Latency", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_AverageLatency);
+
+  sStatName.SetFormat("AI/{0}/Path Queries/Max Latency", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, stats.m_MaxLatency);
+}
+
 const dtQueryFilter& ezAiNavMeshWorldModule::GetPathSearchFilter(ezStringView sName) const
 {
   auto it = m_PathSearchFilters.Find(sName);
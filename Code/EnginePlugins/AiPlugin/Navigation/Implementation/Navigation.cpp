@@ -204,6 +204,7 @@ void ezAiNavigation::Update()
 
 void ezAiNavigation::CancelNavigation()
 {
+  m_pPathQuery = nullptr;
   m_PathCorridor.clear();
   m_uiTargetPositionChangedBit = 0; // don't start another path search
   m_State = State::Idle;
@@ -246,6 +247,21 @@ void ezAiNavigation::SetQueryFilter(const dtQueryFilter& filter)
   m_pFilter = &filter;
 }
 
+void ezAiNavigation::SetPathQueryService(ezAiPathQueryService* pService)
+{
+  if (m_pPathQueryService == pService)
+    return;
+
+  m_pPathQueryService = pService;
+
+  if (m_State == State::Searching)
+  {
+    // the running search belongs to the previous service (or this instance), just start over
+    m_pPathQuery = nullptr;
+    m_State = State::StartNewSearch;
+  }
+}
+
 void ezAiNavigation::ComputeAllWaypoints(ezDynamicArray<ezVec3>& out_waypoints) const
 {
   out_waypoints.Clear();
@@ -303,6 +319,14 @@ bool ezAiNavigation::UpdatePathSearch()
     }
 
     m_vPathSearchTargetPos = m_vTargetPosition;
+
+    if (m_pPathQueryService != nullptr)
+    {
+      m_pPathQuery = m_pPathQueryService->RequestPath(m_pNavmesh, m_pFilter, startRef, m_vCurrentPosition, m_PathSearchTargetPoly, m_vTargetPosition);
+      m_State = State::Searching;
+      return false;
+    }
+
     if (dtStatusFailed(m_Query.initSlicedFindPath(startRef, m_PathSearchTargetPoly, ezRcPos(m_vCurrentPosition), ezRcPos(m_vTargetPosition), m_pFilter)))
     {
       m_State = State::NoPathFound;
@@ -316,30 +340,53 @@ bool ezAiNavigation::UpdatePathSearch()
 
   if (m_State == State::Searching)
   {
-    const int iMaxIterations = 32;
-    int iIterationsDone = 0;
-    dtStatus res = m_Query.updateSlicedFindPath(iMaxIterations, &iIterationsDone);
+    ezInt32 iPathCorridorLength = 0;
+    dtPolyRef resultPolys[MaxPathNodes];
 
-    if (dtStatusInProgress(res))
+    if (m_pPathQuery != nullptr)
     {
-      // still searching
-      return false;
-    }
+      if (!m_pPathQuery->IsFinished())
+      {
+        // the path query service hasn't processed the request yet
+        return false;
+      }
 
-    if (dtStatusFailed(res))
-    {
-      m_State = State::NoPathFound;
-      return false;
-    }
+      const ezArrayPtr<const dtPolyRef> path = m_pPathQuery->GetPath();
+      iPathCorridorLength = (ezInt32)path.GetCount();
+      ezMemoryUtils::Copy(resultPolys, path.GetPtr(), path.GetCount());
 
-    ezInt32 iPathCorridorLength = 0;
-    dtPolyRef resultPolys[MaxPathNodes];
+      m_pPathQuery = nullptr;
 
-    if (dtStatusFailed(m_Query.finalizeSlicedFindPath(resultPolys, &iPathCorridorLength, (int)MaxPathNodes)))
+      if (iPathCorridorLength == 0)
+      {
+        m_State = State::NoPathFound;
+        return false;
+      }
+    }
+    else
     {
-      m_State = State::NoPathFound;
-      EZ_REPORT_FAILURE("Detour: finalizeSlicedFindPath failed.");
-      return false;
+      const int iMaxIterations = 32;
+      int iIterationsDone = 0;
+      dtStatus res = m_Query.updateSlicedFindPath(iMaxIterations, &iIterationsDone);
+
+      if (dtStatusInProgress(res))
+      {
+        // still searching
+        return false;
+      }
+
+      if (dtStatusFailed(res))
+      {
+        m_State = State::NoPathFound;
+        return false;
+      }
+
+      if (dtStatusFailed(m_Query.finalizeSlicedFindPath(resultPolys, &iPathCorridorLength, (int)MaxPathNodes)))
+      {
+        m_State = State::NoPathFound;
+        EZ_REPORT_FAILURE("Detour: finalizeSlicedFindPath failed.");
+        return false;
+      }
     }
 
     // reduce to actual length
@@ -0,0 +1,215 @@
+#include <AiPlugin/Navigation/NavMesh.h>
+#include <AiPlugin/Navigation/PathQueryService.h>
+#include <AiPlugin/Utils/RcMath.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+ezCVarBool cvar_AiPathQueryShareResults("AI.PathQuery.ShareResults", true, ezCVarFlags::Default, "Whether path requests from the same start polygon to the same target polygon share a single search.");
+ezCVarInt cvar_AiPathQueryMaxSearchesPerFrame("AI.PathQuery.MaxSearchesPerFrame", 512, ezCVarFlags::Default, "How many path searches are executed per frame at most. The remaining ones are postponed to the next frame. Zero or less means no limit.");
+
+ezUInt32 ezAiPathQueryService::RequestKeyHashHelper::Hash(const RequestKey& key)
+{
+  static_assert(sizeof(RequestKey) == 2 * sizeof(void*) + 2 * sizeof(dtPolyRef), "RequestKey must not contain padding");
+  return ezHashingUtils::xxHash32(&key, sizeof(RequestKey));
+}
+
+bool ezAiPathQueryService::RequestKeyHashHelper::Equal(const RequestKey& a, const RequestKey& b)
+{
+  return a.m_pNavmesh == b.m_pNavmesh && a.m_pFilter == b.m_pFilter && a.m_StartPoly == b.m_StartPoly && a.m_TargetPoly == b.m_TargetPoly;
+}
+
+ezAiPathQueryService::ezAiPathQueryService() = default;
+ezAiPathQueryService::~ezAiPathQueryService() = default;
+
+ezSharedPtr<ezAiPathQuery> ezAiPathQueryService::RequestPath(const ezAiNavMesh* pNavmesh, const dtQueryFilter* pFilter, dtPolyRef startPoly, const ezVec3& vStartPos, dtPolyRef targetPoly, const ezVec3& vTargetPos)
+{
+  EZ_ASSERT_DEV(pNavmesh != nullptr && pFilter != nullptr, "Invalid path request.");
+
+  RequestKey key;
+  key.m_pNavmesh = pNavmesh;
+  key.m_pFilter = pFilter;
+  key.m_StartPoly = startPoly;
+  key.m_TargetPoly = targetPoly;
+
+  const ezTime now = ezTime::Now();
+  ++m_PendingStats.m_uiNumRequests;
+
+  ezSharedPtr<ezAiPathQuery> pQuery;
+
+  if (cvar_AiPathQueryShareResults && m_PendingRequests.TryGetValue(key, pQuery))
+  {
+    // the first requester determines the exact start and target position of the search
+    ++m_PendingStats.m_uiNumSharedRequests;
+  }
+  else
+  {
+    pQuery = EZ_DEFAULT_NEW(ezAiPathQuery);
+    pQuery->m_pNavmesh = pNavmesh;
+    pQuery->m_pFilter = pFilter;
+    pQuery->m_StartPoly = startPoly;
+    pQuery->m_TargetPoly = targetPoly;
+    pQuery->m_vStartPos = vStartPos;
+    pQuery->m_vTargetPos = vTargetPos;
+    pQuery->m_FirstRequestTime = now;
+
+    if (cvar_AiPathQueryShareResults)
+    {
+      m_PendingRequests.Insert(key, pQuery);
+    }
+
+    m_Queue.PushBack(pQuery);
+  }
+
+  pQuery->m_fSumRequestTimes += now.GetSeconds();
+  ++pQuery->m_uiNumRequesters;
+
+  return pQuery;
+}
+
+void ezAiPathQueryService::ProcessRequests()
+{
+  // the oldest searches go first, so that postponed searches aren't starved by new requests
+  const ezInt32 iMaxSearches = cvar_AiPathQueryMaxSearchesPerFrame;
+  const ezUInt32 uiNumSearches = iMaxSearches > 0 ? ezMath::Min(m_Queue.GetCount(), static_cast<ezUInt32>(iMaxSearches)) : m_Queue.GetCount();
+
+  for (ezUInt32 i = 0; i < uiNumSearches; ++i)
+  {
+    // from now on, new requests for the same polygons can't share this search anymore
+    m_PendingRequests.Remove(MakeRequestKey(*m_Queue.PeekFront()));
+
+    m_Batch.PushBack(std::move(m_Queue.PeekFront()));
+    m_Queue.PopFront();
+  }
+
+  m_Stats = m_PendingStats;
+  m_PendingStats = ezAiPathQueryStats();
+  m_Stats.m_uiNumSearches = m_Batch.GetCount();
+  m_Stats.m_uiNumQueuedSearches = m_Queue.GetCount();
+
+  if (m_Batch.IsEmpty())
+    return;
+
+  const ezTime tStart = ezTime::Now();
+
+  // group the searches by navmesh, every navmesh has its own query objects
+  m_Batch.Sort([](const ezSharedPtr<ezAiPathQuery>& a, const ezSharedPtr<ezAiPathQuery>& b)
+    { return a->m_pNavmesh < b->m_pNavmesh; });
+
+  const ezUInt32 uiMaxSlots = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1;
+
+  struct BatchContext
+  {
+    ezArrayPtr<ezSharedPtr<ezAiPathQuery>> m_Searches;
+    ezArrayPtr<ezUniquePtr<dtNavMeshQuery>> m_Queries;
+    ezAtomicInteger32 m_iNextSearch;
+  };
+
+  for (ezUInt32 uiFirst = 0; uiFirst < m_Batch.GetCount();)
+  {
+    const ezAiNavMesh* pNavmesh = m_Batch[uiFirst]->m_pNavmesh;
+
+    ezUInt32 uiEnd = uiFirst + 1;
+    while (uiEnd < m_Batch.GetCount() && m_Batch[uiEnd]->m_pNavmesh == pNavmesh)
+    {
+      ++uiEnd;
+    }
+
+    const ezUInt32 uiNumSlots = ezMath::Min(uiMaxSlots, uiEnd - uiFirst);
+
+    auto& queries = m_QueryPools[pNavmesh];
+    while (queries.GetCount() < uiNumSlots)
+    {
+      auto& pQuery = queries.ExpandAndGetRef();
+      pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+      pQuery->init(pNavmesh->GetDetourNavMesh(), ezAiPathQuery::MaxSearchNodes);
+    }
+
+    BatchContext ctxt;
+    ctxt.m_Searches = m_Batch.GetArrayPtr().GetSubArray(uiFirst, uiEnd - uiFirst);
+    ctxt.m_Queries = queries.GetArrayPtr().GetSubArray(0, uiNumSlots);
+
+    // every slot owns one query object and pulls searches until none are left, which balances paths of different lengths
+    ezParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumSlots, [&ctxt](ezUInt32 uiStartSlot, ezUInt32 uiEndSlot)
+      {
+        for (ezUInt32 uiSlot = uiStartSlot; uiSlot < uiEndSlot; ++uiSlot)
+        {
+          dtNavMeshQuery& query = *ctxt.m_Queries[uiSlot];
+
+          for (ezUInt32 uiSearch = ctxt.m_iNextSearch.PostIncrement(); uiSearch < ctxt.m_Searches.GetCount(); uiSearch = ctxt.m_iNextSearch.PostIncrement())
+          {
+            ExecuteSearch(query, *ctxt.m_Searches[uiSearch]);
+          }
+        }
+      },
+      "Path Queries", ezTaskNesting::Never, params);
+
+    uiFirst = uiEnd;
+  }
+
+  const ezTime tEnd = ezTime::Now();
+  m_Stats.m_ProcessingTime = tEnd - tStart;
+
+  // the latency covers the requesters whose paths are finished now, which includes requests from earlier frames
+  double fSumLatency = 0.0;
+  ezUInt32 uiNumRequesters = 0;
+  for (const auto& pQuery : m_Batch)
+  {
+    fSumLatency += pQuery->m_uiNumRequesters * tEnd.GetSeconds() - pQuery->m_fSumRequestTimes;
+    uiNumRequesters += pQuery->m_uiNumRequesters;
+    m_Stats.m_MaxLatency = ezMath::Max(m_Stats.m_MaxLatency, tEnd - pQuery->m_FirstRequestTime);
+  }
+
+  m_Stats.m_AverageLatency = ezTime::MakeFromSeconds(fSumLatency / ezMath::Max(uiNumRequesters, 1u));
+
+  m_Batch.Clear();
+}
+
+void ezAiPathQueryService::ClearRequests()
+{
+  m_PendingRequests.Clear();
+  m_Queue.Clear();
+  m_Batch.Clear();
+  m_PendingStats = ezAiPathQueryStats();
+}
+
+ezAiPathQueryService::RequestKey ezAiPathQueryService::MakeRequestKey(const ezAiPathQuery& query)
+{
+  RequestKey key;
+  key.m_pNavmesh = query.m_pNavmesh;
+  key.m_pFilter = query.m_pFilter;
+  key.m_StartPoly = query.m_StartPoly;
+  key.m_TargetPoly = query.m_TargetPoly;
+  return key;
+}
+
+void ezAiPathQueryService::ExecuteSearch(dtNavMeshQuery& ref_query, ezAiPathQuery& ref_pathQuery)
+{
+  int iPathLength = 0;
+  const dtStatus res = ref_query.findPath(ref_pathQuery.m_StartPoly, ref_pathQuery.m_TargetPoly, ezRcPos(ref_pathQuery.m_vStartPos), ezRcPos(ref_pathQuery.m_vTargetPos), ref_pathQuery.m_pFilter, ref_pathQuery.m_Path, &iPathLength, (int)ezAiPathQuery::MaxPathNodes);
+
+  if (dtStatusFailed(res) || iPathLength <= 0)
+  {
+    ref_pathQuery.m_uiPathLength = 0;
+    ref_pathQuery.m_State = ezAiPathQuery::State::NoPathFound;
+    return;
+  }
+
+  ref_pathQuery.m_uiPathLength = (ezUInt32)iPathLength;
+
+  // if the path doesn't end at the target polygon, the target cannot be reached, but one can walk close to it
+  if (ref_pathQuery.m_Path[iPathLength - 1] != ref_pathQuery.m_TargetPoly)
+  {
+    ref_pathQuery.m_State = ezAiPathQuery::State::PartialPathFound;
+  }
+  else
+  {
+    ref_pathQuery.m_State = ezAiPathQuery::State::FullPathFound;
+  }
+}
+
+EZ_STATICLINK_FILE(AiPlugin, AiPlugin_Navigation_Implementation_PathQueryService);
@@ -53,7 +53,6 @@ struct ezAiNavMeshSector final
   ezUInt8 m_FlagUsable : 1;
 
   ezDataBuffer m_NavmeshDataCur;
-  ezDataBuffer m_NavmeshDataNew;
   dtTileRef m_TileRef = 0;
 };
 
@@ -111,7 +110,17 @@ public:
 
   void FinalizeSectorUpdates();
 
+  /// \brief Returns the next requested sector that should be built and marks it as being updated.
+  ///
+  /// Sectors that are currently being built are skipped, they stay in the queue until their current build is finished.
+  /// Returns ezInvalidIndex when there is nothing to build.
   SectorID RetrieveRequestedSector();
+
+  /// \brief Builds the navmesh data for a sector that was returned by RetrieveRequestedSector().
+  ///
+  /// This may run on any thread and concurrently for different sectors. The result is applied by the next FinalizeSectorUpdates().
+  /// If the tile cache is enabled (CVar 'AI.Navmesh.TileCache'), previously built data for the same input geometry is loaded from
+  /// disk instead, and newly built data is written to it.
   void BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo);
 
   const dtNavMesh* GetDetourNavMesh() const { return m_pNavMesh; }
@@ -134,8 +143,14 @@ private:
   ezMap<SectorID, ezAiNavMeshSector> m_Sectors;
   ezDeque<SectorID> m_RequestedSectors;
 
+  struct SectorUpdate
+  {
+    SectorID m_SectorID = ezInvalidIndex;
+    ezDataBuffer m_NavmeshData;
+  };
+
   ezMutex m_Mutex;
-  ezDynamicArray<SectorID> m_UpdatingSectors;
+  ezDynamicArray<SectorUpdate> m_UpdatingSectors;
 
   ezDynamicArray<SectorID> m_UnloadingSectors;
 };
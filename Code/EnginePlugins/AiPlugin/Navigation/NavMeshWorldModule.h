@@ -2,6 +2,7 @@
 
 #include <AiPlugin/AiPluginDLL.h>
 #include <AiPlugin/Navigation/Implementation/NavMeshGeneration.h>
+#include <AiPlugin/Navigation/PathQueryService.h>
 #include <Core/World/WorldModule.h>
 
 class ezAiNavMesh;
@@ -11,7 +12,8 @@ class dtNavMesh;
 /// and makes sure to build their sectors in the background.
 ///
 /// Through this you can get access to one of the available navmeshes.
-/// Additionally, it also provides access to the different path search filters.
+/// Additionally, it also provides access to the different path search filters
+/// and to the service that computes the paths of all agents in batches.
 class EZ_AIPLUGIN_DLL ezAiNavMeshWorldModule final : public ezWorldModule
 {
   EZ_DECLARE_WORLD_MODULE();
@@ -31,19 +33,30 @@ public:
 
   const ezAiNavigationConfig& GetConfig() const { return m_Config; }
 
+  /// \brief Returns the service through which path searches should be done, or nullptr if batched path queries are disabled.
+  ///
+  /// The queued requests are processed once per frame, after the navmesh sectors have been updated.
+  /// Batched path queries can be disabled with the CVar 'AI.PathQuery.Batched'.
+  ezAiPathQueryService* GetPathQueryService();
+
 private:
   void Update(const UpdateContext& ctxt);
+  void UpdatePathQueryStats();
 
   ezMap<ezString, ezAiNavMesh*> m_WorldNavMeshes;
 
   // TODO: this is a hacky solution to delay the navmesh generation until after Physics has been set up.
   ezUInt32 m_uiUpdateDelay = 10;
-  ezTaskGroupID m_GenerateSectorTaskID;
-  ezSharedPtr<ezNavMeshSectorGenerationTask> m_pGenerateSectorTask;
+
+  // one slot per concurrent sector build, the tasks are reused for subsequent builds, see 'AI.Navmesh.MaxConcurrentSectorBuilds'
+  ezHybridArray<ezTaskGroupID, 8> m_GenerateSectorTaskIDs;
+  ezHybridArray<ezSharedPtr<ezNavMeshSectorGenerationTask>, 8> m_GenerateSectorTasks;
 
   ezAiNavigationConfig m_Config;
 
   ezMap<ezString, dtQueryFilter> m_PathSearchFilters;
+
+  ezAiPathQueryService m_PathQueryService;
 };
 
 /* TODO:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AiPlugin/Navigation/NavMesh.h>
+#include <AiPlugin/Navigation/PathQueryService.h>
 #include <DetourNavMeshQuery.h>
 #include <DetourPathCorridor.h>
 #include <Foundation/Math/Angle.h>
@@ -37,6 +38,9 @@ struct ezAiSteeringInfo
 /// If the destination was reached, a completely different path should be computed, or the current
 /// path should be canceled, call CancelNavigation().
 /// To start a new path search, call SetTargetPosition() again (and Update() every frame).
+///
+/// If a path query service is set through SetPathQueryService(), path searches are handed to it and their result is picked up
+/// in a later Update(). Otherwise the path is searched incrementally by this instance, over multiple Update() calls.
 class EZ_AIPLUGIN_DLL ezAiNavigation final
 {
 public:
@@ -55,8 +59,8 @@ public:
     Searching,
   };
 
-  static constexpr ezUInt32 MaxPathNodes = 64;
-  static constexpr ezUInt32 MaxSearchNodes = MaxPathNodes * 8;
+  static constexpr ezUInt32 MaxPathNodes = ezAiPathQuery::MaxPathNodes;
+  static constexpr ezUInt32 MaxSearchNodes = ezAiPathQuery::MaxSearchNodes;
 
   State GetState() const { return m_State; }
 
@@ -70,6 +74,11 @@ public:
   void SetNavmesh(ezAiNavMesh* pNavmesh);
   void SetQueryFilter(const dtQueryFilter& filter);
 
+  /// \brief Sets the service that computes the path searches. If nullptr, the path is searched by this instance.
+  ///
+  /// \see ezAiNavMeshWorldModule::GetPathQueryService()
+  void SetPathQueryService(ezAiPathQueryService* pService);
+
   void ComputeAllWaypoints(ezDynamicArray<ezVec3>& out_waypoints) const;
 
   void DebugDrawPathCorridor(const ezDebugRendererContext& context, ezColor tilesColor, float fPolyRenderOffsetZ = 0.1f);
@@ -109,6 +118,9 @@ private:
   const dtQueryFilter* m_pFilter = nullptr;
   dtPathCorridor m_PathCorridor;
 
+  ezAiPathQueryService* m_pPathQueryService = nullptr;
+  ezSharedPtr<ezAiPathQuery> m_pPathQuery;
+
   dtPolyRef m_PathSearchTargetPoly;
   ezVec3 m_vPathSearchTargetPos;
 
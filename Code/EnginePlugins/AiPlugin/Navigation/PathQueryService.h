@@ -0,0 +1,140 @@
+#pragma once
+
+#include <AiPlugin/AiPluginDLL.h>
+#include <DetourNavMeshQuery.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/RefCounted.h>
+#include <Foundation/Types/SharedPtr.h>
+#include <Foundation/Types/UniquePtr.h>
+
+class ezAiNavMesh;
+
+/// \brief A path search that was submitted to an ezAiPathQueryService.
+///
+/// The query stays in the 'Pending' state until an ezAiPathQueryService::ProcessRequests() call executed its search.
+/// That is usually the next call, but may be a later one, if more searches were requested than fit into one frame.
+/// Several requesters may share the same query object, if they want to go from the same navmesh polygon to the same target polygon.
+class EZ_AIPLUGIN_DLL ezAiPathQuery : public ezRefCounted
+{
+public:
+  enum class State
+  {
+    Pending,
+    NoPathFound,
+    PartialPathFound,
+    FullPathFound,
+  };
+
+  static constexpr ezUInt32 MaxPathNodes = 64;
+  static constexpr ezUInt32 MaxSearchNodes = MaxPathNodes * 8;
+
+  State GetState() const { return m_State; }
+  bool IsFinished() const { return m_State != State::Pending; }
+
+  /// \brief The polygons from the start polygon towards the target polygon. Empty, if no path was found.
+  ezArrayPtr<const dtPolyRef> GetPath() const { return ezArrayPtr<const dtPolyRef>(m_Path, m_uiPathLength); }
+
+private:
+  friend class ezAiPathQueryService;
+
+  const ezAiNavMesh* m_pNavmesh = nullptr;
+  const dtQueryFilter* m_pFilter = nullptr;
+  dtPolyRef m_StartPoly = 0;
+  dtPolyRef m_TargetPoly = 0;
+  ezVec3 m_vStartPos;
+  ezVec3 m_vTargetPos;
+
+  ezTime m_FirstRequestTime;
+  double m_fSumRequestTimes = 0.0;
+  ezUInt32 m_uiNumRequesters = 0;
+
+  State m_State = State::Pending;
+  ezUInt32 m_uiPathLength = 0;
+  dtPolyRef m_Path[MaxPathNodes];
+};
+
+/// \brief Statistics about the last batch of path queries that an ezAiPathQueryService processed.
+struct ezAiPathQueryStats
+{
+  ezUInt32 m_uiNumRequests = 0;       ///< How many paths were requested.
+  ezUInt32 m_uiNumSharedRequests = 0; ///< How many of those requests reused the search of another request.
+  ezUInt32 m_uiNumSearches = 0;       ///< How many path searches were actually executed.
+  ezUInt32 m_uiNumQueuedSearches = 0; ///< How many path searches didn't fit into the budget and were postponed to the next batch.
+  ezTime m_ProcessingTime;            ///< How long it took to execute all searches.
+  ezTime m_AverageLatency;            ///< The average time from requesting a path until the result was available.
+  ezTime m_MaxLatency;                ///< The longest time from requesting a path until the result was available.
+};
+
+/// \brief Computes the paths of many agents in batches.
+///
+/// Instead of every ezAiNavigation running its own incremental search, paths are requested through RequestPath() and are all computed
+/// at once in ProcessRequests(), distributed across the worker threads. Each worker slot uses its own dtNavMeshQuery, which is reused
+/// from frame to frame, so the search node pools don't need to be set up for every agent.
+///
+/// Requests from the same start polygon to the same target polygon (e.g. a group of agents walking to the same destination)
+/// are only searched once and share the result. This can be disabled with the CVar 'AI.PathQuery.ShareResults'.
+///
+/// At most 'AI.PathQuery.MaxSearchesPerFrame' searches are executed per ProcessRequests() call, so that a burst of requests doesn't stall
+/// the frame. The remaining searches stay queued and are executed first in the following calls.
+///
+/// ezAiNavMeshWorldModule owns one service per world and processes the requests once per frame.
+class EZ_AIPLUGIN_DLL ezAiPathQueryService
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAiPathQueryService);
+
+public:
+  ezAiPathQueryService();
+  ~ezAiPathQueryService();
+
+  /// \brief Queues a path search. The returned query is filled out by the next ProcessRequests().
+  ///
+  /// The start and target polygons must have been determined by the caller, e.g. through dtNavMeshQuery::findNearestPoly().
+  ezSharedPtr<ezAiPathQuery> RequestPath(const ezAiNavMesh* pNavmesh, const dtQueryFilter* pFilter, dtPolyRef startPoly, const ezVec3& vStartPos, dtPolyRef targetPoly, const ezVec3& vTargetPos);
+
+  /// \brief Executes the oldest queued path searches, up to the per frame budget, and waits until they are finished.
+  ///
+  /// Must not be called while any of the navmeshes is modified. Tiles should also not be replaced between requesting a path and
+  /// processing it, otherwise the requested polygons may not exist anymore and no path is found. This can happen for searches that
+  /// were postponed to a later call.
+  void ProcessRequests();
+
+  /// \brief Drops all queued requests without processing them. Their queries stay in the 'Pending' state.
+  void ClearRequests();
+
+  /// \brief Returns the statistics of the last ProcessRequests() call.
+  const ezAiPathQueryStats& GetStats() const { return m_Stats; }
+
+private:
+  // hashed as raw memory, so it must not contain any padding
+  struct RequestKey
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezAiNavMesh* m_pNavmesh;
+    const dtQueryFilter* m_pFilter;
+    dtPolyRef m_StartPoly;
+    dtPolyRef m_TargetPoly;
+  };
+
+  struct RequestKeyHashHelper
+  {
+    static ezUInt32 Hash(const RequestKey& key);
+    static bool Equal(const RequestKey& a, const RequestKey& b);
+  };
+
+  static void ExecuteSearch(dtNavMeshQuery& ref_query, ezAiPathQuery& ref_pathQuery);
+
+  static RequestKey MakeRequestKey(const ezAiPathQuery& query);
+
+  ezHashTable<RequestKey, ezSharedPtr<ezAiPathQuery>, RequestKeyHashHelper> m_PendingRequests;
+  ezDeque<ezSharedPtr<ezAiPathQuery>> m_Queue;
+  ezDynamicArray<ezSharedPtr<ezAiPathQuery>> m_Batch;
+  ezMap<const ezAiNavMesh*, ezDynamicArray<ezUniquePtr<dtNavMeshQuery>>> m_QueryPools;
+
+  ezAiPathQueryStats m_PendingStats;
+  ezAiPathQueryStats m_Stats;
+};
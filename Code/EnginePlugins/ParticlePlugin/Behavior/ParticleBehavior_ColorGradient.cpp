@@ -1,6 +1,7 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_ColorGradient.h>
@@ -154,71 +155,57 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
 
   const ezColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
 
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
-
-  // skip the first n particles
-  itColor.Advance(m_uiFirstToUpdate);
-
-  if (m_GradientMode == ezParticleColorGradientMode::Age)
-  {
-    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-
-    // skip the first n particles
-    itLifeTime.Advance(m_uiFirstToUpdate);
-
-    while (!itLifeTime.HasReachedEnd())
+  ProcessInRanges(uiNumElements, [this, &gradient](ezUInt64 uiStartIndex, ezUInt64 uiCount)
     {
-      // if (itLifeTime.Current().y > 0)
-      {
-        const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-        const float posx = 1.0f - fLifeTimeFraction;
+      ezColorLinear16f* pColor = m_pStreamColor->GetWritableData<ezColorLinear16f>();
+      const ezUInt64 uiUpdateInterval = m_uiCurrentUpdateInterval;
 
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
+      // the first particle in this range that is due for an update
+      ezUInt64 uiIndex = ezProcessingStreamKernels::GetFirstStridedIndex(m_uiFirstToUpdate, uiUpdateInterval, uiStartIndex);
 
-        itColor.Current() = rgba * m_TintColor;
-      }
+      const ezUInt64 uiEndIndex = uiStartIndex + uiCount;
 
-      // skip the next n items
+      // only every n-th particle is updated
       // this is to reduce the number of particles that need to be fully evaluated,
       // since sampling the color gradient is pretty expensive
-      itLifeTime.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
-    }
-  }
-  else if (m_GradientMode == ezParticleColorGradientMode::Speed)
-  {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+      if (m_GradientMode == ezParticleColorGradientMode::Age)
+      {
+        const ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<ezFloat16Vec2>();
 
-    // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
+        for (; uiIndex < uiEndIndex; uiIndex += uiUpdateInterval)
+        {
+          const float fLifeTimeFraction = pLifeTime[uiIndex].x * pLifeTime[uiIndex].y;
+          const float posx = 1.0f - fLifeTimeFraction;
 
-    while (!itVelocity.HasReachedEnd())
-    {
-      // if (itLifeTime.Current().y > 0)
+          ezColor rgba;
+          ezUInt8 alpha;
+          gradient.EvaluateColor(posx, rgba);
+          gradient.EvaluateAlpha(posx, alpha);
+          rgba.a = ezMath::ColorByteToFloat(alpha);
+
+          pColor[uiIndex] = rgba * m_TintColor;
+        }
+      }
+      else if (m_GradientMode == ezParticleColorGradientMode::Speed)
       {
-        const float fSpeed = itVelocity.Current().GetLength();
-        const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
+        const ezVec3* pVelocity = m_pStreamVelocity->GetData<ezVec3>();
 
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
+        for (; uiIndex < uiEndIndex; uiIndex += uiUpdateInterval)
+        {
+          const float fSpeed = pVelocity[uiIndex].GetLength();
+          const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
 
-        itColor.Current() = rgba * m_TintColor;
-      }
+          ezColor rgba;
+          ezUInt8 alpha;
+          gradient.EvaluateColor(posx, rgba);
+          gradient.EvaluateAlpha(posx, alpha);
+          rgba.a = ezMath::ColorByteToFloat(alpha);
 
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
-    }
-  }
+          pColor[uiIndex] = rgba * m_TintColor;
+        }
+      }
+    },
+    "PFX: Color Gradient");
 
   // adjust which index is the first to update
   {
@@ -3,7 +3,7 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
@@ -82,14 +82,9 @@ void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
-
-    itVelocity.Advance();
-  }
+  ProcessInRanges(uiNumElements, [this, addGravity](ezUInt64 uiStartIndex, ezUInt64 uiCount)
+    { ezProcessingStreamKernels::AddFloat3(m_pStreamVelocity->GetWritableData<ezVec3>() + uiStartIndex, uiCount, addGravity); },
+    "PFX: Gravity");
 }
 
 void ezParticleBehavior_Gravity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
@@ -1,6 +1,7 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_SizeCurve.h>
@@ -91,9 +92,6 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
 
   EZ_PROFILE_SCOPE("PFX: Size Curve");
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezFloat16> itSize(m_pStreamSize, uiNumElements, 0);
-
   ezResourceLock<ezCurve1DResource> pCurve(m_hCurve, ezResourceAcquireMode::BlockTillLoaded);
 
   if (pCurve.GetAcquireResult() == ezResourceAcquireResult::MissingFallback)
@@ -108,40 +106,36 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
   curve.QueryExtents(fMinX, fMaxX);
 
   // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
-
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+  const ezUInt64 uiFirstToUpdate = m_uiFirstToUpdate;
+  const ezUInt64 uiUpdateInterval = m_uiCurrentUpdateInterval;
 
-  while (!itLifeTime.HasReachedEnd())
-  {
-    // if (itLifeTime.Current().y > 0)
-    {
-      const float fLifeTimeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
-
-      const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
-      double val = curve.Evaluate(evalPos);
-      val = curve.NormalizeValue(val);
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
 
-      itSize.Current() = m_fBaseSize + (float)val * m_fCurveScale;
-    }
-
-    // skip the next n items
-    // this is to reduce the number of particles that need to be fully evaluated,
-    // since sampling the curve is expensive
-    for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
+  ProcessInRanges(uiNumElements, [this, &curve, uiFirstToUpdate, uiUpdateInterval](ezUInt64 uiStartIndex, ezUInt64 uiCount)
     {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
-  }
+      const ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<ezFloat16Vec2>();
+      ezFloat16* pSize = m_pStreamSize->GetWritableData<ezFloat16>();
+
+      // the first particle in this range that is due for an update
+      ezUInt64 uiIndex = ezProcessingStreamKernels::GetFirstStridedIndex(uiFirstToUpdate, uiUpdateInterval, uiStartIndex);
+
+      // only every n-th particle is updated
+      // this is to reduce the number of particles that need to be fully evaluated,
+      // since sampling the curve is expensive
+      for (const ezUInt64 uiEndIndex = uiStartIndex + uiCount; uiIndex < uiEndIndex; uiIndex += uiUpdateInterval)
+      {
+        const float fLifeTimeFraction = 1.0f - (pLifeTime[uiIndex].x * pLifeTime[uiIndex].y);
+
+        const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
+        double val = curve.Evaluate(evalPos);
+        val = curve.NormalizeValue(val);
+
+        pSize[uiIndex] = m_fBaseSize + (float)val * m_fCurveScale;
+      }
+    },
+    "PFX: Size Curve");
 }
 
 
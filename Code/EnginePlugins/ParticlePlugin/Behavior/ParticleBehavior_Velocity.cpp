@@ -3,7 +3,7 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/Interfaces/WindWorldModule.h>
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
@@ -108,44 +108,40 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: Velocity");
 
-  auto pOwner = GetOwnerEffect();
-
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 vDown = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity().GetNormalized() : ezVec3(0.0f, 0.0f, -1.0f);
-  const ezSimdVec4f vRise = ezSimdConversion::ToVec3(vDown * tDiff * -m_fRiseSpeed);
+  const ezVec3 vRise3 = vDown * tDiff * -m_fRiseSpeed;
 
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
   const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+  const float fWindFactor = m_fWindInfluence * tDiff;
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-  if (m_fWindInfluence > 0)
-  {
-    const ezSimdFloat fWindFactor = m_fWindInfluence * tDiff;
-
-    while (!itPosition.HasReachedEnd())
-    {
-      ezSimdVec4f addPos = vRise + pOwner->GetWindAt(itPosition.Current()) * fWindFactor;
-
-      itPosition.Current() += addPos;
-      itVelocity.Current() *= fFrictionFactor;
-
-      itPosition.Advance();
-      itVelocity.Advance();
-    }
-  }
-  else
-  {
-    while (!itPosition.HasReachedEnd())
+  ProcessInRanges(uiNumElements, [this, vRise3, fFrictionFactor, fWindFactor](ezUInt64 uiStartIndex, ezUInt64 uiCount)
     {
-      itPosition.Current() += vRise;
-      itVelocity.Current() *= fFrictionFactor;
-
-      itPosition.Advance();
-      itVelocity.Advance();
-    }
-  }
+      const ezSimdVec4f vRise = ezSimdConversion::ToVec3(vRise3);
+
+      ezSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<ezSimdVec4f>() + uiStartIndex;
+
+      if (fWindFactor > 0)
+      {
+        const ezParticleEffectInstance* pOwner = GetOwnerEffect();
+
+        for (ezUInt64 i = 0; i < uiCount; ++i)
+        {
+          pPosition[i] += vRise + pOwner->GetWindAt(pPosition[i]) * fWindFactor;
+        }
+      }
+      else
+      {
+        for (ezUInt64 i = 0; i < uiCount; ++i)
+        {
+          pPosition[i] += vRise;
+        }
+      }
+
+      ezProcessingStreamKernels::ScaleFloat3(m_pStreamVelocity->GetWritableData<ezVec3>() + uiStartIndex, uiCount, fFrictionFactor);
+    },
+    "PFX: Velocity");
 }
 
 void ezParticleBehavior_Velocity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
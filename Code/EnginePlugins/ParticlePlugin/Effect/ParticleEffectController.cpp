@@ -1,8 +1,45 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
+#include <Core/Graphics/Camera.h>
 #include <ParticlePlugin/Components/ParticleFinisherComponent.h>
 #include <ParticlePlugin/Effect/ParticleEffectController.h>
 #include <ParticlePlugin/WorldModule/ParticleWorldModule.h>
+#include <RendererCore/Pipeline/View.h>
+
+namespace
+{
+  /// Returns which fraction of the view height the bounding sphere of the effect covers.
+  float ComputeScreenSize(const ezParticleEffectInstance* pEffect, const ezView* pView, const ezTransform& systemTransform)
+  {
+    if (pView == nullptr)
+      return 1.0f;
+
+    const ezCamera* pCamera = pView->GetCullingCamera();
+    const ezRectFloat& viewport = pView->GetViewport();
+
+    if (viewport.height <= 0.0f)
+      return 1.0f;
+
+    ezBoundingBoxSphere bounds;
+    pEffect->GetBoundingVolume(bounds);
+    bounds.Transform(systemTransform.GetAsMat4());
+
+    const float fAspectRatio = viewport.width / viewport.height;
+
+    if (pCamera->IsOrthographic())
+      return 2.0f * bounds.m_fSphereRadius / pCamera->GetDimensionY(fAspectRatio);
+
+    if (!pCamera->IsPerspective())
+      return 1.0f;
+
+    const float fDistance = (bounds.m_vCenter - pCamera->GetCenterPosition()).GetLength();
+
+    if (fDistance <= bounds.m_fSphereRadius)
+      return 1.0f;
+
+    return bounds.m_fSphereRadius / (fDistance * ezMath::Tan(pCamera->GetFovY(fAspectRatio) * 0.5f));
+  }
+} // namespace
 
 ezParticleEffectController::ezParticleEffectController()
 {
@@ -106,7 +143,7 @@ void ezParticleEffectController::ExtractRenderData(ezMsgExtractRenderData& ref_m
 {
   if (const ezParticleEffectInstance* pEffect = GetInstance())
   {
-    pEffect->SetIsVisible();
+    pEffect->SetIsVisible(ComputeScreenSize(pEffect, ref_msg.m_pView, systemTransform));
 
     m_pModule->ExtractEffectRenderData(pEffect, ref_msg, systemTransform);
   }
@@ -157,6 +194,16 @@ ezUInt64 ezParticleEffectController::GetNumActiveParticles() const
   return 0;
 }
 
+ezTime ezParticleEffectController::GetTotalEffectLifeTime() const
+{
+  if (ezParticleEffectInstance* pEffect = GetInstance())
+  {
+    return pEffect->GetTotalEffectLifeTime();
+  }
+
+  return ezTime::MakeZero();
+}
+
 void ezParticleEffectController::SetParameter(const ezTempHashedString& sName, float value)
 {
   ezParticleEffectInstance* pEffect = GetInstance();
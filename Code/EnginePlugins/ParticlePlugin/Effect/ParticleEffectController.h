@@ -43,6 +43,9 @@ public:
 
   ezUInt64 GetNumActiveParticles() const;
 
+  /// \brief Returns how much time the effect has simulated so far, see ezParticleEffectInstance::GetTotalEffectLifeTime().
+  ezTime GetTotalEffectLifeTime() const;
+
   /// \name Effect Parameters
   ///@{
 public:
@@ -18,6 +18,8 @@
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 
+ezCVarFloat cvar_ParticlesLodScreenSize("Particles.LodScreenSize", 0.05f, ezCVarFlags::Default, "Visible effects that cover less than this fraction of the view height are simulated with larger time steps. Zero disables this.");
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool cvar_ParticlesDebugWindSamples("Particles.DebugWindSamples", false, ezCVarFlags::Default, "Enables debug visualization for wind sampling on particle effects.");
 #endif
@@ -48,7 +50,11 @@ void ezParticleEffectInstance::Construct(ezParticleEffectHandle hEffectHandle, c
   m_bIsFinishing = false;
   m_BoundingVolume = ezBoundingBoxSphere::MakeInvalid();
   m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
+  m_UpdateCostEstimate = ezTime::MakeZero();
+  m_bSimulatedThisFrame = false;
   m_EffectIsVisible = ezTime::MakeZero();
+  m_iMaxScreenSize = 0;
+  m_fSignificance = 1.0f;
   m_iMinSimStepsToDo = 4;
   m_Transform.SetIdentity();
   m_TransformForNextFrame.SetIdentity();
@@ -221,8 +227,11 @@ void ezParticleEffectInstance::PreSimulate()
   }
 }
 
-void ezParticleEffectInstance::SetIsVisible() const
+void ezParticleEffectInstance::SetIsVisible(float fScreenSize) const
 {
+  // extraction may run for multiple views in parallel
+  m_iMaxScreenSize.Max(ezMath::Max(static_cast<ezInt32>(ezMath::Min(fScreenSize, 1.0f) * 10000.0f), 1));
+
   // if it is visible this frame, also render it the next few frames
   // this has multiple purposes:
   // 1) it fixes the transition when handing off an effect from a
@@ -252,6 +261,43 @@ bool ezParticleEffectInstance::IsVisible() const
   return m_EffectIsVisible >= ezClock::GetGlobalClock()->GetAccumulatedTime();
 }
 
+void ezParticleEffectInstance::UpdateSignificance()
+{
+  const ezInt32 iMaxScreenSize = m_iMaxScreenSize.Set(0);
+
+  if (!IsVisible())
+  {
+    m_fSignificance = 0.0f;
+  }
+  else if (m_pVisibleIf != nullptr)
+  {
+    m_fSignificance = m_pVisibleIf->m_fSignificance;
+  }
+  else if (iMaxScreenSize > 0)
+  {
+    m_fSignificance = iMaxScreenSize / 10000.0f;
+  }
+
+  // otherwise the effect was not extracted since the last update, but is still considered visible for a short while (see SetIsVisible()),
+  // so just keep the previous value
+}
+
+ezTime ezParticleEffectInstance::GetLodTimeStep() const
+{
+  const float fFullRateScreenSize = cvar_ParticlesLodScreenSize;
+
+  if (m_fSignificance >= fFullRateScreenSize)
+    return ezTime::MakeZero();
+
+  if (m_fSignificance >= fFullRateScreenSize * 0.5f)
+    return ezTime::MakeFromSeconds(1.0 / 30.0);
+
+  if (m_fSignificance >= fFullRateScreenSize * 0.25f)
+    return ezTime::MakeFromMilliseconds(50);
+
+  return ezTime::MakeFromMilliseconds(100);
+}
+
 void ezParticleEffectInstance::Reconfigure(bool bFirstTime, ezArrayPtr<ezParticleEffectFloatParam> floatParams, ezArrayPtr<ezParticleEffectColorParam> colorParams)
 {
   if (!m_hResource.IsValid())
@@ -468,6 +514,11 @@ bool ezParticleEffectInstance::Update(const ezTime& diff)
         return false;
     }
   }
+  else if (m_iMinSimStepsToDo == 0)
+  {
+    // visible, but small effects get fewer, larger time steps
+    tMinStep = GetLodTimeStep();
+  }
 
   m_ElapsedTimeSinceUpdate += diff;
   PassTransformToSystems();
@@ -754,6 +805,22 @@ void ezParticleEffectInstance::RemoveSharedInstance(const void* pSharedInstanceO
   m_SharedInstances.Remove(pSharedInstanceOwner);
 }
 
+float ezParticleEffectInstance::GetUpdatePriority(const ezTime& diff) const
+{
+  // effects that are still starting up can't be delayed
+  if (m_iMinSimStepsToDo > 0 || m_PreSimulateDuration.GetSeconds() > 0.0)
+    return ezMath::MaxValue<float>();
+
+  // the longer an effect has been deferred, the more urgent it gets, so even invisible effects get an update eventually
+  return (m_fSignificance + 0.001f) * (float)(m_ElapsedTimeSinceUpdate + diff).GetSeconds();
+}
+
+void ezParticleEffectInstance::DeferUpdate(const ezTime& diff)
+{
+  // don't accumulate an arbitrary amount of time that then would have to be simulated at once
+  m_ElapsedTimeSinceUpdate = ezMath::Min(m_ElapsedTimeSinceUpdate + diff, ezTime::MakeFromSeconds(1.0));
+}
+
 bool ezParticleEffectInstance::ShouldBeUpdated() const
 {
   if (m_hEffectHandle.IsInvalidated())
@@ -855,9 +922,24 @@ void ezParticleEffectUpdateTask::Execute()
 
   if (m_UpdateDiff.GetSeconds() != 0.0)
   {
+    const ezTime tStart = ezTime::Now();
+    const ezTime tLifeTime = m_pEffect->m_TotalEffectLifeTime;
+
     m_pEffect->PreSimulate();
 
-    if (!m_pEffect->Update(m_UpdateDiff))
+    const bool bAlive = m_pEffect->Update(m_UpdateDiff);
+
+    m_pEffect->m_bSimulatedThisFrame = m_pEffect->m_TotalEffectLifeTime != tLifeTime;
+
+    // an update that only accumulates time for a larger LOD time step is nearly free and says nothing about the cost of the next step
+    if (m_pEffect->m_bSimulatedThisFrame)
+    {
+      const ezTime tDuration = ezTime::Now() - tStart;
+      const ezTime tEstimate = m_pEffect->m_UpdateCostEstimate;
+      m_pEffect->m_UpdateCostEstimate = tEstimate.IsZero() ? tDuration : tEstimate + (tDuration - tEstimate) * 0.25;
+    }
+
+    if (!bAlive)
     {
       const ezParticleEffectHandle hEffect = m_pEffect->GetHandle();
       EZ_ASSERT_DEBUG(!hEffect.IsInvalidated(), "Invalid particle effect handle");
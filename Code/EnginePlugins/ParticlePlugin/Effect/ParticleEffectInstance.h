@@ -133,6 +133,13 @@ private: // friend ezParticleWorldModule
   /// \brief Returns the task that is used to update the effect
   const ezSharedPtr<ezTask>& GetUpdateTask() { return m_pTask; }
 
+  /// \brief How urgently this effect should be updated when not all effects fit into the update budget. Higher values are more urgent.
+  float GetUpdatePriority(const ezTime& diff) const;
+
+  /// \brief Called instead of Update() when the effect was skipped to stay within the update budget.
+  /// The time is simulated during the next update, so the effect continues with a larger time step.
+  void DeferUpdate(const ezTime& diff);
+
 private: // friend ezParticleEffectUpdateTask
   friend class ezParticleEffectController;
   /// \brief If the effect wants to skip all the initial behavior, this simulates it multiple times before it is shown the first time.
@@ -144,6 +151,8 @@ private: // friend ezParticleEffectUpdateTask
 private:
   ezTime m_TotalEffectLifeTime = ezTime::MakeZero();
   ezTime m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
+  ezTime m_UpdateCostEstimate = ezTime::MakeZero(); ///< Smoothed duration of the updates that stepped the simulation, the estimated cost of the next one.
+  bool m_bSimulatedThisFrame = false;               ///< Whether the last update task actually stepped the simulation.
 
 
   /// @}
@@ -166,13 +175,19 @@ private:
 public:
   /// \brief Marks this effect as visible from at least one view.
   /// This affects simulation update rates.
-  void SetIsVisible() const;
+  ///
+  /// \a fScreenSize is the fraction of the view height that the effect covers. Small effects are simulated with larger time steps,
+  /// see the CVar 'Particles.LodScreenSize'. The largest value across all views is used.
+  void SetIsVisible(float fScreenSize = 1.0f) const;
 
   void SetVisibleIf(ezParticleEffectInstance* pOtherVisible);
 
   /// \brief Whether the effect has been marked as visible recently.
   bool IsVisible() const;
 
+  /// \brief Returns the screen size of the effect, as determined at the start of the last update. Zero when the effect is not visible.
+  float GetSignificance() const { return m_fSignificance; }
+
   /// \brief Returns the bounding volume of the effect.
   /// The volume is in the local space of the effect.
   void GetBoundingVolume(ezBoundingBoxSphere& ref_volume) const;
@@ -180,8 +195,16 @@ public:
 private:
   void CombineSystemBoundingVolumes();
 
+  /// \brief Computes the significance from the screen sizes that were passed to SetIsVisible() since the last call.
+  void UpdateSignificance();
+
+  /// \brief The minimum time step that a visible effect is simulated with, depending on its significance.
+  ezTime GetLodTimeStep() const;
+
   ezBoundingBoxSphere m_BoundingVolume;
   mutable ezTime m_EffectIsVisible;
+  mutable ezAtomicInteger32 m_iMaxScreenSize; // in 1/10000 of the view height
+  float m_fSignificance = 1.0f;
   ezParticleEffectInstance* m_pVisibleIf = nullptr;
   ezEnum<ezEffectInvisibleUpdateRate> m_InvisibleUpdateRate;
   ezUInt64 m_uiRandomSeed = 0;
@@ -1,7 +1,7 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Math/Declarations.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
@@ -46,18 +46,9 @@ void ezParticleFinalizer_ApplyVelocity::Process(ezUInt64 uiNumElements)
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-  while (!itPosition.HasReachedEnd())
-  {
-    ezVec3& pos = reinterpret_cast<ezVec3&>(itPosition.Current());
-
-    pos += itVelocity.Current() * tDiff;
-
-    itPosition.Advance();
-    itVelocity.Advance();
-  }
+  ProcessInRanges(uiNumElements, [this, tDiff](ezUInt64 uiStartIndex, ezUInt64 uiCount)
+    { ezProcessingStreamKernels::MulAddFloat3ToFloat4(m_pStreamPosition->GetWritableData<ezSimdVec4f>() + uiStartIndex, m_pStreamVelocity->GetData<ezVec3>() + uiStartIndex, uiCount, tDiff); },
+    "PFX: ApplyVelocity");
 }
 
 
@@ -1,10 +1,15 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
 #include <ParticlePlugin/Resources/ParticleEffectResource.h>
 #include <ParticlePlugin/WorldModule/ParticleWorldModule.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 
+ezCVarFloat cvar_ParticlesUpdateBudget("Particles.UpdateBudget", 0.0f, ezCVarFlags::Default, "Maximum time in milliseconds that particle effect updates may take per frame and world. Zero disables the budget.");
+
 ezParticleEffectHandle ezParticleWorldModule::InternalCreateEffectInstance(const ezParticleEffectResourceHandle& hResource, ezUInt64 uiRandomSeed,
   bool bIsShared, ezArrayPtr<ezParticleEffectFloatParam> floatParams, ezArrayPtr<ezParticleEffectColorParam> colorParams)
 {
@@ -140,14 +145,31 @@ void ezParticleWorldModule::UpdateEffects(const ezWorldModule::UpdateContext& co
   m_EffectUpdateTaskGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::LateThisFrame);
 
   const ezTime tDiff = GetWorld()->GetClock().GetTimeDiff();
+
+  m_EffectsToUpdate.Clear();
   for (ezUInt32 i = 0; i < m_ParticleEffects.GetCount(); ++i)
   {
-    if (!m_ParticleEffects[i].ShouldBeUpdated())
+    ezParticleEffectInstance& effect = m_ParticleEffects[i];
+    effect.m_bSimulatedThisFrame = false;
+
+    if (!effect.ShouldBeUpdated())
       continue;
 
-    m_ParticleEffects[i].ProcessEventQueues();
+    effect.ProcessEventQueues();
+    effect.UpdateSignificance();
 
-    const ezSharedPtr<ezTask>& pTask = m_ParticleEffects[i].GetUpdateTask();
+    m_EffectsToUpdate.PushBack(&effect);
+  }
+
+  const ezTime tBudget = ezTime::MakeFromMilliseconds(cvar_ParticlesUpdateBudget);
+  if (tBudget.IsPositive())
+  {
+    ApplyUpdateBudget(tBudget, tDiff);
+  }
+
+  for (ezParticleEffectInstance* pEffect : m_EffectsToUpdate)
+  {
+    const ezSharedPtr<ezTask>& pTask = pEffect->GetUpdateTask();
     static_cast<ezParticleEffectUpdateTask*>(pTask.Borrow())->m_UpdateDiff = tDiff;
 
     ezTaskSystem::AddTaskToGroup(m_EffectUpdateTaskGroup, pTask);
@@ -156,6 +178,77 @@ void ezParticleWorldModule::UpdateEffects(const ezWorldModule::UpdateContext& co
   ezTaskSystem::StartTaskGroup(m_EffectUpdateTaskGroup);
 }
 
+void ezParticleWorldModule::ApplyUpdateBudget(ezTime budget, ezTime diff)
+{
+  EZ_PROFILE_SCOPE("PFX: Update Budget");
+
+  m_EffectsToUpdate.Sort([diff](const ezParticleEffectInstance* a, const ezParticleEffectInstance* b)
+    { return a->GetUpdatePriority(diff) > b->GetUpdatePriority(diff); });
+
+  // the estimate is the sum of the smoothed update costs, independent of how many threads end up running the updates
+  ezTime tEstimatedCost = ezTime::MakeZero();
+  ezUInt32 uiNumToUpdate = 0;
+
+  for (; uiNumToUpdate < m_EffectsToUpdate.GetCount(); ++uiNumToUpdate)
+  {
+    const ezParticleEffectInstance* pEffect = m_EffectsToUpdate[uiNumToUpdate];
+
+    tEstimatedCost += pEffect->m_UpdateCostEstimate;
+
+    // always update at least one effect and never defer effects that still need to start up
+    if (tEstimatedCost > budget && uiNumToUpdate > 0 && pEffect->GetUpdatePriority(diff) != ezMath::MaxValue<float>())
+      break;
+  }
+
+  for (ezUInt32 i = uiNumToUpdate; i < m_EffectsToUpdate.GetCount(); ++i)
+  {
+    m_EffectsToUpdate[i]->DeferUpdate(diff);
+  }
+
+  m_EffectsToUpdate.SetCount(uiNumToUpdate);
+}
+
+void ezParticleWorldModule::UpdateStats() const
+{
+  ezUInt32 uiSimulatedEffects = 0;
+  ezUInt32 uiSkippedEffects = 0;
+  ezUInt64 uiSimulatedParticles = 0;
+  ezUInt64 uiSkippedParticles = 0;
+
+  for (ezUInt32 i = 0; i < m_ParticleEffects.GetCount(); ++i)
+  {
+    const ezParticleEffectInstance& effect = m_ParticleEffects[i];
+
+    if (effect.GetHandle().IsInvalidated())
+      continue;
+
+    if (effect.m_bSimulatedThisFrame)
+    {
+      ++uiSimulatedEffects;
+      uiSimulatedParticles += effect.GetNumActiveParticles();
+    }
+    else
+    {
+      ++uiSkippedEffects;
+      uiSkippedParticles += effect.GetNumActiveParticles();
+    }
+  }
+
+  ezStringBuilder sStatName;
+
+  sStatName.SetFormat("Particles/{0}/Simulated Effects", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, uiSimulatedEffects);
+
+  sStatName.SetFormat("Particles/{0}/Skipped Effects", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, uiSkippedEffects);
+
+  sStatName.SetFormat("Particles/{0}/Simulated Particles", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, uiSimulatedParticles);
+
+  sStatName.SetFormat("Particles/{0}/Skipped Particles", GetWorld()->GetName());
+  ezStats::SetStat(sStatName, uiSkippedParticles);
+}
+
 void ezParticleWorldModule::DestroyFinishedEffects()
 {
   EZ_LOCK(m_Mutex);
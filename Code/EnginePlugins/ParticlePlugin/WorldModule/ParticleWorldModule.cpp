@@ -83,6 +83,8 @@ void ezParticleWorldModule::EnsureUpdatesFinished(const ezWorldModule::UpdateCon
   {
     EZ_LOCK(m_Mutex);
 
+    UpdateStats();
+
     // The simulation tasks are done and the game objects have their global transform updated at this point, so we can push the transform
     // to the particle effects for the next simulation step and also ensure that the bounding volumes are correct for culling and rendering.
     if (ezParticleComponentManager* pManager = GetWorld()->GetComponentManager<ezParticleComponentManager>())
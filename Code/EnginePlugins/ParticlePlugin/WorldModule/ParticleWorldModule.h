@@ -20,6 +20,11 @@ class ezParticleStreamFactory;
 /// When an effect is stopped, it only stops emitting new particles, but it lives on until all particles are dead.
 /// Therefore particle effects need to be managed outside of components. When a component dies, it only tells the
 /// world module to 'destroy' it's effect, the rest is handled behind the scenes.
+///
+/// Effects are updated with a rate that depends on their significance, i.e. whether and how large they were visible in the last frame.
+/// Additionally the CVar 'Particles.UpdateBudget' limits how much time may be spent on particle simulation per frame. When the
+/// estimated cost of all updates exceeds it, the least significant effects are deferred to a later frame.
+/// The number of simulated and skipped effects and particles is published through ezStats under 'Particles/<world name>/'.
 class EZ_PARTICLEPLUGIN_DLL ezParticleWorldModule final : public ezWorldModule
 {
   EZ_DECLARE_WORLD_MODULE();
@@ -67,6 +72,8 @@ private:
 
   void UpdateEffects(const ezWorldModule::UpdateContext& context);
   void EnsureUpdatesFinished(const ezWorldModule::UpdateContext& context);
+  void ApplyUpdateBudget(ezTime budget, ezTime diff);
+  void UpdateStats() const;
 
   void DestroyFinishedEffects();
   void CreateFinisherComponent(ezParticleEffectInstance* pEffect);
@@ -84,6 +91,7 @@ private:
   ezDynamicArray<ezParticleEffectInstance*> m_NeedFinisherComponent;
   ezDynamicArray<ezParticleEffectInstance*> m_EffectsToReconfigure;
   ezDynamicArray<ezParticleEffectInstance*> m_ParticleEffectsFreeList;
+  ezDynamicArray<ezParticleEffectInstance*> m_EffectsToUpdate;
   ezMap<ezString, ezParticleEffectHandle> m_SharedEffects;
   ezIdTable<ezParticleEffectId, ezParticleEffectInstance*> m_ActiveEffects;
   ezDeque<ezParticleSystemInstance> m_ParticleSystems;
@@ -301,6 +301,10 @@ public:
     if (ext.IsEqual_NoCase("dds"))
       return ezArchiveBuilder::InclusionMode::Compress_zstd_fast;
 
+    // audio banks are streamed from, so they need to support random access
+    if (ext.IsEqual_NoCase("bank"))
+      return ezArchiveBuilder::InclusionMode::Compress_zstd_blocks;
+
     return ezArchiveBuilder::InclusionMode::Compress_zstd_average;
   }
 
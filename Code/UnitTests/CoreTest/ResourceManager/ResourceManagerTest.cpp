@@ -2,6 +2,7 @@
 
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Foundation/Types/ScopeExit.h>
+#include <Foundation/Utilities/Stats.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
 
@@ -126,6 +127,71 @@ namespace
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestResource, 1, ezRTTIDefaultAllocator<TestResource>)
   EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+  struct TestQualityResourceDescriptor
+  {
+    ezUInt8 m_uiNumQualityLevels = 0;
+  };
+
+  using TestQualityResourceHandle = ezTypedResourceHandle<class TestQualityResource>;
+
+  /// Every quality level uses the same amount of memory. The lowest quality level cannot be discarded and nothing can be loaded again.
+  class TestQualityResource : public ezResource
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(TestQualityResource, ezResource);
+    EZ_RESOURCE_DECLARE_COMMON_CODE(TestQualityResource);
+    EZ_RESOURCE_DECLARE_CREATEABLE(TestQualityResource, TestQualityResourceDescriptor);
+
+  public:
+    static constexpr ezUInt64 MemoryPerQualityLevel = 1000;
+
+    TestQualityResource()
+      : ezResource(ezResource::DoUpdate::OnAnyThread, 1)
+    {
+    }
+
+  protected:
+    virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override
+    {
+      if (WhatToUnload == Unload::OneQualityLevel && m_uiNumQualityLevels > 1)
+        --m_uiNumQualityLevels;
+      else
+        m_uiNumQualityLevels = 0;
+
+      return GetLoadDesc();
+    }
+
+    virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override { return GetLoadDesc(); }
+
+    virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override
+    {
+      out_NewMemoryUsage.m_uiMemoryCPU = m_uiNumQualityLevels * MemoryPerQualityLevel;
+      out_NewMemoryUsage.m_uiMemoryGPU = 0;
+    }
+
+  private:
+    ezResourceLoadDesc GetLoadDesc() const
+    {
+      ezResourceLoadDesc ld;
+      ld.m_State = m_uiNumQualityLevels > 0 ? ezResourceState::Loaded : ezResourceState::Unloaded;
+      ld.m_uiQualityLevelsDiscardable = m_uiNumQualityLevels > 0 ? m_uiNumQualityLevels - 1 : 0;
+      ld.m_uiQualityLevelsLoadable = 0;
+
+      return ld;
+    }
+
+    ezUInt8 m_uiNumQualityLevels = 0;
+  };
+
+  EZ_RESOURCE_IMPLEMENT_COMMON_CODE(TestQualityResource);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestQualityResource, 1, ezRTTIDefaultAllocator<TestQualityResource>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  EZ_RESOURCE_IMPLEMENT_CREATEABLE(TestQualityResource, TestQualityResourceDescriptor)
+  {
+    m_uiNumQualityLevels = descriptor.m_uiNumQualityLevels;
+    return GetLoadDesc();
+  }
+
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
@@ -171,6 +237,17 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
 
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumResources);
 
+    // every loaded resource contributes to the loading statistics
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+    }
+
+    ezResourceManager::PerFrameUpdate();
+    EZ_TEST_INT(ezStats::GetStat("Resource Manager/Loading/Queue Depth").ConvertTo<ezUInt32>(), 0);
+    EZ_TEST_BOOL(ezStats::GetStat("Resource Manager/Loading/Loaded Resources").ConvertTo<ezUInt32>() >= uiNumResources);
+    EZ_TEST_BOOL(ezStats::GetStat("Resource Manager/Loading/Time To Load P50 (ms)").ConvertTo<double>() <= ezStats::GetStat("Resource Manager/Loading/Time To Load P99 (ms)").ConvertTo<double>());
+
     hResources.Clear();
 
     ezUInt32 uiUnloaded = 0;
@@ -190,6 +267,142 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
   }
 }
 
+EZ_CREATE_SIMPLE_TEST(ResourceManager, MemoryBudget)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+  EZ_SCOPE_EXIT(ezResourceManager::SetMemoryBudgetForResourceType<TestResource>(0, 0));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "EnforceMemoryBudgets")
+  {
+    const ezUInt32 uiNumResources = 100;
+    const ezUInt32 uiNumReferenced = 5;
+
+    ezDynamicArray<TestResourceHandle> hResources;
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.SetFormat("Budget-{}", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+
+      ezResourceLock<TestResource> pTestResource(hResources.PeekBack(), ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_TEST_BOOL(pTestResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+    }
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+    }
+
+    // only keep a few of them referenced, those must not be freed
+    hResources.SetCount(uiNumReferenced);
+
+    // no budget -> nothing happens
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 0);
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumResources);
+
+    ezResourceManager::SetMemoryBudgetForResourceType<TestResource>(sizeof(TestResource) * 20, 0);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), uiNumResources - 20);
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 20);
+
+    // the referenced resources cannot be freed and have no quality levels to discard, so the budget cannot be met
+    ezResourceManager::SetMemoryBudgetForResourceType<TestResource>(sizeof(TestResource), 0);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 20 - uiNumReferenced);
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumReferenced);
+
+    for (ezUInt32 i = 0; i < uiNumReferenced; ++i)
+    {
+      EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hResources[i]) == ezResourceState::Loaded);
+    }
+
+    hResources.Clear();
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Demote least recently used")
+  {
+    EZ_SCOPE_EXIT(ezResourceManager::SetMemoryBudgetForResourceType<TestQualityResource>(0, 0));
+
+    constexpr ezUInt32 uiNumResources = 6;
+    constexpr ezUInt64 uiFullMemory = uiNumResources * 3 * TestQualityResource::MemoryPerQualityLevel;
+
+    ezDynamicArray<TestQualityResourceHandle> hResources;
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      TestQualityResourceDescriptor desc;
+      desc.m_uiNumQualityLevels = 3;
+
+      sResourceID.SetFormat("Demote-{}", i);
+      hResources.PushBack(ezResourceManager::CreateResource<TestQualityResource>(sResourceID, std::move(desc)));
+    }
+
+    // the acquire time is the time of the last frame update, so every resource is acquired in its own frame, starting with the first one
+    auto AcquireInNewFrame = [&](ezUInt32 uiIndex)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(2));
+      ezResourceManager::PerFrameUpdate();
+
+      ezResourceLock<TestQualityResource> pResource(hResources[uiIndex], ezResourceAcquireMode::BlockTillLoaded);
+    };
+
+    auto GetNumDiscardable = [&](ezUInt32 uiIndex) -> ezUInt32
+    {
+      ezResourceLock<TestQualityResource> pResource(hResources[uiIndex], ezResourceAcquireMode::PointerOnly);
+      return pResource->GetNumQualityLevelsDiscardable();
+    };
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      AcquireInNewFrame(i);
+    }
+
+    // recently used resources are not demoted, even when over budget
+    ezResourceManager::SetMemoryBudgetForResourceType<TestQualityResource>(uiFullMemory - 2500, 0);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeFromHours(1)), 0);
+
+    // one quality level at a time in least recently used order, until the budget is met
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 3);
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      EZ_TEST_INT(GetNumDiscardable(i), i < 3 ? 1 : 2);
+    }
+
+    // using a resource again moves it to the end of the order
+    AcquireInNewFrame(0);
+
+    ezResourceManager::SetMemoryBudgetForResourceType<TestQualityResource>(uiFullMemory - 5000, 0);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 2);
+
+    const ezUInt32 expectedDiscardable[uiNumResources] = {1, 0, 0, 2, 2, 2};
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      EZ_TEST_INT(GetNumDiscardable(i), expectedDiscardable[i]);
+    }
+
+    // every call demotes a resource by one quality level at most and the lowest quality level is never discarded from referenced resources
+    ezResourceManager::SetMemoryBudgetForResourceType<TestQualityResource>(1, 0);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 4);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 3);
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(ezTime::MakeFromSeconds(10), ezTime::MakeZero()), 0);
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      EZ_TEST_INT(GetNumDiscardable(i), 0);
+      EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hResources[i]) == ezResourceState::Loaded);
+    }
+
+    hResources.Clear();
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestQualityResource>()->GetCount(), 0);
+  }
+}
+
 EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
 {
   TestResourceTypeLoader TypeLoader;
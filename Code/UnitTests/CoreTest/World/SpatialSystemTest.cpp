@@ -1,6 +1,7 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
 #include <Core/World/World.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
@@ -58,10 +59,11 @@ namespace
   // clang-format on
 } // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+static void TestSpatialSystem(ezUniquePtr<ezSpatialSystem>&& pSpatialSystem)
 {
   ezWorldDesc worldDesc("Test");
   worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  worldDesc.m_pSpatialSystem = std::move(pSpatialSystem);
 
   ezWorld world(worldDesc);
   EZ_LOCK(world.GetWriteMarker());
@@ -281,6 +283,44 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Moving dynamic objects")
+  {
+    for (ezGameObject* pObject : objects)
+    {
+      if (pObject->IsDynamic())
+      {
+        pObject->SetLocalPosition(pObject->GetLocalPosition() + ezVec3(2000.0f, 0.0f, 0.0f));
+      }
+    }
+
+    world.Update();
+
+    ezSpatialSystem::QueryParams dynamicQueryParams;
+    dynamicQueryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    ezBoundingSphere testSphere = ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(2100.0f, 60.0f, 400.0f), 3000.0f);
+
+    ezDynamicArray<ezGameObject*> objectsInSphere;
+    ezHashSet<ezGameObject*> uniqueObjects;
+    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, dynamicQueryParams, objectsInSphere);
+
+    for (auto pObject : objectsInSphere)
+    {
+      EZ_TEST_BOOL(testSphere.Overlaps(pObject->GetGlobalBounds().GetSphere()));
+      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      EZ_TEST_BOOL(pObject->IsDynamic());
+    }
+
+    // Check for missing objects
+    for (ezGameObject* pObject : objects)
+    {
+      if (pObject->IsDynamic() && testSphere.Overlaps(pObject->GetGlobalBounds().GetSphere()))
+      {
+        EZ_TEST_BOOL(uniqueObjects.Contains(pObject));
+      }
+    }
+  }
+
   if (false)
   {
     ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
@@ -319,3 +359,15 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     world.Update();
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  // default spatial system
+  TestSpatialSystem(nullptr);
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem_LooseOctree)
+{
+  // small root and node sizes to also cover objects outside of the root cell and deeper trees
+  TestSpatialSystem(EZ_DEFAULT_NEW(ezSpatialSystem_LooseOctree, 4096.0f, 8.0f));
+}
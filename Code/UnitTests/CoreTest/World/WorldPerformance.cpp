@@ -1,8 +1,13 @@
 #include <CoreTest/CoreTestPCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdTransformStreams.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Utilities/GraphicsUtils.h>
 
 namespace
 {
@@ -114,6 +119,319 @@ namespace
     }
   }
 
+  void MeasureIdleUpdateTime(bool bTrackTransformChanges)
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bTrackTransformChanges = bTrackTransformChanges;
+    ezWorld world(worldDesc);
+    MeasureCreationTime(true, 200, 5, 6, 0, &world);
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    // first round always has some overhead
+    world.Update();
+
+    ezDynamicArray<ezGameObject*> movingObjects;
+    ezUInt32 uiObjectIndex = 0;
+    for (auto it = world.GetObjects(); it.IsValid(); ++it, ++uiObjectIndex)
+    {
+      // move one percent of the objects every frame
+      if (uiObjectIndex % 100 == 0)
+      {
+        movingObjects.PushBack(it);
+      }
+    }
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      for (ezGameObject* pObject : movingObjects)
+      {
+        pObject->SetLocalPosition(pObject->GetLocalPosition() + ezVec3(0.1f, 0.0f, 0.0f));
+      }
+
+      world.Update();
+
+      const ezTime tDiff = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u mostly idle objects (%s): %.2fms", world.GetObjectCount(),
+        bTrackTransformChanges ? "track changes" : "full update", tDiff.GetMilliseconds());
+    }
+  }
+
+  /// Mimics the size and the relevant members of ezGameObject::TransformationData, which is not accessible here.
+  struct alignas(16) AosTransformationData
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    void* m_pObject;
+    AosTransformationData* m_pParentData;
+
+    ezSimdTransform m_localTransform;
+    ezSimdTransform m_globalTransform;
+
+    ezUInt8 m_OtherData[256 - 2 * sizeof(void*) - 2 * sizeof(ezSimdTransform)];
+  };
+
+  void MeasureTransformLayouts(ezUInt32 uiNumParents, ezUInt32 uiNumChildren, bool bShuffledParents)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezDynamicArray<ezUInt32> parentIndices;
+    parentIndices.SetCountUninitialized(uiNumChildren);
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      parentIndices[i] = bShuffledParents ? rng.UIntInRange(uiNumParents) : (ezUInt64(i) * uiNumParents) / uiNumChildren;
+    }
+
+    auto makeTransform = [&]()
+    {
+      return ezSimdTransform(ezSimdVec4f((float)rng.DoubleMinMax(-100, 100), (float)rng.DoubleMinMax(-100, 100), 0.0f, 0.0f),
+        ezSimdQuat::MakeFromAxisAndAngle(ezSimdVec4f(0, 0, 1), ezAngle::MakeFromDegree((float)rng.DoubleMinMax(-180, 180))), ezSimdVec4f(1.0f));
+    };
+
+    ezDynamicArray<AosTransformationData, ezAlignedAllocatorWrapper> aosParents;
+    ezDynamicArray<AosTransformationData, ezAlignedAllocatorWrapper> aosChildren;
+    aosParents.SetCountUninitialized(uiNumParents);
+    aosChildren.SetCountUninitialized(uiNumChildren);
+
+    ezSimdTransformStreams soaParents;
+    ezSimdTransformStreams soaLocals;
+    ezSimdTransformStreams soaGlobals;
+    soaParents.SetCount(uiNumParents);
+    soaLocals.SetCount(uiNumChildren);
+
+    for (ezUInt32 i = 0; i < uiNumParents; ++i)
+    {
+      aosParents[i].m_pParentData = nullptr;
+      aosParents[i].m_globalTransform = makeTransform();
+      soaParents.SetTransform(i, aosParents[i].m_globalTransform);
+    }
+
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      aosChildren[i].m_pParentData = &aosParents[parentIndices[i]];
+      aosChildren[i].m_localTransform = makeTransform();
+      soaLocals.SetTransform(i, aosChildren[i].m_localTransform);
+    }
+
+    ezTime tAos = ezTime::MakeFromHours(1);
+    ezTime tSoa = ezTime::MakeFromHours(1);
+
+    // take the best of a few runs, the first one always has some overhead
+    for (ezUInt32 uiRun = 0; uiRun < 5; ++uiRun)
+    {
+      ezStopwatch sw;
+
+      for (AosTransformationData& data : aosChildren)
+      {
+        data.m_globalTransform = ezSimdTransform::MakeGlobalTransform(data.m_pParentData->m_globalTransform, data.m_localTransform);
+      }
+
+      tAos = ezMath::Min(tAos, sw.Checkpoint());
+
+      ezSimdTransformStreams::MakeGlobalTransforms(soaParents, parentIndices, soaLocals, soaGlobals);
+
+      tSoa = ezMath::Min(tSoa, sw.Checkpoint());
+    }
+
+    // make sure both layouts computed the same
+    const ezUInt32 uiCheckIndex = uiNumChildren / 2;
+    EZ_TEST_BOOL(soaGlobals.GetTransform(uiCheckIndex).m_Position.IsEqual(aosChildren[uiCheckIndex].m_globalTransform.m_Position, 0.01f).AllSet<3>());
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Global transforms of %u children (%s parents): AoS %.2fms, SoA %.2fms", uiNumChildren,
+      bShuffledParents ? "shuffled" : "sorted", tAos.GetMilliseconds(), tSoa.GetMilliseconds());
+  }
+
+  struct SpatialBenchmarkScene
+  {
+    ezDynamicArray<ezSimdBBoxSphere, ezAlignedAllocatorWrapper> m_Bounds;
+    ezDynamicArray<ezSimdBBoxSphere, ezAlignedAllocatorWrapper> m_MovedBounds;
+    ezDynamicArray<ezBoundingSphere> m_QuerySpheres;
+    ezDynamicArray<ezFrustum> m_Frustums;
+  };
+
+  /// A large sparse world with clusters of mostly small objects, some medium sized ones and a few huge ones.
+  void CreateSpatialBenchmarkScene(SpatialBenchmarkScene& ref_scene)
+  {
+    constexpr ezUInt32 uiNumObjects = 100000;
+    constexpr ezUInt32 uiNumClusters = 50;
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezHybridArray<ezVec3, uiNumClusters> clusterCenters;
+    for (ezUInt32 i = 0; i < uiNumClusters; ++i)
+    {
+      clusterCenters.PushBack(ezVec3((float)rng.DoubleMinMax(-50000, 50000), (float)rng.DoubleMinMax(-50000, 50000), (float)rng.DoubleMinMax(-500, 500)));
+    }
+
+    auto randomPosition = [&](const ezVec3& vCenter, double fRange)
+    {
+      return vCenter + ezVec3((float)rng.DoubleMinMax(-fRange, fRange), (float)rng.DoubleMinMax(-fRange, fRange), (float)rng.DoubleMinMax(-fRange, fRange));
+    };
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const ezVec3 vCenter = randomPosition(clusterCenters[i % uiNumClusters], 500.0);
+
+      float fHalfExtents = (float)rng.DoubleMinMax(0.5, 4.0);
+      if (i % 1000 == 0)
+      {
+        fHalfExtents = (float)rng.DoubleMinMax(2000.0, 20000.0);
+      }
+      else if (i % 50 == 0)
+      {
+        fHalfExtents = (float)rng.DoubleMinMax(20.0, 200.0);
+      }
+
+      const ezBoundingBox box = ezBoundingBox::MakeFromCenterAndHalfExtents(vCenter, ezVec3(fHalfExtents, fHalfExtents * 0.5f, fHalfExtents));
+      ref_scene.m_Bounds.PushBack(ezSimdConversion::ToBBoxSphere(ezBoundingBoxSphere::MakeFromBox(box)));
+
+      const ezVec3 vMovedCenter = randomPosition(vCenter, 10.0);
+      const ezBoundingBox movedBox = ezBoundingBox::MakeFromCenterAndHalfExtents(vMovedCenter, ezVec3(fHalfExtents, fHalfExtents * 0.5f, fHalfExtents));
+      ref_scene.m_MovedBounds.PushBack(ezSimdConversion::ToBBoxSphere(ezBoundingBoxSphere::MakeFromBox(movedBox)));
+    }
+
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      ref_scene.m_QuerySpheres.PushBack(ezBoundingSphere::MakeFromCenterAndRadius(randomPosition(clusterCenters[i % uiNumClusters], 500.0), 100.0f));
+    }
+
+    const ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 1000.0f);
+    for (ezUInt32 i = 0; i < 200; ++i)
+    {
+      const ezVec3 vPosition = randomPosition(clusterCenters[i % uiNumClusters], 500.0);
+      const ezVec3 vTarget = vPosition + ezVec3((float)rng.DoubleMinMax(-1, 1), (float)rng.DoubleMinMax(-1, 1), 0.1f);
+      const ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(vPosition, vTarget, ezVec3::MakeAxisZ());
+
+      ref_scene.m_Frustums.PushBack(ezFrustum::MakeFromMVP(projection * lookAt));
+    }
+  }
+
+  void MeasureSpatialSystem(const char* szName, ezSpatialSystem& ref_system, const SpatialBenchmarkScene& scene, ezUInt32& out_uiNumFoundInSpheres, ezUInt32& out_uiNumVisible)
+  {
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezSpatialSystem::QueryParams queryParams;
+    queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+
+    ezDynamicArray<ezSpatialDataHandle> handles;
+    handles.Reserve(scene.m_Bounds.GetCount());
+
+    ezStopwatch sw;
+
+    for (const ezSimdBBoxSphere& bounds : scene.m_Bounds)
+    {
+      handles.PushBack(ref_system.CreateSpatialData(bounds, nullptr, uiCategoryBitmask, ezTagSet()));
+    }
+
+    const ezTime tCreate = sw.Checkpoint();
+
+    out_uiNumFoundInSpheres = 0;
+    for (const ezBoundingSphere& sphere : scene.m_QuerySpheres)
+    {
+      ref_system.FindObjectsInSphere(sphere, queryParams,
+        [&](ezGameObject*)
+        {
+          ++out_uiNumFoundInSpheres;
+          return ezVisitorExecution::Continue;
+        });
+    }
+
+    const ezTime tSpheres = sw.Checkpoint();
+
+    out_uiNumVisible = 0;
+    ezDynamicArray<const ezGameObject*> visibleObjects;
+    for (const ezFrustum& frustum : scene.m_Frustums)
+    {
+      visibleObjects.Clear();
+      ref_system.FindVisibleObjects(frustum, queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+      out_uiNumVisible += visibleObjects.GetCount();
+    }
+
+    const ezTime tFrustums = sw.Checkpoint();
+
+    ref_system.UpdateSpatialDataBoundsBatch(handles, scene.m_MovedBounds);
+
+    const ezTime tUpdate = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: creating %u objects %.2fms, %u sphere queries %.2fms (%u found), %u frustum queries %.2fms (%u visible), moving all objects %.2fms", szName,
+      scene.m_Bounds.GetCount(), tCreate.GetMilliseconds(), scene.m_QuerySpheres.GetCount(), tSpheres.GetMilliseconds(), out_uiNumFoundInSpheres,
+      scene.m_Frustums.GetCount(), tFrustums.GetMilliseconds(), out_uiNumVisible, tUpdate.GetMilliseconds());
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  /// Measures how many objects per second the query kernels test on a single thread, using a dense scene where most objects are close to the query shapes.
+  void MeasureQueryThroughput(const char* szName, ezSpatialSystem& ref_system)
+  {
+    constexpr ezUInt32 uiNumObjects = 200000;
+    constexpr ezUInt32 uiNumQueries = 100;
+
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    auto randomPosition = [&](double fRange)
+    {
+      return ezVec3((float)rng.DoubleMinMax(-fRange, fRange), (float)rng.DoubleMinMax(-fRange, fRange), (float)rng.DoubleMinMax(-fRange, fRange));
+    };
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const ezBoundingBox box = ezBoundingBox::MakeFromCenterAndHalfExtents(randomPosition(500.0), ezVec3((float)rng.DoubleMinMax(0.5, 2.0)));
+      ref_system.CreateSpatialData(ezSimdConversion::ToBBoxSphere(ezBoundingBoxSphere::MakeFromBox(box)), nullptr, uiCategoryBitmask, ezTagSet());
+    }
+
+    ezSpatialSystem::QueryStats stats;
+    ezSpatialSystem::QueryParams queryParams;
+    queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+    queryParams.m_pStats = &stats;
+
+    ezUInt64 uiNumTested[3] = {};
+    ezTime times[3];
+
+    auto countObject = [](ezGameObject*)
+    { return ezVisitorExecution::Continue; };
+
+    const ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(90.0f), 1.0f, 1.0f, 2000.0f);
+    ezDynamicArray<const ezGameObject*> visibleObjects;
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezVec3 vPosition = randomPosition(100.0);
+      const ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(vPosition, vPosition + randomPosition(1.0), ezVec3::MakeAxisZ());
+
+      ezStopwatch sw;
+
+      stats = {};
+      visibleObjects.Clear();
+      ref_system.FindVisibleObjects(ezFrustum::MakeFromMVP(projection * lookAt), queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+      times[0] += sw.Checkpoint();
+      uiNumTested[0] += stats.m_uiNumObjectsTested;
+
+      stats = {};
+      ref_system.FindObjectsInSphere(ezBoundingSphere::MakeFromCenterAndRadius(vPosition, 300.0f), queryParams, countObject);
+      times[1] += sw.Checkpoint();
+      uiNumTested[1] += stats.m_uiNumObjectsTested;
+
+      stats = {};
+      ref_system.FindObjectsInBox(ezBoundingBox::MakeFromCenterAndHalfExtents(vPosition, ezVec3(300.0f)), queryParams, countObject);
+      times[2] += sw.Checkpoint();
+      uiNumTested[2] += stats.m_uiNumObjectsTested;
+    }
+
+    auto objectsPerSecond = [&](ezUInt32 uiIndex)
+    { return (double)uiNumTested[uiIndex] / times[uiIndex].GetSeconds() / 1000000.0; };
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s (single thread): frustum %.1fM objects/s, sphere %.1fM objects/s, box %.1fM objects/s", szName,
+      objectsPerSecond(0), objectsPerSecond(1), objectsPerSecond(2));
+  }
+#endif
+
 } // namespace
 
 
@@ -267,6 +585,12 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
+  EZ_TEST_BLOCK(EnableInRelease, "Update 250,000 mostly idle dynamic objects")
+  {
+    MeasureIdleUpdateTime(false);
+    MeasureIdleUpdateTime(true);
+  }
+
   EZ_TEST_BLOCK(EnableInRelease, "MT Update 1,000,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
@@ -288,3 +612,60 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_TransformLayout)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "AoS vs. SoA 16,000 transforms")
+  {
+    MeasureTransformLayouts(1000, 16000, false);
+    MeasureTransformLayouts(1000, 16000, true);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "AoS vs. SoA 250,000 transforms")
+  {
+    MeasureTransformLayouts(16000, 250000, false);
+    MeasureTransformLayouts(16000, 250000, true);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_SpatialSystem)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Regular grid vs. loose octree with mixed object sizes")
+  {
+    SpatialBenchmarkScene scene;
+    CreateSpatialBenchmarkScene(scene);
+
+    ezUInt32 uiGridNumFound = 0;
+    ezUInt32 uiGridNumVisible = 0;
+    {
+      ezSpatialSystem_RegularGrid grid;
+      MeasureSpatialSystem("Regular grid", grid, scene, uiGridNumFound, uiGridNumVisible);
+    }
+
+    ezUInt32 uiOctreeNumFound = 0;
+    ezUInt32 uiOctreeNumVisible = 0;
+    {
+      ezSpatialSystem_LooseOctree octree;
+      MeasureSpatialSystem("Loose octree", octree, scene, uiOctreeNumFound, uiOctreeNumVisible);
+    }
+
+    // Both systems use the same conservative sphere vs. frustum test, so they have to find the same objects.
+    // The grid may miss a few objects in sphere queries that are close to its cell boundaries, though, so only the frustum results are compared.
+    EZ_TEST_INT(uiGridNumVisible, uiOctreeNumVisible);
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  EZ_TEST_BLOCK(EnableInRelease, "Query throughput")
+  {
+    {
+      ezSpatialSystem_RegularGrid grid;
+      MeasureQueryThroughput("Regular grid", grid);
+    }
+
+    {
+      ezSpatialSystem_LooseOctree octree;
+      MeasureQueryThroughput("Loose octree", octree);
+    }
+  }
+#endif
+}
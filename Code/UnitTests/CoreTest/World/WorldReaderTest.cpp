@@ -0,0 +1,535 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/Implementation/WorldSnapshot.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Types/TagRegistry.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  class TestSerialComponent;
+  using TestSerialComponentManager = ezComponentManager<TestSerialComponent, ezBlockStorageType::Compact>;
+
+  class TestSerialComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestSerialComponent, ezComponent, TestSerialComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override { inout_stream.GetStream() << m_iValue; }
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override { inout_stream.GetStream() >> m_iValue; }
+
+    ezInt32 m_iValue = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(TestSerialComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  class TestConcurrentComponent;
+  using TestConcurrentComponentManager = ezComponentManager<TestConcurrentComponent, ezBlockStorageType::Compact>;
+
+  class TestConcurrentComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestConcurrentComponent, ezComponent, TestConcurrentComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override
+    {
+      ezStreamWriter& s = inout_stream.GetStream();
+      s << m_iValue;
+      s << m_sText;
+      inout_stream.WriteGameObjectHandle(m_hTarget);
+      inout_stream.WriteComponentHandle(m_hSerialComponent);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      EZ_TEST_INT(inout_stream.GetComponentTypeVersion(GetStaticRTTI()), 2);
+
+      ezStreamReader& s = inout_stream.GetStream();
+      s >> m_iValue;
+      s >> m_sText;
+      m_hTarget = inout_stream.ReadGameObjectHandle();
+      inout_stream.ReadComponentHandle(m_hSerialComponent);
+    }
+
+    ezInt32 m_iValue = 0;
+    ezString m_sText;
+    ezGameObjectHandle m_hTarget;
+    ezComponentHandle m_hSerialComponent;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(TestConcurrentComponent, 2, ezComponentMode::Static)
+  {
+    EZ_BEGIN_ATTRIBUTES
+    {
+      new ezConcurrentDeserializationAttribute(),
+    }
+    EZ_END_ATTRIBUTES;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  class TestUnknownComponent;
+  using TestUnknownComponentManager = ezComponentManager<TestUnknownComponent, ezBlockStorageType::Compact>;
+
+  /// Is treated as an unknown type while reading, its data has to be skipped.
+  class TestUnknownComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestUnknownComponent, ezComponent, TestUnknownComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override
+    {
+      ezStreamWriter& s = inout_stream.GetStream();
+      s << m_iValue;
+      s << m_sText;
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      ezStreamReader& s = inout_stream.GetStream();
+      s >> m_iValue;
+      s >> m_sText;
+    }
+
+    ezInt32 m_iValue = 0;
+    ezString m_sText;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(TestUnknownComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  constexpr ezUInt32 s_uiNumObjects = 1000;
+
+  void CreateSourceWorld(ezWorld& ref_world)
+  {
+    EZ_LOCK(ref_world.GetWriteMarker());
+
+    auto* pSerialManager = ref_world.GetOrCreateComponentManager<TestSerialComponentManager>();
+    auto* pConcurrentManager = ref_world.GetOrCreateComponentManager<TestConcurrentComponentManager>();
+
+    ezGameObjectHandle hPrevObject;
+
+    for (ezUInt32 i = 0; i < s_uiNumObjects; ++i)
+    {
+      ezStringBuilder sName;
+      sName.SetFormat("Object{}", i);
+
+      ezGameObjectDesc desc;
+      desc.m_sName.Assign(sName);
+      desc.m_LocalPosition.Set(static_cast<float>(i), 0, 0);
+
+      ezGameObject* pObject = nullptr;
+      ref_world.CreateObject(desc, pObject);
+
+      TestSerialComponent* pSerial = nullptr;
+      pSerialManager->CreateComponent(pObject, pSerial);
+      pSerial->m_iValue = i;
+
+      TestConcurrentComponent* pConcurrent = nullptr;
+      pConcurrentManager->CreateComponent(pObject, pConcurrent);
+      pConcurrent->m_iValue = i * 3;
+      pConcurrent->m_sText = (i % 2) == 0 ? "Even" : "Odd";
+      pConcurrent->m_hTarget = hPrevObject;
+      pConcurrent->m_hSerialComponent = pSerial->GetHandle();
+
+      hPrevObject = pObject->GetHandle();
+    }
+  }
+
+  void CheckInstantiatedWorld(const ezWorld& world)
+  {
+    EZ_LOCK(world.GetReadMarker());
+
+    EZ_TEST_INT(world.GetObjectCount(), s_uiNumObjects);
+
+    const auto* pConcurrentManager = world.GetComponentManager<TestConcurrentComponentManager>();
+    if (!EZ_TEST_BOOL(pConcurrentManager != nullptr))
+      return;
+
+    EZ_TEST_INT(pConcurrentManager->GetComponentCount(), s_uiNumObjects);
+
+    for (auto it = pConcurrentManager->GetComponents(); it.IsValid(); ++it)
+    {
+      const TestConcurrentComponent* pConcurrent = it;
+
+      const TestSerialComponent* pSerial = nullptr;
+      if (!EZ_TEST_BOOL(world.TryGetComponent(pConcurrent->m_hSerialComponent, pSerial)))
+        continue;
+
+      EZ_TEST_BOOL(pSerial->GetOwner() == pConcurrent->GetOwner());
+      EZ_TEST_VEC3(pSerial->GetOwner()->GetLocalPosition(), ezVec3(static_cast<float>(pSerial->m_iValue), 0, 0), 0);
+      EZ_TEST_INT(pConcurrent->m_iValue, pSerial->m_iValue * 3);
+      EZ_TEST_STRING(pConcurrent->m_sText, (pSerial->m_iValue % 2) == 0 ? "Even" : "Odd");
+
+      const ezGameObject* pTarget = nullptr;
+      if (pSerial->m_iValue == 0)
+      {
+        EZ_TEST_BOOL(pConcurrent->m_hTarget.IsInvalidated());
+      }
+      else if (EZ_TEST_BOOL(world.TryGetObject(pConcurrent->m_hTarget, pTarget)))
+      {
+        ezStringBuilder sExpectedName;
+        sExpectedName.SetFormat("Object{}", pSerial->m_iValue - 1);
+        EZ_TEST_STRING(pTarget->GetName(), sExpectedName);
+      }
+    }
+  }
+
+  constexpr ezUInt32 s_uiNumHierarchyRoots = 10;
+  constexpr ezUInt32 s_uiNumHierarchyChildren = 3;
+
+  /// Roots with children and grandchildren, the children have tags and an additional component of an unknown type.
+  void CreateHierarchyWorld(ezWorld& ref_world)
+  {
+    EZ_LOCK(ref_world.GetWriteMarker());
+
+    auto* pSerialManager = ref_world.GetOrCreateComponentManager<TestSerialComponentManager>();
+    auto* pUnknownManager = ref_world.GetOrCreateComponentManager<TestUnknownComponentManager>();
+
+    const ezTag& childTag = ezTagRegistry::GetGlobalRegistry().RegisterTag("WorldReaderTestChild");
+    const ezTag& oddTag = ezTagRegistry::GetGlobalRegistry().RegisterTag("WorldReaderTestOdd");
+
+    for (ezUInt32 r = 0; r < s_uiNumHierarchyRoots; ++r)
+    {
+      ezStringBuilder sName;
+      sName.SetFormat("Root{}", r);
+
+      ezGameObjectDesc rootDesc;
+      rootDesc.m_sName.Assign(sName);
+
+      ezGameObject* pRoot = nullptr;
+      const ezGameObjectHandle hRoot = ref_world.CreateObject(rootDesc, pRoot);
+
+      for (ezUInt32 c = 0; c < s_uiNumHierarchyChildren; ++c)
+      {
+        sName.SetFormat("Root{}Child{}", r, c);
+
+        ezGameObjectDesc childDesc;
+        childDesc.m_sName.Assign(sName);
+        childDesc.m_hParent = hRoot;
+        childDesc.m_Tags.Set(childTag);
+        if ((c % 2) != 0)
+          childDesc.m_Tags.Set(oddTag);
+
+        ezGameObject* pChild = nullptr;
+        const ezGameObjectHandle hChild = ref_world.CreateObject(childDesc, pChild);
+
+        TestUnknownComponent* pUnknown = nullptr;
+        pUnknownManager->CreateComponent(pChild, pUnknown);
+        pUnknown->m_iValue = -1;
+        pUnknown->m_sText = "Unknown";
+
+        TestSerialComponent* pSerial = nullptr;
+        pSerialManager->CreateComponent(pChild, pSerial);
+        pSerial->m_iValue = r * 100 + c;
+
+        sName.SetFormat("Root{}Child{}Grandchild", r, c);
+
+        ezGameObjectDesc grandchildDesc;
+        grandchildDesc.m_sName.Assign(sName);
+        grandchildDesc.m_hParent = hChild;
+
+        ezGameObject* pGrandchild = nullptr;
+        ref_world.CreateObject(grandchildDesc, pGrandchild);
+
+        pSerialManager->CreateComponent(pGrandchild, pSerial);
+        pSerial->m_iValue = r * 100 + c + 50;
+      }
+    }
+  }
+
+  void CheckInstantiatedHierarchy(const ezWorld& world)
+  {
+    EZ_LOCK(world.GetReadMarker());
+
+    EZ_TEST_INT(world.GetObjectCount(), s_uiNumHierarchyRoots * (1 + 2 * s_uiNumHierarchyChildren));
+
+    const auto* pUnknownManager = world.GetComponentManager<TestUnknownComponentManager>();
+    EZ_TEST_BOOL(pUnknownManager == nullptr || pUnknownManager->GetComponentCount() == 0);
+
+    const auto* pSerialManager = world.GetComponentManager<TestSerialComponentManager>();
+    if (!EZ_TEST_BOOL(pSerialManager != nullptr))
+      return;
+
+    EZ_TEST_INT(pSerialManager->GetComponentCount(), s_uiNumHierarchyRoots * 2 * s_uiNumHierarchyChildren);
+
+    const ezTag& childTag = ezTagRegistry::GetGlobalRegistry().RegisterTag("WorldReaderTestChild");
+    const ezTag& oddTag = ezTagRegistry::GetGlobalRegistry().RegisterTag("WorldReaderTestOdd");
+
+    ezStringBuilder sExpectedName;
+
+    for (auto it = pSerialManager->GetComponents(); it.IsValid(); ++it)
+    {
+      const TestSerialComponent* pSerial = it;
+      const ezGameObject* pOwner = pSerial->GetOwner();
+
+      const bool bGrandchild = (pSerial->m_iValue % 100) >= 50;
+      const ezUInt32 r = pSerial->m_iValue / 100;
+      const ezUInt32 c = (pSerial->m_iValue % 100) - (bGrandchild ? 50 : 0);
+
+      const ezGameObject* pChild = bGrandchild ? pOwner->GetParent() : pOwner;
+      if (!EZ_TEST_BOOL(pChild != nullptr && pChild->GetParent() != nullptr))
+        continue;
+
+      sExpectedName.SetFormat("Root{}Child{}", r, c);
+      EZ_TEST_STRING(pChild->GetName(), sExpectedName);
+
+      sExpectedName.SetFormat("Root{}", r);
+      EZ_TEST_STRING(pChild->GetParent()->GetName(), sExpectedName);
+      EZ_TEST_BOOL(pChild->GetParent()->GetParent() == nullptr);
+
+      EZ_TEST_BOOL(pChild->GetTags().IsSet(childTag));
+      EZ_TEST_BOOL(pChild->GetTags().IsSet(oddTag) == ((c % 2) != 0));
+      EZ_TEST_INT(pChild->GetChildCount(), 1);
+
+      if (bGrandchild)
+      {
+        sExpectedName.SetFormat("Root{}Child{}Grandchild", r, c);
+        EZ_TEST_STRING(pOwner->GetName(), sExpectedName);
+        EZ_TEST_INT(pOwner->GetTags().GetNumTagsSet(), 0);
+      }
+    }
+  }
+
+  void WriteSnapshot(ezDynamicArray<ezUInt8>& out_snapshot, void (*createWorld)(ezWorld&))
+  {
+    ezDefaultMemoryStreamStorage storage;
+
+    {
+      ezWorldDesc worldDesc("Source");
+      ezWorld world(worldDesc);
+      createWorld(world);
+
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezMemoryStreamWriter writer(&storage);
+      ezWorldWriter worldWriter;
+      worldWriter.WriteWorldSnapshot(writer, world);
+    }
+
+    // the snapshot must be contiguous in memory, like a memory mapped file
+    out_snapshot.SetCountUninitialized(storage.GetStorageSize32());
+    ezMemoryStreamReader(&storage).ReadBytes(out_snapshot.GetData(), out_snapshot.GetCount());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, WorldReader)
+{
+  ezDefaultMemoryStreamStorage storage;
+
+  {
+    ezWorldDesc worldDesc("Source");
+    ezWorld world(worldDesc);
+    CreateSourceWorld(world);
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezMemoryStreamWriter writer(&storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteWorld(writer, world);
+  }
+
+  ezCVarBool* pConcurrentCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("World.ConcurrentDeserialization"));
+  if (!EZ_TEST_BOOL(pConcurrentCVar != nullptr))
+    return;
+
+  const bool bPrevConcurrent = *pConcurrentCVar;
+  EZ_SCOPE_EXIT(*pConcurrentCVar = bPrevConcurrent);
+
+  ezMemoryStreamReader reader(&storage);
+  ezWorldReader worldReader;
+  EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Serial")
+  {
+    *pConcurrentCVar = false;
+
+    ezWorldDesc worldDesc("Serial");
+    ezWorld world(worldDesc);
+
+    ezStopwatch sw;
+    {
+      EZ_LOCK(world.GetWriteMarker());
+      worldReader.InstantiateWorld(world);
+    }
+    ezLog::Info("[test]Serial instantiation of {} objects: {}", s_uiNumObjects, sw.GetRunningTotal());
+
+    CheckInstantiatedWorld(world);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent")
+  {
+    *pConcurrentCVar = true;
+
+    ezWorldDesc worldDesc("Concurrent");
+    ezWorld world(worldDesc);
+
+    ezStopwatch sw;
+    {
+      EZ_LOCK(world.GetWriteMarker());
+      worldReader.InstantiateWorld(world);
+    }
+    ezLog::Info("[test]Concurrent instantiation of {} objects: {}", s_uiNumObjects, sw.GetRunningTotal());
+
+    CheckInstantiatedWorld(world);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Time Sliced")
+  {
+    *pConcurrentCVar = true;
+
+    ezWorldDesc worldDesc("TimeSliced");
+    ezWorld world(worldDesc);
+
+    ezPrefabInstantiationOptions options;
+    options.m_MaxStepTime = ezTime::MakeFromMicroseconds(100);
+
+    ezUniquePtr<ezWorldReader::InstantiationContextBase> pContext;
+    {
+      EZ_LOCK(world.GetWriteMarker());
+      pContext = worldReader.InstantiatePrefab(world, ezTransform::MakeIdentity(), options);
+    }
+
+    if (EZ_TEST_BOOL(pContext != nullptr))
+    {
+      while (true)
+      {
+        const auto result = pContext->Step();
+        if (result == ezWorldReader::InstantiationContextBase::StepResult::Finished)
+          break;
+
+        if (result == ezWorldReader::InstantiationContextBase::StepResult::ContinueNextFrame)
+        {
+          world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(1.0 / 60.0));
+
+          EZ_LOCK(world.GetWriteMarker());
+          world.Update();
+        }
+      }
+    }
+
+    CheckInstantiatedWorld(world);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Snapshot")
+  {
+    ezDynamicArray<ezUInt8> snapshot;
+    WriteSnapshot(snapshot, CreateSourceWorld);
+
+    ezWorldReader snapshotReader;
+
+    ezStopwatch sw;
+    EZ_TEST_BOOL(snapshotReader.ReadWorldSnapshot(snapshot).Succeeded());
+    ezLog::Info("[test]Reading snapshot of {} objects: {}", s_uiNumObjects, sw.GetRunningTotal());
+
+    sw.StopAndReset();
+    sw.Resume();
+    ezWorldReader streamReader;
+    reader.SetReadPosition(0);
+    EZ_TEST_BOOL(streamReader.ReadWorldDescription(reader).Succeeded());
+    ezLog::Info("[test]Reading world description of {} objects: {}", s_uiNumObjects, sw.GetRunningTotal());
+
+    EZ_TEST_INT(snapshotReader.GetRootObjectCount(), s_uiNumObjects);
+    EZ_TEST_INT(snapshotReader.GetChildObjectCount(), 0);
+    EZ_TEST_INT(snapshotReader.GetComponentTypeVersion(ezGetStaticRTTI<TestConcurrentComponent>()), 2);
+
+    for (bool bConcurrent : {false, true})
+    {
+      *pConcurrentCVar = bConcurrent;
+
+      ezWorldDesc worldDesc("Snapshot");
+      ezWorld world(worldDesc);
+
+      {
+        EZ_LOCK(world.GetWriteMarker());
+        snapshotReader.InstantiateWorld(world);
+      }
+
+      CheckInstantiatedWorld(world);
+    }
+
+    // a truncated snapshot must be rejected
+    {
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("World snapshot is corrupted", ezLogMsgType::ErrorMsg);
+
+      EZ_TEST_BOOL(snapshotReader.ReadWorldSnapshot(snapshot.GetArrayPtr().GetSubArray(0, snapshot.GetCount() - 1)).Failed());
+      EZ_TEST_INT(snapshotReader.GetRootObjectCount(), 0);
+    }
+  }
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Snapshot Hierarchy")
+  {
+    ezDynamicArray<ezUInt8> snapshot;
+    WriteSnapshot(snapshot, CreateHierarchyWorld);
+
+    // treat one of the types as unknown, its creation and component data must be skipped
+    const ezWorldReader::FindComponentTypeCallback prevCallback = ezWorldReader::s_FindComponentTypeCallback;
+    EZ_SCOPE_EXIT(ezWorldReader::s_FindComponentTypeCallback = prevCallback);
+
+    ezWorldReader::s_FindComponentTypeCallback = [](ezStringView sTypeName) -> const ezRTTI*
+    {
+      if (sTypeName == ezGetStaticRTTI<TestUnknownComponent>()->GetTypeName())
+        return nullptr;
+
+      return ezRTTI::FindTypeByName(sTypeName);
+    };
+
+    ezWorldReader snapshotReader;
+    EZ_TEST_BOOL(snapshotReader.ReadWorldSnapshot(snapshot).Succeeded());
+    EZ_TEST_INT(snapshotReader.GetRootObjectCount(), s_uiNumHierarchyRoots);
+    EZ_TEST_INT(snapshotReader.GetChildObjectCount(), s_uiNumHierarchyRoots * 2 * s_uiNumHierarchyChildren);
+    EZ_TEST_BOOL(!snapshotReader.HasComponentOfType(ezGetStaticRTTI<TestUnknownComponent>()));
+
+    for (bool bConcurrent : {false, true})
+    {
+      *pConcurrentCVar = bConcurrent;
+
+      ezWorldDesc worldDesc("SnapshotHierarchy");
+      ezWorld world(worldDesc);
+
+      {
+        EZ_LOCK(world.GetWriteMarker());
+        snapshotReader.InstantiateWorld(world);
+      }
+
+      CheckInstantiatedHierarchy(world);
+    }
+
+    // component owners that are not part of the snapshot must be rejected
+    {
+      using namespace ezInternal;
+
+      const WorldSnapshotHeader& header = *reinterpret_cast<const WorldSnapshotHeader*>(snapshot.GetData());
+      const WorldSnapshotComponentType* pComponentTypes = reinterpret_cast<const WorldSnapshotComponentType*>(snapshot.GetData() + header.m_uiComponentTypesOffset);
+
+      for (ezUInt32 i = 0; i < header.m_uiNumComponentTypes; ++i)
+      {
+        if (pComponentTypes[i].m_uiNumComponents == 0)
+          continue;
+
+        ezDynamicArray<ezUInt8> corrupted = snapshot;
+        const ezUInt32 uiInvalidOwner = header.m_uiNumRootObjects + header.m_uiNumChildObjects + 1;
+        ezMemoryUtils::RawByteCopy(corrupted.GetData() + header.m_uiCreationDataOffset + pComponentTypes[i].m_uiCreationDataOffset, &uiInvalidOwner, sizeof(ezUInt32));
+
+        ezTestLogInterface log;
+        ezTestLogSystemScope logSystemScope(&log);
+        log.ExpectMessage("World snapshot is corrupted", ezLogMsgType::ErrorMsg);
+
+        EZ_TEST_BOOL(snapshotReader.ReadWorldSnapshot(corrupted).Failed());
+        EZ_TEST_INT(snapshotReader.GetRootObjectCount(), 0);
+      }
+    }
+  }
+}
@@ -216,6 +216,8 @@ public:
     EZ_TEST_BOOL(pObject->m_pTransformationData->m_pParentData == (pParent != nullptr ? pParent->m_pTransformationData : nullptr));
     EZ_TEST_BOOL(pObject->GetParent() == pParent);
   }
+
+  static ezUInt32 GetGlobalTransformUpdateCounter(const ezGameObject* pObject) { return pObject->m_pTransformationData->m_uiGlobalTransformUpdateCounter; }
 };
 
 EZ_CREATE_SIMPLE_TEST(World, World)
@@ -237,6 +239,110 @@ EZ_CREATE_SIMPLE_TEST(World, World)
     TestTransforms(o, offset);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms dynamic (track changes)")
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bTrackTransformChanges = true;
+
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    TestWorldObjects o = CreateTestWorld(world, true);
+
+    world.Update();
+
+    TestTransforms(o);
+
+    ezVec3 offset = ezVec3(200.0f, 0.0f, 0.0f);
+    o.pParent1->SetLocalPosition(offset);
+    o.pParent2->SetLocalPosition(offset);
+
+    world.Update();
+
+    TestTransforms(o, offset);
+
+    // only move the second hierarchy, the first one has to stay where it is
+    const ezVec3 vChild11Pos = o.pChild11->GetGlobalPosition();
+    const ezVec3 vChild21Pos = o.pChild21->GetGlobalPosition();
+
+    o.pParent2->SetLocalPosition(ezVec3(300.0f, 0.0f, 0.0f));
+
+    world.Update();
+
+    EZ_TEST_VEC3(o.pParent1->GetGlobalPosition(), offset, 0);
+    EZ_TEST_VEC3(o.pChild11->GetGlobalPosition(), vChild11Pos, 0);
+    EZ_TEST_VEC3(o.pParent2->GetGlobalPosition(), ezVec3(300.0f, 0.0f, 0.0f), 0);
+    EZ_TEST_VEC3(o.pChild21->GetGlobalPosition(), vChild21Pos + ezVec3(100.0f, 0.0f, 0.0f), ezMath::DefaultEpsilon<float>());
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+    EZ_TEST_VEC3(o.pChild21->GetLastGlobalTransform().m_vPosition, vChild21Pos, ezMath::DefaultEpsilon<float>());
+
+    world.Update();
+
+    // nothing moved, so the last global transform has to catch up
+    EZ_TEST_VEC3(o.pChild21->GetLastGlobalTransform().m_vPosition, o.pChild21->GetGlobalPosition(), 0);
+    EZ_TEST_VEC3(o.pChild11->GetLastGlobalTransform().m_vPosition, vChild11Pos, 0);
+#endif
+
+    // re-parenting has to update the child as well
+    o.pChild21->SetParent(o.pParent1->GetHandle(), ezGameObject::TransformPreservation::PreserveLocal);
+
+    world.Update();
+
+    EZ_TEST_VEC3(o.pChild21->GetGlobalPosition(), vChild11Pos, ezMath::DefaultEpsilon<float>());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms static parent (track changes)")
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bTrackTransformChanges = true;
+    worldDesc.m_bReportErrorWhenStaticObjectMoves = false;
+
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = false;
+
+    ezGameObject* pParent = nullptr;
+    world.CreateObject(desc, pParent);
+
+    desc.m_bDynamic = true;
+    desc.m_hParent = pParent->GetHandle();
+    desc.m_LocalPosition = ezVec3(0.0f, 10.0f, 0.0f);
+
+    ezGameObject* pChild = nullptr;
+    world.CreateObject(desc, pChild);
+
+    world.Update();
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(0.0f, 10.0f, 0.0f), 0);
+
+    // moving the static parent between two updates
+    pParent->SetLocalPosition(ezVec3(100.0f, 0.0f, 0.0f));
+
+    world.Update();
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(100.0f, 10.0f, 0.0f), 0);
+
+    // the child must only be updated once after the parent moved
+    const ezUInt32 uiChildUpdateCounter = ezGameObjectTest::GetGlobalTransformUpdateCounter(pChild);
+
+    world.Update();
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(100.0f, 10.0f, 0.0f), 0);
+    EZ_TEST_INT(ezGameObjectTest::GetGlobalTransformUpdateCounter(pChild), uiChildUpdateCounter);
+
+    // the static parent may be moved again later on
+    pParent->SetLocalPosition(ezVec3(200.0f, 0.0f, 0.0f));
+
+    world.Update();
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(200.0f, 10.0f, 0.0f), 0);
+
+    // moving the child alone must still work once the parent is no longer marked as changed
+    pChild->SetLocalPosition(ezVec3(0.0f, 20.0f, 0.0f));
+
+    world.Update();
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(200.0f, 20.0f, 0.0f), 0);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms static")
   {
     ezWorldDesc worldDesc("Test");
@@ -1,6 +1,7 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Random.h>
 
 namespace
 {
@@ -11,6 +12,44 @@ namespace
     // Comparision via operator. Sorting algorithm should prefer Less operator
     bool operator()(ezInt32 a, ezInt32 b) const { return a < b; }
   };
+
+  struct KeyValuePair
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiOriginalIndex;
+  };
+
+  void TestRadixSort(ezRandom& ref_rng, ezUInt32 uiCount, ezUInt64 uiKeyMask)
+  {
+    ezDynamicArray<KeyValuePair> data;
+    data.SetCountUninitialized(uiCount);
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const ezUInt64 uiRandom = (static_cast<ezUInt64>(ref_rng.UInt()) << 32) | ref_rng.UInt();
+      data[i].m_uiKey = uiRandom & uiKeyMask;
+      data[i].m_uiOriginalIndex = i;
+    }
+
+    ezDynamicArray<KeyValuePair> scratch;
+    scratch.SetCountUninitialized(uiCount);
+
+    ezSorting::RadixSort(data.GetArrayPtr(), scratch.GetArrayPtr(), [](const KeyValuePair& p)
+      { return p.m_uiKey; });
+
+    bool bSorted = true;
+    for (ezUInt32 i = 1; i < uiCount; ++i)
+    {
+      const KeyValuePair& a = data[i - 1];
+      const KeyValuePair& b = data[i];
+
+      // equal keys have to keep their original order
+      bSorted &= a.m_uiKey < b.m_uiKey || (a.m_uiKey == b.m_uiKey && a.m_uiOriginalIndex < b.m_uiOriginalIndex);
+    }
+
+    EZ_TEST_BOOL(bSorted);
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
@@ -53,4 +92,24 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    // small arrays fall back to insertion sort
+    TestRadixSort(rng, 0, 0xFFFFFFFFFFFFFFFFull);
+    TestRadixSort(rng, 11, 0xFFFFFFFFFFFFFFFFull);
+
+    TestRadixSort(rng, 2000, 0xFFFFFFFFFFFFFFFFull);
+
+    // lots of duplicates and bytes that are the same in all keys
+    TestRadixSort(rng, 2000, 0x0000FF000000000Full);
+    TestRadixSort(rng, 2000, 0);
+
+    // large enough to be split into several chunks
+    TestRadixSort(rng, 100000, 0xFFFFFFFFFFFFFFFFull);
+    TestRadixSort(rng, 300000, 0xFFFF0000000000FFull);
+  }
 }
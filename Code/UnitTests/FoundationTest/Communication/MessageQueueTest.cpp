@@ -1,6 +1,8 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 namespace
 {
@@ -106,4 +108,95 @@ EZ_CREATE_SIMPLE_TEST(Communication, MessageQueue)
       EZ_DEFAULT_DELETE(pMsg);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "EnqueueStaged / FlushStaged")
+  {
+    constexpr ezUInt32 uiNumMessages = 1000;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumMessages,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          TestMessage* pMsg = EZ_DEFAULT_NEW(TestMessage);
+          pMsg->x = i;
+          pMsg->y = 0;
+
+          MetaData md;
+          md.receiver = i;
+
+          q.EnqueueStaged(pMsg, md);
+        }
+      });
+
+    // staged messages are not visible before flushing
+    EZ_TEST_BOOL(q.IsEmpty());
+
+    q.FlushStaged();
+    EZ_TEST_INT(q.GetCount(), uiNumMessages);
+
+    ezDynamicArray<bool> received;
+    received.SetCount(uiNumMessages);
+
+    ezMessage* pMsg = nullptr;
+    MetaData md;
+
+    while (q.TryDequeue(pMsg, md))
+    {
+      TestMessage* pTestMsg = static_cast<TestMessage*>(pMsg);
+      EZ_TEST_INT(pTestMsg->x, md.receiver);
+      EZ_TEST_BOOL(!received[md.receiver]);
+      received[md.receiver] = true;
+
+      EZ_DEFAULT_DELETE(pMsg);
+    }
+
+    for (bool b : received)
+    {
+      EZ_TEST_BOOL(b);
+    }
+
+    // flushing again doesn't add anything
+    q.FlushStaged();
+    EZ_TEST_BOOL(q.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Staged messages: allocator / Clear / copy")
+  {
+    ezProxyAllocator testAllocator("Test", ezFoundation::GetDefaultAllocator());
+
+    {
+      TestMessage msg;
+      MetaData md;
+      md.receiver = 0;
+
+      TestMessageQueue q2(&testAllocator);
+      q2.EnqueueStaged(&msg, md);
+      EZ_TEST_BOOL(testAllocator.GetStats().m_uiNumAllocations > 0);
+
+      // staged messages are dropped by Clear() and don't show up after the next flush
+      q2.Clear();
+      q2.FlushStaged();
+      EZ_TEST_BOOL(q2.IsEmpty());
+
+      // copies only take the queued messages
+      q2.Enqueue(&msg, md);
+      q2.EnqueueStaged(&msg, md);
+
+      TestMessageQueue q3(q2);
+      q3.FlushStaged();
+      EZ_TEST_INT(q3.GetCount(), 1);
+
+      // the staged messages of the assigned queue are dropped
+      q3.EnqueueStaged(&msg, md);
+      q3 = q2;
+      q3.FlushStaged();
+      EZ_TEST_INT(q3.GetCount(), 1);
+
+      q2.FlushStaged();
+      EZ_TEST_INT(q2.GetCount(), 2);
+    }
+
+    EZ_TEST_INT(testAllocator.GetStats().m_uiAllocationSize, 0);
+  }
 }
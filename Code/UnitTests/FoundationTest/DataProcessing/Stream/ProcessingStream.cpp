@@ -4,8 +4,13 @@
 #include <Foundation/DataProcessing/Stream/DefaultImplementations/ZeroInitializer.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Time/Stopwatch.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(DataProcessing);
 
@@ -156,3 +161,300 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+// Adds a constant to a Float3 stream, the way the gravity behavior accelerates particles
+
+class AccelerateStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(AccelerateStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  ezVec3 m_vAcceleration = ezVec3::MakeZero();
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStreamVelocity = m_pStreamGroup->GetStreamByName("Velocity");
+
+    return m_pStreamVelocity ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+
+  virtual void Process(ezUInt64 uiNumElements) override
+  {
+    ProcessInRanges(uiNumElements, [this](ezUInt64 uiStartIndex, ezUInt64 uiCount)
+      { ezProcessingStreamKernels::AddFloat3(m_pStreamVelocity->GetWritableData<ezVec3>() + uiStartIndex, uiCount, m_vAcceleration); });
+  }
+
+  ezProcessingStream* m_pStreamVelocity = nullptr;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AccelerateStreamProcessor, 1, ezRTTIDefaultAllocator<AccelerateStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+// Adds a Float3 velocity stream to a Float4 position stream, the way the apply velocity finalizer moves particles
+
+class IntegrateStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(IntegrateStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  float m_fTimeStep = 0.0f;
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStreamPosition = m_pStreamGroup->GetStreamByName("Position");
+    m_pStreamVelocity = m_pStreamGroup->GetStreamByName("Velocity");
+
+    return (m_pStreamPosition && m_pStreamVelocity) ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+
+  virtual void Process(ezUInt64 uiNumElements) override
+  {
+    ProcessInRanges(uiNumElements, [this](ezUInt64 uiStartIndex, ezUInt64 uiCount)
+      { ezProcessingStreamKernels::MulAddFloat3ToFloat4(m_pStreamPosition->GetWritableData<ezSimdVec4f>() + uiStartIndex, m_pStreamVelocity->GetData<ezVec3>() + uiStartIndex, uiCount, m_fTimeStep); });
+  }
+
+  ezProcessingStream* m_pStreamPosition = nullptr;
+  ezProcessingStream* m_pStreamVelocity = nullptr;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(IntegrateStreamProcessor, 1, ezRTTIDefaultAllocator<IntegrateStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+class RangeTestStreamProcessor : public ezProcessingStreamProcessor
+{
+public:
+  struct Range
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiStart;
+    ezUInt64 m_uiCount;
+  };
+
+  ezMutex m_Mutex;
+  ezDynamicArray<Range> m_Ranges;
+
+  void ProcessRanges(ezUInt64 uiNumElements)
+  {
+    ProcessInRanges(uiNumElements, [this](ezUInt64 uiStartIndex, ezUInt64 uiCount)
+      {
+        EZ_LOCK(m_Mutex);
+        m_Ranges.PushBack({uiStartIndex, uiCount});
+      });
+  }
+
+protected:
+  virtual ezResult UpdateStreamBindings() override { return EZ_SUCCESS; }
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+  virtual void Process(ezUInt64 uiNumElements) override {}
+};
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ParallelProcessing)
+{
+  const ezUInt32 uiPrevMinElementsPerTask = ezProcessingStreamProcessor::s_uiMinElementsPerTask;
+  EZ_SCOPE_EXIT(ezProcessingStreamProcessor::s_uiMinElementsPerTask = uiPrevMinElementsPerTask);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Ranges")
+  {
+    ezProcessingStreamProcessor::s_uiMinElementsPerTask = 64;
+
+    for (ezUInt64 uiNumElements : {0, 1, 7, 64, 65, 1000, 12345})
+    {
+      RangeTestStreamProcessor processor;
+      processor.ProcessRanges(uiNumElements);
+
+      processor.m_Ranges.Sort([](const auto& a, const auto& b)
+        { return a.m_uiStart < b.m_uiStart; });
+
+      // the ranges must cover all elements exactly once
+      ezUInt64 uiNextStart = 0;
+      for (const auto& range : processor.m_Ranges)
+      {
+        EZ_TEST_INT(range.m_uiStart, uiNextStart);
+        EZ_TEST_INT(range.m_uiStart % ezProcessingStreamProcessor::ElementRangeAlignment, 0);
+        EZ_TEST_BOOL(range.m_uiCount > 0);
+
+        uiNextStart = range.m_uiStart + range.m_uiCount;
+      }
+
+      EZ_TEST_INT(uiNextStart, uiNumElements);
+
+      if (uiNumElements <= 64)
+      {
+        EZ_TEST_INT(processor.m_Ranges.GetCount(), uiNumElements > 0 ? 1 : 0);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Kernels")
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    constexpr ezUInt32 uiMaxCount = 23;
+
+    ezVec3 velocities[uiMaxCount + 1];
+    ezVec3 expectedVelocities[uiMaxCount + 1];
+    ezSimdVec4f positions[uiMaxCount];
+    ezVec4 expectedPositions[uiMaxCount];
+
+    // all counts around the block size of the kernels, with the Float3 data starting at different alignments
+    for (ezUInt32 uiCount = 0; uiCount <= uiMaxCount; ++uiCount)
+    {
+      for (ezUInt32 uiOffset = 0; uiOffset < 2 && uiOffset + uiCount <= uiMaxCount; ++uiOffset)
+      {
+        auto Randomize = [&]()
+        {
+          for (ezUInt32 i = 0; i <= uiMaxCount; ++i)
+          {
+            velocities[i].Set((float)rng.DoubleMinMax(-10, 10), (float)rng.DoubleMinMax(-10, 10), (float)rng.DoubleMinMax(-10, 10));
+            expectedVelocities[i] = velocities[i];
+          }
+
+          for (ezUInt32 i = 0; i < uiMaxCount; ++i)
+          {
+            expectedPositions[i].Set((float)rng.DoubleMinMax(-10, 10), (float)rng.DoubleMinMax(-10, 10), (float)rng.DoubleMinMax(-10, 10), (float)i);
+            positions[i].Load<4>(&expectedPositions[i].x);
+          }
+        };
+
+        // elements outside of the range must not be touched
+        auto CheckVelocities = [&]()
+        {
+          bool bAllCorrect = true;
+          for (ezUInt32 i = 0; i <= uiMaxCount; ++i)
+          {
+            bAllCorrect &= velocities[i].IsEqual(expectedVelocities[i], 0.0001f);
+          }
+          EZ_TEST_BOOL(bAllCorrect);
+        };
+
+        Randomize();
+        const ezVec3 vAdd(1.5f, -2.0f, 0.25f);
+        ezProcessingStreamKernels::AddFloat3(velocities + uiOffset, uiCount, vAdd);
+        for (ezUInt32 i = uiOffset; i < uiOffset + uiCount; ++i)
+        {
+          expectedVelocities[i] += vAdd;
+        }
+        CheckVelocities();
+
+        Randomize();
+        ezProcessingStreamKernels::ScaleFloat3(velocities + uiOffset, uiCount, 0.75f);
+        for (ezUInt32 i = uiOffset; i < uiOffset + uiCount; ++i)
+        {
+          expectedVelocities[i] *= 0.75f;
+        }
+        CheckVelocities();
+
+        Randomize();
+        ezProcessingStreamKernels::MulAddFloat3ToFloat4(positions, velocities + uiOffset, uiCount, 0.5f);
+        for (ezUInt32 i = 0; i < uiCount; ++i)
+        {
+          expectedPositions[i] += (velocities[uiOffset + i] * 0.5f).GetAsVec4(0.0f);
+        }
+        CheckVelocities();
+
+        bool bAllCorrect = true;
+        for (ezUInt32 i = 0; i < uiMaxCount; ++i)
+        {
+          ezVec4 vPosition;
+          positions[i].Store<4>(&vPosition.x);
+          bAllCorrect &= vPosition.IsEqual(expectedPositions[i], 0.0001f);
+        }
+        EZ_TEST_BOOL(bAllCorrect);
+      }
+    }
+
+    // processors that only update every n-th element continue in the next range where the previous one stopped
+    for (ezUInt64 uiFirstIndex : {0, 1, 2})
+    {
+      for (ezUInt64 uiRangeStart : {0, 8, 16, 24})
+      {
+        const ezUInt64 uiIndex = ezProcessingStreamKernels::GetFirstStridedIndex(uiFirstIndex, 3, uiRangeStart);
+        EZ_TEST_BOOL(uiIndex >= uiRangeStart || uiIndex == uiFirstIndex);
+        EZ_TEST_BOOL(uiIndex < ezMath::Max(uiRangeStart, uiFirstIndex) + 3);
+        EZ_TEST_INT((uiIndex - uiFirstIndex) % 3, 0);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Throughput")
+  {
+    for (ezUInt32 uiNumElements : {1000, 10000, 100000, 1000000})
+    {
+      ezTime tElapsed[2];
+
+      for (ezUInt32 uiMode = 0; uiMode < 2; ++uiMode)
+      {
+        // mode 0 processes everything on one thread, mode 1 uses the default split
+        ezProcessingStreamProcessor::s_uiMinElementsPerTask = uiMode == 0 ? ezMath::MaxValue<ezUInt32>() : uiPrevMinElementsPerTask;
+
+        ezProcessingStreamGroup group;
+        ezProcessingStream* pPosition = group.AddStream("Position", ezProcessingStream::DataType::Float4);
+        ezProcessingStream* pVelocity = group.AddStream("Velocity", ezProcessingStream::DataType::Float3);
+
+        ezProcessingStreamSpawnerZeroInitialized* pSpawner1 = EZ_DEFAULT_NEW(ezProcessingStreamSpawnerZeroInitialized);
+        ezProcessingStreamSpawnerZeroInitialized* pSpawner2 = EZ_DEFAULT_NEW(ezProcessingStreamSpawnerZeroInitialized);
+        pSpawner1->SetStreamName(pPosition->GetName());
+        pSpawner2->SetStreamName(pVelocity->GetName());
+        group.AddProcessor(pSpawner1);
+        group.AddProcessor(pSpawner2);
+
+        AccelerateStreamProcessor* pAccelerate = EZ_DEFAULT_NEW(AccelerateStreamProcessor);
+        pAccelerate->m_vAcceleration.Set(0, 0, -1.0f);
+        pAccelerate->m_fPriority = 0.0f;
+        group.AddProcessor(pAccelerate);
+
+        IntegrateStreamProcessor* pIntegrate = EZ_DEFAULT_NEW(IntegrateStreamProcessor);
+        pIntegrate->m_fTimeStep = 0.5f;
+        pIntegrate->m_fPriority = 1.0f;
+        group.AddProcessor(pIntegrate);
+
+        group.SetSize(uiNumElements);
+        group.InitializeElements(uiNumElements);
+
+        // pending spawns are only executed at the end of Process()
+        group.Process();
+
+        constexpr ezUInt32 uiNumSteps = 10;
+
+        ezStopwatch sw;
+        for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        {
+          group.Process();
+        }
+        tElapsed[uiMode] = sw.GetRunningTotal();
+
+        EZ_TEST_INT(group.GetNumActiveElements(), uiNumElements);
+
+        // after n steps the velocity is -n and the position is the sum of all velocities times the time step
+        const float fExpectedPos = -0.5f * (uiNumSteps * (uiNumSteps + 1) / 2);
+
+        ezProcessingStreamIterator<ezVec4> itPos(pPosition, uiNumElements, 0);
+        ezProcessingStreamIterator<ezVec3> itVel(pVelocity, uiNumElements, 0);
+
+        bool bAllCorrect = true;
+        while (!itPos.HasReachedEnd())
+        {
+          bAllCorrect &= itVel.Current().IsEqual(ezVec3(0, 0, -(float)uiNumSteps), 0.001f);
+          bAllCorrect &= itPos.Current().IsEqual(ezVec4(0, 0, fExpectedPos, 0), 0.001f);
+
+          itPos.Advance();
+          itVel.Advance();
+        }
+
+        EZ_TEST_BOOL(bAllCorrect);
+      }
+
+      const double fSteps = 10.0 * uiNumElements / 1000000.0;
+      ezLog::Info("[test]{} particles: single thread {} M particle updates/s, parallel {} M particle updates/s", uiNumElements,
+        ezArgF(fSteps / tElapsed[0].GetSeconds(), 1), ezArgF(fSteps / tElapsed[1].GetSeconds(), 1));
+    }
+  }
+}
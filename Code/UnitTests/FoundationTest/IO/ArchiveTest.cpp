@@ -1,7 +1,10 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
@@ -159,3 +162,284 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveBuilder)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveBuilderTest");
+  sOutputFolder.MakeCleanPath();
+
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "Clear", "output", ezDataDirUsage::AllowWrites).Succeeded()))
+    return;
+
+  EZ_SCOPE_EXIT(ezFileSystem::RemoveDataDirectoryGroup("Clear"));
+
+  // files with the same index have identical content
+  const ezUInt32 uiNumFiles = 40;
+  auto GetContentIndex = [](ezUInt32 uiFile)
+  { return uiFile % 16; };
+
+  ezStringBuilder sFileName;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+    {
+      sFileName.SetFormat(":output/Data/Folder{}/File{}.txt", uiFile % 3, uiFile);
+
+      ezFileWriter file;
+      if (!EZ_TEST_BOOL(file.Open(sFileName).Succeeded()))
+        return;
+
+      const ezUInt32 uiContent = GetContentIndex(uiFile);
+      for (ezUInt32 i = 0; i < uiContent * 1000; ++i)
+      {
+        file << (i % (uiContent + 1));
+      }
+    }
+  }
+
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Data.ezArchive");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteArchive")
+  {
+    ezArchiveBuilder builder;
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    builder.AddFolder(ezStringBuilder(sOutputFolder, "/Data"), ezArchiveCompressionMode::Compressed_zstd);
+#  else
+    builder.AddFolder(ezStringBuilder(sOutputFolder, "/Data"), ezArchiveCompressionMode::Uncompressed);
+#  endif
+
+    EZ_TEST_INT(builder.m_Entries.GetCount(), uiNumFiles);
+
+    ezFileWriter file;
+    if (!EZ_TEST_BOOL(file.Open(":output/Data.ezArchive").Succeeded()))
+      return;
+
+    EZ_TEST_BOOL(builder.WriteArchive(file).Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read and compare")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+      return;
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    EZ_TEST_INT(toc.m_Entries.GetCount(), uiNumFiles);
+
+    ezHashTable<ezUInt32, ezUInt64> contentToDataOffset;
+    ezDynamicArray<ezUInt8> archiveData;
+    ezDynamicArray<ezUInt8> fileData;
+
+    for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+    {
+      sFileName.SetFormat("Folder{}/File{}.txt", uiFile % 3, uiFile);
+
+      const ezUInt32 uiEntry = toc.FindEntry(sFileName);
+      if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+        continue;
+
+      // identical files must share their data
+      ezUInt64 uiDataOffset = 0;
+      if (contentToDataOffset.TryGetValue(GetContentIndex(uiFile), uiDataOffset))
+      {
+        EZ_TEST_INT(toc.m_Entries[uiEntry].m_uiDataStartOffset, uiDataOffset);
+      }
+      else
+      {
+        contentToDataOffset.Insert(GetContentIndex(uiFile), toc.m_Entries[uiEntry].m_uiDataStartOffset);
+      }
+
+      ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(uiEntry);
+      archiveData.SetCountUninitialized(static_cast<ezUInt32>(toc.m_Entries[uiEntry].m_uiUncompressedDataSize));
+      EZ_TEST_INT(pEntryReader->ReadBytes(archiveData.GetData(), archiveData.GetCount()), archiveData.GetCount());
+
+      sFileName.SetFormat(":output/Data/Folder{}/File{}.txt", uiFile % 3, uiFile);
+      ezFileReader file;
+      if (!EZ_TEST_BOOL(file.Open(sFileName).Succeeded()))
+        continue;
+
+      fileData.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+      file.ReadBytes(fileData.GetData(), fileData.GetCount());
+
+      EZ_TEST_BOOL(archiveData == fileData);
+    }
+
+    // all distinct files are stored, the duplicates are not
+    EZ_TEST_INT(contentToDataOffset.GetCount(), 16);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Zero-copy access")
+  {
+    {
+      ezArchiveBuilder builder;
+      builder.AddFolder(ezStringBuilder(sOutputFolder, "/Data"), ezArchiveCompressionMode::Uncompressed);
+
+      ezFileWriter file;
+      if (!EZ_TEST_BOOL(file.Open(":output/Uncompressed.ezArchive").Succeeded()))
+        return;
+
+      EZ_TEST_BOOL(builder.WriteArchive(file).Succeeded());
+    }
+
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(ezStringBuilder(sOutputFolder, "/Uncompressed.ezArchive")).Succeeded()))
+      return;
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+
+    ezDynamicArray<ezUInt32> allEntries;
+    for (ezUInt32 uiEntry = 0; uiEntry < toc.m_Entries.GetCount(); ++uiEntry)
+    {
+      allEntries.PushBack(uiEntry);
+    }
+
+    // only a hint, must not change anything
+    reader.PrefetchEntries(allEntries);
+
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(ezStringBuilder(sOutputFolder, "/Uncompressed.ezArchive"), "Clear", "archive").Succeeded()))
+      return;
+
+    const ezDataDirectoryInfo* pArchiveDirInfo = ezFileSystem::FindDataDirectoryWithRoot("archive");
+    if (!EZ_TEST_BOOL(pArchiveDirInfo != nullptr))
+      return;
+
+    ezDataDirectory::ArchiveType* pArchiveDir = static_cast<ezDataDirectory::ArchiveType*>(pArchiveDirInfo->m_pDataDirType);
+
+    ezHybridArray<ezStringView, 2> prefetchFiles;
+    prefetchFiles.PushBack("Folder1/File1.txt");
+    prefetchFiles.PushBack("DoesNotExist.txt");
+    pArchiveDir->PrefetchFiles(prefetchFiles);
+
+    ezDynamicArray<ezUInt8> fileData;
+
+    for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+    {
+      sFileName.SetFormat("Folder{}/File{}.txt", uiFile % 3, uiFile);
+
+      const ezUInt32 uiEntry = toc.FindEntry(sFileName);
+      if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+        continue;
+
+      ezArrayPtr<const ezUInt8> entryData = reader.GetUncompressedEntryData(uiEntry);
+      EZ_TEST_INT(entryData.GetCount(), toc.m_Entries[uiEntry].m_uiUncompressedDataSize);
+
+      sFileName.SetFormat(":output/Data/Folder{}/File{}.txt", uiFile % 3, uiFile);
+      ezFileReader file;
+      if (!EZ_TEST_BOOL(file.Open(sFileName).Succeeded()))
+        continue;
+
+      // regular files are not memory mapped
+      EZ_TEST_BOOL(file.GetMappedData().IsEmpty());
+
+      fileData.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+      file.ReadBytes(fileData.GetData(), fileData.GetCount());
+
+      const ezArrayPtr<const ezUInt8> expectedData = fileData;
+      EZ_TEST_BOOL(entryData == expectedData);
+
+      sFileName.SetFormat(":archive/Folder{}/File{}.txt", uiFile % 3, uiFile);
+      ezFileReader archiveFile;
+      if (!EZ_TEST_BOOL(archiveFile.Open(sFileName).Succeeded()))
+        continue;
+
+      EZ_TEST_BOOL(archiveFile.GetMappedData() == expectedData);
+    }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    {
+      ezArchiveReader compressedReader;
+      if (EZ_TEST_BOOL(compressedReader.OpenArchive(sArchiveFile).Succeeded()))
+      {
+        sFileName.SetFormat("Folder{}/File{}.txt", 15 % 3, 15);
+        const ezUInt32 uiEntry = compressedReader.GetArchiveTOC().FindEntry(sFileName);
+
+        // compressed entries have to be decompressed through CreateEntryReader()
+        if (compressedReader.GetArchiveTOC().m_Entries[uiEntry].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+        {
+          EZ_TEST_BOOL(compressedReader.GetUncompressedEntryData(uiEntry).IsEmpty());
+        }
+      }
+    }
+#  endif
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Block compressed entries")
+  {
+    ezDynamicArray<ezUInt32> largeData;
+    largeData.SetCountUninitialized(512 * 1024);
+    for (ezUInt32 i = 0; i < largeData.GetCount(); ++i)
+    {
+      largeData[i] = i / 3;
+    }
+
+    {
+      ezFileWriter file;
+      if (!EZ_TEST_BOOL(file.Open(":output/BlockData/Large.bin").Succeeded()))
+        return;
+
+      file.WriteBytes(largeData.GetData(), largeData.GetCount() * sizeof(ezUInt32)).AssertSuccess();
+    }
+
+    {
+      ezArchiveBuilder builder;
+      builder.AddFolder(ezStringBuilder(sOutputFolder, "/BlockData"), ezArchiveCompressionMode::Compressed_zstd_blocks);
+
+      ezFileWriter file;
+      if (!EZ_TEST_BOOL(file.Open(":output/Blocks.ezArchive").Succeeded()))
+        return;
+
+      EZ_TEST_BOOL(builder.WriteArchive(file).Succeeded());
+    }
+
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(ezStringBuilder(sOutputFolder, "/Blocks.ezArchive")).Succeeded()))
+      return;
+
+    const ezUInt32 uiEntry = reader.GetArchiveTOC().FindEntry("Large.bin");
+    if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+      return;
+
+    EZ_TEST_BOOL(reader.GetArchiveTOC().m_Entries[uiEntry].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_blocks);
+    EZ_TEST_BOOL(reader.GetArchiveTOC().m_Entries[uiEntry].m_uiStoredDataSize < largeData.GetCount());
+
+    const ezUInt32 uiReadStart = 300 * 1024 + 3;
+    ezUInt32 uiValue = 0;
+
+    {
+      ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(uiEntry);
+      ezBlockCompressedStreamReaderZstd* pBlockReader = static_cast<ezBlockCompressedStreamReaderZstd*>(pEntryReader.Borrow());
+
+      pBlockReader->SetReadPosition(uiReadStart * sizeof(ezUInt32));
+      EZ_TEST_INT(pBlockReader->ReadBytes(&uiValue, sizeof(ezUInt32)), sizeof(ezUInt32));
+      EZ_TEST_INT(uiValue, largeData[uiReadStart]);
+    }
+
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(ezStringBuilder(sOutputFolder, "/Blocks.ezArchive"), "Clear", "blocks").Succeeded()))
+      return;
+
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":blocks/Large.bin").Succeeded()))
+      return;
+
+    EZ_TEST_INT(file.GetFileSize(), largeData.GetCount() * sizeof(ezUInt32));
+
+    // skipping jumps straight to the right block
+    EZ_TEST_INT(file.SkipBytes(uiReadStart * sizeof(ezUInt32)), uiReadStart * sizeof(ezUInt32));
+
+    ezDynamicArray<ezUInt32> readData;
+    readData.SetCount(largeData.GetCount() - uiReadStart);
+    EZ_TEST_INT(file.ReadBytes(readData.GetData(), readData.GetCount() * sizeof(ezUInt32)), readData.GetCount() * sizeof(ezUInt32));
+    EZ_TEST_BOOL(readData.GetArrayPtr() == largeData.GetArrayPtr().GetSubArray(uiReadStart));
+  }
+#  endif
+}
+
+#endif
@@ -136,4 +136,113 @@ EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstd)
   }
 }
 
+EZ_CREATE_SIMPLE_TEST(IO, BlockCompressedStreamZstd)
+{
+  ezDynamicArray<ezUInt32> TestData;
+  TestData.SetCountUninitialized(1024 * 1024);
+
+  for (ezUInt32 i = 0; i < TestData.GetCount(); ++i)
+  {
+    TestData[i] = (i / 7) ^ (i % 13);
+  }
+
+  const ezUInt32 uiBlockSize = 16 * 1024;
+  const ezUInt64 uiDataSize = TestData.GetCount() * sizeof(ezUInt32);
+
+  ezDynamicArray<ezUInt8> Compressed;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compress Data")
+  {
+    ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&Compressed);
+    ezMemoryStreamWriter writer(&storage);
+
+    ezBlockCompressedStreamWriterZstd CompressedWriter(&writer, true, ezCompressedStreamWriterZstd::Compression::Fast, uiBlockSize);
+
+    // write in odd chunk sizes, so that writes cross block and batch boundaries
+    const ezUInt8* pData = reinterpret_cast<const ezUInt8*>(TestData.GetData());
+    ezUInt64 uiWrite = 1;
+    for (ezUInt64 i = 0; i < uiDataSize;)
+    {
+      uiWrite = ezMath::Min(uiWrite, uiDataSize - i);
+      EZ_TEST_BOOL(CompressedWriter.WriteBytes(pData + i, uiWrite).Succeeded());
+
+      i += uiWrite;
+      uiWrite = uiWrite * 3 + 1;
+    }
+
+    EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+
+    EZ_TEST_INT(CompressedWriter.GetUncompressedSize(), uiDataSize);
+    EZ_TEST_INT(CompressedWriter.GetWrittenBytes(), Compressed.GetCount());
+    EZ_TEST_BOOL(Compressed.GetCount() < uiDataSize / 4);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read all")
+  {
+    ezBlockCompressedStreamReaderZstd CompressedReader;
+    if (!EZ_TEST_BOOL(CompressedReader.SetInputData(Compressed.GetData(), Compressed.GetCount()).Succeeded()))
+      return;
+
+    EZ_TEST_INT(CompressedReader.GetUncompressedSize(), uiDataSize);
+
+    // reading everything at once decompresses the blocks in parallel
+    ezDynamicArray<ezUInt32> TestDataRead;
+    TestDataRead.SetCount(TestData.GetCount());
+    EZ_TEST_INT(CompressedReader.ReadBytes(TestDataRead.GetData(), uiDataSize + 100), uiDataSize);
+    EZ_TEST_BOOL(TestData == TestDataRead);
+
+    ezUInt32 uiTemp = 0;
+    EZ_TEST_INT(CompressedReader.ReadBytes(&uiTemp, sizeof(ezUInt32)), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Random access")
+  {
+    ezBlockCompressedStreamReaderZstd CompressedReader;
+    if (!EZ_TEST_BOOL(CompressedReader.SetInputData(Compressed.GetData(), Compressed.GetCount()).Succeeded()))
+      return;
+
+    const ezUInt8* pExpected = reinterpret_cast<const ezUInt8*>(TestData.GetData());
+    ezDynamicArray<ezUInt8> ReadData;
+
+    const ezUInt64 uiReads[][2] = {
+      {uiDataSize - 10, 10},                          // the very end
+      {uiBlockSize * 3 + 100, 64},                    // within one block
+      {uiBlockSize * 5 - 7, 14},                      // across a block boundary
+      {uiBlockSize * 2, uiBlockSize * 7},             // several complete blocks
+      {uiBlockSize * 2 + 1, uiBlockSize * 7},         // several blocks, unaligned
+      {uiDataSize - uiBlockSize * 4, uiBlockSize * 4}, // complete blocks up to the end
+      {0, 3},
+    };
+
+    for (const auto& read : uiReads)
+    {
+      CompressedReader.SetReadPosition(read[0]);
+      EZ_TEST_INT(CompressedReader.GetReadPosition(), read[0]);
+
+      ReadData.SetCount(static_cast<ezUInt32>(read[1]));
+      EZ_TEST_INT(CompressedReader.ReadBytes(ReadData.GetData(), read[1]), read[1]);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(ReadData.GetData(), pExpected + read[0], ReadData.GetCount()));
+
+      EZ_TEST_INT(CompressedReader.GetReadPosition(), read[0] + read[1]);
+    }
+
+    CompressedReader.SetReadPosition(0);
+    EZ_TEST_INT(CompressedReader.SkipBytes(uiBlockSize * 10 + 5), uiBlockSize * 10 + 5);
+
+    ezUInt32 uiValue = 0;
+    EZ_TEST_INT(CompressedReader.ReadBytes(&uiValue, sizeof(ezUInt32)), sizeof(ezUInt32));
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(reinterpret_cast<const ezUInt8*>(&uiValue), pExpected + uiBlockSize * 10 + 5, sizeof(ezUInt32)));
+
+    EZ_TEST_INT(CompressedReader.SkipBytes(uiDataSize), uiDataSize - (uiBlockSize * 10 + 9));
+    EZ_TEST_INT(CompressedReader.ReadBytes(&uiValue, sizeof(ezUInt32)), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid data")
+  {
+    ezBlockCompressedStreamReaderZstd CompressedReader;
+    EZ_TEST_BOOL(CompressedReader.SetInputData(Compressed.GetData(), 10).Failed());
+    EZ_TEST_BOOL(CompressedReader.SetInputData(Compressed.GetData(), Compressed.GetCount() - 1).Failed());
+  }
+}
+
 #endif
@@ -331,4 +331,67 @@ string{\"s\\2\",\"bla\"}\n\
     ezOpenDdlReader doc;
     EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffered Input")
+  {
+    // large enough that strings, numbers and whitespace runs cross the boundaries of the chunks that streams are read in
+    ezStringBuilder sDoc;
+
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      sDoc.AppendFormat("Item $item{}\n", i);
+      sDoc.Append("{\n");
+      sDoc.AppendFormat("  string %%Name{ \"item {} with a name that is long enough to be scanned in several blocks\", \"a\\\\b\\\"{}\\\"\" }\n", i, i);
+      sDoc.AppendFormat("  float { {}.{}e-2, -1_000.5, {} } // comment\n", i, i % 10, (ezInt32)i - 1000);
+      sDoc.AppendFormat("  int32 {   {},\t\t{}  }\n", i * 3, (ezInt32)i * -7);
+      sDoc.Append("}\n");
+    }
+
+    ByteWiseStringStream byteWiseStream(sDoc.GetData());
+    StringStream chunkedStream(sDoc.GetData());
+
+    ezOpenDdlReader docs[3];
+    EZ_TEST_BOOL(docs[0].ParseDocument(byteWiseStream).Succeeded());
+    EZ_TEST_BOOL(docs[1].ParseDocument(chunkedStream).Succeeded());
+    EZ_TEST_BOOL(docs[2].ParseDocument(ezArrayPtr<const ezUInt8>((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount())).Succeeded());
+
+    ezStringBuilder sExpected;
+    WriteToString(docs[0], sExpected);
+
+    for (const ezOpenDdlReader& doc : docs)
+    {
+      EZ_TEST_INT(doc.GetRootElement()->GetNumChildObjects(), 2000);
+
+      const ezOpenDdlReaderElement* pItem = doc.FindElement("item1234");
+      if (EZ_TEST_BOOL(pItem != nullptr))
+      {
+        const ezOpenDdlReaderElement* pName = pItem->FindChild("Name");
+        if (EZ_TEST_BOOL(pName != nullptr && pName->GetNumPrimitives() == 2))
+        {
+          EZ_TEST_STRING(pName->GetPrimitivesString()[0], "item 1234 with a name that is long enough to be scanned in several blocks");
+          EZ_TEST_STRING(pName->GetPrimitivesString()[1], "a\\b\"1234\"");
+        }
+      }
+
+      ezStringBuilder sRecreation;
+      WriteToString(doc, sRecreation);
+      TestEqual(sExpected, sRecreation);
+    }
+
+    // errors must be reported at the same line and column
+    sDoc.Append("Item\n{\n  string { \"a\",\n   \"b\" 3 }\n}\n");
+
+    ByteWiseStringStream byteWiseErrorStream(sDoc.GetData());
+    StringStream chunkedErrorStream(sDoc.GetData());
+
+    ErrorCollectorLog logs[3];
+    ezOpenDdlReader errorDocs[3];
+    EZ_TEST_BOOL(errorDocs[0].ParseDocument(byteWiseErrorStream, 0, &logs[0]).Failed());
+    EZ_TEST_BOOL(errorDocs[1].ParseDocument(chunkedErrorStream, 0, &logs[1]).Failed());
+    EZ_TEST_BOOL(errorDocs[2].ParseDocument(ezArrayPtr<const ezUInt8>((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount()), 0, &logs[2]).Failed());
+
+    EZ_TEST_BOOL(logs[0].m_sErrors.StartsWith("Line 12004 (9): "));
+    EZ_TEST_STRING(logs[1].m_sErrors, logs[0].m_sErrors);
+    EZ_TEST_STRING(logs[2].m_sErrors, logs[0].m_sErrors);
+  }
 }
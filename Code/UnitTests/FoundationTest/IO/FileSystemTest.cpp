@@ -363,4 +363,44 @@ Only concrete and clocks.\n\
 
     ezFileSystem::RemoveDataDirectoryGroup("remove");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "File Index")
+  {
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":output1/Indexed/SubSub/FileSystemTest3.txt") == EZ_SUCCESS);
+    }
+
+    ezDataDirectory::FolderType::s_bUseFileIndex = true;
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder1, "remove", "indexed", ezDataDirUsage::ReadOnly) == EZ_SUCCESS);
+    ezDataDirectory::FolderType::s_bUseFileIndex = false;
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":indexed/Indexed/SubSub/FileSystemTest3.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":indexed/Indexed/SubSub/../SubSub/FileSystemTest3.txt"));
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":indexed/Indexed/SubSub/DoesNotExist.txt"));
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":indexed/DoesNotExist/FileSystemTest3.txt"));
+
+    ezFileStats stats;
+    EZ_TEST_BOOL(ezFileSystem::GetFileStats(":indexed/Indexed/SubSub", stats).Succeeded());
+    EZ_TEST_BOOL(stats.m_bIsDirectory);
+    EZ_TEST_BOOL(ezFileSystem::GetFileStats(":indexed/Indexed/SubSub/DoesNotExist.txt", stats).Failed());
+
+    {
+      ezFileReader FileIn;
+      EZ_TEST_BOOL(FileIn.Open(":indexed/Indexed/SubSub/FileSystemTest3.txt") == EZ_SUCCESS);
+    }
+
+    // files written through another data directory must show up right away
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":output1/Indexed/SubSub/FileSystemTest4.txt") == EZ_SUCCESS);
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":indexed/Indexed/SubSub/FileSystemTest4.txt"));
+
+    ezFileSystem::DeleteFile(":output1/Indexed/SubSub/FileSystemTest3.txt");
+    ezFileSystem::DeleteFile(":output1/Indexed/SubSub/FileSystemTest4.txt");
+
+    ezFileSystem::RemoveDataDirectoryGroup("remove");
+  }
 }
@@ -4,6 +4,7 @@
 
 #include <Foundation/Containers/Deque.h>
 #include <Foundation/IO/JSONReader.h>
+#include <FoundationTest/IO/JSONTestHelpers.h>
 
 namespace JSONReaderTestDetail
 {
@@ -526,4 +527,69 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONReader)
       EZ_TEST_BOOL(sCompare.IsEmpty());
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffered Input")
+  {
+    // large enough that strings, numbers and whitespace runs cross the boundaries of the chunks that streams are read in
+    ezStringBuilder sDoc = "{\n  \"items\" :\n  [\n";
+
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      sDoc.Append(i > 0 ? ",\n    { " : "    { ");
+      sDoc.AppendFormat("\"name\" : \"item {} with a name that is long enough to be scanned in several blocks\", ", i);
+      sDoc.AppendFormat("\"path\" : \"a\\\\b\\\"{}\\\"\\n\", /* comment */ \"value\" : {}, \"scale\" : {}.{}e-2,   \t\"enabled\" : {}", i, (ezInt32)i * 7 - 1000, i, i % 10, (i % 3) == 0);
+      sDoc.Append(" }");
+    }
+
+    const ezUInt32 uiValidDocLength = sDoc.GetElementCount();
+    sDoc.Append("\n  ]\n}\n");
+
+    ByteWiseStringStream byteWiseStream(sDoc.GetData());
+    StringStream chunkedStream(sDoc.GetData());
+
+    ezJSONReader readers[3];
+    EZ_TEST_BOOL(readers[0].Parse(byteWiseStream).Succeeded());
+    EZ_TEST_BOOL(readers[1].Parse(chunkedStream).Succeeded());
+    EZ_TEST_BOOL(readers[2].Parse(ezArrayPtr<const ezUInt8>((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount())).Succeeded());
+
+    for (const ezJSONReader& reader : readers)
+    {
+      const ezVariantArray& items = reader.GetTopLevelObject().GetValue("items")->Get<ezVariantArray>();
+
+      if (EZ_TEST_INT(items.GetCount(), 2000))
+      {
+        const ezVariantDictionary& item = items[1234].Get<ezVariantDictionary>();
+        EZ_TEST_STRING(item.GetValue("name")->Get<ezString>(), "item 1234 with a name that is long enough to be scanned in several blocks");
+        EZ_TEST_STRING(item.GetValue("path")->Get<ezString>(), "a\\b\"1234\"\n");
+        EZ_TEST_DOUBLE(item.GetValue("value")->Get<double>(), 7638.0, 0.0);
+        EZ_TEST_DOUBLE(item.GetValue("scale")->Get<double>(), 12.344, 0.000001);
+        EZ_TEST_BOOL(item.GetValue("enabled")->Get<bool>() == false);
+      }
+
+      EZ_TEST_BOOL(reader.GetTopLevelObject() == readers[0].GetTopLevelObject());
+    }
+
+    // errors must be reported at the same line and column
+    sDoc.Shrink(0, sDoc.GetElementCount() - uiValidDocLength);
+    sDoc.Append("\n  ]\n  \"missing comma\" : 1\n}\n");
+
+    ByteWiseStringStream byteWiseErrorStream(sDoc.GetData());
+    StringStream chunkedErrorStream(sDoc.GetData());
+
+    ErrorCollectorLog logs[3];
+    ezJSONReader errorReaders[3];
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      errorReaders[i].SetLogInterface(&logs[i]);
+    }
+
+    EZ_TEST_BOOL(errorReaders[0].Parse(byteWiseErrorStream).Failed());
+    EZ_TEST_BOOL(errorReaders[1].Parse(chunkedErrorStream).Failed());
+    EZ_TEST_BOOL(errorReaders[2].Parse(ezArrayPtr<const ezUInt8>((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount())).Failed());
+
+    EZ_TEST_BOOL(logs[0].m_sErrors.StartsWith("Line 2005 (4): "));
+    EZ_TEST_STRING(logs[1].m_sErrors, logs[0].m_sErrors);
+    EZ_TEST_STRING(logs[2].m_sErrors, logs[0].m_sErrors);
+  }
 }
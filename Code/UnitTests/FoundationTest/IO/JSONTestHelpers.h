@@ -73,3 +73,33 @@ private:
   const void* m_pData;
   ezUInt64 m_uiLength;
 };
+
+/// Returns at most one byte per ReadBytes() call, which is how the text parsers used to read their input.
+class ByteWiseStringStream : public StringStream
+{
+public:
+  ByteWiseStringStream(const void* pData)
+    : StringStream(pData)
+  {
+  }
+
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+  {
+    return StringStream::ReadBytes(pReadBuffer, ezMath::Min<ezUInt64>(uiBytesToRead, 1));
+  }
+};
+
+/// Collects all error messages, to compare the reported line and column numbers.
+class ErrorCollectorLog : public ezLogInterface
+{
+public:
+  virtual void HandleLogMessage(const ezLoggingEventData& le) override
+  {
+    if (le.m_EventType == ezLogMsgType::ErrorMsg)
+    {
+      m_sErrors.Append(le.m_sText, "\n");
+    }
+  }
+
+  ezStringBuilder m_sErrors;
+};
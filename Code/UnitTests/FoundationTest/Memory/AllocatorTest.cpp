@@ -3,6 +3,7 @@
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/Memory/MemoryTracker.h>
 
 struct alignas(EZ_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -242,4 +243,80 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sampled Tracking")
+  {
+    using SampledAllocator = ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::Sampled>;
+
+    const ezUInt32 uiPrevInterval = ezMemoryTracker::GetSamplingInterval();
+
+    ezDynamicArray<void*> allocations;
+
+    // with a tiny interval, every allocation gets sampled and the estimates are exact
+    {
+      SampledAllocator allocator("SampledTest");
+      ezMemoryTracker::SetSamplingInterval(1);
+
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        allocations.PushBack(allocator.Allocate(128, 8));
+      }
+
+      EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, 100);
+      EZ_TEST_INT(allocator.GetStats().m_uiAllocationSize, 100 * 128);
+
+      ezMemoryTracker::HeapProfileEntry entries[4];
+      const ezUInt32 uiNumEntries = ezMemoryTracker::GetSampledHeapProfile(entries, allocator.GetId());
+      EZ_TEST_BOOL(uiNumEntries >= 1);
+
+      ezUInt64 uiTotalBytes = 0;
+      for (ezUInt32 i = 0; i < ezMath::Min<ezUInt32>(uiNumEntries, EZ_ARRAY_SIZE(entries)); ++i)
+      {
+        EZ_TEST_BOOL(entries[i].m_AllocatorId == allocator.GetId());
+        uiTotalBytes += entries[i].m_uiEstimatedBytes;
+      }
+      EZ_TEST_INT(uiTotalBytes, 100 * 128);
+
+      for (void* ptr : allocations)
+      {
+        allocator.Deallocate(ptr);
+      }
+      allocations.Clear();
+
+      EZ_TEST_INT(allocator.GetStats().m_uiNumDeallocations, 100);
+      EZ_TEST_INT(allocator.GetStats().m_uiAllocationSize, 0);
+      EZ_TEST_INT(ezMemoryTracker::GetSampledHeapProfile({}, allocator.GetId()), 0);
+    }
+
+    // with a larger interval, only some allocations are sampled, but the estimate must still be close
+    {
+      SampledAllocator allocator("SampledTest");
+      ezMemoryTracker::SetSamplingInterval(4096);
+
+      constexpr ezUInt32 uiNumAllocations = 20000;
+      constexpr ezUInt32 uiSize = 256;
+
+      for (ezUInt32 i = 0; i < uiNumAllocations; ++i)
+      {
+        allocations.PushBack(allocator.Allocate(uiSize, 8));
+      }
+
+      // ~1250 samples, so the standard error is below 3%
+      const double fEstimatedSize = static_cast<double>(allocator.GetStats().m_uiAllocationSize);
+      EZ_TEST_DOUBLE(fEstimatedSize / (uiNumAllocations * uiSize), 1.0, 0.1);
+
+      const double fEstimatedCount = static_cast<double>(allocator.GetStats().m_uiNumAllocations);
+      EZ_TEST_DOUBLE(fEstimatedCount / uiNumAllocations, 1.0, 0.1);
+
+      for (void* ptr : allocations)
+      {
+        allocator.Deallocate(ptr);
+      }
+      allocations.Clear();
+
+      EZ_TEST_INT(allocator.GetStats().m_uiAllocationSize, 0);
+    }
+
+    ezMemoryTracker::SetSamplingInterval(uiPrevInterval);
+  }
 }
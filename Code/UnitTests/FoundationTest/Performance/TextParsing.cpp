@@ -0,0 +1,189 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONParser.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OpenDdlParser.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+#include <FoundationTest/IO/JSONTestHelpers.h>
+
+namespace
+{
+  constexpr ezUInt32 NUM_ITEMS = 10000;
+  constexpr ezUInt32 NUM_RUNS = 3;
+
+  void CreateJsonDocument(ezStringBuilder& out_sDoc)
+  {
+    out_sDoc = "{\n  \"items\" :\n  [\n";
+
+    for (ezUInt32 i = 0; i < NUM_ITEMS; ++i)
+    {
+      out_sDoc.Append(i > 0 ? ",\n    {\n" : "    {\n");
+      out_sDoc.AppendFormat("      \"name\" : \"item {} of the performance test document\",\n", i);
+      out_sDoc.AppendFormat("      \"position\" : [{}.25, -{}.5, 1.0e-3],\n", i, i * 3);
+      out_sDoc.AppendFormat("      \"value\" : {},\n", i * 17);
+      out_sDoc.AppendFormat("      \"enabled\" : {}\n", (i % 2) == 0);
+      out_sDoc.Append("    }");
+    }
+
+    out_sDoc.Append("\n  ]\n}\n");
+  }
+
+  void CreateDdlDocument(ezStringBuilder& out_sDoc)
+  {
+    out_sDoc.Clear();
+
+    for (ezUInt32 i = 0; i < NUM_ITEMS; ++i)
+    {
+      out_sDoc.Append("Item\n{\n");
+      out_sDoc.AppendFormat("  string %%Name{ \"item {} of the performance test document\" }\n", i);
+      out_sDoc.AppendFormat("  float %%Position{ {}.25, -{}.5, 1.0e-3 }\n", i, i * 3);
+      out_sDoc.AppendFormat("  uint32 %%Value{ {} }\n", i * 17);
+      out_sDoc.AppendFormat("  bool %%Enabled{ {} }\n", (i % 2) == 0);
+      out_sDoc.Append("}\n");
+    }
+  }
+
+  // The parsers only count the values, so that the measurement isn't dominated by building a document structure like the readers do.
+
+  class CountingJSONParser : public ezJSONParser
+  {
+  public:
+    template <typename InputType>
+    bool Parse(InputType& ref_input)
+    {
+      m_uiNumValues = 0;
+      SetInput(ref_input);
+      ParseAll();
+      return m_uiNumValues > 0 && !m_bParsingError;
+    }
+
+    ezUInt32 m_uiNumValues = 0;
+    bool m_bParsingError = false;
+
+  private:
+    void SetInput(ezStreamReader& ref_stream) { SetInputStream(ref_stream); }
+    void SetInput(ezArrayPtr<const ezUInt8>& ref_data) { SetInputData(ref_data); }
+
+    virtual bool OnVariable(ezStringView sVarName) override { return true; }
+    virtual void OnReadValue(ezStringView sValue) override { ++m_uiNumValues; }
+    virtual void OnReadValue(double fValue) override { ++m_uiNumValues; }
+    virtual void OnReadValue(bool bValue) override { ++m_uiNumValues; }
+    virtual void OnReadValueNULL() override { ++m_uiNumValues; }
+    virtual void OnBeginObject() override {}
+    virtual void OnEndObject() override {}
+    virtual void OnBeginArray() override {}
+    virtual void OnEndArray() override {}
+    virtual void OnParsingError(ezStringView sMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override { m_bParsingError = true; }
+  };
+
+  class CountingOpenDdlParser : public ezOpenDdlParser
+  {
+  public:
+    template <typename InputType>
+    bool Parse(InputType& ref_input)
+    {
+      m_uiNumValues = 0;
+      SetInput(ref_input);
+      return ParseAll().Succeeded() && m_uiNumValues > 0;
+    }
+
+    ezUInt32 m_uiNumValues = 0;
+
+  private:
+    void SetInput(ezStreamReader& ref_stream) { SetInputStream(ref_stream); }
+    void SetInput(ezArrayPtr<const ezUInt8>& ref_data) { SetInputData(ref_data); }
+
+    virtual void OnBeginObject(ezStringView sType, ezStringView sName, bool bGlobalName) override {}
+    virtual void OnEndObject() override {}
+    virtual void OnBeginPrimitiveList(ezOpenDdlPrimitiveType type, ezStringView sName, bool bGlobalName) override {}
+    virtual void OnEndPrimitiveList() override {}
+    virtual void OnPrimitiveBool(ezUInt32 count, const bool* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt8(ezUInt32 count, const ezInt8* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt16(ezUInt32 count, const ezInt16* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt32(ezUInt32 count, const ezInt32* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveInt64(ezUInt32 count, const ezInt64* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt8(ezUInt32 count, const ezUInt8* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt16(ezUInt32 count, const ezUInt16* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt32(ezUInt32 count, const ezUInt32* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveUInt64(ezUInt32 count, const ezUInt64* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveFloat(ezUInt32 count, const float* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveDouble(ezUInt32 count, const double* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+    virtual void OnPrimitiveString(ezUInt32 count, const ezStringView* pData, bool bThisIsAll) override { m_uiNumValues += count; }
+  };
+
+  /// Returns the throughput of the best run in MB/s.
+  template <typename ParseFunc>
+  double MeasureThroughput(ezUInt32 uiNumBytes, ParseFunc parse)
+  {
+    double fBestSeconds = ezMath::MaxValue<double>();
+
+    for (ezUInt32 uiRun = 0; uiRun < NUM_RUNS; ++uiRun)
+    {
+      const ezTime t0 = ezTime::Now();
+      EZ_TEST_BOOL(parse());
+      fBestSeconds = ezMath::Min(fBestSeconds, (ezTime::Now() - t0).GetSeconds());
+    }
+
+    return uiNumBytes / (1024.0 * 1024.0) / fBestSeconds;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, TextParsing)
+{
+  // The byte-wise stream hands out a single byte per ReadBytes() call, which is how the parsers used to read all input.
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "JSON")
+  {
+    ezStringBuilder sDoc;
+    CreateJsonDocument(sDoc);
+    const ezArrayPtr<const ezUInt8> data((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount());
+
+    const double fByteWise = MeasureThroughput(data.GetCount(), [&]()
+      {
+        ByteWiseStringStream stream(sDoc.GetData());
+        CountingJSONParser parser;
+        return parser.Parse(stream); });
+
+    const double fStream = MeasureThroughput(data.GetCount(), [&]()
+      {
+        ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
+        CountingJSONParser parser;
+        return parser.Parse(stream); });
+
+    const double fMemory = MeasureThroughput(data.GetCount(), [&]()
+      {
+        ezArrayPtr<const ezUInt8> input = data;
+        CountingJSONParser parser;
+        return parser.Parse(input); });
+
+    ezLog::Info("[test]JSON parsing {} KB: byte-wise stream {} MB/s, stream {} MB/s, memory {} MB/s", data.GetCount() / 1024, ezArgF(fByteWise, 1), ezArgF(fStream, 1), ezArgF(fMemory, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OpenDDL")
+  {
+    ezStringBuilder sDoc;
+    CreateDdlDocument(sDoc);
+    const ezArrayPtr<const ezUInt8> data((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount());
+
+    const double fByteWise = MeasureThroughput(data.GetCount(), [&]()
+      {
+        ByteWiseStringStream stream(sDoc.GetData());
+        CountingOpenDdlParser parser;
+        return parser.Parse(stream); });
+
+    const double fStream = MeasureThroughput(data.GetCount(), [&]()
+      {
+        ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
+        CountingOpenDdlParser parser;
+        return parser.Parse(stream); });
+
+    const double fMemory = MeasureThroughput(data.GetCount(), [&]()
+      {
+        ezArrayPtr<const ezUInt8> input = data;
+        CountingOpenDdlParser parser;
+        return parser.Parse(input); });
+
+    ezLog::Info("[test]OpenDDL parsing {} KB: byte-wise stream {} MB/s, stream {} MB/s, memory {} MB/s", data.GetCount() / 1024, ezArgF(fByteWise, 1), ezArgF(fStream, 1), ezArgF(fMemory, 1));
+  }
+}
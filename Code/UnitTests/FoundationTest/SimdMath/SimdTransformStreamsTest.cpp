@@ -0,0 +1,114 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdTransformStreams.h>
+
+namespace
+{
+  ezSimdTransform CreateRandomTransform(ezRandom& ref_rng)
+  {
+    const ezSimdVec4f vAxis = ezSimdVec4f((float)ref_rng.DoubleMinMax(-1, 1), (float)ref_rng.DoubleMinMax(-1, 1), 1.0f).GetNormalized<3>();
+
+    ezSimdTransform t;
+    t.m_Position.Set((float)ref_rng.DoubleMinMax(-100, 100), (float)ref_rng.DoubleMinMax(-100, 100), (float)ref_rng.DoubleMinMax(-100, 100), 0.0f);
+    t.m_Rotation = ezSimdQuat::MakeFromAxisAndAngle(vAxis, ezAngle::MakeFromDegree((float)ref_rng.DoubleMinMax(-180, 180)));
+    t.m_Scale.Set((float)ref_rng.DoubleMinMax(0.5, 2), (float)ref_rng.DoubleMinMax(0.5, 2), (float)ref_rng.DoubleMinMax(0.5, 2), 1.0f);
+    return t;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdTransformStreams)
+{
+  ezRandom rng;
+  rng.Initialize(42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetCount / SetTransform / GetTransform")
+  {
+    ezSimdTransformStreams streams;
+    EZ_TEST_INT(streams.GetCount(), 0);
+
+    streams.SetCount(7);
+    EZ_TEST_INT(streams.GetCount(), 7);
+
+    for (ezUInt32 i = 0; i < streams.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(streams.GetTransform(i).IsEqual(ezSimdTransform::MakeIdentity(), 0.0f));
+    }
+
+    ezSimdTransform transforms[7];
+    for (ezUInt32 i = 0; i < 7; ++i)
+    {
+      transforms[i] = CreateRandomTransform(rng);
+      streams.SetTransform(i, transforms[i]);
+    }
+
+    for (ezUInt32 i = 0; i < 7; ++i)
+    {
+      EZ_TEST_BOOL(streams.GetTransform(i).IsEqual(transforms[i], 0.0f));
+    }
+
+    // growing keeps the existing elements and initializes the new ones, including the old padding
+    streams.SetCount(13);
+
+    for (ezUInt32 i = 0; i < 7; ++i)
+    {
+      EZ_TEST_BOOL(streams.GetTransform(i).IsEqual(transforms[i], 0.0f));
+    }
+
+    for (ezUInt32 i = 7; i < 13; ++i)
+    {
+      EZ_TEST_BOOL(streams.GetTransform(i).IsEqual(ezSimdTransform::MakeIdentity(), 0.0f));
+    }
+
+    // shrinking resets the elements that became padding, so growing again within the same vector does not bring back stale data
+    streams.SetCount(5);
+    streams.SetCount(7);
+
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      EZ_TEST_BOOL(streams.GetTransform(i).IsEqual(transforms[i], 0.0f));
+    }
+
+    for (ezUInt32 i = 5; i < 7; ++i)
+    {
+      EZ_TEST_BOOL(streams.GetTransform(i).IsEqual(ezSimdTransform::MakeIdentity(), 0.0f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MakeGlobalTransforms")
+  {
+    constexpr ezUInt32 uiNumParents = 5;
+    constexpr ezUInt32 uiNumChildren = 23;
+
+    ezSimdTransformStreams parents;
+    parents.SetCount(uiNumParents);
+    for (ezUInt32 i = 0; i < uiNumParents; ++i)
+    {
+      parents.SetTransform(i, CreateRandomTransform(rng));
+    }
+
+    // mix groups of siblings with children of different parents
+    ezDynamicArray<ezUInt32> parentIndices;
+    ezSimdTransformStreams locals;
+    locals.SetCount(uiNumChildren);
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      parentIndices.PushBack(i < 8 ? i / 4 : rng.UIntInRange(uiNumParents));
+      locals.SetTransform(i, CreateRandomTransform(rng));
+    }
+
+    ezSimdTransformStreams globals;
+    ezSimdTransformStreams::MakeGlobalTransforms(parents, parentIndices, locals, globals);
+    EZ_TEST_INT(globals.GetCount(), uiNumChildren);
+
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      const ezSimdTransform expected = ezSimdTransform::MakeGlobalTransform(parents.GetTransform(parentIndices[i]), locals.GetTransform(i));
+      const ezSimdTransform result = globals.GetTransform(i);
+
+      EZ_TEST_BOOL(result.m_Position.IsEqual(expected.m_Position, 0.001f).AllSet<3>());
+      EZ_TEST_BOOL(result.m_Rotation.IsEqualRotation(expected.m_Rotation, 0.0001f));
+      EZ_TEST_BOOL(result.m_Scale.IsEqual(expected.m_Scale, 0.0001f).AllSet<3>());
+    }
+  }
+}
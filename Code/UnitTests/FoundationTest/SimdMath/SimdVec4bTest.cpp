@@ -100,5 +100,10 @@ EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec4b)
     ezSimdVec4b cmp(false, true, false, true);
     c = ezSimdVec4b::Select(cmp, a, b);
     EZ_TEST_BOOL(!c.x() && !c.y() && c.z() && !c.w());
+
+    EZ_TEST_INT(a.GetMask(), 0x5);
+    EZ_TEST_INT(cmp.GetMask(), 0xA);
+    EZ_TEST_INT(ezSimdVec4b(true).GetMask(), 0xF);
+    EZ_TEST_INT(ezSimdVec4b(false).GetMask(), 0x0);
   }
 }
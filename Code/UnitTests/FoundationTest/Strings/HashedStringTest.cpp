@@ -1,6 +1,48 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  class HashingThread : public ezThread
+  {
+  public:
+    HashingThread()
+      : ezThread("HashedString Test Thread")
+    {
+    }
+
+    ezUInt32 m_uiThreadIndex = 0;
+    ezUInt32 m_uiNumThreads = 0;
+    ezUInt32 m_uiNumStrings = 0;
+    ezAtomicInteger32* m_pErrors = nullptr;
+
+    virtual ezUInt32 Run()
+    {
+      ezStringBuilder sTemp;
+      ezHashedString hs;
+
+      for (ezUInt32 i = 0; i < m_uiNumStrings; ++i)
+      {
+        // half of the strings are the same in all threads, the other half is unique to this thread
+        // every thread count uses its own set of strings, so that no pass finds the strings of a previous one
+        if (i % 2 == 0)
+          sTemp.SetFormat("SharedString_{}_{}", m_uiNumThreads, i);
+        else
+          sTemp.SetFormat("Thread{}_{}_String_{}", m_uiNumThreads, m_uiThreadIndex, i);
+
+        hs.Assign(sTemp);
+
+        if (hs.GetView() != sTemp)
+          m_pErrors->Increment();
+      }
+
+      return 0;
+    }
+  };
+} // namespace
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -185,6 +227,56 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_STRING(s3.GetString().GetData(), "tut");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multithreaded")
+  {
+    constexpr ezUInt32 uiNumStrings = 20000;
+
+    ezTime tSingleThread;
+
+    for (ezUInt32 uiNumThreads = 1; uiNumThreads <= 8; uiNumThreads *= 2)
+    {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+      // drop the strings of the previous pass, so that every pass inserts into a table of the same size
+      ezHashedString::ClearUnusedStrings();
+#endif
+
+      ezAtomicInteger32 iErrors = 0;
+      ezUniquePtr<HashingThread> pThreads[8];
+
+      const ezTime tStart = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+      {
+        pThreads[i] = EZ_DEFAULT_NEW(HashingThread);
+        pThreads[i]->m_uiThreadIndex = i;
+        pThreads[i]->m_uiNumThreads = uiNumThreads;
+        pThreads[i]->m_uiNumStrings = uiNumStrings;
+        pThreads[i]->m_pErrors = &iErrors;
+        pThreads[i]->Start();
+      }
+
+      for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+      {
+        pThreads[i]->Join();
+      }
+
+      const ezTime tDuration = ezTime::Now() - tStart;
+
+      if (uiNumThreads == 1)
+        tSingleThread = tDuration;
+
+      EZ_TEST_INT(iErrors, 0);
+
+      // with perfect scaling the duration would stay the same, as every thread hashes the same amount of strings
+      ezLog::Info("[test]{} threads hashed {} strings each: {}ms, throughput {}x of a single thread", uiNumThreads, uiNumStrings, ezArgF(tDuration.GetMilliseconds(), 3),
+        ezArgF(uiNumThreads * tSingleThread.GetSeconds() / tDuration.GetSeconds(), 2));
+    }
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    ezHashedString::ClearUnusedStrings();
+#endif
+  }
+
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ClearUnusedStrings")
   {
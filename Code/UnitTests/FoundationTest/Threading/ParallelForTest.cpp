@@ -8,6 +8,26 @@ namespace
   static constexpr ezUInt32 s_uiNumberOfWorkers = 4;
   static constexpr ezUInt32 s_uiTaskItemSliceSize = 25;
   static constexpr ezUInt32 s_uiTotalNumberOfTaskItems = s_uiNumberOfWorkers * s_uiTaskItemSliceSize;
+
+  /// Burns CPU time proportional to the given cost, so that items can be made arbitrarily expensive.
+  ezUInt32 SimulateWork(ezUInt32 uiItem, ezUInt32 uiCost)
+  {
+    ezUInt32 uiHash = uiItem;
+    for (ezUInt32 i = 0; i < uiCost * 64; ++i)
+    {
+      uiHash = uiHash * 1664525u + 1013904223u;
+    }
+    return uiHash;
+  }
+
+  /// Uniform workloads cost the same for every item, skewed workloads put most of the work into the last tenth of the items.
+  ezUInt32 GetItemCost(ezUInt32 uiItem, ezUInt32 uiNumItems, bool bSkewed)
+  {
+    if (!bSkewed)
+      return 4;
+
+    return (uiItem >= uiNumItems - uiNumItems / 10) ? 64 : 1;
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Threading, ParallelFor)
@@ -76,6 +96,37 @@ EZ_CREATE_SIMPLE_TEST(Threading, ParallelFor)
     EZ_TEST_INT(uiNumbersSum, uiNumbersCheckSum);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel For (Indexed, Start Index)")
+  {
+    constexpr ezUInt32 uiStartIndex = 1000;
+
+    ezUInt32 uiIndexSum = 0;
+    uiRangesEncounteredCheck = 0;
+
+    // every slice must lie inside [uiStartIndex; uiStartIndex + numItems), also when the range is split across several tasks
+    ezTaskSystem::ParallelForIndexed(
+      uiStartIndex, ::s_uiTotalNumberOfTaskItems,
+      [&](ezUInt32 uiSliceStart, ezUInt32 uiSliceEnd)
+      {
+        EZ_LOCK(dataAccessMutex);
+
+        EZ_TEST_BOOL(uiSliceStart >= uiStartIndex);
+        EZ_TEST_BOOL(uiSliceEnd <= uiStartIndex + ::s_uiTotalNumberOfTaskItems);
+        EZ_TEST_INT(uiSliceEnd - uiSliceStart, ::s_uiTaskItemSliceSize);
+
+        uiRangesEncounteredCheck |= 1 << ((uiSliceStart - uiStartIndex) / ::s_uiTaskItemSliceSize);
+
+        for (ezUInt32 uiIndex = uiSliceStart; uiIndex < uiSliceEnd; ++uiIndex)
+        {
+          uiIndexSum += uiIndex;
+        }
+      },
+      "ParallelForIndexed Start Index Test", ezTaskNesting::Never, parallelForParams);
+
+    EZ_TEST_INT(uiRangesEncounteredCheck, 0b1111);
+    EZ_TEST_INT(uiIndexSum, uiStartIndex * ::s_uiTotalNumberOfTaskItems + (::s_uiTotalNumberOfTaskItems * (::s_uiTotalNumberOfTaskItems - 1)) / 2);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel For (Array)")
   {
     // reset
@@ -221,4 +272,164 @@ EZ_CREATE_SIMPLE_TEST(Threading, ParallelFor)
     // check the resulting sum
     EZ_TEST_INT(uiNumbersSum, 4 * uiNumbersCheckSum);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel For (Adaptive)")
+  {
+    constexpr ezUInt32 uiNumItems = 10000;
+    constexpr ezUInt32 uiMinChunkSize = 16;
+
+    ezParallelForParams adaptiveParams;
+    adaptiveParams.m_uiBinSize = uiMinChunkSize;
+    adaptiveParams.m_Partitioning = ezParallelForPartitioning::Adaptive;
+
+    ezDynamicArray<ezUInt32> visited;
+    visited.SetCount(uiNumItems);
+
+    ezAtomicInteger32 iEmptyChunks = 0;
+    ezAtomicInteger32 iWorkResult = 0;
+
+    // every index must be visited exactly once, even though the ranges get split up while they are being processed
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumItems,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        if (uiStartIndex >= uiEndIndex)
+          iEmptyChunks.Increment();
+
+        ezUInt32 uiLocal = 0;
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          visited[i] += 1;
+          uiLocal ^= SimulateWork(i, GetItemCost(i, uiNumItems, true));
+        }
+
+        iWorkResult.Add(static_cast<ezInt32>(uiLocal & 1));
+      },
+      "ParallelFor Adaptive Indexed Test", ezTaskNesting::Never, adaptiveParams);
+
+    ezUInt32 uiNumVisitedOnce = 0;
+    for (ezUInt32 i = 0; i < uiNumItems; ++i)
+    {
+      if (visited[i] == 1)
+        ++uiNumVisitedOnce;
+    }
+
+    EZ_TEST_INT(uiNumVisitedOnce, uiNumItems);
+    EZ_TEST_INT(iEmptyChunks, 0);
+
+    // the same through the 64 bit variant, with an offset start index
+    ezAtomicInteger64 iSum = 0;
+    ezTaskSystem::ParallelForIndexed(
+      ezUInt64(1000), ezUInt64(uiNumItems),
+      [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
+      {
+        ezInt64 iLocalSum = 0;
+        for (ezUInt64 i = uiStartIndex; i < uiEndIndex; ++i)
+          iLocalSum += static_cast<ezInt64>(i);
+
+        iSum.Add(iLocalSum);
+      },
+      "ParallelFor Adaptive Indexed64 Test", ezTaskNesting::Never, adaptiveParams);
+
+    EZ_TEST_INT(iSum, (ezInt64(1000 + uiNumItems) * (1000 + uiNumItems - 1)) / 2 - (ezInt64(1000) * 999) / 2);
+
+    // array variants hand out correctly offset sub-arrays
+    ezDynamicArray<ezUInt32> values;
+    values.SetCount(uiNumItems);
+    for (ezUInt32 i = 0; i < uiNumItems; ++i)
+      values[i] = i;
+
+    ezAtomicInteger32 iMismatches = 0;
+    ezTaskSystem::ParallelForSingleIndex(
+      values.GetArrayPtr(),
+      [&](ezUInt32 uiIndex, ezUInt32& ref_uiValue)
+      {
+        if (uiIndex != ref_uiValue)
+          iMismatches.Increment();
+
+        ref_uiValue *= 2;
+      },
+      "ParallelFor Adaptive Array Test", adaptiveParams);
+
+    EZ_TEST_INT(iMismatches, 0);
+
+    ezUInt64 uiValueSum = 0;
+    for (ezUInt32 i = 0; i < uiNumItems; ++i)
+      uiValueSum += values[i];
+
+    EZ_TEST_INT(uiValueSum, ezUInt64(uiNumItems) * (uiNumItems - 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance (Static vs. Adaptive)")
+  {
+    constexpr ezUInt32 uiNumItems = 20000;
+    constexpr ezUInt32 uiNumRuns = 5;
+
+    ezDynamicArray<ezUInt32> items;
+    items.SetCount(uiNumItems);
+    for (ezUInt32 i = 0; i < uiNumItems; ++i)
+      items[i] = i;
+
+    for (ezUInt32 uiSkewed = 0; uiSkewed < 2; ++uiSkewed)
+    {
+      const bool bSkewed = uiSkewed != 0;
+
+      for (ezUInt32 uiMode = 0; uiMode < 2; ++uiMode)
+      {
+        ezParallelForParams params;
+        params.m_uiBinSize = 32;
+        params.m_Partitioning = uiMode == 0 ? ezParallelForPartitioning::Static : ezParallelForPartitioning::Adaptive;
+
+        ezAtomicInteger32 iResult = 0;
+        ezTime tIndexed, tArray, tSingle;
+
+        for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+        {
+          ezTime tStart = ezTime::Now();
+
+          ezTaskSystem::ParallelForIndexed(
+            0, uiNumItems,
+            [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+            {
+              ezUInt32 uiLocal = 0;
+              for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+                uiLocal ^= SimulateWork(i, GetItemCost(i, uiNumItems, bSkewed));
+              iResult.Add(static_cast<ezInt32>(uiLocal & 1));
+            },
+            "ParallelFor Benchmark Indexed", ezTaskNesting::Never, params);
+
+          tIndexed += ezTime::Now() - tStart;
+          tStart = ezTime::Now();
+
+          ezTaskSystem::ParallelFor(
+            items.GetArrayPtr(),
+            [&](ezArrayPtr<ezUInt32> slice)
+            {
+              ezUInt32 uiLocal = 0;
+              for (ezUInt32 uiItem : slice)
+                uiLocal ^= SimulateWork(uiItem, GetItemCost(uiItem, uiNumItems, bSkewed));
+              iResult.Add(static_cast<ezInt32>(uiLocal & 1));
+            },
+            "ParallelFor Benchmark Array", params);
+
+          tArray += ezTime::Now() - tStart;
+          tStart = ezTime::Now();
+
+          ezTaskSystem::ParallelForSingle(
+            items.GetArrayPtr(),
+            [&](ezUInt32 uiItem)
+            {
+              if (SimulateWork(uiItem, GetItemCost(uiItem, uiNumItems, bSkewed)) == 0)
+                iResult.Increment();
+            },
+            "ParallelFor Benchmark Single", params);
+
+          tSingle += ezTime::Now() - tStart;
+        }
+
+        ezLog::Info("[test]{} workload, {} partitioning: ParallelForIndexed {}ms, ParallelFor {}ms, ParallelForSingle {}ms", bSkewed ? "Skewed" : "Uniform", uiMode == 0 ? "static" : "adaptive",
+          ezArgF(tIndexed.GetMilliseconds() / uiNumRuns, 3), ezArgF(tArray.GetMilliseconds() / uiNumRuns, 3), ezArgF(tSingle.GetMilliseconds() / uiNumRuns, 3));
+      }
+    }
+  }
 }
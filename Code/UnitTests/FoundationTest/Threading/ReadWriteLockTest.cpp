@@ -0,0 +1,185 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/ReadWriteLock.h>
+
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  struct SharedState
+  {
+    ezReadWriteLock m_Lock;
+    ezAtomicInteger32 m_iActiveReaders;
+    ezAtomicInteger32 m_iActiveWriters;
+    ezAtomicInteger32 m_iErrors;
+
+    // only modified while the exclusive lock is held, so non-atomic
+    ezUInt32 m_uiValueA = 0;
+    ezUInt32 m_uiValueB = 0;
+  };
+
+  class ReaderWriterThread : public ezThread
+  {
+  public:
+    ReaderWriterThread()
+      : ezThread("ReadWriteLock Test Thread")
+    {
+    }
+
+    SharedState* m_pState = nullptr;
+    bool m_bWriter = false;
+
+    virtual ezUInt32 Run()
+    {
+      for (ezUInt32 i = 0; i < 200; ++i)
+      {
+        if (m_bWriter)
+        {
+          EZ_LOCK(m_pState->m_Lock);
+
+          if (m_pState->m_iActiveReaders != 0 || m_pState->m_iActiveWriters.Increment() != 1)
+            m_pState->m_iErrors.Increment();
+
+          ++m_pState->m_uiValueA;
+          ezThreadUtils::YieldTimeSlice();
+          ++m_pState->m_uiValueB;
+
+          // the writer may take (recursive) read locks as well
+          {
+            EZ_LOCK_READ(m_pState->m_Lock);
+            EZ_LOCK(m_pState->m_Lock);
+          }
+
+          m_pState->m_iActiveWriters.Decrement();
+        }
+        else
+        {
+          EZ_LOCK_READ(m_pState->m_Lock);
+
+          m_pState->m_iActiveReaders.Increment();
+
+          if (m_pState->m_iActiveWriters != 0 || m_pState->m_uiValueA != m_pState->m_uiValueB)
+            m_pState->m_iErrors.Increment();
+
+          // recursive read locks must not block, even if a writer is waiting
+          {
+            EZ_LOCK_READ(m_pState->m_Lock);
+            ezThreadUtils::Sleep(ezTime::MakeFromMicroseconds(100));
+          }
+
+          m_pState->m_iActiveReaders.Decrement();
+        }
+      }
+
+      return 0;
+    }
+  };
+
+  class BarrierReaderThread : public ezThread
+  {
+  public:
+    BarrierReaderThread()
+      : ezThread("ReadWriteLock Barrier Thread")
+    {
+    }
+
+    ezReadWriteLock* m_pLock = nullptr;
+    ezAtomicInteger32* m_pNumArrived = nullptr;
+    ezInt32 m_iNumThreads = 0;
+    bool m_bAllArrived = false;
+
+    virtual ezUInt32 Run()
+    {
+      EZ_LOCK_READ(*m_pLock);
+
+      // every thread holds its read lock until all threads have arrived, which only works if the readers don't exclude each other
+      m_pNumArrived->Increment();
+
+      const ezTime tTimeout = ezTime::Now() + ezTime::MakeFromSeconds(10);
+      while (*m_pNumArrived < m_iNumThreads && ezTime::Now() < tTimeout)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      m_bAllArrived = *m_pNumArrived == m_iNumThreads;
+      return 0;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Threading, ReadWriteLock)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Single Thread")
+  {
+    ezReadWriteLock lock;
+
+    {
+      EZ_LOCK_READ(lock);
+      EZ_LOCK_READ(lock);
+      EZ_TEST_BOOL(!lock.IsWriteLocked());
+    }
+
+    {
+      EZ_LOCK(lock);
+      EZ_TEST_BOOL(lock.IsWriteLocked());
+
+      EZ_LOCK(lock);
+      EZ_LOCK_READ(lock);
+      EZ_TEST_BOOL(lock.IsWriteLocked());
+    }
+
+    EZ_TEST_BOOL(!lock.IsWriteLocked());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Readers and Writers")
+  {
+    constexpr ezUInt32 uiNumThreads = 16;
+
+    SharedState state;
+    ezUniquePtr<ReaderWriterThread> pThreads[uiNumThreads];
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      pThreads[i] = EZ_DEFAULT_NEW(ReaderWriterThread);
+      pThreads[i]->m_pState = &state;
+      pThreads[i]->m_bWriter = (i % 4) == 0;
+      pThreads[i]->Start();
+    }
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      pThreads[i]->Join();
+    }
+
+    EZ_TEST_INT(state.m_iErrors, 0);
+    EZ_TEST_INT(state.m_uiValueA, 4 * 200);
+    EZ_TEST_INT(state.m_uiValueB, 4 * 200);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent Readers")
+  {
+    constexpr ezUInt32 uiNumThreads = 8;
+
+    ezReadWriteLock lock;
+    ezAtomicInteger32 iNumArrived;
+    ezUniquePtr<BarrierReaderThread> pThreads[uiNumThreads];
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      pThreads[i] = EZ_DEFAULT_NEW(BarrierReaderThread);
+      pThreads[i]->m_pLock = &lock;
+      pThreads[i]->m_pNumArrived = &iNumArrived;
+      pThreads[i]->m_iNumThreads = uiNumThreads;
+      pThreads[i]->Start();
+    }
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      pThreads[i]->Join();
+      EZ_TEST_BOOL(pThreads[i]->m_bAllArrived);
+    }
+
+    EZ_TEST_BOOL(!lock.IsWriteLocked());
+  }
+}
@@ -0,0 +1,227 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskGraph.h>
+#include <Foundation/Time/Time.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  class ezGraphTestTask final : public ezTask
+  {
+  public:
+    ezGraphTestTask(ezAtomicInteger32* pSequence, ezTaskNesting nesting = ezTaskNesting::Never)
+      : m_pSequence(pSequence)
+    {
+      ConfigureTask("ezGraphTestTask", nesting);
+    }
+
+    ezInt32 m_iStarted = -1;
+    ezInt32 m_iFinished = -1;
+    mutable ezAtomicInteger32 m_iNumInvocations;
+
+  private:
+    virtual void Execute() override
+    {
+      m_iStarted = m_pSequence->Increment();
+      m_iNumInvocations.Increment();
+      m_iFinished = m_pSequence->Increment();
+    }
+
+    virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
+    {
+      EZ_IGNORE_UNUSED(uiInvocation);
+      m_iNumInvocations.Increment();
+    }
+
+    ezAtomicInteger32* m_pSequence;
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Threading, TaskGraph)
+{
+  ezTaskSystem::SetWorkerThreadCount(4, 4);
+
+  ezAtomicInteger32 iSequence = 0;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dependencies")
+  {
+    // diamond: 0 -> (1, 2) -> 3, plus an unrelated node 4 and a multiplicity node 5 that depends on 3
+    ezSharedPtr<ezGraphTestTask> tasks[6];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(tasks); ++i)
+    {
+      tasks[i] = EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence);
+    }
+
+    tasks[5]->SetMultiplicity(16);
+
+    ezTaskGraph graph;
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(tasks); ++i)
+    {
+      EZ_TEST_INT(graph.AddNode(tasks[i]), i);
+    }
+
+    graph.AddDependency(1, 0);
+    graph.AddDependency(2, 0);
+    graph.AddDependency(3, 1);
+    graph.AddDependency(3, 2);
+    graph.AddDependency(5, 3);
+
+    EZ_TEST_BOOL(graph.Compile().Succeeded());
+
+    for (ezUInt32 uiRun = 0; uiRun < 10; ++uiRun)
+    {
+      ezTaskGroupID group = graph.Launch();
+      ezTaskSystem::WaitForGroup(group);
+
+      EZ_TEST_BOOL(!graph.IsRunning());
+      EZ_TEST_BOOL(tasks[1]->m_iStarted > tasks[0]->m_iFinished);
+      EZ_TEST_BOOL(tasks[2]->m_iStarted > tasks[0]->m_iFinished);
+      EZ_TEST_BOOL(tasks[3]->m_iStarted > tasks[1]->m_iFinished);
+      EZ_TEST_BOOL(tasks[3]->m_iStarted > tasks[2]->m_iFinished);
+
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(tasks); ++i)
+      {
+        EZ_TEST_BOOL(tasks[i]->IsTaskFinished());
+      }
+    }
+
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      EZ_TEST_INT(tasks[i]->m_iNumInvocations, 10);
+    }
+
+    EZ_TEST_INT(tasks[5]->m_iNumInvocations, 160);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Group Dependencies")
+  {
+    ezSharedPtr<ezGraphTestTask> pBefore = EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence);
+    ezSharedPtr<ezGraphTestTask> pAfter = EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence);
+    ezSharedPtr<ezGraphTestTask> pNode0 = EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence);
+    ezSharedPtr<ezGraphTestTask> pNode1 = EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence);
+
+    ezTaskGraph graph;
+    graph.AddNode(pNode0);
+    graph.AddNode(pNode1);
+    graph.AddDependency(1, 0);
+
+    // the graph waits for a regular group and another group waits for the graph
+    ezTaskGroupID beforeGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+    ezTaskSystem::AddTaskToGroup(beforeGroup, pBefore);
+
+    ezTaskGroupID graphGroup = graph.Launch(ezTaskPriority::ThisFrame, beforeGroup);
+
+    ezTaskGroupID afterGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+    ezTaskSystem::AddTaskToGroup(afterGroup, pAfter);
+    ezTaskSystem::AddTaskGroupDependency(afterGroup, graphGroup);
+
+    ezTaskSystem::StartTaskGroup(afterGroup);
+    ezTaskSystem::StartTaskGroup(beforeGroup);
+
+    ezTaskSystem::WaitForGroup(afterGroup);
+
+    EZ_TEST_BOOL(pNode0->m_iStarted > pBefore->m_iFinished);
+    EZ_TEST_BOOL(pNode1->m_iStarted > pNode0->m_iFinished);
+    EZ_TEST_BOOL(pAfter->m_iStarted > pNode1->m_iFinished);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cycles")
+  {
+    ezTaskGraph graph;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      graph.AddNode(EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence));
+    }
+
+    graph.AddDependency(1, 0);
+    graph.AddDependency(2, 1);
+    EZ_TEST_BOOL(graph.Compile().Succeeded());
+
+    graph.AddDependency(0, 2);
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("cyclic dependency", ezLogMsgType::ErrorMsg);
+
+    EZ_TEST_BOOL(graph.Compile().Failed());
+
+    graph.Clear();
+    EZ_TEST_INT(graph.GetNodeCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance (Graph vs. Groups)")
+  {
+    // layers of nodes, where every node depends on two nodes of the previous layer
+    constexpr ezUInt32 uiNumLayers = 16;
+    constexpr ezUInt32 uiNodesPerLayer = 32;
+    constexpr ezUInt32 uiNumRuns = 20;
+
+    ezDynamicArray<ezSharedPtr<ezGraphTestTask>> tasks;
+    for (ezUInt32 i = 0; i < uiNumLayers * uiNodesPerLayer; ++i)
+    {
+      tasks.PushBack(EZ_DEFAULT_NEW(ezGraphTestTask, &iSequence));
+    }
+
+    ezTaskGraph graph;
+    for (ezUInt32 i = 0; i < tasks.GetCount(); ++i)
+    {
+      graph.AddNode(tasks[i]);
+    }
+
+    for (ezUInt32 uiLayer = 1; uiLayer < uiNumLayers; ++uiLayer)
+    {
+      for (ezUInt32 i = 0; i < uiNodesPerLayer; ++i)
+      {
+        const ezUInt32 uiNode = uiLayer * uiNodesPerLayer + i;
+        graph.AddDependency(uiNode, uiNode - uiNodesPerLayer);
+        graph.AddDependency(uiNode, (uiLayer - 1) * uiNodesPerLayer + (i + 1) % uiNodesPerLayer);
+      }
+    }
+
+    ezTime tGraph;
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      const ezTime tStart = ezTime::Now();
+      ezTaskSystem::WaitForGroup(graph.Launch());
+      tGraph += ezTime::Now() - tStart;
+    }
+
+    graph.Clear();
+
+    // the same dependencies, expressed with one task group per node
+    ezDynamicArray<ezTaskGroupID> groups;
+    groups.SetCount(tasks.GetCount());
+
+    ezTime tGroups;
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      const ezTime tStart = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < tasks.GetCount(); ++i)
+      {
+        groups[i] = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+        ezTaskSystem::AddTaskToGroup(groups[i], tasks[i]);
+
+        if (i >= uiNodesPerLayer)
+        {
+          const ezUInt32 uiLayer = i / uiNodesPerLayer;
+          ezTaskSystem::AddTaskGroupDependency(groups[i], groups[i - uiNodesPerLayer]);
+          ezTaskSystem::AddTaskGroupDependency(groups[i], groups[(uiLayer - 1) * uiNodesPerLayer + (i % uiNodesPerLayer + 1) % uiNodesPerLayer]);
+        }
+      }
+
+      ezTaskSystem::StartTaskGroupBatch(groups);
+
+      for (const ezTaskGroupID& group : groups)
+      {
+        ezTaskSystem::WaitForGroup(group);
+      }
+
+      tGroups += ezTime::Now() - tStart;
+    }
+
+    ezLog::Info("[test]{} nodes, {} edges: task graph {}ms, task groups {}ms", tasks.GetCount(), 2 * (uiNumLayers - 1) * uiNodesPerLayer,
+      ezArgF(tGraph.GetMilliseconds() / uiNumRuns, 3), ezArgF(tGroups.GetMilliseconds() / uiNumRuns, 3));
+  }
+}
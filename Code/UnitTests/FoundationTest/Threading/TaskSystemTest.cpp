@@ -66,6 +66,70 @@ private:
   }
 };
 
+class ezTinyTask final : public ezTask
+{
+public:
+  ezTinyTask(ezAtomicInteger32* pExecuted)
+    : m_pExecuted(pExecuted)
+  {
+    ConfigureTask("ezTinyTask", ezTaskNesting::Never);
+  }
+
+private:
+  virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override { m_pExecuted->Increment(); }
+
+  ezAtomicInteger32* m_pExecuted;
+};
+
+class ezSpawnTinyTasksTask final : public ezTask
+{
+public:
+  ezSpawnTinyTasksTask(ezAtomicInteger32* pExecuted, ezUInt32 uiNumTinyTasks)
+    : m_pExecuted(pExecuted)
+    , m_uiNumTinyTasks(uiNumTinyTasks)
+  {
+    ConfigureTask("ezSpawnTinyTasksTask", ezTaskNesting::Maybe);
+  }
+
+private:
+  virtual void Execute() override
+  {
+    // scheduled from a worker thread, so the tiny tasks end up in that worker's own queue
+    ezSharedPtr<ezTinyTask> pTask = EZ_DEFAULT_NEW(ezTinyTask, m_pExecuted);
+    pTask->SetMultiplicity(m_uiNumTinyTasks);
+    ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame));
+  }
+
+  ezAtomicInteger32* m_pExecuted;
+  ezUInt32 m_uiNumTinyTasks;
+};
+
+class ezBlockWorkersTask final : public ezTask
+{
+public:
+  ezBlockWorkersTask(ezAtomicInteger32* pStarted, ezAtomicBool* pRelease)
+    : m_pStarted(pStarted)
+    , m_pRelease(pRelease)
+  {
+    // not 'Never', so that it doesn't go into the work-stealing queues and every worker picks up one invocation
+    ConfigureTask("ezBlockWorkersTask", ezTaskNesting::Maybe);
+  }
+
+private:
+  virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
+  {
+    m_pStarted->Increment();
+
+    while (!*m_pRelease)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+  }
+
+  ezAtomicInteger32* m_pStarted;
+  ezAtomicBool* m_pRelease;
+};
+
 class TaskCallbacks
 {
 public:
@@ -550,6 +614,105 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Canceling Queued Tasks with Multiplicity")
+  {
+    // keep all short task workers busy, so that none of the invocations of the canceled task get dequeued before it is canceled
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+    ezAtomicInteger32 iBlockersStarted;
+    ezAtomicBool bReleaseBlockers;
+
+    ezSharedPtr<ezBlockWorkersTask> pBlocker = EZ_DEFAULT_NEW(ezBlockWorkersTask, &iBlockersStarted, &bReleaseBlockers);
+    pBlocker->SetMultiplicity(uiNumWorkers);
+    ezTaskGroupID blockerGroup = ezTaskSystem::StartSingleTask(pBlocker, ezTaskPriority::EarlyThisFrame);
+
+    while (iBlockersStarted < (ezInt32)uiNumWorkers)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+
+    ezAtomicInteger32 iExecuted;
+    ezAtomicInteger32 iFinishedCallbacks;
+
+    TaskCallbacks callbacks;
+    callbacks.m_pInt = &iFinishedCallbacks;
+
+    // scheduled from the main thread, so all invocations go into the main thread's work-stealing queue
+    ezSharedPtr<ezTinyTask> pTask = EZ_DEFAULT_NEW(ezTinyTask, &iExecuted);
+    pTask->ConfigureTask("ezTinyTask", ezTaskNesting::Never, ezMakeDelegate(&TaskCallbacks::TaskFinished, &callbacks));
+    pTask->SetMultiplicity(16);
+    ezTaskGroupID taskGroup = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame);
+
+    EZ_TEST_BOOL(ezTaskSystem::CancelTask(pTask, ezOnTaskRunning::ReturnWithoutBlocking).Succeeded());
+    EZ_TEST_BOOL(!pTask->IsTaskFinished());
+
+    bReleaseBlockers = true;
+
+    ezTaskSystem::WaitForGroup(taskGroup);
+    ezTaskSystem::WaitForGroup(blockerGroup);
+
+    EZ_TEST_BOOL(pTask->IsTaskFinished());
+    EZ_TEST_INT(iExecuted, 0);
+    EZ_TEST_INT(iFinishedCallbacks, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scheduling Throughput")
+  {
+    // Measures how many tiny tasks per second get scheduled, dequeued and executed, depending on the number of worker threads.
+    // The tasks do no actual work, so the numbers are dominated by contention in the scheduler.
+    // 'Main' spawns all tasks from the main thread, so the workers have to steal all of them.
+    // 'Nested' spawns them from inside of tasks, so every worker also fills and drains its own queue.
+
+    const ezUInt32 uiNumIterations = 50;
+    const ezUInt32 uiTasksPerIteration = 512;
+    const ezUInt32 uiNumSpawners = 8;
+
+    for (ezUInt32 uiNumWorkers : {1, 2, 4, 8, 16, 32})
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiNumWorkers, iWorkersLong);
+
+      ezAtomicInteger32 iExecuted;
+
+      const ezTime tStartMain = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        ezSharedPtr<ezTinyTask> pTask = EZ_DEFAULT_NEW(ezTinyTask, &iExecuted);
+        pTask->SetMultiplicity(uiTasksPerIteration);
+        ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame));
+      }
+
+      const ezTime tMain = ezTime::Now() - tStartMain;
+      EZ_TEST_INT(iExecuted, uiNumIterations * uiTasksPerIteration);
+
+      iExecuted = 0;
+
+      const ezTime tStartNested = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
+        for (ezUInt32 s = 0; s < uiNumSpawners; ++s)
+        {
+          ezTaskSystem::AddTaskToGroup(group, EZ_DEFAULT_NEW(ezSpawnTinyTasksTask, &iExecuted, uiTasksPerIteration / uiNumSpawners));
+        }
+
+        ezTaskSystem::StartTaskGroup(group);
+        ezTaskSystem::WaitForGroup(group);
+      }
+
+      const ezTime tNested = ezTime::Now() - tStartNested;
+      EZ_TEST_INT(iExecuted, uiNumIterations * uiTasksPerIteration);
+
+      const double fNumTasks = uiNumIterations * uiTasksPerIteration;
+      ezLog::Info("[test]{} workers: Main {} tasks/ms, Nested {} tasks/ms", uiNumWorkers, ezArgF(fNumTasks / tMain.GetMilliseconds(), 1),
+        ezArgF(fNumTasks / tNested.GetMilliseconds(), 1));
+    }
+
+    ezTaskSystem::SetWorkerThreadCount(iWorkersShort, iWorkersLong);
+  }
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 
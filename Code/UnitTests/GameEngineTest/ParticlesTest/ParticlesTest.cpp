@@ -2,7 +2,9 @@
 
 #include "ParticlesTest.h"
 #include <Core/WorldSerializer/WorldReader.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/Utilities/Stats.h>
 #include <ParticlePlugin/Components/ParticleComponent.h>
 #include <RendererFoundation/Device/Device.h>
 
@@ -54,6 +56,8 @@ void ezGameEngineTestParticles::SetupSubTests()
   AddSubTest("LocalSpaceSim", SubTests::LocalSpaceSim);
 
   AddSubTest("Lighting", SubTests::Lighting);
+
+  AddSubTest("UpdateBudget", SubTests::UpdateBudget);
 }
 
 ezResult ezGameEngineTestParticles::InitializeSubTest(ezInt32 iIdentifier)
@@ -98,6 +102,11 @@ ezResult ezGameEngineTestParticles::InitializeSubTest(ezInt32 iIdentifier)
     m_pOwnApplication->SetupSceneSubTest("Particles/AssetCache/Common/Lighting.ezBinScene");
     return EZ_SUCCESS;
   }
+  else if (iIdentifier == SubTests::UpdateBudget)
+  {
+    m_pOwnApplication->SetupUpdateBudgetSubTest();
+    return EZ_SUCCESS;
+  }
   else
   {
     const char* szEffects[] = {
@@ -136,6 +145,9 @@ ezTestAppRun ezGameEngineTestParticles::RunSubTest(ezInt32 iIdentifier, ezUInt32
 {
   ++m_iFrame;
 
+  if (iIdentifier == SubTests::UpdateBudget)
+    return m_pOwnApplication->ExecUpdateBudgetSubTest(m_iFrame);
+
   return m_pOwnApplication->ExecParticleSubTest(m_iFrame);
 }
 
@@ -219,3 +231,158 @@ ezTestAppRun ezGameEngineTestApplication_Particles::ExecParticleSubTest(ezInt32
 
   return ezTestAppRun::Continue;
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  constexpr ezInt32 s_iUpdateBudgetPhaseLength = 30;
+  constexpr ezInt32 s_iUpdateBudgetWarmupFrames = 10;
+} // namespace
+
+void ezGameEngineTestApplication_Particles::SetupUpdateBudgetSubTest()
+{
+  LoadScene("Particles/AssetCache/Common/Particles1.ezBinScene").IgnoreResult();
+
+  m_UpdateBudgetEffects.Clear();
+  m_UpdateBudgetLifeTimes.Clear();
+
+  m_fPrevUpdateBudget = *static_cast<ezCVarFloat*>(ezCVar::FindCVarByName("Particles.UpdateBudget"));
+  m_fPrevLodScreenSize = *static_cast<ezCVarFloat*>(ezCVar::FindCVarByName("Particles.LodScreenSize"));
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezGameObject* pEffectObject;
+  if (!m_pWorld->TryGetObjectWithGlobalKey("Effect", pEffectObject))
+    return;
+
+  // a grid of effects, all of them in view
+  for (ezUInt32 i = 0; i < 16; ++i)
+  {
+    ezGameObjectDesc desc;
+    desc.m_LocalPosition = pEffectObject->GetGlobalPosition() + ezVec3(0, (i % 4) * 0.5f - 0.75f, (i / 4) * 0.5f - 0.75f);
+
+    ezGameObject* pObject;
+    m_pWorld->CreateObject(desc, pObject);
+
+    ezParticleComponent* pEffect;
+    m_pWorld->GetOrCreateComponentManager<ezParticleComponentManager>()->CreateComponent(pObject, pEffect);
+    pEffect->SetParticleEffectFile("{ 0881d8a5-3c3f-4868-8950-ee7402daa234 }"); // ContinuousEmitter
+    pEffect->m_uiRandomSeed = 42 + i;
+
+    m_UpdateBudgetEffects.PushBack(pEffect->GetHandle());
+  }
+}
+
+ezTestAppRun ezGameEngineTestApplication_Particles::ExecUpdateBudgetSubTest(ezInt32 iCurFrame)
+{
+  ezCVarFloat* pUpdateBudget = static_cast<ezCVarFloat*>(ezCVar::FindCVarByName("Particles.UpdateBudget"));
+  ezCVarFloat* pLodScreenSize = static_cast<ezCVarFloat*>(ezCVar::FindCVarByName("Particles.LodScreenSize"));
+
+  if (!EZ_TEST_BOOL(pUpdateBudget != nullptr && pLodScreenSize != nullptr) || !EZ_TEST_INT(m_UpdateBudgetEffects.GetCount(), 16))
+    return ezTestAppRun::Quit;
+
+  // phase 0: every effect is simulated every frame
+  // phase 1: all effects count as small, so they are simulated with 10 Hz
+  // phase 2: only very few effects fit into the update budget, the others are deferred
+  const ezInt32 iPhase = iCurFrame / s_iUpdateBudgetPhaseLength;
+  const ezInt32 iPhaseFrame = iCurFrame % s_iUpdateBudgetPhaseLength;
+
+  if (iPhase == 3)
+  {
+    *pUpdateBudget = m_fPrevUpdateBudget;
+    *pLodScreenSize = m_fPrevLodScreenSize;
+    return ezTestAppRun::Quit;
+  }
+
+  *pLodScreenSize = iPhase == 1 ? 100.0f : 0.0f;
+  *pUpdateBudget = iPhase == 2 ? 0.0001f : 0.0f;
+
+  Run();
+  if (ShouldApplicationQuit())
+    return ezTestAppRun::Quit;
+
+  auto GetLifeTimes = [this](ezDynamicArray<ezTime>& out_lifeTimes)
+  {
+    EZ_LOCK(m_pWorld->GetReadMarker());
+
+    for (const ezComponentHandle& hEffect : m_UpdateBudgetEffects)
+    {
+      const ezParticleComponent* pEffect = nullptr;
+      out_lifeTimes.PushBack(m_pWorld->TryGetComponent(hEffect, pEffect) ? pEffect->m_EffectController.GetTotalEffectLifeTime() : ezTime::MakeZero());
+    }
+  };
+
+  if (iPhaseFrame < s_iUpdateBudgetWarmupFrames)
+  {
+    // give the effects time to start up and adjust to the new settings
+    m_uiNumSimulatedEffects = 0;
+    m_uiNumSkippedEffects = 0;
+
+    if (iPhaseFrame == s_iUpdateBudgetWarmupFrames - 1)
+    {
+      m_UpdateBudgetLifeTimes.Clear();
+      GetLifeTimes(m_UpdateBudgetLifeTimes);
+    }
+
+    return ezTestAppRun::Continue;
+  }
+
+  ezStringBuilder sStatName;
+  sStatName.SetFormat("Particles/{0}/Simulated Effects", m_pWorld->GetName());
+  const ezUInt32 uiSimulated = ezStats::GetStat(sStatName).ConvertTo<ezUInt32>();
+  sStatName.SetFormat("Particles/{0}/Skipped Effects", m_pWorld->GetName());
+  const ezUInt32 uiSkipped = ezStats::GetStat(sStatName).ConvertTo<ezUInt32>();
+
+  m_uiNumSimulatedEffects += uiSimulated;
+  m_uiNumSkippedEffects += uiSkipped;
+
+  if (iPhase == 0)
+  {
+    EZ_TEST_BOOL(uiSimulated >= 16);
+  }
+
+  if (iPhase == 2)
+  {
+    // at least one effect is always updated
+    EZ_TEST_BOOL(uiSimulated >= 1);
+  }
+
+  if (iPhaseFrame < s_iUpdateBudgetPhaseLength - 1)
+    return ezTestAppRun::Continue;
+
+  ezHybridArray<ezTime, 16> lifeTimes;
+  GetLifeTimes(lifeTimes);
+
+  const ezTime tPhaseDuration = m_pWorld->GetClock().GetFixedTimeStep() * (s_iUpdateBudgetPhaseLength - s_iUpdateBudgetWarmupFrames);
+
+  for (ezUInt32 i = 0; i < lifeTimes.GetCount(); ++i)
+  {
+    const ezTime tSimulated = lifeTimes[i] - m_UpdateBudgetLifeTimes[i];
+
+    if (iPhase == 2)
+    {
+      // deferred effects get their turn eventually and catch up on the skipped time
+      EZ_TEST_BOOL(tSimulated.IsPositive());
+    }
+    else
+    {
+      // with larger time steps the effects lag behind by less than one step, but don't lose any time
+      const ezTime tTolerance = ezTime::MakeFromMilliseconds(iPhase == 1 ? 101 : 1);
+      EZ_TEST_BOOL(tSimulated <= tPhaseDuration + tTolerance);
+      EZ_TEST_BOOL(tSimulated >= tPhaseDuration - tTolerance);
+    }
+  }
+
+  if (iPhase == 0)
+  {
+    EZ_TEST_INT(m_uiNumSkippedEffects, 0);
+  }
+  else
+  {
+    EZ_TEST_BOOL(m_uiNumSimulatedEffects > 0);
+    EZ_TEST_BOOL(m_uiNumSkippedEffects > m_uiNumSimulatedEffects);
+  }
+
+  return ezTestAppRun::Continue;
+}
@@ -13,7 +13,18 @@ public:
   void SetupParticleSubTest(const char* szFile);
   ezTestAppRun ExecParticleSubTest(ezInt32 iCurFrame);
 
+  void SetupUpdateBudgetSubTest();
+  ezTestAppRun ExecUpdateBudgetSubTest(ezInt32 iCurFrame);
+
   ezUInt32 m_uiImageCompareThreshold = 110;
+
+private:
+  ezHybridArray<ezComponentHandle, 16> m_UpdateBudgetEffects;
+  ezHybridArray<ezTime, 16> m_UpdateBudgetLifeTimes;
+  ezUInt32 m_uiNumSimulatedEffects = 0;
+  ezUInt32 m_uiNumSkippedEffects = 0;
+  float m_fPrevUpdateBudget = 0.0f;
+  float m_fPrevLodScreenSize = 0.0f;
 };
 
 class ezGameEngineTestParticles : public ezGameEngineTest
@@ -59,7 +70,9 @@ private:
     EventReactionEffect,
     LocalSpaceSim,
 
-    Lighting
+    Lighting,
+
+    UpdateBudget,
   };
 
   virtual void SetupSubTests() override;
@@ -0,0 +1,126 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Math/Color8UNorm.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <Foundation/Types/ScopeExit.h>
+#include <RendererCore/Rasterizer/RasterizerObject.h>
+#include <RendererCore/Rasterizer/RasterizerView.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Occlusion);
+
+namespace
+{
+  struct OccluderInstance
+  {
+    ezSharedPtr<const ezRasterizerObject> m_pObject;
+    ezTransform m_Transform;
+  };
+
+  void RasterizeScene(ezRasterizerView& ref_view, ezArrayPtr<const OccluderInstance> occluders, ezArrayPtr<const ezSimdBBox> queries, ezDynamicArray<bool>& out_visibility, ezDynamicArray<ezColorLinearUB>& out_depth)
+  {
+    ref_view.BeginScene();
+
+    for (const OccluderInstance& occluder : occluders)
+    {
+      ref_view.AddObject(occluder.m_pObject.Borrow(), occluder.m_Transform);
+    }
+
+    ref_view.EndScene();
+
+    out_depth.SetCount(ref_view.GetResolutionX() * ref_view.GetResolutionY());
+    ref_view.ReadBackFrame(out_depth);
+
+    out_visibility.Clear();
+    for (const ezSimdBBox& box : queries)
+    {
+      out_visibility.PushBack(ref_view.IsVisible(box));
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Occlusion, RasterizerView)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 500.0f);
+  camera.LookAt(ezVec3::MakeZero(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+  // walls and boxes of different sizes in front of the camera, including some that intersect the near plane
+  ezDynamicArray<OccluderInstance> occluders;
+  for (ezUInt32 i = 0; i < 40; ++i)
+  {
+    const ezVec3 vSize((float)rng.DoubleMinMax(0.5, 4.0), (float)rng.DoubleMinMax(1.0, 20.0), (float)rng.DoubleMinMax(1.0, 20.0));
+
+    auto& occluder = occluders.ExpandAndGetRef();
+    occluder.m_pObject = ezRasterizerObject::CreateBox(vSize);
+    occluder.m_Transform = ezTransform::MakeIdentity();
+    occluder.m_Transform.m_vPosition.Set((float)rng.DoubleMinMax(0.0, 60.0), (float)rng.DoubleMinMax(-40.0, 40.0), (float)rng.DoubleMinMax(-40.0, 40.0));
+  }
+
+  ezDynamicArray<ezSimdBBox> queries;
+  for (ezUInt32 i = 0; i < 2000; ++i)
+  {
+    const ezSimdVec4f vCenter((float)rng.DoubleMinMax(5.0, 100.0), (float)rng.DoubleMinMax(-80.0, 80.0), (float)rng.DoubleMinMax(-80.0, 80.0));
+    const ezSimdVec4f vHalfExtents((float)rng.DoubleMinMax(0.1, 2.0), (float)rng.DoubleMinMax(0.1, 2.0), (float)rng.DoubleMinMax(0.1, 2.0));
+
+    queries.PushBack(ezSimdBBox::MakeFromCenterAndHalfExtents(vCenter, vHalfExtents));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tiled rasterization matches single-threaded")
+  {
+    ezRasterizerView view;
+    view.SetResolution(256, 128, 2.0f);
+    view.SetCamera(&camera);
+
+    // a single tile uses the sequential path, which rejects hidden occluders before rasterizing them
+    ezDynamicArray<bool> expected;
+    ezDynamicArray<ezColorLinearUB> expectedDepth;
+    view.SetNumTiles(1);
+    RasterizeScene(view, occluders, queries, expected, expectedDepth);
+
+    ezUInt32 uiNumVisible = 0;
+    for (bool bVisible : expected)
+    {
+      uiNumVisible += bVisible ? 1 : 0;
+    }
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+    EZ_TEST_BOOL(view.HasRasterizedAnyOccluders());
+
+    // make sure the scene actually tests something
+    EZ_TEST_BOOL(uiNumVisible > 0);
+    EZ_TEST_BOOL(uiNumVisible < queries.GetCount());
+#endif
+
+    // The depth buffer has to match as well, cleared blocks of the hierarchical depth buffer are read back as zero.
+    // Triangles that are clipped at tile borders may cover slightly different pixels, depending on the compiler and the scene,
+    // so a few pixels along the tile edges are allowed to differ.
+    const ezUInt32 uiMaxDifferingPixels = expectedDepth.GetCount() / 200;
+
+    ezDynamicArray<bool> result;
+    ezDynamicArray<ezColorLinearUB> resultDepth;
+    for (ezUInt32 uiNumTiles : {2u, 3u, 7u, 16u, 100u})
+    {
+      view.SetNumTiles(uiNumTiles);
+      RasterizeScene(view, occluders, queries, result, resultDepth);
+
+      EZ_TEST_BOOL(result == expected);
+
+      ezUInt32 uiNumDifferingPixels = 0;
+      for (ezUInt32 i = 0; i < expectedDepth.GetCount(); ++i)
+      {
+        uiNumDifferingPixels += ezMemoryUtils::RawByteCompare(&resultDepth[i], &expectedDepth[i], sizeof(ezColorLinearUB)) != 0 ? 1 : 0;
+      }
+
+      EZ_TEST_BOOL_MSG(uiNumDifferingPixels <= uiMaxDifferingPixels, "%u tiles: %u of %u depth pixels differ", uiNumTiles, uiNumDifferingPixels, expectedDepth.GetCount());
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Math/Random.h>
+#include <RendererCore/Components/SpriteComponent.h>
+#include <RendererCore/Meshes/MeshComponentBase.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/SortingFunctions.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Pipeline);
+
+namespace
+{
+  void RandomizeRenderData(ezRandom& ref_rng, ezRenderData& ref_renderData)
+  {
+    // some of the render data is behind the camera or beyond the far plane, so that the distance gets clamped
+    ref_renderData.m_GlobalTransform.m_vPosition.Set((float)ref_rng.DoubleMinMax(-50.0, 900.0), (float)ref_rng.DoubleMinMax(-100.0, 100.0), (float)ref_rng.DoubleMinMax(-100.0, 100.0));
+    ref_renderData.m_fSortingDepthOffset = ref_rng.Bool() ? 0.0f : (float)ref_rng.DoubleMinMax(-10.0, 10.0);
+
+    // only a few different values, so that many sorting keys are equal
+    ref_renderData.m_uiSortingKey = ref_rng.UIntInRange(4);
+    ref_renderData.m_uiBatchId = ref_rng.UIntInRange(8);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, RenderDataSorting)
+{
+  ezRandom rng;
+  rng.Initialize(42);
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 500.0f);
+  camera.LookAt(ezVec3(1, 2, 3), ezVec3(10, 2, 3), ezVec3(0, 0, 1));
+
+  // different types in runs of varying length, the batched functions only look up the type hash when the type changes
+  ezDynamicArray<ezMeshRenderData> meshRenderData;
+  ezDynamicArray<ezSpriteRenderData> spriteRenderData;
+  meshRenderData.SetCount(300);
+  spriteRenderData.SetCount(203);
+
+  ezDynamicArray<const ezRenderData*> renderData;
+  for (ezUInt32 uiMesh = 0, uiSprite = 0; uiMesh < meshRenderData.GetCount() || uiSprite < spriteRenderData.GetCount();)
+  {
+    const bool bMesh = uiSprite == spriteRenderData.GetCount() || (uiMesh < meshRenderData.GetCount() && rng.Bool());
+    const ezUInt32 uiRunLength = rng.UIntInRange(5) + 1;
+
+    for (ezUInt32 i = 0; i < uiRunLength; ++i)
+    {
+      ezRenderData* pRenderData = nullptr;
+      if (bMesh && uiMesh < meshRenderData.GetCount())
+        pRenderData = &meshRenderData[uiMesh++];
+      else if (!bMesh && uiSprite < spriteRenderData.GetCount())
+        pRenderData = &spriteRenderData[uiSprite++];
+      else
+        break;
+
+      RandomizeRenderData(rng, *pRenderData);
+      renderData.PushBack(pRenderData);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batched sorting keys")
+  {
+    ezDynamicArray<ezUInt64> sortingKeys;
+    sortingKeys.SetCount(renderData.GetCount());
+
+    // also test counts that are not a multiple of four
+    for (ezUInt32 uiCount : {1u, 2u, 3u, 4u, 7u, renderData.GetCount()})
+    {
+      const ezArrayPtr<const ezRenderData* const> data = renderData.GetArrayPtr().GetSubArray(0, uiCount);
+      const ezArrayPtr<ezUInt64> keys = sortingKeys.GetArrayPtr().GetSubArray(0, uiCount);
+
+      ezRenderSortingFunctions::ByRenderDataThenFrontToBackBatch(data, camera, keys);
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_TEST_BOOL(keys[i] == ezRenderSortingFunctions::ByRenderDataThenFrontToBack(data[i], camera));
+      }
+
+      ezRenderSortingFunctions::BackToFrontThenByRenderDataBatch(data, camera, keys);
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_TEST_BOOL(keys[i] == ezRenderSortingFunctions::BackToFrontThenByRenderData(data[i], camera));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SortAndBatch")
+  {
+    for (ezRenderData::Category category : {ezDefaultRenderDataCategories::LitOpaque, ezDefaultRenderDataCategories::LitTransparent})
+    {
+      ezExtractedRenderData extractedData;
+      extractedData.SetCamera(camera);
+
+      for (const ezRenderData* pRenderData : renderData)
+      {
+        extractedData.AddRenderData(pRenderData, category);
+      }
+
+      extractedData.SortAndBatch();
+
+      // render data is sorted by sorting key, equal keys are ordered by batch id and every batch only contains one batch id and type
+      const ezRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(category);
+
+      ezUInt32 uiNumRenderData = 0;
+      ezUInt64 uiLastSortingKey = 0;
+      ezUInt32 uiLastBatchId = 0;
+      const ezRenderData* pLastRenderData = nullptr;
+
+      for (ezUInt32 uiBatch = 0; uiBatch < batchList.GetBatchCount(); ++uiBatch)
+      {
+        const ezRenderDataBatch batch = batchList.GetBatch(uiBatch);
+        const ezRenderData* pFirstData = batch.GetFirstData<ezRenderData>();
+
+        for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+        {
+          const ezRenderData* pRenderData = it;
+          const ezUInt64 uiSortingKey = pRenderData->GetCategorySortingKey(category, camera);
+
+          EZ_TEST_INT(pRenderData->m_uiBatchId, pFirstData->m_uiBatchId);
+          EZ_TEST_BOOL(pRenderData->GetDynamicRTTI() == pFirstData->GetDynamicRTTI());
+
+          if (pLastRenderData != nullptr)
+          {
+            EZ_TEST_BOOL(uiLastSortingKey <= uiSortingKey);
+
+            if (uiLastSortingKey == uiSortingKey)
+            {
+              EZ_TEST_BOOL(uiLastBatchId <= pRenderData->m_uiBatchId);
+            }
+          }
+
+          uiLastSortingKey = uiSortingKey;
+          uiLastBatchId = pRenderData->m_uiBatchId;
+          pLastRenderData = pRenderData;
+          ++uiNumRenderData;
+        }
+      }
+
+      EZ_TEST_INT(uiNumRenderData, renderData.GetCount());
+    }
+  }
+}